@@ -78,6 +78,31 @@ void KisBlurBenchmark::benchmarkFilter()
     }
 }
 
+void KisBlurBenchmark::benchmarkLensBlur_data()
+{
+    QTest::addColumn<bool>("circularApproximation");
+
+    QTest::newRow("exact") << false;
+    QTest::newRow("approximation") << true;
+}
+
+void KisBlurBenchmark::benchmarkLensBlur()
+{
+    QFETCH(bool, circularApproximation);
+
+    KisFilterSP filter = KisFilterRegistry::instance()->value("lens blur");
+    QVERIFY(filter);
 
+    KisFilterConfigurationSP kfc = filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    kfc->setProperty("irisShape", "Octagon (8)");
+    kfc->setProperty("irisRadius", 20);
+    kfc->setProperty("halfWidth", 20);
+    kfc->setProperty("halfHeight", 20);
+    kfc->setProperty("circularApproximation", circularApproximation);
+
+    QBENCHMARK{
+        filter->process(m_device, QRect(0, 0, GMP_IMAGE_WIDTH,GMP_IMAGE_HEIGHT), kfc);
+    }
+}
 
 SIMPLE_TEST_MAIN(KisBlurBenchmark)
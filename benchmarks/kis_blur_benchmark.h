@@ -27,6 +27,8 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkFilter();
+    void benchmarkLensBlur_data();
+    void benchmarkLensBlur();
     
 };
 
@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <cmath>
 
 #if defined(_WIN32) || defined(_WIN64)
 #define srand48 srand
@@ -39,6 +40,10 @@ inline double drand48()
 #include <brushengine/kis_paintop_registry.h>
 
 #include <KisGlobalResourcesInterface.h>
+#include <KisLocalStrokeResources.h>
+#include <KoPattern.h>
+#include <kis_fixed_paint_device.h>
+#include <kis_pointer_utils.h>
 
 //#define SAVE_OUTPUT
 
@@ -347,6 +352,45 @@ void KisStrokeBenchmark::colorsmudgeRL()
     benchmarkStroke(presetFileName);
 }
 
+void KisStrokeBenchmark::texturedBrush300px()
+{
+    KisPaintOpPresetSP preset = loadTexturedPreset("autobrush_300px.kpp");
+    QVERIFY(preset);
+
+    m_painter->setPaintOpPreset(preset, m_layer, m_image);
+
+    QBENCHMARK{
+        KisDistanceInformation currentDistance;
+        m_painter->paintBezierCurve(m_pi1, m_c1, m_c1, m_pi2, &currentDistance);
+        m_painter->paintBezierCurve(m_pi2, m_c2, m_c2, m_pi3, &currentDistance);
+    }
+
+#ifdef SAVE_OUTPUT
+    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + "textured_autobrush_300px" + OUTPUT_FORMAT);
+#endif
+}
+
+void KisStrokeBenchmark::texturedBrush300pxRL()
+{
+    KisPaintOpPresetSP preset = loadTexturedPreset("autobrush_300px.kpp");
+    QVERIFY(preset);
+
+    m_painter->setPaintOpPreset(preset, m_layer, m_image);
+
+    QBENCHMARK{
+        KisDistanceInformation currentDistance;
+        for (int i = 0; i < LINES; i++){
+            KisPaintInformation pi1(m_startPoints[i], 0.0);
+            KisPaintInformation pi2(m_endPoints[i], 1.0);
+            m_painter->paintLine(pi1, pi2, &currentDistance);
+        }
+    }
+
+#ifdef SAVE_OUTPUT
+    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + "textured_autobrush_300px_randomLines" + OUTPUT_FORMAT);
+#endif
+}
+
 
 void KisStrokeBenchmark::roundMarker()
 {
@@ -584,6 +628,49 @@ void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
 #endif
 }
 
+KisPaintOpPresetSP KisStrokeBenchmark::loadTexturedPreset(QString presetFileName)
+{
+    /**
+     * The benchmark data has no textured presets, so take a plain one and
+     * enable the texture option with a generated noise-like pattern. The
+     * pattern is passed via local resources to avoid depending on the
+     * resources database.
+     */
+    QImage patternImage(173, 157, QImage::Format_ARGB32);
+    srand(12345678);
+    for (int y = 0; y < patternImage.height(); y++) {
+        QRgb *line = reinterpret_cast<QRgb*>(patternImage.scanLine(y));
+        for (int x = 0; x < patternImage.width(); x++) {
+            const int value = rand() % 256;
+            line[x] = qRgba(value, value, value, 255);
+        }
+    }
+
+    KoPatternSP pattern(new KoPattern(patternImage, "benchmark_texture", "benchmark_texture.pat"));
+
+    QSharedPointer<KisLocalStrokeResources> resourcesInterface(new KisLocalStrokeResources());
+    resourcesInterface->addResource(pattern);
+
+    KisPaintOpPresetSP preset(new KisPaintOpPreset(m_dataPath + presetFileName));
+    if (!preset->load(resourcesInterface)) {
+        dbgKrita << "The preset was not loaded correctly. Done.";
+        return KisPaintOpPresetSP();
+    }
+
+    KisPaintOpSettingsSP settings = preset->settings();
+    settings->setProperty("Texture/Pattern/Enabled", true);
+    settings->setProperty("Texture/Pattern/Name", pattern->name());
+    settings->setProperty("Texture/Pattern/PatternFileName", pattern->filename());
+    settings->setProperty("Texture/Pattern/Scale", 1.0);
+    settings->setProperty("Texture/Pattern/Contrast", 1.0);
+    settings->setProperty("Texture/Pattern/NeutralPoint", 0.5);
+    settings->setProperty("Texture/Pattern/TexturingMode", 0); // multiply
+    settings->setProperty("Texture/Pattern/CutoffRight", 255);
+    preset->setResourcesInterface(resourcesInterface);
+
+    return preset;
+}
+
 static const int COUNT = 1000000;
 void KisStrokeBenchmark::benchmarkRand48()
 {
@@ -621,5 +708,63 @@ void KisStrokeBenchmark::benchmarkPresetCloning()
     }
 }
 
+void KisStrokeBenchmark::benchmarkDabAllocation(KisOptimizedByteArray::MemoryAllocatorSP allocator)
+{
+    /**
+     * Simulates the dab churn of a pressure-driven stroke: the dab size
+     * swings between 10 and 300 px and a few dabs are kept alive at the
+     * same time, like the dab rendering queue does when the jobs are
+     * executed in parallel.
+     */
+    const int numDabs = 2000;
+    const int maxDabsInFlight = 8;
+
+    QVector<KisFixedPaintDeviceSP> dabsInFlight;
+
+    QBENCHMARK {
+        for (int i = 0; i < numDabs; i++) {
+            const int size = 155 + 145 * std::sin(i * 0.05);
+
+            KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(m_colorSpace, allocator);
+            dab->setRect(QRect(0, 0, size, size));
+            dab->lazyGrowBufferWithoutInitialization();
+            dab->data()[0] = quint8(i);
+
+            dabsInFlight.append(dab);
+            if (dabsInFlight.size() > maxDabsInFlight) {
+                dabsInFlight.removeFirst();
+            }
+        }
+        dabsInFlight.clear();
+    }
+
+    if (auto *pooled = dynamic_cast<KisOptimizedByteArray::PooledMemoryAllocator*>(allocator.data())) {
+        const KisOptimizedByteArray::Statistics stats = pooled->statistics();
+        qDebug() << "system allocs:" << stats.systemAllocations
+                 << "pooled allocs:" << stats.pooledAllocations
+                 << "system frees:" << stats.systemDeallocations;
+    } else if (auto *sizeClass = dynamic_cast<KisOptimizedByteArray::SizeClassMemoryAllocator*>(allocator.data())) {
+        const KisOptimizedByteArray::Statistics stats = sizeClass->statistics();
+        qDebug() << "system allocs:" << stats.systemAllocations
+                 << "pooled allocs:" << stats.pooledAllocations
+                 << "system frees:" << stats.systemDeallocations;
+    }
+}
+
+void KisStrokeBenchmark::dabAllocationDefault()
+{
+    benchmarkDabAllocation(KisOptimizedByteArray::MemoryAllocatorSP());
+}
+
+void KisStrokeBenchmark::dabAllocationPooled()
+{
+    benchmarkDabAllocation(toQShared(new KisOptimizedByteArray::PooledMemoryAllocator()));
+}
+
+void KisStrokeBenchmark::dabAllocationSizeClass()
+{
+    benchmarkDabAllocation(toQShared(new KisOptimizedByteArray::SizeClassMemoryAllocator()));
+}
+
 
 SIMPLE_TEST_MAIN(KisStrokeBenchmark)
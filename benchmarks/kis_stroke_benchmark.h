@@ -14,6 +14,7 @@
 #include <brushengine/kis_paint_information.h>
 #include <kis_image.h>
 #include <kis_layer.h>
+#include <KisOptimizedByteArray.h>
 
 
 const QString PRESET_FILE_NAME = "hairy-benchmark1.kpp";
@@ -57,6 +58,9 @@ private:
         inline void benchmarkCircle(QString presetFileName);
         inline void benchmarkRectangle(QString presetFileName);
 
+        KisPaintOpPresetSP loadTexturedPreset(QString presetFileName);
+        void benchmarkDabAllocation(KisOptimizedByteArray::MemoryAllocatorSP allocator);
+
 private Q_SLOTS:
     void initTestCase();
     void cleanupTestCase();
@@ -115,6 +119,9 @@ private Q_SLOTS:
     void colorsmudge();
     void colorsmudgeRL();
 
+    void texturedBrush300px();
+    void texturedBrush300pxRL();
+
     void roundMarker();
     void roundMarkerRandomLines();
     void roundMarkerRectangle();
@@ -131,6 +138,10 @@ private Q_SLOTS:
     void benchmarkRand48();
 
     void benchmarkPresetCloning();
+
+    void dabAllocationDefault();
+    void dabAllocationPooled();
+    void dabAllocationSizeClass();
 };
 
 #endif
@@ -9,14 +9,61 @@
 #include <QApplication>
 
 #include <QGlobalStatic>
+#include <QCache>
+#include <QMutex>
+#include <QCryptographicHash>
 #include <KoResourcePaths.h>
 
 #include <KoResource.h>
 
 #include <kis_debug.h>
+#include "kis_qimage_pyramid.h"
 
 Q_GLOBAL_STATIC(KisBrushServerProvider, s_instance)
 
+namespace {
+
+/**
+ * The cache is limited by the memory footprint of the pyramids
+ * (in KiB). The pyramid takes about 4/3 of the size of its base
+ * level, plus the upscaled levels of small brushes.
+ */
+static const int maxPyramidCacheCost = 128 * 1024;
+
+struct BrushTipPyramidCache
+{
+    QMutex mutex;
+    QCache<QByteArray, KisQImagePyramid> cache {maxPyramidCacheCost};
+};
+
+Q_GLOBAL_STATIC(BrushTipPyramidCache, s_pyramidCache)
+
+QByteArray brushTipKey(const QImage &image)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    const QSize size = image.size();
+    const int format = image.format();
+    hash.addData(reinterpret_cast<const char*>(&size), sizeof(size));
+    hash.addData(reinterpret_cast<const char*>(&format), sizeof(format));
+
+    const int bytesPerLine = image.bytesPerLine();
+    for (int y = 0; y < image.height(); y++) {
+        hash.addData(reinterpret_cast<const char*>(image.constScanLine(y)), bytesPerLine);
+    }
+
+    return hash.result();
+}
+
+int pyramidCost(const QImage &image)
+{
+    // the pyramid has about twice as much pixels as the base
+    // image (mipmaps plus upscaled levels for small tips)
+    return qMax(1, int(2 * qint64(image.width()) * image.height() * 4 / 1024));
+}
+
+}
+
 
 KisBrushServerProvider::KisBrushServerProvider()
 {
@@ -37,3 +84,42 @@ KoResourceServer<KisBrush>* KisBrushServerProvider::brushServer()
 {
     return m_brushServer;
 }
+
+KisQImagePyramid* KisBrushServerProvider::fetchBrushTipPyramid(const QImage &brushTipImage)
+{
+    const QByteArray key = brushTipKey(brushTipImage);
+
+    BrushTipPyramidCache *storage = s_pyramidCache;
+
+    {
+        QMutexLocker l(&storage->mutex);
+        KisQImagePyramid *cachedPyramid = storage->cache.object(key);
+        if (cachedPyramid) {
+            return new KisQImagePyramid(*cachedPyramid);
+        }
+    }
+
+    /**
+     * Generate the pyramid without holding the lock. If two threads
+     * race for the same tip, the pyramids are equal, so we just keep
+     * the one that came first.
+     */
+    KisQImagePyramid *pyramid = new KisQImagePyramid(brushTipImage);
+
+    {
+        QMutexLocker l(&storage->mutex);
+        if (!storage->cache.contains(key)) {
+            storage->cache.insert(key, new KisQImagePyramid(*pyramid), pyramidCost(brushTipImage));
+        }
+    }
+
+    return pyramid;
+}
+
+void KisBrushServerProvider::clearBrushTipPyramidCache()
+{
+    BrushTipPyramidCache *storage = s_pyramidCache;
+
+    QMutexLocker l(&storage->mutex);
+    storage->cache.clear();
+}
@@ -12,6 +12,8 @@
 #include "kritabrush_export.h"
 #include "kis_brush.h"
 
+class KisQImagePyramid;
+
 /**
  *
  */
@@ -28,6 +30,23 @@ public:
 
     static KisBrushServerProvider* instance();
 
+    /**
+     * Returns a mipmap pyramid for \p brushTipImage. The pyramids are
+     * cached process-wide by the content of the tip image, so all the
+     * brushes using the same tip (e.g. different presets or the clones
+     * created for every stroke) reuse the same prescaled levels. The
+     * levels are implicitly shared, so the returned object is cheap.
+     *
+     * The function is thread-safe and doesn't access the resource
+     * server, so it can be called from the stroke threads.
+     */
+    static KisQImagePyramid* fetchBrushTipPyramid(const QImage &brushTipImage);
+
+    /**
+     * Drops all the cached pyramids
+     */
+    static void clearBrushTipPyramidCache();
+
 private:
 
     KisBrushServerProvider(const KisBrushServerProvider&);
@@ -34,6 +34,7 @@
 #include <brushengine/kis_paint_information.h>
 #include <kis_fixed_paint_device.h>
 #include <kis_qimage_pyramid.h>
+#include "KisBrushServerProvider.h"
 #include <brushengine/kis_paintop_lod_limitations.h>
 #include <resources/KoAbstractGradient.h>
 #include <resources/KoCachedGradient.h>
@@ -128,7 +129,7 @@ struct KisBrush::Private {
         , threadingAllowed(true)
         , brushPyramid([] (const KisBrush* brush)
                        {
-                           return new KisQImagePyramid(brush->brushTipImage());
+                           return KisBrushServerProvider::fetchBrushTipPyramid(brush->brushTipImage());
                        })
         , brushOutline(&detail::outlineFactory)
 
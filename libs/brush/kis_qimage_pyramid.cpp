@@ -246,9 +246,13 @@ void KisQImagePyramid::appendPyramidLevel(const QImage &image)
      * wide border to the image, so that it transforms smoothly.
      *
      * See a unittest in: KisGbrBrushTest::testQPainterTransformationBorder
+     *
+     * The levels are stored non-premultiplied, the format the users of the
+     * pyramid read, so the dabs don't go through a lossy premultiplication
+     * round trip and don't need an extra conversion pass.
      */
-    
-QSize levelSize = image.size();
+
+    QSize levelSize = image.size();
     QImage tmp = image.convertToFormat(QImage::Format_ARGB32);
     tmp = tmp.copy(-QPAINTER_WORKAROUND_BORDER,
                    -QPAINTER_WORKAROUND_BORDER,
@@ -21,6 +21,7 @@
 #include "brushengine/kis_paint_information.h"
 #include <kis_fixed_paint_device.h>
 #include "kis_qimage_pyramid.h"
+#include "KisBrushServerProvider.h"
 #include <KisGlobalResourcesInterface.h>
 
 void KisGbrBrushTest::testMaskGenerationSingleColor()
@@ -242,6 +243,43 @@ void KisGbrBrushTest::testPyramidDabTransform()
     QCOMPARE(dabTransformHelper(KisDabShape(1.0, 0.5, M_PI / 4)), QSize(160, 160));
 }
 
+void KisGbrBrushTest::testBrushTipPyramidCache()
+{
+    QScopedPointer<KisGbrBrush> brush1(new KisGbrBrush(QString(FILES_DATA_DIR) + '/' + "testing_brush_512_bars.gbr"));
+    brush1->load(KisGlobalResourcesInterface::instance());
+    QVERIFY(!brush1->brushTipImage().isNull());
+
+    QScopedPointer<KisGbrBrush> brush2(new KisGbrBrush(QString(FILES_DATA_DIR) + '/' + "testing_brush_512_bars.gbr"));
+    brush2->load(KisGlobalResourcesInterface::instance());
+    QVERIFY(!brush2->brushTipImage().isNull());
+
+    KisBrushServerProvider::clearBrushTipPyramidCache();
+
+    QScopedPointer<KisQImagePyramid> pyramid1(KisBrushServerProvider::fetchBrushTipPyramid(brush1->brushTipImage()));
+    QScopedPointer<KisQImagePyramid> pyramid2(KisBrushServerProvider::fetchBrushTipPyramid(brush2->brushTipImage()));
+
+    // two independently loaded brushes share the same levels
+    QCOMPARE(pyramid1->m_levels.size(), pyramid2->m_levels.size());
+    for (int i = 0; i < pyramid1->m_levels.size(); i++) {
+        QCOMPARE(pyramid1->m_levels[i].image.cacheKey(), pyramid2->m_levels[i].image.cacheKey());
+    }
+
+    // and the cached pyramid generates the same dabs as a fresh one
+    KisQImagePyramid freshPyramid(brush1->brushTipImage());
+
+    const QVector<KisDabShape> shapes = {
+        KisDabShape(1.0, 1.0, 0.0),
+        KisDabShape(0.37, 1.0, 0.0),
+        KisDabShape(1.7, 0.5, 1.3)
+    };
+
+    Q_FOREACH (const KisDabShape &shape, shapes) {
+        QCOMPARE(pyramid2->createImage(shape, 0.25, 0.1), freshPyramid.createImage(shape, 0.25, 0.1));
+    }
+
+    KisBrushServerProvider::clearBrushTipPyramidCache();
+}
+
 // see comment in KisQImagePyramid::appendPyramidLevel
 void KisGbrBrushTest::testQPainterTransformationBorder()
 {
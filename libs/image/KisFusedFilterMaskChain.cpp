@@ -0,0 +1,278 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisFusedFilterMaskChain.h"
+
+#include <QSharedPointer>
+#include <QVector>
+
+#include <KoColorSpace.h>
+#include <KoColorTransformation.h>
+#include <KoCompositeOp.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "kis_effect_mask.h"
+#include "kis_filter_mask.h"
+#include "kis_selection.h"
+#include "kis_paint_device.h"
+#include "kis_random_accessor_ng.h"
+#include "kis_busy_progress_indicator.h"
+#include "filter/kis_filter_registry.h"
+#include "filter/kis_color_transformation_filter.h"
+#include "filter/kis_color_transformation_configuration.h"
+
+namespace {
+
+struct Candidate {
+    KisFilterMaskSP mask;
+    KisColorTransformationConfigurationSP config;
+    KisFilterSP filter;
+};
+
+struct Step {
+    KisFilterMaskSP mask;
+    QSharedPointer<KoColorTransformation> transformation;
+
+    KisPaintDeviceSP selectionProjection;
+    QRect selectionRect;
+    KisRandomConstAccessorSP selectionIt;
+
+    QSharedPointer<KisIndirectPaintingSupport::ReadLocker> locker;
+};
+
+}
+
+struct KisFusedFilterMaskChain::Private
+{
+    KisPaintDeviceSP projection;
+    QRect applyRect;
+    QVector<Candidate> candidates;
+    QVector<Step> steps;
+
+    bool tryAddCandidate(KisEffectMaskSP effectMask);
+    bool tryAddStep(const Candidate &candidate);
+    void processRow(quint8 *row, int x, int y, int numPixels,
+                    const QVector<qint32> &selectionRowOffsets,
+                    quint8 *scratch);
+};
+
+bool KisFusedFilterMaskChain::Private::tryAddCandidate(KisEffectMaskSP effectMask)
+{
+    KisFilterMaskSP mask = dynamic_cast<KisFilterMask*>(effectMask.data());
+    if (!mask) return false;
+
+    KisFilterConfigurationSP filterConfig = mask->filter();
+    if (!filterConfig) return false;
+
+    KisColorTransformationConfigurationSP config(
+        dynamic_cast<KisColorTransformationConfiguration*>(filterConfig.data()));
+    if (!config) return false;
+
+    KisFilterSP filter = KisFilterRegistry::instance()->value(filterConfig->name());
+    if (!dynamic_cast<const KisColorTransformationFilter*>(filter.data())) return false;
+
+    /**
+     * Just a hint, the mask is not locked yet. The temporary target is
+     * checked once again when the mask is locked in tryAddStep().
+     */
+    if (mask->hasTemporaryTarget()) return false;
+
+    Candidate candidate;
+    candidate.mask = mask;
+    candidate.config = config;
+    candidate.filter = filter;
+    candidates.append(candidate);
+
+    return true;
+}
+
+bool KisFusedFilterMaskChain::Private::tryAddStep(const Candidate &candidate)
+{
+    Step step;
+    step.locker.reset(new KisIndirectPaintingSupport::ReadLocker(candidate.mask.data()));
+
+    /**
+     * The temporary target should be merged into the selection on the
+     * fly, let the mask do that itself
+     */
+    if (candidate.mask->hasTemporaryTarget()) return false;
+
+    KisSelectionSP selection = candidate.mask->selection();
+    if (selection) {
+        selection->updateProjection(applyRect);
+
+        step.selectionRect = applyRect & selection->selectedRect();
+        step.selectionProjection = selection->projection();
+        step.selectionIt = step.selectionProjection->createRandomConstAccessorNG();
+    }
+
+    const KisColorTransformationFilter *colorFilter =
+        dynamic_cast<const KisColorTransformationFilter*>(candidate.filter.data());
+
+    step.mask = candidate.mask;
+    step.transformation =
+        colorFilter->cachedTransformation(projection->colorSpace(), candidate.config,
+                                          qint64(applyRect.width()) * applyRect.height());
+
+    if (!step.transformation) return false;
+
+    steps.append(step);
+    return true;
+}
+
+void KisFusedFilterMaskChain::Private::processRow(quint8 *row, int x, int y, int numPixels,
+                                                  const QVector<qint32> &selectionRowOffsets,
+                                                  quint8 *scratch)
+{
+    const KoColorSpace *cs = projection->colorSpace();
+    const int pixelSize = cs->pixelSize();
+    const KoCompositeOp *copyOp = cs->compositeOp(COMPOSITE_COPY);
+
+    for (int i = 0; i < steps.size(); i++) {
+        const Step &step = steps[i];
+
+        if (!step.selectionProjection) {
+            step.transformation->transform(row, row, numPixels);
+            continue;
+        }
+
+        if (y < step.selectionRect.top() || y > step.selectionRect.bottom()) continue;
+
+        const int left = qMax(x, step.selectionRect.left());
+        const int right = qMin(x + numPixels - 1, step.selectionRect.right());
+        if (left > right) continue;
+
+        quint8 *dst = row + (left - x) * pixelSize;
+        const int cols = right - left + 1;
+
+        step.transformation->transform(dst, scratch, cols);
+
+        KoCompositeOp::ParameterInfo params;
+        params.dstRowStart = dst;
+        params.srcRowStart = scratch;
+        params.maskRowStart = step.selectionIt->rawDataConst() + selectionRowOffsets[i] + (left - x);
+        params.rows = 1;
+        params.cols = cols;
+        copyOp->composite(params);
+    }
+}
+
+KisFusedFilterMaskChain::KisFusedFilterMaskChain(const QList<KisEffectMaskSP> &masks,
+                                                 int firstMask,
+                                                 KisPaintDeviceSP projection,
+                                                 const QRect &applyRect)
+    : m_d(new Private)
+{
+    m_d->projection = projection;
+    m_d->applyRect = applyRect;
+
+    const KoColorSpace *cs = projection->colorSpace();
+    const KoColorSpace *compositionCs = projection->compositionSourceColorSpace();
+
+    if (cs != compositionCs && *cs != *compositionCs) return;
+    if (!cs->compositeOp(COMPOSITE_COPY)) return;
+
+    for (int i = firstMask; i < masks.size(); i++) {
+        if (!m_d->tryAddCandidate(masks[i])) break;
+    }
+}
+
+KisFusedFilterMaskChain::~KisFusedFilterMaskChain()
+{
+}
+
+int KisFusedFilterMaskChain::size() const
+{
+    return m_d->candidates.size();
+}
+
+int KisFusedFilterMaskChain::apply()
+{
+    if (m_d->applyRect.isEmpty()) return m_d->candidates.size();
+
+    Q_FOREACH (const Candidate &candidate, m_d->candidates) {
+        if (!m_d->tryAddStep(candidate)) break;
+    }
+
+    if (m_d->steps.isEmpty()) return 0;
+
+    Q_FOREACH (const Step &step, m_d->steps) {
+        if (step.mask->busyProgressIndicator()) {
+            step.mask->busyProgressIndicator()->update();
+        }
+    }
+
+    const QRect &rc = m_d->applyRect;
+    const int pixelSize = m_d->projection->pixelSize();
+
+    KisRandomAccessorSP dstIt = m_d->projection->createRandomAccessorNG();
+
+    QVector<qint32> selectionRowStrides(m_d->steps.size(), 0);
+    QVector<qint32> selectionRowOffsets(m_d->steps.size(), 0);
+    QVector<quint8> scratch(qMin(rc.width(), 64) * pixelSize);
+
+    qint32 y = rc.y();
+    qint32 rowsRemaining = rc.height();
+
+    while (rowsRemaining > 0) {
+        qint32 x = rc.x();
+        qint32 columnsRemaining = rc.width();
+
+        qint32 rows = qMin(dstIt->numContiguousRows(y), rowsRemaining);
+        Q_FOREACH (const Step &step, m_d->steps) {
+            if (step.selectionIt) {
+                rows = qMin(rows, step.selectionIt->numContiguousRows(y));
+            }
+        }
+
+        while (columnsRemaining > 0) {
+            qint32 columns = qMin(dstIt->numContiguousColumns(x), columnsRemaining);
+            Q_FOREACH (const Step &step, m_d->steps) {
+                if (step.selectionIt) {
+                    columns = qMin(columns, step.selectionIt->numContiguousColumns(x));
+                }
+            }
+
+            if (scratch.size() < columns * pixelSize) {
+                scratch.resize(columns * pixelSize);
+            }
+
+            const qint32 dstRowStride = dstIt->rowStride(x, y);
+            dstIt->moveTo(x, y);
+
+            for (int i = 0; i < m_d->steps.size(); i++) {
+                const Step &step = m_d->steps[i];
+                if (step.selectionIt) {
+                    selectionRowStrides[i] = step.selectionIt->rowStride(x, y);
+                    step.selectionIt->moveTo(x, y);
+                }
+            }
+
+            quint8 *dstRow = dstIt->rawData();
+
+            for (int row = 0; row < rows; row++) {
+                for (int i = 0; i < m_d->steps.size(); i++) {
+                    selectionRowOffsets[i] = row * selectionRowStrides[i];
+                }
+
+                m_d->processRow(dstRow, x, y + row, columns, selectionRowOffsets, scratch.data());
+                dstRow += dstRowStride;
+            }
+
+            x += columns;
+            columnsRemaining -= columns;
+        }
+
+        y += rows;
+        rowsRemaining -= rows;
+    }
+
+    // release the locks of the masks
+    const int numAppliedMasks = m_d->steps.size();
+    m_d->steps.clear();
+
+    return numAppliedMasks;
+}
@@ -0,0 +1,79 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISFUSEDFILTERMASKCHAIN_H
+#define KISFUSEDFILTERMASKCHAIN_H
+
+#include <QScopedPointer>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class KoColorSpace;
+
+/**
+ * @brief Applies a run of per-pixel color filter masks in a single pass
+ *
+ * Every filter mask applied by KisLayer::applyMasks() normally copies
+ * the projection into a cache device, runs the filter on a composition
+ * source device and writes the result back. For a stack of color
+ * adjustments (levels, curves, HSV, invert...) that means several full
+ * passes over the same pixels and a couple of temporary devices per
+ * mask.
+ *
+ * KisFusedFilterMaskChain collects the longest run of consecutive
+ * filter masks whose filters are KisColorTransformationFilter and
+ * applies all of them in one walk over the tiles of the projection.
+ * The masks' selections are blended in with COMPOSITE_COPY right after
+ * every transformation, exactly like KisMask::apply() does, so the
+ * result is the same as the one of the sequential application.
+ *
+ * The masks with an active temporary target (i.e. being painted on)
+ * and the devices whose composition source color space differs from
+ * the device color space are never fused.
+ *
+ * The chain is cheap to create: the masks are neither locked nor their
+ * transformations compiled until apply() is called.
+ */
+class KRITAIMAGE_EXPORT KisFusedFilterMaskChain
+{
+public:
+    /**
+     * Collect the masks that can be fused starting from
+     * \p masks[\p firstMask]
+     */
+    KisFusedFilterMaskChain(const QList<KisEffectMaskSP> &masks,
+                            int firstMask,
+                            KisPaintDeviceSP projection,
+                            const QRect &applyRect);
+    ~KisFusedFilterMaskChain();
+
+    /**
+     * @return the number of masks collected into the chain. Applying
+     *         a chain of less than two masks makes no sense, the masks
+     *         should be applied in a usual way then.
+     */
+    int size() const;
+
+    /**
+     * Lock the collected masks and apply them to \p projection in
+     * \p applyRect (the ones that were passed to the constructor).
+     * The locks are released before the function returns.
+     *
+     * A mask may get a temporary target after the chain was created,
+     * then only the masks before it are applied.
+     *
+     * @return the number of the applied masks, the rest of the masks
+     *         should be applied in a usual way
+     */
+    int apply();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISFUSEDFILTERMASKCHAIN_H
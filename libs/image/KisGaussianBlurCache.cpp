@@ -0,0 +1,146 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGaussianBlurCache.h"
+
+#include <QGlobalStatic>
+#include <QMutexLocker>
+
+#include <KoColorSpace.h>
+
+#include "kis_algebra_2d.h"
+#include "kis_default_bounds_base.h"
+#include "kis_gaussian_kernel.h"
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "kis_painter.h"
+
+
+Q_GLOBAL_STATIC(KisGaussianBlurCache, s_instance)
+
+
+KisGaussianBlurCache::KisGaussianBlurCache()
+{
+}
+
+KisGaussianBlurCache::~KisGaussianBlurCache()
+{
+}
+
+KisGaussianBlurCache *KisGaussianBlurCache::instance()
+{
+    return s_instance;
+}
+
+QVector<QRect> KisGaussianBlurCache::splitIntoCells(const QRect &rect)
+{
+    QVector<QRect> cells;
+    if (rect.isEmpty()) return cells;
+
+    const int firstColumn = KisAlgebra2D::divideFloor(rect.left(), cellSize);
+    const int lastColumn = KisAlgebra2D::divideFloor(rect.right(), cellSize);
+    const int firstRow = KisAlgebra2D::divideFloor(rect.top(), cellSize);
+    const int lastRow = KisAlgebra2D::divideFloor(rect.bottom(), cellSize);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            cells << (QRect(column * cellSize, row * cellSize, cellSize, cellSize) & rect);
+        }
+    }
+
+    return cells;
+}
+
+void KisGaussianBlurCache::readBlurredBytes(KisPaintDeviceSP device,
+                                           const QRect &cell,
+                                           qreal radius,
+                                           const QBitArray &channelFlags,
+                                           quint8 *dstBytes)
+{
+    const KoColorSpace *cs = device->colorSpace();
+    const int pixelSize = cs->pixelSize();
+    const int cellBytes = cell.width() * cell.height() * pixelSize;
+
+    const int border = KisGaussianKernel::kernelSizeFromRadius(radius) / 2;
+    const QRect sourceRect = kisGrowRect(cell, border);
+
+    QVector<quint8> sourceBytes(sourceRect.width() * sourceRect.height() * pixelSize);
+    device->readBytes(sourceBytes.data(), sourceRect);
+
+    const QRect bounds = device->defaultBounds()->bounds();
+    const bool wrapAroundMode = device->defaultBounds()->wrapAroundMode();
+
+    auto matches = [&] (const Entry &entry) {
+        return entry.cell == cell &&
+               entry.radius == radius &&
+               entry.channelFlags == channelFlags &&
+               *entry.colorSpace == *cs &&
+               entry.bounds == bounds &&
+               entry.wrapAroundMode == wrapAroundMode &&
+               entry.sourceBytes == sourceBytes;
+    };
+
+    {
+        QMutexLocker l(&m_mutex);
+
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (matches(*it)) {
+                memcpy(dstBytes, it->blurredBytes.constData(), cellBytes);
+                m_entries.move(it - m_entries.begin(), 0);
+                return;
+            }
+        }
+    }
+
+    KisPaintDeviceSP blur = new KisPaintDevice(cs);
+    blur->setDefaultBounds(device->defaultBounds());
+    blur->setDefaultPixel(device->defaultPixel());
+    KisPainter::copyAreaOptimized(sourceRect.topLeft(), device, blur, sourceRect);
+
+    KisGaussianKernel::applyGaussian(blur, cell,
+                                     radius, radius,
+                                     channelFlags,
+                                     nullptr);
+
+    Entry entry;
+    entry.cell = cell;
+    entry.radius = radius;
+    entry.channelFlags = channelFlags;
+    entry.colorSpace = cs;
+    entry.bounds = bounds;
+    entry.wrapAroundMode = wrapAroundMode;
+    entry.sourceBytes = sourceBytes;
+    entry.blurredBytes.resize(cellBytes);
+    blur->readBytes(entry.blurredBytes.data(), cell);
+
+    memcpy(dstBytes, entry.blurredBytes.constData(), cellBytes);
+
+    QMutexLocker l(&m_mutex);
+
+    // another thread might have calculated the same cell meanwhile
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (matches(*it)) {
+            m_cacheSize -= it->size();
+            m_entries.erase(it);
+            break;
+        }
+    }
+
+    m_cacheSize += entry.size();
+    m_entries.prepend(entry);
+
+    while (m_cacheSize > maxCacheSize && m_entries.size() > 1) {
+        m_cacheSize -= m_entries.last().size();
+        m_entries.removeLast();
+    }
+}
+
+void KisGaussianBlurCache::clear()
+{
+    QMutexLocker l(&m_mutex);
+    m_entries.clear();
+    m_cacheSize = 0;
+}
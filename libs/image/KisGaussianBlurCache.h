@@ -0,0 +1,100 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISGAUSSIANBLURCACHE_H
+#define KISGAUSSIANBLURCACHE_H
+
+#include <QBitArray>
+#include <QList>
+#include <QMutex>
+#include <QRect>
+#include <QVector>
+
+#include "kis_types.h"
+#include "kritaimage_export.h"
+
+class KoColorSpace;
+
+/**
+ * @brief Keeps the gaussian blurs calculated by the filters that combine
+ * the blurred image with the original one (unsharp mask, high pass)
+ *
+ * While the filter dialog previews such a filter, usually only the
+ * amount or the threshold changes, so the blur of the same pixels with
+ * the same radius is requested again and again. The cache splits the
+ * filtered area into cells of a fixed grid (see splitIntoCells()) and
+ * keeps the blurred pixels of every cell together with a copy of the
+ * source pixels the blur was calculated from. A cell is reused only when
+ * the source pixels under the kernel are still the same, so the cache
+ * doesn't need to know which layer or which device the pixels belong to.
+ *
+ * The cache is thread-safe, the blur of a missing cell is calculated
+ * outside of the lock.
+ */
+class KRITAIMAGE_EXPORT KisGaussianBlurCache
+{
+public:
+    KisGaussianBlurCache();
+    ~KisGaussianBlurCache();
+
+    static KisGaussianBlurCache* instance();
+
+    /**
+     * Splits \p rect into the cells the cache works with. The cells are
+     * aligned to a fixed grid, so the same area is always split the same
+     * way.
+     */
+    static QVector<QRect> splitIntoCells(const QRect &rect);
+
+    /**
+     * Fills \p dstBytes with the pixels of \p cell of \p device blurred
+     * with KisGaussianKernel::applyGaussian(). The blurred pixels are
+     * calculated from the current content of \p device, the border is
+     * repeated as BORDER_REPEAT does.
+     *
+     * \p cell should be one of the rects returned by splitIntoCells(),
+     * other rects are still blurred correctly, but are unlikely to be
+     * reused.
+     */
+    void readBlurredBytes(KisPaintDeviceSP device,
+                          const QRect &cell,
+                          qreal radius,
+                          const QBitArray &channelFlags,
+                          quint8 *dstBytes);
+
+    /// drops all the cached cells
+    void clear();
+
+private:
+    struct Entry {
+        QRect cell;
+        qreal radius;
+        QBitArray channelFlags;
+        const KoColorSpace *colorSpace;
+        QRect bounds;
+        bool wrapAroundMode;
+        QVector<quint8> sourceBytes;
+        QVector<quint8> blurredBytes;
+
+        qint64 size() const {
+            return sourceBytes.size() + blurredBytes.size();
+        }
+    };
+
+    static const int cellSize = 256;
+
+    /**
+     * Every cell keeps two copies of the pixels, so the size of the
+     * cache is limited to keep memory usage reasonable for big images.
+     */
+    static const qint64 maxCacheSize = 128 * 1024 * 1024;
+
+    QMutex m_mutex;
+    QList<Entry> m_entries;
+    qint64 m_cacheSize = 0;
+};
+
+#endif // KISGAUSSIANBLURCACHE_H
@@ -8,6 +8,7 @@
 
 #include <QGlobalStatic>
 #include <QMutexLocker>
+#include <QtAlgorithms>
 
 #include <string.h>
 
@@ -88,6 +89,19 @@ KisOptimizedByteArray::PooledMemoryAllocator::alloc(int size)
         }
 
         m_meanSize(size);
+
+        if (chunk.first) {
+            m_statistics.cachedBytes -= chunk.second;
+        }
+
+        if (chunk.second < size) {
+            if (chunk.first) {
+                m_statistics.systemDeallocations++;
+            }
+            m_statistics.systemAllocations++;
+        } else {
+            m_statistics.pooledAllocations++;
+        }
     }
 
     if (chunk.second < size) {
@@ -111,12 +125,124 @@ void KisOptimizedByteArray::PooledMemoryAllocator::free(KisOptimizedByteArray::M
         // smaller ones to the system
         if (chunk.second > 0.8 * m_meanSize.rollingMean()) {
             m_chunks.append(chunk);
+            m_statistics.cachedBytes += chunk.second;
         } else {
             delete[] chunk.first;
+            m_statistics.systemDeallocations++;
+        }
+    }
+}
+
+KisOptimizedByteArray::Statistics
+KisOptimizedByteArray::PooledMemoryAllocator::statistics() const
+{
+    QMutexLocker l(&m_mutex);
+    return m_statistics;
+}
+
+
+/*****************************************************************/
+/*         KisOptimizedByteArray::SizeClassMemoryAllocator       */
+/*****************************************************************/
+
+namespace {
+/// the smallest size class, all smaller requests are rounded up to it
+const int minSizeClassShift = 12;
+/// the largest size class, bigger requests bypass the pool
+const int maxSizeClassShift = 26;
+/// number of size classes each power of two is split into
+const int sizeClassSteps = 4;
+const int sizeClassStepsShift = 2;
+
+const int numSizeClasses = 1 + (maxSizeClassShift - minSizeClassShift) * sizeClassSteps;
+}
+
+KisOptimizedByteArray::SizeClassMemoryAllocator::SizeClassMemoryAllocator(qint64 maxCachedBytes)
+    : m_freeLists(numSizeClasses),
+      m_maxCachedBytes(maxCachedBytes)
+{
+}
+
+KisOptimizedByteArray::SizeClassMemoryAllocator::~SizeClassMemoryAllocator()
+{
+    for (auto it = m_freeLists.begin(); it != m_freeLists.end(); ++it) {
+        Q_FOREACH (const MemoryChunk &chunk, *it) {
+            delete[] chunk.first;
         }
     }
 }
 
+int KisOptimizedByteArray::SizeClassMemoryAllocator::roundUpToSizeClass(int size)
+{
+    if (size <= (1 << minSizeClassShift)) return 1 << minSizeClassShift;
+    if (size > (1 << maxSizeClassShift)) return size;
+
+    // 2^k < size <= 2^(k+1)
+    const int k = 31 - qCountLeadingZeroBits(quint32(size - 1));
+    const int step = 1 << (k - sizeClassStepsShift);
+
+    return (size + step - 1) & ~(step - 1);
+}
+
+int KisOptimizedByteArray::SizeClassMemoryAllocator::sizeClassIndex(int classSize)
+{
+    if (classSize == (1 << minSizeClassShift)) return 0;
+
+    const int k = 31 - qCountLeadingZeroBits(quint32(classSize - 1));
+    const int step = 1 << (k - sizeClassStepsShift);
+
+    return 1 + (k - minSizeClassShift) * sizeClassSteps + (classSize / step - sizeClassSteps - 1);
+}
+
+KisOptimizedByteArray::MemoryChunk
+KisOptimizedByteArray::SizeClassMemoryAllocator::alloc(int size)
+{
+    const int classSize = roundUpToSizeClass(size);
+
+    if (classSize <= (1 << maxSizeClassShift)) {
+        QMutexLocker l(&m_mutex);
+
+        QVector<MemoryChunk> &freeList = m_freeLists[sizeClassIndex(classSize)];
+        if (!freeList.isEmpty()) {
+            m_statistics.pooledAllocations++;
+            m_statistics.cachedBytes -= classSize;
+            return freeList.takeLast();
+        }
+
+        m_statistics.systemAllocations++;
+    }
+
+    return MemoryChunk(new quint8[classSize], classSize);
+}
+
+void KisOptimizedByteArray::SizeClassMemoryAllocator::free(KisOptimizedByteArray::MemoryChunk chunk)
+{
+    if (!chunk.first) return;
+
+    if (chunk.second <= (1 << maxSizeClassShift) &&
+        roundUpToSizeClass(chunk.second) == chunk.second) {
+
+        QMutexLocker l(&m_mutex);
+
+        if (m_statistics.cachedBytes + chunk.second <= m_maxCachedBytes) {
+            m_freeLists[sizeClassIndex(chunk.second)].append(chunk);
+            m_statistics.cachedBytes += chunk.second;
+            return;
+        }
+
+        m_statistics.systemDeallocations++;
+    }
+
+    delete[] chunk.first;
+}
+
+KisOptimizedByteArray::Statistics
+KisOptimizedByteArray::SizeClassMemoryAllocator::statistics() const
+{
+    QMutexLocker l(&m_mutex);
+    return m_statistics;
+}
+
 
 /*****************************************************************/
 /*         KisOptimizedByteArray::Private                        */
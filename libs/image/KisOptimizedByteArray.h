@@ -31,6 +31,16 @@ public:
 
     typedef QSharedPointer<MemoryAllocator> MemoryAllocatorSP;
 
+    /**
+     * Allocation counters collected by the pooling allocators
+     */
+    struct Statistics {
+        int systemAllocations = 0; ///< chunks requested from the system
+        int pooledAllocations = 0; ///< chunks reused from the pool
+        int systemDeallocations = 0; ///< chunks returned to the system
+        qint64 cachedBytes = 0; ///< bytes currently kept in the pool
+    };
+
     struct KRITAIMAGE_EXPORT PooledMemoryAllocator : public MemoryAllocator {
         PooledMemoryAllocator();
         ~PooledMemoryAllocator();
@@ -38,10 +48,55 @@ public:
         MemoryChunk alloc(int size) override;
         void free(MemoryChunk chunk) override;
 
+        Statistics statistics() const;
+
     private:
-        QMutex m_mutex;
+        mutable QMutex m_mutex;
         QVector<MemoryChunk> m_chunks;
         KisRollingMeanAccumulatorWrapper m_meanSize;
+        Statistics m_statistics;
+    };
+
+    /**
+     * A pool that keeps a separate free list for every size class. The
+     * classes split every power of two into four steps, so a chunk is at
+     * most 25% larger than requested. Unlike PooledMemoryAllocator it
+     * doesn't depend on the dab size being stable: the dabs of a stroke
+     * with pressure-driven size will find a chunk of a matching class
+     * instead of dropping and reallocating the chunks at the tail of the
+     * pool.
+     *
+     * The allocator is supposed to be owned by a single stroke (e.g. by
+     * the dab rendering queue of the paintop), so that all the cached
+     * memory is returned to the system when the stroke ends.
+     */
+    struct KRITAIMAGE_EXPORT SizeClassMemoryAllocator : public MemoryAllocator {
+        /**
+         * \p maxCachedBytes limits the amount of memory kept in the free
+         * lists; the chunks exceeding the budget are returned to the system
+         */
+        SizeClassMemoryAllocator(qint64 maxCachedBytes = 64 * 1024 * 1024);
+        ~SizeClassMemoryAllocator();
+
+        MemoryChunk alloc(int size) override;
+        void free(MemoryChunk chunk) override;
+
+        Statistics statistics() const;
+
+        /**
+         * \return the size of the chunk that will be allocated for
+         * a request of \p size bytes
+         */
+        static int roundUpToSizeClass(int size);
+
+    private:
+        static int sizeClassIndex(int classSize);
+
+    private:
+        mutable QMutex m_mutex;
+        QVector<QVector<MemoryChunk>> m_freeLists;
+        const qint64 m_maxCachedBytes;
+        Statistics m_statistics;
     };
 
 public:
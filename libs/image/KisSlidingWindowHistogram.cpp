@@ -0,0 +1,59 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisSlidingWindowHistogram.h"
+
+#include <algorithm>
+
+KisSlidingWindowHistogram::KisSlidingWindowHistogram(int numBins)
+    : m_counts(numBins, 0)
+{
+}
+
+void KisSlidingWindowHistogram::reset()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_total = 0;
+}
+
+int KisSlidingWindowHistogram::mostFrequentBin() const
+{
+    if (!m_total) return -1;
+
+    int bin = -1;
+    int maxCount = 0;
+
+    for (int i = 0; i < m_counts.size(); i++) {
+        if (m_counts[i] > maxCount) {
+            bin = i;
+            maxCount = m_counts[i];
+        }
+    }
+
+    return bin;
+}
+
+int KisSlidingWindowHistogram::rankBin(int rank) const
+{
+    if (!m_total) return -1;
+
+    rank = qBound(0, rank, m_total - 1);
+
+    int accumulated = 0;
+    for (int i = 0; i < m_counts.size(); i++) {
+        accumulated += m_counts[i];
+        if (accumulated > rank) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int KisSlidingWindowHistogram::medianBin() const
+{
+    return rankBin((m_total - 1) / 2);
+}
@@ -0,0 +1,162 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSLIDINGWINDOWHISTOGRAM_H
+#define KISSLIDINGWINDOWHISTOGRAM_H
+
+#include <QRect>
+#include <QVector>
+
+#include "kis_assert.h"
+#include "kis_global.h"
+#include "kritaimage_export.h"
+
+/**
+ * @brief A histogram of a square neighbourhood sliding along the rows
+ *
+ * Neighbourhood filters (oil paint, median and other rank filters)
+ * need the histogram of a (2 * radius + 1)^2 window around every pixel.
+ * Building it from scratch costs O(radius^2) per pixel. When the
+ * window moves one pixel to the right, only one column leaves it and
+ * another one enters, so updating the histogram costs O(radius) only
+ * (T. Huang's algorithm).
+ *
+ * The histogram only counts the pixels in every bin. The bins of the
+ * pixels are precomputed by the caller and the per-bin payload (e.g.
+ * the sum of the colors for the oil paint filter) is kept by a policy
+ * passed to slideAlongRows().
+ *
+ * The lookups scan the bins, so the histogram is meant for a few
+ * hundreds of bins, e.g. 8-bit values.
+ */
+class KRITAIMAGE_EXPORT KisSlidingWindowHistogram
+{
+public:
+    explicit KisSlidingWindowHistogram(int numBins);
+
+    void reset();
+
+    inline void add(int bin) {
+        m_counts[bin]++;
+        m_total++;
+    }
+
+    inline void remove(int bin) {
+        m_counts[bin]--;
+        m_total--;
+    }
+
+    inline int numBins() const {
+        return m_counts.size();
+    }
+
+    inline int total() const {
+        return m_total;
+    }
+
+    inline int count(int bin) const {
+        return m_counts[bin];
+    }
+
+    /**
+     * @return the bin with the largest count (the lowest one if there
+     *         are several of them) or -1 if the histogram is empty
+     */
+    int mostFrequentBin() const;
+
+    /**
+     * @return the bin of the element with index \p rank in the sorted
+     *         window (0 is the minimum, total() - 1 is the maximum)
+     *         or -1 if the histogram is empty
+     */
+    int rankBin(int rank) const;
+
+    /**
+     * @return the bin of the median element (the lower median when
+     *         the number of elements is even) or -1 if the histogram
+     *         is empty
+     */
+    int medianBin() const;
+
+    /**
+     * Walk the pixels of \p rc row by row and keep the histogram of the
+     * window of \p radius around the current pixel up to date.
+     *
+     * \p bins are the bins of the pixels of \p dataRect stored row by
+     * row, the pixels with negative bins are skipped. \p dataRect must
+     * contain \p rc grown by \p radius.
+     *
+     * \p policy should provide the following methods:
+     *
+     *     void reset(); // the histogram has just been reset
+     *     void add(int dataIndex, int bin);
+     *     void remove(int dataIndex, int bin);
+     *     void writePixel(int x, int y, const KisSlidingWindowHistogram &histogram);
+     *
+     * where `dataIndex` is the index of the pixel in \p bins
+     */
+    template <class Policy>
+    void slideAlongRows(const QRect &rc, int radius,
+                        const QRect &dataRect, const int *bins,
+                        Policy &policy);
+
+private:
+    QVector<int> m_counts;
+    int m_total {0};
+};
+
+template <class Policy>
+void KisSlidingWindowHistogram::slideAlongRows(const QRect &rc, int radius,
+                                               const QRect &dataRect, const int *bins,
+                                               Policy &policy)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dataRect.contains(kisGrowRect(rc, radius)));
+
+    const int stride = dataRect.width();
+    const int windowSize = 2 * radius + 1;
+
+    for (int y = rc.top(); y <= rc.bottom(); y++) {
+        reset();
+        policy.reset();
+
+        const int topRowIndex = (y - radius - dataRect.top()) * stride - dataRect.left();
+
+        auto addColumn = [&] (int x) {
+            int index = topRowIndex + x;
+            for (int i = 0; i < windowSize; i++, index += stride) {
+                const int bin = bins[index];
+                if (bin >= 0) {
+                    add(bin);
+                    policy.add(index, bin);
+                }
+            }
+        };
+
+        auto removeColumn = [&] (int x) {
+            int index = topRowIndex + x;
+            for (int i = 0; i < windowSize; i++, index += stride) {
+                const int bin = bins[index];
+                if (bin >= 0) {
+                    remove(bin);
+                    policy.remove(index, bin);
+                }
+            }
+        };
+
+        for (int x = rc.left() - radius; x <= rc.left() + radius; x++) {
+            addColumn(x);
+        }
+        policy.writePixel(rc.left(), y, *this);
+
+        for (int x = rc.left() + 1; x <= rc.right(); x++) {
+            removeColumn(x - radius - 1);
+            addColumn(x + radius);
+            policy.writePixel(x, y, *this);
+        }
+    }
+}
+
+#endif // KISSLIDINGWINDOWHISTOGRAM_H
@@ -0,0 +1,312 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisSummedAreaTable.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+
+#include "kis_assert.h"
+#include "kis_default_bounds.h"
+#include "kis_paint_device.h"
+#include "krita_utils.h"
+
+namespace {
+
+bool isFloatColorSpace(const KoColorSpace *cs)
+{
+    const KoID depth = cs->colorDepthId();
+    return depth == Float16BitsColorDepthID ||
+           depth == Float32BitsColorDepthID ||
+           depth == Float64BitsColorDepthID;
+}
+
+/**
+ * The strips are built concurrently, every strip should be
+ * big enough to be worth a separate job
+ */
+const int minStripHeight = 64;
+
+}
+
+struct KisSummedAreaTable::Private
+{
+    KisPaintDeviceSP device;
+    const KoColorSpace *colorSpace = nullptr;
+    int channelCount = 0;
+    int alphaPos = -1;
+    bool clampResults = true;
+
+    QRect rect;
+    QRect dataRect;
+
+    /**
+     * Every plane has an extra zero row at the top and an extra zero
+     * column at the left, so the lookups never need to check the edges
+     */
+    int stride = 0;
+    int planeSize = 0;
+    QVector<double> table;
+
+    QMutex mutex;
+    QAtomicInt isBuilt;
+
+    inline int clampX(int x) const {
+        return dataRect.isValid() ? qBound(dataRect.left(), x, dataRect.right()) : x;
+    }
+
+    inline int clampY(int y) const {
+        return dataRect.isValid() ? qBound(dataRect.top(), y, dataRect.bottom()) : y;
+    }
+};
+
+KisSummedAreaTable::KisSummedAreaTable(KisPaintDeviceSP device, const QRect &rect, const QRect &dataRect)
+    : m_d(new Private)
+{
+    m_d->device = device;
+    m_d->colorSpace = device->colorSpace();
+    m_d->channelCount = m_d->colorSpace->channelCount();
+    m_d->alphaPos = m_d->colorSpace->alphaPos();
+    m_d->clampResults = !isFloatColorSpace(m_d->colorSpace);
+    m_d->rect = rect;
+    m_d->dataRect = dataRect;
+    m_d->stride = rect.width() + 1;
+    m_d->planeSize = m_d->stride * (rect.height() + 1);
+}
+
+KisSummedAreaTable::~KisSummedAreaTable()
+{
+}
+
+QRect KisSummedAreaTable::repeatedBorderDataRect(KisPaintDeviceSP device, const QRect &rect)
+{
+    if (device->defaultBounds()->wrapAroundMode()) return QRect();
+
+    QRect dataRect = rect | device->defaultBounds()->bounds();
+    KIS_SAFE_ASSERT_RECOVER(device->defaultBounds()->bounds() != KisDefaultBounds().bounds()) {
+        dataRect = rect | device->exactBounds();
+    }
+
+    return dataRect;
+}
+
+QRect KisSummedAreaTable::rect() const
+{
+    return m_d->rect;
+}
+
+int KisSummedAreaTable::channelCount() const
+{
+    return m_d->channelCount;
+}
+
+double KisSummedAreaTable::sum(int channel, const QRect &rc) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->rect.contains(rc), 0.0);
+    ensureBuilt();
+
+    const double *plane = m_d->table.constData() + channel * m_d->planeSize;
+
+    const int left = rc.left() - m_d->rect.left();
+    const int right = left + rc.width();
+    const int top = (rc.top() - m_d->rect.top()) * m_d->stride;
+    const int bottom = top + rc.height() * m_d->stride;
+
+    return plane[bottom + right] - plane[top + right] - plane[bottom + left] + plane[top + left];
+}
+
+void KisSummedAreaTable::meanChannels(const QRect &rc, QVector<float> &channels) const
+{
+    weightedMeanChannels({rc}, {1.0}, channels);
+}
+
+void KisSummedAreaTable::weightedMeanChannels(const QVector<QRect> &rects, const QVector<qreal> &weights,
+                                              QVector<float> &channels) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(rects.size() == weights.size());
+
+    channels.resize(m_d->channelCount);
+
+    double area = 0.0;
+    double alphaSum = 0.0;
+
+    for (int i = 0; i < rects.size(); ++i) {
+        if (rects[i].isEmpty()) continue;
+
+        const double rectArea = double(rects[i].width()) * rects[i].height();
+        area += weights[i] * rectArea;
+        alphaSum += weights[i] * (m_d->alphaPos >= 0 ? sum(m_d->alphaPos, rects[i]) : rectArea);
+    }
+
+    for (int c = 0; c < m_d->channelCount; ++c) {
+        double value = 0.0;
+
+        if (c == m_d->alphaPos) {
+            value = area > 0.0 ? alphaSum / area : 0.0;
+        } else if (alphaSum > 0.0) {
+            for (int i = 0; i < rects.size(); ++i) {
+                if (rects[i].isEmpty()) continue;
+                value += weights[i] * sum(c, rects[i]);
+            }
+            value /= alphaSum;
+        }
+
+        if (m_d->clampResults) {
+            value = qBound(0.0, value, 1.0);
+        }
+
+        channels[c] = value;
+    }
+}
+
+void KisSummedAreaTable::meanPixel(const QRect &rc, quint8 *dst) const
+{
+    QVector<float> channels(m_d->channelCount);
+    meanChannels(rc, channels);
+    m_d->colorSpace->fromNormalisedChannelsValue(dst, channels);
+}
+
+void KisSummedAreaTable::ensureBuilt() const
+{
+    if (m_d->isBuilt.loadAcquire()) return;
+
+    QMutexLocker l(&m_d->mutex);
+    if (m_d->isBuilt.loadAcquire()) return;
+
+    build();
+
+    m_d->device.clear();
+    m_d->isBuilt.storeRelease(1);
+}
+
+void KisSummedAreaTable::build() const
+{
+    const QRect &rc = m_d->rect;
+    const int width = rc.width();
+    const int stride = m_d->stride;
+    const int planeSize = m_d->planeSize;
+    const int channelCount = m_d->channelCount;
+    const int alphaPos = m_d->alphaPos;
+
+    m_d->table.fill(0.0, channelCount * planeSize);
+    if (rc.isEmpty()) return;
+
+    QVector<QRect> strips;
+    {
+        const int numStrips = qMax(1, rc.height() / minStripHeight);
+        const int stripHeight = rc.height() / numStrips;
+        const int extraRows = rc.height() % numStrips;
+
+        int y = rc.top();
+        for (int i = 0; i < numStrips; i++) {
+            const int height = stripHeight + (i < extraRows ? 1 : 0);
+            strips.append(QRect(rc.left(), y, width, height));
+            y += height;
+        }
+    }
+
+    double *table = m_d->table.data();
+
+    /**
+     * First, every strip is summed up independently: the prefix sums
+     * of the rows are accumulated downwards inside the strip only.
+     */
+    KritaUtils::runOnPatches(strips,
+        [&] (int, const QRect &strip) {
+            const QRect readRect(QPoint(m_d->clampX(strip.left()), m_d->clampY(strip.top())),
+                                 QPoint(m_d->clampX(strip.right()), m_d->clampY(strip.bottom())));
+            const int readArea = readRect.width() * readRect.height();
+            const int pixelSize = m_d->colorSpace->pixelSize();
+
+            QVector<quint8> bytes(readArea * pixelSize);
+            m_d->device->readBytes(bytes.data(), readRect);
+
+            QVector<float> planes(channelCount * readArea);
+            QVector<float> channels(channelCount);
+            const quint8 *pixel = bytes.constData();
+
+            for (int i = 0; i < readArea; ++i, pixel += pixelSize) {
+                m_d->colorSpace->normalisedChannelsValue(pixel, channels);
+                const float alpha = alphaPos >= 0 ? channels[alphaPos] : 1.0f;
+
+                for (int c = 0; c < channelCount; ++c) {
+                    planes[c * readArea + i] = c == alphaPos ? alpha : channels[c] * alpha;
+                }
+            }
+
+            QVector<int> columns(width);
+            for (int x = 0; x < width; ++x) {
+                columns[x] = m_d->clampX(rc.left() + x) - readRect.left();
+            }
+
+            for (int y = strip.top(); y <= strip.bottom(); ++y) {
+                const int readY = m_d->clampY(y) - readRect.top();
+                const int row = y - rc.top() + 1;
+
+                for (int c = 0; c < channelCount; ++c) {
+                    const float *src = planes.constData() + c * readArea + readY * readRect.width();
+                    double *dst = table + c * planeSize + row * stride + 1;
+
+                    double rowSum = 0.0;
+                    for (int x = 0; x < width; ++x) {
+                        rowSum += src[columns[x]];
+                        dst[x] = rowSum;
+                    }
+
+                    if (y > strip.top()) {
+                        const double *above = dst - stride;
+                        for (int x = 0; x < width; ++x) {
+                            dst[x] += above[x];
+                        }
+                    }
+                }
+            }
+        });
+
+    if (strips.size() == 1) return;
+
+    /**
+     * Then the sums of all the strips above are added to every strip.
+     * The carried sums are collected before any strip is changed.
+     */
+    QVector<double> carries(strips.size() * channelCount * width, 0.0);
+
+    for (int i = 1; i < strips.size(); ++i) {
+        const int lastRow = strips[i - 1].bottom() - rc.top() + 1;
+
+        for (int c = 0; c < channelCount; ++c) {
+            const double *prevCarry = carries.constData() + ((i - 1) * channelCount + c) * width;
+            const double *last = table + c * planeSize + lastRow * stride + 1;
+            double *carry = carries.data() + (i * channelCount + c) * width;
+
+            for (int x = 0; x < width; ++x) {
+                carry[x] = prevCarry[x] + last[x];
+            }
+        }
+    }
+
+    KritaUtils::runOnPatches(strips,
+        [&] (int index, const QRect &strip) {
+            if (!index) return;
+
+            for (int y = strip.top(); y <= strip.bottom(); ++y) {
+                const int row = y - rc.top() + 1;
+
+                for (int c = 0; c < channelCount; ++c) {
+                    const double *carry = carries.constData() + (index * channelCount + c) * width;
+                    double *dst = table + c * planeSize + row * stride + 1;
+
+                    for (int x = 0; x < width; ++x) {
+                        dst[x] += carry[x];
+                    }
+                }
+            }
+        });
+}
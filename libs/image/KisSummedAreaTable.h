@@ -0,0 +1,91 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSUMMEDAREATABLE_H
+#define KISSUMMEDAREATABLE_H
+
+#include <QRect>
+#include <QScopedPointer>
+#include <QVector>
+
+#include "kis_types.h"
+#include "kritaimage_export.h"
+
+/**
+ * @brief A summed-area table (integral image) of a rect of a paint device
+ *
+ * Every entry of the table keeps the sum of all the pixels above and to
+ * the left of it, so the sum (and the average) of the pixels of any
+ * rectangle inside the table costs four lookups, whatever the size of
+ * the rectangle is. Box-style filters (pixelize, box blur, wide
+ * feathering) use it to get constant-time neighbourhood averages.
+ *
+ * The table keeps the normalized channels of the pixels with the color
+ * channels premultiplied by alpha, so the averages are weighted by the
+ * opacity of the pixels just like KoMixColorsOp does. The sums are
+ * stored as doubles, one plane per channel.
+ *
+ * The table is built lazily, on the first query, from the pixels the
+ * device has at that moment. The building is split into row strips
+ * processed concurrently, the queries are thread-safe.
+ */
+class KRITAIMAGE_EXPORT KisSummedAreaTable
+{
+public:
+    /**
+     * Prepares the table for \p rect of \p device. When \p dataRect is
+     * valid, the pixels outside of it are not read, the nearest pixel
+     * of \p dataRect is repeated instead (see repeatedBorderDataRect()).
+     */
+    KisSummedAreaTable(KisPaintDeviceSP device, const QRect &rect, const QRect &dataRect = QRect());
+    ~KisSummedAreaTable();
+
+    /**
+     * Returns the rect of the pixels of \p device that BORDER_REPEAT
+     * mode of KisConvolutionPainter reads when filtering \p rect, or
+     * an invalid rect when the device wraps around.
+     */
+    static QRect repeatedBorderDataRect(KisPaintDeviceSP device, const QRect &rect);
+
+    QRect rect() const;
+    int channelCount() const;
+
+    /**
+     * Returns the sum of the (premultiplied) normalized values of
+     * \p channel of the pixels of \p rc. \p rc should lie inside rect().
+     */
+    double sum(int channel, const QRect &rc) const;
+
+    /**
+     * Fills \p channels with the average normalized (not premultiplied)
+     * channels of the pixels of \p rc
+     */
+    void meanChannels(const QRect &rc, QVector<float> &channels) const;
+
+    /**
+     * Fills \p channels with the average normalized (not premultiplied)
+     * channels of the pixels of \p rects, every pixel weighted by the sum
+     * of \p weights of the rects it belongs to. Empty rects are skipped.
+     */
+    void weightedMeanChannels(const QVector<QRect> &rects, const QVector<qreal> &weights,
+                              QVector<float> &channels) const;
+
+    /**
+     * Writes the average pixel of \p rc into \p dst in the color space
+     * of the device
+     */
+    void meanPixel(const QRect &rc, quint8 *dst) const;
+
+private:
+    void ensureBuilt() const;
+    void build() const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISSUMMEDAREATABLE_H
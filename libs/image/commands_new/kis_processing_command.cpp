@@ -20,7 +20,10 @@ KisProcessingCommand::KisProcessingCommand(KisProcessingVisitorSP visitor, KisNo
 void KisProcessingCommand::redo()
 {
     if(!m_visitorExecuted) {
+        // let the visitor split its work into concurrent jobs
+        m_undoAdapter.setRunnableJobsInterface(runnableJobsInterface());
         m_node->accept(*m_visitor, &m_undoAdapter);
+        m_undoAdapter.setRunnableJobsInterface(nullptr);
         m_visitorExecuted = true;
         m_visitor = 0;
     }
@@ -10,10 +10,11 @@
 #include <kundo2command.h>
 #include "kis_types.h"
 #include "kis_surrogate_undo_adapter.h"
+#include "kis_stroke_strategy_undo_command_based.h"
 
 class KisProcessingVisitor;
 
-class KRITAIMAGE_EXPORT KisProcessingCommand : public KUndo2Command
+class KRITAIMAGE_EXPORT KisProcessingCommand : public KUndo2Command, public KisStrokeStrategyUndoCommandBased::MutatedCommandInterface
 {
 public:
     KisProcessingCommand(KisProcessingVisitorSP visitor, KisNodeSP node, KUndo2Command *parent = 0);
@@ -6,10 +6,13 @@
 
 #include "filter/kis_color_transformation_configuration.h"
 
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QMap>
 #include <QThread>
+#include <KoColorTransformation.h>
+#include <KoColorTransformationLutCompiler.h>
 #include "filter/kis_color_transformation_filter.h"
 
 struct Q_DECL_HIDDEN KisColorTransformationConfiguration::Private {
@@ -26,10 +29,28 @@ struct Q_DECL_HIDDEN KisColorTransformationConfiguration::Private {
         QMutexLocker locker(&mutex);
         qDeleteAll(colorTransformation);
         colorTransformation.clear();
+
+        compiledTransformations.clear();
     }
 
     // XXX: Threadlocal storage!!!
     QMap<QThread*, KoColorTransformation*> colorTransformation;
+
+    struct CompiledEntry {
+        qint64 compilationCost {-1};
+        bool isApproximate {false};
+        QSharedPointer<KoColorTransformation> source;
+        QSharedPointer<KoColorTransformation> compiled;
+    };
+
+    /**
+     * The entries are never replaced, only dropped all together on
+     * invalidation. The callers hold shared pointers to the compiled
+     * transformations, so the dropped ones live until the last caller
+     * is done with them.
+     */
+    QHash<const KoColorSpace*, CompiledEntry> compiledTransformations;
+
     QMutex mutex;
 };
 
@@ -79,6 +100,58 @@ KoColorTransformation* KisColorTransformationConfiguration::colorTransformation(
     return transformation;
 }
 
+QSharedPointer<KoColorTransformation>
+KisColorTransformationConfiguration::compiledColorTransformation(const KoColorSpace *cs,
+                                                                 const KisColorTransformationFilter *filter,
+                                                                 qint64 numPixels,
+                                                                 bool allowApproximation) const
+{
+    QMutexLocker locker(&d->mutex);
+
+    auto it = d->compiledTransformations.find(cs);
+
+    if (it == d->compiledTransformations.end()) {
+        Private::CompiledEntry entry;
+
+        KisFilterConfigurationSP config(clone().data());
+        entry.source.reset(filter->createTransformation(cs, config));
+
+        if (entry.source) {
+            entry.compilationCost =
+                KoColorTransformationLutCompiler::compilationCost(cs, {entry.source.data()}, false);
+
+            if (entry.compilationCost < 0 && allowApproximation) {
+                entry.compilationCost =
+                    KoColorTransformationLutCompiler::compilationCost(cs, {entry.source.data()}, true);
+                entry.isApproximate = entry.compilationCost >= 0;
+            }
+        }
+
+        if (entry.compilationCost < 0) {
+            entry.source.reset();
+        }
+
+        it = d->compiledTransformations.insert(cs, entry);
+    }
+
+    /**
+     * The exact tables are built only when some caller processes an area
+     * that is big enough to pay for them. The approximate ones are built
+     * right away, otherwise small updates would be processed exactly and
+     * big ones approximately, and the patches of the same mask would
+     * look different.
+     */
+    if (!it->compiled && it->source &&
+        (it->isApproximate || numPixels >= it->compilationCost)) {
+
+        it->compiled.reset(
+            KoColorTransformationLutCompiler::compile(cs, {it->source.data()}, it->isApproximate));
+        it->source.reset();
+    }
+
+    return it->compiled;
+}
+
 void KisColorTransformationConfiguration::invalidateColorTransformationCache()
 {
     d->destroyCache();
@@ -6,10 +6,13 @@
 #ifndef _KIS_COLOR_TRANSFORMATION_CONFIGURATION_H_
 #define _KIS_COLOR_TRANSFORMATION_CONFIGURATION_H_
 
+#include <QSharedPointer>
+
 #include "kis_filter_configuration.h"
 #include "kritaimage_export.h"
 
 class KoColorSpace;
+class KoColorTransformation;
 class KisColorTransformationFilter;
 
 class KisColorTransformationConfiguration;
@@ -29,6 +32,29 @@ public:
 
     KoColorTransformation *colorTransformation(const KoColorSpace *cs, const KisColorTransformationFilter *filter) const;
 
+    /**
+     * @brief Return the transformation compiled into lookup tables by
+     *        KoColorTransformationLutCompiler
+     *
+     * The exact (channelwise) tables are built only when filtering
+     * @p numPixels pixels directly would be more expensive than building
+     * them. When @p allowApproximation is true, the transformations
+     * that depend on the whole color are baked into an approximate 3D
+     * LUT, which is built on the first call whatever the size of the
+     * area is. Otherwise, or when the transformation cannot be compiled
+     * at all, null is returned and @ref colorTransformation should be
+     * used instead.
+     *
+     * The compiled transformation is read-only, so it is shared between
+     * all the threads. There is one per color space, and it stays valid
+     * while the caller holds the returned pointer, even if the cache is
+     * invalidated meanwhile.
+     */
+    QSharedPointer<KoColorTransformation> compiledColorTransformation(const KoColorSpace *cs,
+                                                                      const KisColorTransformationFilter *filter,
+                                                                      qint64 numPixels,
+                                                                      bool allowApproximation = false) const;
+
     /**
      * @brief Manually invalidate the cache. By default @ref setProperty
      *        invalidates the cache but this method can be used in subclasses
@@ -12,6 +12,7 @@
 #include <kis_processing_information.h>
 #include <kis_paint_device.h>
 #include <kis_selection.h>
+#include <kis_image_config.h>
 
 #ifndef NDEBUG
 #include <QTime>
@@ -37,14 +38,16 @@ void KisColorTransformationFilter::processImpl(KisPaintDeviceSP device,
     Q_ASSERT(!device.isNull());
 
     const KoColorSpace * cs = device->colorSpace();
-    KoColorTransformation * colorTransformation = 0;
+    QSharedPointer<KoColorTransformation> colorTransformation;
     // Ew, casting
     KisColorTransformationConfigurationSP colorTransformationConfiguration(dynamic_cast<KisColorTransformationConfiguration*>(const_cast<KisFilterConfiguration*>(config.data())));
     if (colorTransformationConfiguration) {
-        colorTransformation = colorTransformationConfiguration->colorTransformation(cs, this);
+        colorTransformation =
+            cachedTransformation(cs, colorTransformationConfiguration,
+                                 qint64(applyRect.width()) * applyRect.height());
     }
     else {
-        colorTransformation = createTransformation(cs, config);
+        colorTransformation.reset(createTransformation(cs, config));
     }
     if (!colorTransformation) return;
 
@@ -55,11 +58,29 @@ void KisColorTransformationFilter::processImpl(KisPaintDeviceSP device,
         conseq = it.nConseqPixels();
         colorTransformation->transform(it.oldRawData(), it.rawData(), conseq);
     }
+}
+
+QSharedPointer<KoColorTransformation>
+KisColorTransformationFilter::cachedTransformation(const KoColorSpace *cs,
+                                                   const KisColorTransformationConfigurationSP config,
+                                                   qint64 numPixels) const
+{
+    static const bool useLuts = KisImageConfig(true).useColorTransformationLuts();
+    static const bool useApproximateLuts = KisImageConfig(true).useApproximateColorTransformationLuts();
+
+    QSharedPointer<KoColorTransformation> colorTransformation;
+
+    if (useLuts) {
+        colorTransformation = config->compiledColorTransformation(cs, this, numPixels, useApproximateLuts);
+    }
 
-    if (!colorTransformationConfiguration) {
-        delete colorTransformation;
+    if (!colorTransformation) {
+        // the per-thread transformation is owned by the configuration
+        colorTransformation = QSharedPointer<KoColorTransformation>(
+            config->colorTransformation(cs, this), [] (KoColorTransformation*) {});
     }
 
+    return colorTransformation;
 }
 
 KisFilterConfigurationSP  KisColorTransformationFilter::factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const
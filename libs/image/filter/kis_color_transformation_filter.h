@@ -9,6 +9,7 @@
 
 #include "kis_filter.h"
 #include "kritaimage_export.h"
+#include "kis_color_transformation_configuration.h"
 
 /**
  * This is a base class for filters that implement a filter for
@@ -29,6 +30,16 @@ public:
      */
     virtual KoColorTransformation* createTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const = 0;
 
+    /**
+     * Return the transformation cached in \p config that suits best for
+     * processing \p numPixels pixels, i.e. the one compiled into lookup
+     * tables when the area is big enough. The approximate 3D tables are
+     * used only when enabled in KisImageConfig.
+     */
+    QSharedPointer<KoColorTransformation> cachedTransformation(const KoColorSpace *cs,
+                                                               const KisColorTransformationConfigurationSP config,
+                                                               qint64 numPixels) const;
+
     KisFilterConfigurationSP factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
 };
 
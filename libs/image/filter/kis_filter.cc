@@ -6,6 +6,9 @@
 
 #include "filter/kis_filter.h"
 
+#include <memory>
+#include <vector>
+
 #include <QString>
 
 #include <KoCompositeOpRegistry.h>
@@ -18,6 +21,8 @@
 #include "kis_types.h"
 #include <kis_painter.h>
 #include <KoUpdater.h>
+#include "krita_utils.h"
+#include "kis_updater_context.h"
 
 KisFilter::KisFilter(const KoID& _id, const KoID & category, const QString & entry)
     : KisBaseProcessor(_id, category, entry),
@@ -75,7 +80,7 @@ void KisFilter::process(const KisPaintDeviceSP src,
             progressUpdater = updaterHolder->updater();
         }
 
-        processImpl(temporary, applyRect, config, progressUpdater);
+        processImplInParallel(temporary, applyRect, config, progressUpdater);
     }
     catch (const std::bad_alloc&) {
         warnKrita << "Filter" << name() << "failed to allocate enough memory to run.";
@@ -88,6 +93,90 @@ void KisFilter::process(const KisPaintDeviceSP src,
     }
 }
 
+void KisFilter::processImplInParallel(KisPaintDeviceSP device,
+                                      const QRect& applyRect,
+                                      const KisFilterConfigurationSP config,
+                                      KoUpdater* progressUpdater) const
+{
+    /**
+     * The jobs of the strokes and the updates already occupy all the
+     * threads of the updater context, so the filter is not split any
+     * further when process() is called from them
+     */
+    if (!supportsThreading() || KisUpdaterContext::isInsideJob()) {
+        processImpl(device, applyRect, config, progressUpdater);
+        return;
+    }
+
+    const QVector<QRect> patches =
+        KritaUtils::splitRectIntoPatches(applyRect, KritaUtils::optimalPatchSize());
+
+    if (patches.size() <= 1) {
+        processImpl(device, applyRect, config, progressUpdater);
+        return;
+    }
+
+    const int lod = device->defaultBounds()->currentLevelOfDetail();
+
+    bool needsBorder = false;
+    Q_FOREACH (const QRect &patch, patches) {
+        if (neededRect(patch, config, lod) != patch) {
+            needsBorder = true;
+            break;
+        }
+    }
+
+    /**
+     * processImpl() filters the device in-place, so when the patches
+     * read their neighbourhood, they should read the original pixels.
+     * The copy-on-write clones of all the patches are created before
+     * any of them is processed, so they share the original tiles of
+     * the device and no other snapshot is needed.
+     */
+    QVector<KisPaintDeviceSP> patchDevices;
+    if (needsBorder) {
+        Q_FOREACH (const QRect &patch, patches) {
+            KisPaintDeviceSP patchDevice = new KisPaintDevice(device->colorSpace());
+            patchDevice->makeCloneFromRough(device, neededRect(patch, config, lod));
+            patchDevices.append(patchDevice);
+        }
+    }
+
+    /**
+     * KoUpdater cannot be shared between the threads, so every patch
+     * gets its own dummy updater and the overall progress is reported
+     * by runOnPatches()
+     */
+    std::vector<std::unique_ptr<KoDummyUpdaterHolder>> patchUpdaters;
+    for (int i = 0; i < patches.size(); i++) {
+        patchUpdaters.emplace_back(new KoDummyUpdaterHolder());
+    }
+
+    KritaUtils::runOnPatches(patches,
+        [&] (int index, const QRect &patch) {
+            KoUpdater *patchUpdater = patchUpdaters[index]->updater();
+
+            if (!needsBorder) {
+                processImpl(device, patch, config, patchUpdater);
+                return;
+            }
+
+            KisPaintDeviceSP patchDevice = patchDevices[index];
+
+            {
+                // the filters read the neighbourhood through oldRawData()
+                KisTransaction transaction(patchDevice);
+                processImpl(patchDevice, patch, config, patchUpdater);
+            }
+
+            KisPainter::copyAreaOptimized(patch.topLeft(), patchDevice, device, patch);
+
+            // release the tiles as soon as possible
+            patchDevices[index].clear();
+        },
+        progressUpdater);
+}
+
 QRect KisFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP c, int lod) const
 {
     Q_UNUSED(c);
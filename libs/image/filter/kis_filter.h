@@ -50,6 +50,30 @@ public:
                              const KisFilterConfigurationSP config,
                              KoUpdater* progressUpdater = 0 ) const = 0;
 
+    /**
+     * Runs processImpl() for the tile-aligned patches of \p applyRect
+     * concurrently if the filter supports threading (see
+     * KisBaseProcessor::supportsThreading()) and the rect is big enough,
+     * otherwise just calls processImpl().
+     *
+     * When the filter needs pixels outside the patches (see neededRect()),
+     * every patch is processed on its own copy-on-write clone of the
+     * original pixels, so the patches never see the pixels already
+     * filtered by their neighbours. The progress is aggregated over all
+     * the patches and reported to \p progressUpdater.
+     *
+     * The filter stroke splits the threaded filters into the jobs of the
+     * updater context itself, so this function is used by process() only.
+     * The patches run on the global thread pool (see
+     * KritaUtils::runOnPatches()). When called from a job of an updater
+     * context (e.g. when a filter mask is updated), the rect is processed
+     * in one pass on the calling thread.
+     */
+    void processImplInParallel(KisPaintDeviceSP device,
+                               const QRect& applyRect,
+                               const KisFilterConfigurationSP config,
+                               KoUpdater* progressUpdater = 0) const;
+
     /**
      * Filter \p src device and write the result into \p dst device.
      * If \p dst is an alpha color space device, it will get special
@@ -573,6 +573,28 @@ void KisImageConfig::setUseLodForColorizeMask(bool value)
     m_config.writeEntry("useLodForColorizeMask", value);
 }
 
+bool KisImageConfig::useColorTransformationLuts(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("useColorTransformationLuts", true) : true;
+}
+
+void KisImageConfig::setUseColorTransformationLuts(bool value)
+{
+    m_config.writeEntry("useColorTransformationLuts", value);
+}
+
+bool KisImageConfig::useApproximateColorTransformationLuts(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("useApproximateColorTransformationLuts", false) : false;
+}
+
+void KisImageConfig::setUseApproximateColorTransformationLuts(bool value)
+{
+    m_config.writeEntry("useApproximateColorTransformationLuts", value);
+}
+
 int KisImageConfig::maxNumberOfThreads(bool defaultValue) const
 {
     return (defaultValue ? QThread::idealThreadCount() : m_config.readEntry("maxNumberOfThreads", QThread::idealThreadCount()));
@@ -109,6 +109,12 @@ public:
     bool useLodForColorizeMask(bool requestDefault = false) const;
     void setUseLodForColorizeMask(bool value);
 
+    bool useColorTransformationLuts(bool requestDefault = false) const;
+    void setUseColorTransformationLuts(bool value);
+
+    bool useApproximateColorTransformationLuts(bool requestDefault = false) const;
+    void setUseApproximateColorTransformationLuts(bool value);
+
     int maxNumberOfThreads(bool defaultValue = false) const;
     void setMaxNumberOfThreads(int value);
 
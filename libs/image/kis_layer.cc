@@ -30,6 +30,7 @@
 #include "kis_mask.h"
 #include "kis_effect_mask.h"
 #include "kis_filter_mask.h"
+#include "KisFusedFilterMaskChain.h"
 #include "kis_selection_mask.h"
 #include "kis_meta_data_store.h"
 #include "kis_selection.h"
@@ -703,13 +704,42 @@ QRect KisLayer::applyMasks(const KisPaintDeviceSP source,
                 copyOriginalToProjection(source, destination, needRect);
             }
 
-            Q_FOREACH (const KisEffectMaskSP& mask, masks) {
-                const QRect maskApplyRect = applyRects.pop();
+            for (int i = 0; i < masks.size();) {
+                const QRect maskApplyRect = applyRects.top();
+
+                /**
+                 * Consecutive per-pixel color filters are applied
+                 * in a single pass without any temporary devices.
+                 * The chain is destroyed before any mask is applied
+                 * in a usual way, so it never holds a lock of a mask
+                 * that locks itself in KisMask::apply().
+                 */
+                int numFusedMasks = 0;
+                {
+                    KisFusedFilterMaskChain fusedChain(masks, i, destination, maskApplyRect);
+
+                    if (fusedChain.size() > 1) {
+                        numFusedMasks = fusedChain.apply();
+                    }
+                }
+
+                if (numFusedMasks > 0) {
+                    for (int j = 0; j < numFusedMasks; j++) {
+                        applyRects.pop();
+                    }
+                    i += numFusedMasks;
+                    continue;
+                }
+
+                const KisEffectMaskSP &mask = masks[i];
+
+                applyRects.pop();
                 const QRect maskNeedRect =
                     applyRects.isEmpty() ? needRect : applyRects.top();
-                    
+
                 PositionToFilthy maskPosition = calculatePositionToFilthy(mask, filthyNode, const_cast<KisLayer*>(this));
                 mask->apply(destination, maskApplyRect, maskNeedRect, maskPosition, flags);
+                i++;
             }
             Q_ASSERT(applyRects.isEmpty());
         } else {
@@ -53,6 +53,7 @@
 
 #include "kis_paint_device_cache.h"
 #include "kis_paint_device_data.h"
+#include "KisRunnableStrokeJobsInterface.h"
 #include "kis_paint_device_frames_interface.h"
 
 #include "kis_transform_worker.h"
@@ -102,7 +103,8 @@ public:
                            KoColorConversionTransformation::Intent renderingIntent,
                            KoColorConversionTransformation::ConversionFlags conversionFlags,
                            KUndo2Command *parentCommand,
-                           KoUpdater *progressUpdater);
+                           KoUpdater *progressUpdater,
+                           KisRunnableStrokeJobsInterface *jobsInterface);
     bool assignProfile(const KoColorProfile * profile, KUndo2Command *parentCommand);
 
     KUndo2Command* reincarnateWithDetachedHistory(bool copyContent);
@@ -982,7 +984,8 @@ void KisPaintDevice::Private::convertColorSpace(const KoColorSpace *dstColorSpac
                                                 KoColorConversionTransformation::Intent renderingIntent,
                                                 KoColorConversionTransformation::ConversionFlags conversionFlags,
                                                 KUndo2Command *parentCommand,
-                                                KoUpdater *progressUpdater)
+                                                KoUpdater *progressUpdater,
+                                                KisRunnableStrokeJobsInterface *jobsInterface)
 {
     QList<Data*> dataObjects = allDataObjects();
     if (dataObjects.isEmpty()) return;
@@ -990,13 +993,30 @@ void KisPaintDevice::Private::convertColorSpace(const KoColorSpace *dstColorSpac
     KUndo2Command *mainCommand =
         parentCommand ? new DeviceChangeColorSpaceCommand(q, parentCommand) : 0;
 
+    QVector<KisRunnableStrokeJobData*> jobs;
+
     Q_FOREACH (Data *data, dataObjects) {
         if (!data) continue;
 
-        data->convertDataColorSpace(dstColorSpace, renderingIntent, conversionFlags, mainCommand, progressUpdater);
+        data->convertDataColorSpace(dstColorSpace, renderingIntent, conversionFlags, mainCommand, progressUpdater,
+                                    jobsInterface ? &jobs : nullptr);
     }
 
-    q->emitColorSpaceChanged();
+    if (jobsInterface) {
+        /**
+         * The data objects are switched to the new color space by the
+         * sequential jobs, so the device can notify about the change
+         * only after all of them are completed
+         */
+        KisPaintDeviceSP device(q);
+        KritaUtils::addJobSequential(jobs, [device] () {
+            device->emitColorSpaceChanged();
+        });
+
+        jobsInterface->addRunnableJobs(jobs);
+    } else {
+        q->emitColorSpaceChanged();
+    }
 }
 
 bool KisPaintDevice::Private::assignProfile(const KoColorProfile * profile, KUndo2Command *parentCommand)
@@ -1572,9 +1592,10 @@ void KisPaintDevice::convertTo(const KoColorSpace *dstColorSpace,
                                KoColorConversionTransformation::Intent renderingIntent,
                                KoColorConversionTransformation::ConversionFlags conversionFlags,
                                KUndo2Command *parentCommand,
-                               KoUpdater *progressUpdater)
+                               KoUpdater *progressUpdater,
+                               KisRunnableStrokeJobsInterface *jobsInterface)
 {
-    m_d->convertColorSpace(dstColorSpace, renderingIntent, conversionFlags, parentCommand, progressUpdater);
+    m_d->convertColorSpace(dstColorSpace, renderingIntent, conversionFlags, parentCommand, progressUpdater, jobsInterface);
 }
 
 bool KisPaintDevice::setProfile(const KoColorProfile * profile, KUndo2Command *parentCommand)
@@ -41,6 +41,7 @@ class KisKeyframe;
 class KisRasterKeyframeChannel;
 
 class KisPaintDeviceFramesInterface;
+class KisRunnableStrokeJobsInterface;
 
 class KisInterstrokeData;
 using KisInterstrokeDataSP = QSharedPointer<KisInterstrokeData>;
@@ -475,12 +476,18 @@ public:
 
     /**
      * Converts the paint device to a different colorspace
+     *
+     * If \p jobsInterface is passed, the pixels are converted by concurrent
+     * jobs added to the current stroke. The device keeps its old pixels and
+     * color space until the final sequential job of the conversion switches
+     * it to the converted data and emits colorSpaceChanged().
      */
     void convertTo(const KoColorSpace *dstColorSpace,
                    KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::internalRenderingIntent(),
                    KoColorConversionTransformation::ConversionFlags conversionFlags = KoColorConversionTransformation::internalConversionFlags(),
                    KUndo2Command *parentCommand = nullptr,
-                   KoUpdater *progressUpdater = nullptr);
+                   KoUpdater *progressUpdater = nullptr,
+                   KisRunnableStrokeJobsInterface *jobsInterface = nullptr);
 
     /**
      * Changes the profile of the colorspace of this paint device to the given
@@ -13,6 +13,8 @@
 #include "KoAlwaysInline.h"
 #include "kis_command_utils.h"
 #include "kundo2command.h"
+#include "krita_utils.h"
+#include "KisRunnableStrokeJobUtils.h"
 
 struct DirectDataAccessPolicy {
     DirectDataAccessPolicy(KisDataManager *dataManager, KisIteratorCompleteListener *completionListener)
@@ -158,17 +160,66 @@ public:
         }
     }
 
-    void convertDataColorSpace(const KoColorSpace *dstColorSpace,
-                               KoColorConversionTransformation::Intent renderingIntent,
-                               KoColorConversionTransformation::ConversionFlags conversionFlags,
-                               KUndo2Command *parentCommand,
-                               KoUpdater *updater = nullptr)
+    /**
+     * Converts all the pixels of \p rc from \p srcDataManager into
+     * \p dstDataManager. The data managers must have the same tile grid.
+     */
+    static void convertDataRect(KisDataManager *srcDataManager, const KoColorSpace *srcColorSpace,
+                                KisDataManager *dstDataManager, const KoColorSpace *dstColorSpace,
+                                const QRect &rc,
+                                KoColorConversionTransformation::Intent renderingIntent,
+                                KoColorConversionTransformation::ConversionFlags conversionFlags,
+                                KisIteratorCompleteListener *completionListener,
+                                KoUpdater *updater)
     {
         using InternalSequentialConstIterator =
             KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
         using InternalSequentialIterator =
             KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
 
+        InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(srcDataManager, completionListener), rc, updater);
+        InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager, completionListener), rc, updater);
+
+        int nConseqPixels = srcIt.nConseqPixels();
+
+        // since we are accessing data managers directly, the columns are always aligned
+        KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+
+        while(srcIt.nextPixels(nConseqPixels) &&
+              dstIt.nextPixels(nConseqPixels)) {
+
+            nConseqPixels = srcIt.nConseqPixels();
+
+            const quint8 *srcData = srcIt.rawDataConst();
+            quint8 *dstData = dstIt.rawData();
+
+            srcColorSpace->convertPixelsTo(srcData, dstData,
+                                           dstColorSpace,
+                                           nConseqPixels,
+                                           renderingIntent, conversionFlags);
+        }
+    }
+
+    /**
+     * Converts the data into \p dstColorSpace. If \p jobs is provided,
+     * then the actual pixel conversion is split into concurrent
+     * patch-based jobs, which are appended to \p jobs. The pixels are
+     * converted into a separate data manager, and the data of the device
+     * is switched to it only by the sequential job appended after the
+     * conversion jobs. Until then the device keeps its old pixels and
+     * color space, so it can be safely read at any moment.
+     *
+     * The jobs write directly into the new data manager, so no
+     * transaction mementos are created: the undo history keeps only
+     * the old and the new data managers.
+     */
+    void convertDataColorSpace(const KoColorSpace *dstColorSpace,
+                               KoColorConversionTransformation::Intent renderingIntent,
+                               KoColorConversionTransformation::ConversionFlags conversionFlags,
+                               KUndo2Command *parentCommand,
+                               KoUpdater *updater = nullptr,
+                               QVector<KisRunnableStrokeJobData*> *jobs = nullptr)
+    {
         if (m_colorSpace == dstColorSpace || *m_colorSpace == *dstColorSpace) {
             return;
         }
@@ -182,29 +233,68 @@ public:
 
         KisDataManagerSP dstDataManager = new KisDataManager(dstPixelSize, dstDefaultPixel.data());
 
+        if (jobs) {
+            /**
+             * Only the allocated tiles are converted, the rest of the
+             * device is covered by the converted default pixel.
+             */
+            const QVector<QRect> patches =
+                !rc.isEmpty() ?
+                KritaUtils::splitRegionIntoPatches(m_dataManager->region(),
+                                                   KritaUtils::optimalPatchSize()) :
+                QVector<QRect>();
+
+            KisDataManagerSP srcDataManager = m_dataManager;
+            const KoColorSpace *srcColorSpace = m_colorSpace;
+            KisIteratorCompleteListener *completionListener = cacheInvalidator();
+
+            KoUpdaterPtr progressUpdater(updater);
+            const int numPatches = patches.size();
+            QSharedPointer<QAtomicInt> numConvertedPatches(new QAtomicInt(0));
+
+            Q_FOREACH (const QRect &patch, patches) {
+                KritaUtils::addJobConcurrent(*jobs,
+                    [srcDataManager, srcColorSpace, dstDataManager, dstColorSpace,
+                     patch, renderingIntent, conversionFlags, completionListener,
+                     progressUpdater, numPatches, numConvertedPatches] () {
+
+                    convertDataRect(srcDataManager.data(), srcColorSpace,
+                                    dstDataManager.data(), dstColorSpace,
+                                    patch, renderingIntent, conversionFlags,
+                                    completionListener, nullptr);
+
+                    const int numConverted = numConvertedPatches->fetchAndAddOrdered(1) + 1;
+
+                    if (progressUpdater) {
+                        progressUpdater->setProgress(100 * numConverted / numPatches);
+                    }
+                });
+            }
 
-        if (!rc.isEmpty()) {
-            InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc, updater);
-            InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager.data(), cacheInvalidator()), rc, updater);
-
-            int nConseqPixels = srcIt.nConseqPixels();
-
-            // since we are accessing data managers directly, the columns are always aligned
-            KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+            // becomes owned by the parent
+            ChangeColorSpaceCommand *cmd =
+                new ChangeColorSpaceCommand(this,
+                                            m_dataManager, dstDataManager,
+                                            m_colorSpace, dstColorSpace,
+                                            parentCommand);
 
-            while(srcIt.nextPixels(nConseqPixels) &&
-                  dstIt.nextPixels(nConseqPixels)) {
+            QSharedPointer<KUndo2Command> ownedCommand(!parentCommand ? cmd : nullptr);
 
-                nConseqPixels = srcIt.nConseqPixels();
+            // NOTE: first redo is skipped on a higher level,
+            //       at DeviceChangeColorSpaceCommand
+            KritaUtils::addJobSequential(*jobs, [cmd, ownedCommand] () {
+                Q_UNUSED(ownedCommand);
+                cmd->redo();
+            });
 
-                const quint8 *srcData = srcIt.rawDataConst();
-                quint8 *dstData = dstIt.rawData();
+            return;
+        }
 
-                m_colorSpace->convertPixelsTo(srcData, dstData,
-                                              dstColorSpace,
-                                              nConseqPixels,
-                                              renderingIntent, conversionFlags);
-            }
+        if (!rc.isEmpty()) {
+            convertDataRect(m_dataManager.data(), m_colorSpace,
+                            dstDataManager.data(), dstColorSpace,
+                            rc, renderingIntent, conversionFlags,
+                            cacheInvalidator(), updater);
         }
 
         // becomes owned by the parent
@@ -16,6 +16,8 @@
 #include "kis_convolution_kernel.h"
 #include "kis_pixel_selection.h"
 #include <kis_sequential_iterator.h>
+#include "KisSummedAreaTable.h"
+#include "krita_utils.h"
 
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -507,8 +509,104 @@ QRect KisFeatherSelectionFilter::changeRect(const QRect& rect, KisDefaultBoundsB
                          m_radius, m_radius);
 }
 
+namespace {
+
+/**
+ * The convolution costs O(radius) per pixel, so starting from this
+ * radius the feathering is approximated with box filters
+ */
+const qint32 minBoxFeatherRadius = 32;
+
+/**
+ * The number of box passes approximating the gaussian kernel
+ */
+const int numFeatherBoxPasses = 3;
+
+/**
+ * Writes the box averages of \p src into \p rect of \p dst. The box
+ * averages are taken from summed-area tables, so they cost the same
+ * for any \p halfSize.
+ */
+void applyBoxPass(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                  const QRect &rect, const QRect &dataRect, qint32 halfSize)
+{
+    const qint32 boxSize = 2 * halfSize + 1;
+    const qreal boxArea = qreal(boxSize) * boxSize;
+
+    KritaUtils::runOnRowStrips(rect,
+        [&] (const QRect &strip) {
+            const KisSummedAreaTable table(src, kisGrowRect(strip, halfSize), dataRect);
+
+            QVector<quint8> bytes(strip.width() * strip.height());
+            quint8 *pixel = bytes.data();
+
+            for (qint32 y = strip.top(); y <= strip.bottom(); y++) {
+                for (qint32 x = strip.left(); x <= strip.right(); x++, pixel++) {
+                    const qreal sum = table.sum(0, QRect(x - halfSize, y - halfSize, boxSize, boxSize));
+                    *pixel = quint8(qBound(0, qRound(sum / boxArea * MAX_SELECTED), int(MAX_SELECTED)));
+                }
+            }
+
+            dst->writeBytes(bytes.constData(), strip);
+        });
+}
+
+/**
+ * The gaussian kernel of the feathering is approximated with a few
+ * iterated box passes of the same total variance. Every pass reads
+ * the result of the previous one, so the earlier passes cover the
+ * rect grown by the boxes of the passes left.
+ */
+void featherWithBox(KisPixelSelectionSP pixelSelection, const QRect &rect, qint32 radius)
+{
+    qreal weightsSum = 0.0;
+    qreal variance = 0.0;
+
+    for (qint32 d = -radius; d <= radius; d++) {
+        const qreal weight = exp(-qreal(d * d) / (2.0 * radius * radius));
+        weightsSum += weight;
+        variance += weight * d * d;
+    }
+    variance /= weightsSum;
+
+    // the variance of a box of (2 * h + 1) pixels is h * (h + 1) / 3,
+    // the variances of the passes add up
+    const qreal passVariance = variance / numFeatherBoxPasses;
+    const qint32 halfSize = qBound(1, qRound(0.5 * (sqrt(1.0 + 12.0 * passVariance) - 1.0)), int(radius));
+
+    const QRect dataRect = KisSummedAreaTable::repeatedBorderDataRect(pixelSelection, rect);
+    KisPaintDeviceSP source = new KisPaintDevice(*pixelSelection);
+
+    for (int pass = 0; pass < numFeatherBoxPasses; pass++) {
+        const bool isLastPass = pass == numFeatherBoxPasses - 1;
+
+        QRect passRect = kisGrowRect(rect, (numFeatherBoxPasses - 1 - pass) * halfSize);
+        if (dataRect.isValid()) {
+            passRect &= dataRect;
+        }
+
+        KisPaintDeviceSP destination;
+        if (isLastPass) {
+            destination = pixelSelection;
+        } else {
+            destination = new KisPaintDevice(pixelSelection->colorSpace());
+            destination->prepareClone(pixelSelection);
+        }
+
+        applyBoxPass(source, destination, passRect, dataRect, halfSize);
+        source = destination;
+    }
+}
+
+}
+
 void KisFeatherSelectionFilter::process(KisPixelSelectionSP pixelSelection, const QRect& rect)
 {
+    if (m_radius >= minBoxFeatherRadius) {
+        featherWithBox(pixelSelection, rect, m_radius);
+        return;
+    }
+
     // compute horizontal kernel
     const uint kernelSize = m_radius * 2 + 1;
     Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> gaussianMatrix(1, kernelSize);
@@ -38,7 +38,7 @@ public:
         }
 
     private:
-        KisRunnableStrokeJobsInterface *m_mutatedJobsInterface;
+        KisRunnableStrokeJobsInterface *m_mutatedJobsInterface {nullptr};
     };
 
 
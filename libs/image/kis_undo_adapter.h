@@ -12,6 +12,8 @@
 #include <kritaimage_export.h>
 #include <kis_undo_store.h>
 
+class KisRunnableStrokeJobsInterface;
+
 
 class KRITAIMAGE_EXPORT KisUndoAdapter : public QObject
 {
@@ -34,6 +36,19 @@ public:
         m_undoStore = undoStore;
     }
 
+    /**
+     * The interface for adding concurrent jobs into the stroke, which
+     * executes the commands of this adapter. Null if the adapter is used
+     * outside of a runnable-based stroke.
+     */
+    inline KisRunnableStrokeJobsInterface* runnableJobsInterface() const {
+        return m_runnableJobsInterface;
+    }
+
+    inline void setRunnableJobsInterface(KisRunnableStrokeJobsInterface *interface) {
+        m_runnableJobsInterface = interface;
+    }
+
 Q_SIGNALS:
     void selectionChanged();
 
@@ -45,6 +60,7 @@ protected:
 private:
     Q_DISABLE_COPY(KisUndoAdapter)
     KisUndoStore *m_undoStore;
+    KisRunnableStrokeJobsInterface *m_runnableJobsInterface {nullptr};
 };
 
 
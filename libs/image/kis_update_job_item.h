@@ -46,7 +46,9 @@ public:
     }
 
     void run() override {
+        KisUpdaterContext::setInsideJob(true);
         runImpl();
+        KisUpdaterContext::setInsideJob(false);
 
         // notify that the job is exiting and wake everybody
         // waiting on wakeForDone()
@@ -15,6 +15,13 @@
 
 const int KisUpdaterContext::useIdealThreadCountTag = -1;
 
+namespace {
+/**
+ * Set by KisUpdateJobItem while it runs its jobs
+ */
+thread_local bool s_isInsideJob = false;
+}
+
 KisUpdaterContext::KisUpdaterContext(qint32 threadCount, KisUpdateScheduler *parent)
     : m_scheduler(parent)
 {
@@ -299,6 +306,16 @@ void KisUpdaterContext::jobThreadExited()
     }
 }
 
+bool KisUpdaterContext::isInsideJob()
+{
+    return s_isInsideJob;
+}
+
+void KisUpdaterContext::setInsideJob(bool value)
+{
+    s_isInsideJob = value;
+}
+
 void KisUpdaterContext::setTestingMode(bool value)
 {
     m_testingMode = value;
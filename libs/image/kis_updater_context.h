@@ -134,6 +134,14 @@ public:
 
     void setTestingMode(bool value);
 
+    /**
+     * Returns true if the calling thread is running a job of some
+     * updater context right now, that is, a merge job or a job of a
+     * stroke. Such jobs already occupy all the threads of the context,
+     * so they should not split their work any further.
+     */
+    static bool isInsideJob();
+
 protected:
     static bool walkerIntersectsJob(KisBaseRectsWalkerSP walker,
                                     const KisUpdateJobItem* job);
@@ -171,6 +179,8 @@ private:
 
     void startThread(int index);
 
+    static void setInsideJob(bool value);
+
 };
 
 class KRITAIMAGE_EXPORT KisTestableUpdaterContext : public KisUpdaterContext
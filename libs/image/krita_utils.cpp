@@ -6,6 +6,8 @@
 
 #include "krita_utils.h"
 
+#include <numeric>
+
 #include <QtCore/qmath.h>
 
 #include <QRect>
@@ -14,10 +16,12 @@
 #include <QPolygonF>
 #include <QPen>
 #include <QPainter>
+#include <QtConcurrent>
 
 #include "kis_algebra_2d.h"
 
 #include <KoColorSpaceRegistry.h>
+#include <KoUpdater.h>
 
 #include "kis_image.h"
 #include "kis_image_config.h"
@@ -451,6 +455,112 @@ namespace KritaUtils
         return qreal(numTransparentPixels) / numPixels;
     }
 
+    namespace {
+        /**
+         * The number of runOnPatches() calls the current thread is
+         * processing the patches for
+         */
+        thread_local int patchRunnerNestingLevel = 0;
+    }
+
+    void runOnPatches(const QVector<QRect> &patches,
+                      std::function<void(int index, const QRect &patch)> func,
+                      KoUpdater *progressUpdater,
+                      int maxNumThreads)
+    {
+        if (patches.isEmpty()) return;
+
+        qint64 totalArea = 0;
+        Q_FOREACH (const QRect &patch, patches) {
+            totalArea += qint64(patch.width()) * patch.height();
+        }
+
+        QAtomicInteger<qint64> processedArea(0);
+        QThread *callerThread = QThread::currentThread();
+
+        auto processPatch = [&] (int index) {
+            if (progressUpdater && progressUpdater->interrupted()) return;
+
+            const QRect &patch = patches[index];
+            func(index, patch);
+
+            const qint64 area = qint64(patch.width()) * patch.height();
+            const qint64 processed = processedArea.fetchAndAddOrdered(area) + area;
+
+            if (progressUpdater && QThread::currentThread() == callerThread) {
+                progressUpdater->setProgress(int(processed * 100 / qMax(qint64(1), totalArea)));
+            }
+        };
+
+        if (maxNumThreads < 0) {
+            maxNumThreads = KisImageConfig(true).maxNumberOfThreads();
+        }
+
+        const int numWorkers =
+            qMin(patches.size(), qMin(maxNumThreads, QThread::idealThreadCount()));
+
+        if (numWorkers <= 1 || patchRunnerNestingLevel > 0) {
+            for (int index = 0; index < patches.size(); index++) {
+                processPatch(index);
+            }
+        } else {
+            /**
+             * Every worker takes the patches one by one until there are
+             * none left, so the number of workers limits the number of
+             * threads busy with the patches
+             */
+            QAtomicInt nextPatch(0);
+
+            auto runWorker = [&] (int) {
+                patchRunnerNestingLevel++;
+
+                int index;
+                while ((index = nextPatch.fetchAndAddOrdered(1)) < patches.size()) {
+                    processPatch(index);
+                }
+
+                patchRunnerNestingLevel--;
+            };
+
+            QVector<int> workers(numWorkers);
+            std::iota(workers.begin(), workers.end(), 0);
+
+            /**
+             * blockingMap() lets the calling thread run the workers as well,
+             * so it never deadlocks even when the global pool is saturated
+             */
+            QtConcurrent::blockingMap(workers, runWorker);
+        }
+
+        if (progressUpdater && !progressUpdater->interrupted()) {
+            progressUpdater->setProgress(100);
+        }
+    }
+
+    void runOnRowStrips(const QRect &rc,
+                        std::function<void(const QRect&)> func,
+                        KoUpdater *progressUpdater,
+                        int minStripHeight)
+    {
+        if (rc.isEmpty()) return;
+
+        const int numStrips = qMax(1, rc.height() / qMax(1, minStripHeight));
+
+        QVector<QRect> strips;
+
+        const int stripHeight = rc.height() / numStrips;
+        const int extraRows = rc.height() % numStrips;
+
+        int y = rc.top();
+        for (int i = 0; i < numStrips; i++) {
+            const int height = stripHeight + (i < extraRows ? 1 : 0);
+            strips.append(QRect(rc.left(), y, rc.width(), height));
+            y += height;
+        }
+
+        runOnPatches(strips, [func] (int, const QRect &strip) { func(strip); }, progressUpdater);
+    }
+
     void mirrorDab(Qt::Orientation dir, const QPoint &center, KisRenderedDab *dab, bool skipMirrorPixels)
     {
         const QRect rc = dab->realBounds();
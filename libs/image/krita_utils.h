@@ -17,6 +17,7 @@ class QBitArray;
 class QPainter;
 struct KisRenderedDab;
 class KisRegion;
+class KoUpdater;
 
 #include <QVector>
 #include "kritaimage_export.h"
@@ -89,6 +90,42 @@ namespace KritaUtils
 
     qreal KRITAIMAGE_EXPORT estimatePortionOfTransparentPixels(KisPaintDeviceSP dev, const QRect &rect, qreal samplePortion);
 
+    /**
+     * Run \p func for every patch of \p patches concurrently. The
+     * calling thread takes part in the processing and the function
+     * returns when all the patches are done.
+     *
+     * KoUpdater is not thread-safe, so \p progressUpdater is never passed
+     * to the worker threads. The progress (the portion of the processed
+     * area) is reported by the calling thread only. When the updater is
+     * interrupted, the patches that have not been started yet are skipped.
+     *
+     * The patches are processed by the global QThreadPool, not by the
+     * threads of the updater context, so the function is meant for the
+     * code that runs outside of the concurrent jobs of a stroke (e.g.
+     * a sequential stroke job or KisFilter::process()). Not more than
+     * \p maxNumThreads threads (KisImageConfig::maxNumberOfThreads() by
+     * default) work on the patches at the same time. A call nested into
+     * a patch of another runOnPatches() processes all its patches on the
+     * calling thread.
+     */
+    void KRITAIMAGE_EXPORT runOnPatches(const QVector<QRect> &patches,
+                                        std::function<void(int index, const QRect &patch)> func,
+                                        KoUpdater *progressUpdater = nullptr,
+                                        int maxNumThreads = -1);
+
+    /**
+     * Split \p rc into full-width strips of \p minStripHeight to
+     * 2 * \p minStripHeight rows and run \p func for every strip
+     * concurrently (see runOnPatches()). The strips are small enough
+     * to keep the per-strip buffers of the filters bounded, the thread
+     * pool balances them between the threads.
+     */
+    void KRITAIMAGE_EXPORT runOnRowStrips(const QRect &rc,
+                                          std::function<void(const QRect&)> func,
+                                          KoUpdater *progressUpdater = nullptr,
+                                          int minStripHeight = 64);
+
     void KRITAIMAGE_EXPORT mirrorDab(Qt::Orientation dir, const QPoint &center, KisRenderedDab *dab, bool skipMirrorPixels = false);
     void KRITAIMAGE_EXPORT mirrorDab(Qt::Orientation dir, const QPointF &center, KisRenderedDab *dab, bool skipMirrorPixels = false);
 
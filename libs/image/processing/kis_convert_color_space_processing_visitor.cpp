@@ -98,17 +98,31 @@ void KisConvertColorSpaceProcessingVisitor::visitNodeWithPaintDevice(KisNode *no
         }
     }
 
-    if (layer->original()) {
-        layer->original()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater());
-    }
+    const QRect extent = layer->extent();
+    KisRunnableStrokeJobsInterface *jobsInterface = undoAdapter->runnableJobsInterface();
+
+    /**
+     * When the conversion is split into stroke jobs, the devices are
+     * switched to the new color space only after the jobs are completed,
+     * so the devices shared between original, paintDevice and projection
+     * should be explicitly skipped to avoid converting them twice.
+     */
+    QVector<KisPaintDevice*> convertedDevices;
+
+    auto convertDevice = [&] (KisPaintDeviceSP device) {
+        if (!device || convertedDevices.contains(device.data())) return;
+        convertedDevices.append(device.data());
+
+        device->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater(), jobsInterface);
+    };
+
+    convertDevice(layer->original());
 
     if (layer->paintDevice() && layer->paintDevice()->colorSpace()->colorModelId() != AlphaColorModelID) {
-        layer->paintDevice()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater());
+        convertDevice(layer->paintDevice());
     }
 
-    if (layer->projection()) {
-        layer->projection()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater());
-    }
+    convertDevice(layer->projection());
 
     if (alphaDisabled) {
         new KisChangeChannelFlagsCommand(m_dstColorSpace->channelFlags(true, false),
@@ -121,7 +135,7 @@ void KisConvertColorSpaceProcessingVisitor::visitNodeWithPaintDevice(KisNode *no
     }
 
     undoAdapter->addCommand(parentConversionCommand);
-    layer->invalidateFrames(KisTimeSpan::infinite(0), layer->extent());
+    layer->invalidateFrames(KisTimeSpan::infinite(0), extent);
 }
 
 void KisConvertColorSpaceProcessingVisitor::visit(KisGroupLayer *layer, KisUndoAdapter *undoAdapter)
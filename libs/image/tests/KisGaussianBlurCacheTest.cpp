@@ -0,0 +1,120 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGaussianBlurCacheTest.h"
+
+#include <QBitArray>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <KisGaussianBlurCache.h>
+#include <kis_gaussian_kernel.h>
+#include <kis_paint_device.h>
+#include <kistest.h>
+#include "testing_timed_default_bounds.h"
+
+namespace {
+
+KisPaintDeviceSP createTestDevice(const QRect &imageRect)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(imageRect));
+
+    dev->fill(imageRect, KoColor(Qt::white, cs));
+    dev->fill(QRect(40, 30, 300, 120), KoColor(Qt::red, cs));
+    dev->fill(QRect(250, 100, 200, 250), KoColor(Qt::blue, cs));
+    dev->fill(QRect(500, 0, 20, 400), KoColor(Qt::transparent, cs));
+
+    return dev;
+}
+
+/**
+ * Compares the blurred pixels of the cache with the plain gaussian blur
+ * of the whole rect. The FFT worker may round differently for different
+ * sizes of the area, so a difference of one is allowed.
+ */
+void checkCells(KisGaussianBlurCache &cache, KisPaintDeviceSP dev, const QRect &rect, qreal radius)
+{
+    const int pixelSize = dev->pixelSize();
+
+    KisPaintDeviceSP reference = new KisPaintDevice(*dev);
+    KisGaussianKernel::applyGaussian(reference, rect, radius, radius, QBitArray(), nullptr);
+
+    Q_FOREACH (const QRect &cell, KisGaussianBlurCache::splitIntoCells(rect)) {
+        QVector<quint8> expected(cell.width() * cell.height() * pixelSize);
+        QVector<quint8> result(cell.width() * cell.height() * pixelSize);
+
+        reference->readBytes(expected.data(), cell);
+        cache.readBlurredBytes(dev, cell, radius, QBitArray(), result.data());
+
+        for (int i = 0; i < expected.size(); i++) {
+            if (qAbs(int(expected[i]) - int(result[i])) > 1) {
+                QFAIL(QString("Different blurred pixel in cell (%1, %2): expected %3, got %4")
+                      .arg(cell.x()).arg(cell.y()).arg(expected[i]).arg(result[i]).toLatin1());
+            }
+        }
+    }
+}
+
+}
+
+void KisGaussianBlurCacheTest::testSplitIntoCells()
+{
+    const QRect rect(-10, 20, 600, 300);
+    const QVector<QRect> cells = KisGaussianBlurCache::splitIntoCells(rect);
+
+    QCOMPARE(cells.size(), 4 * 2);
+
+    QRegion covered;
+    Q_FOREACH (const QRect &cell, cells) {
+        QVERIFY(rect.contains(cell));
+        QVERIFY(!covered.intersects(cell));
+        covered += cell;
+    }
+    QCOMPARE(covered, QRegion(rect));
+
+    // the cells are aligned to the grid, not to the rect
+    QVERIFY(cells.contains(QRect(0, 20, 256, 236)));
+
+    QVERIFY(KisGaussianBlurCache::splitIntoCells(QRect()).isEmpty());
+}
+
+void KisGaussianBlurCacheTest::testBlurMatchesGaussian()
+{
+    const QRect imageRect(0, 0, 600, 400);
+    KisPaintDeviceSP dev = createTestDevice(imageRect);
+
+    KisGaussianBlurCache cache;
+
+    // the second pass is served from the cache
+    checkCells(cache, dev, imageRect, 5.0);
+    checkCells(cache, dev, imageRect, 5.0);
+
+    // a different radius must not reuse the cells of the first one
+    checkCells(cache, dev, imageRect, 12.0);
+}
+
+void KisGaussianBlurCacheTest::testSourceChangeInvalidatesCell()
+{
+    const QRect imageRect(0, 0, 600, 400);
+    KisPaintDeviceSP dev = createTestDevice(imageRect);
+
+    KisGaussianBlurCache cache;
+    checkCells(cache, dev, imageRect, 5.0);
+
+    // the change is outside of the cell (0, 0), but still under its kernel
+    dev->fill(QRect(258, 10, 4, 4), KoColor(Qt::green, dev->colorSpace()));
+    checkCells(cache, dev, imageRect, 5.0);
+
+    cache.clear();
+    checkCells(cache, dev, imageRect, 5.0);
+}
+
+KISTEST_MAIN(KisGaussianBlurCacheTest)
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISGAUSSIANBLURCACHETEST_H
+#define KISGAUSSIANBLURCACHETEST_H
+
+#include <simpletest.h>
+
+class KisGaussianBlurCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testSplitIntoCells();
+    void testBlurMatchesGaussian();
+    void testSourceChangeInvalidatesCell();
+};
+
+#endif // KISGAUSSIANBLURCACHETEST_H
@@ -0,0 +1,106 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedByteArrayTest.h"
+
+#include "KisOptimizedByteArray.h"
+
+#include <simpletest.h>
+
+using Allocator = KisOptimizedByteArray::SizeClassMemoryAllocator;
+
+void KisOptimizedByteArrayTest::testSizeClasses()
+{
+    QCOMPARE(Allocator::roundUpToSizeClass(1), 4096);
+    QCOMPARE(Allocator::roundUpToSizeClass(4096), 4096);
+    QCOMPARE(Allocator::roundUpToSizeClass(4097), 5120);
+    QCOMPARE(Allocator::roundUpToSizeClass(5120), 5120);
+    QCOMPARE(Allocator::roundUpToSizeClass(7169), 8192);
+    QCOMPARE(Allocator::roundUpToSizeClass(8193), 10240);
+
+    // 300x300 RGBA8 dab
+    QCOMPARE(Allocator::roundUpToSizeClass(360000), 393216);
+
+    // too big requests bypass the pool and are not rounded
+    QCOMPARE(Allocator::roundUpToSizeClass((1 << 26) + 1), (1 << 26) + 1);
+
+    for (int size = 1; size < 100000; size += 37) {
+        const int classSize = Allocator::roundUpToSizeClass(size);
+        QVERIFY(classSize >= size);
+        QVERIFY(size <= 4096 || classSize <= 1.25 * size);
+        QCOMPARE(Allocator::roundUpToSizeClass(classSize), classSize);
+    }
+}
+
+void KisOptimizedByteArrayTest::testSizeClassReuse()
+{
+    Allocator allocator;
+
+    KisOptimizedByteArray::MemoryChunk chunk1 = allocator.alloc(10000);
+    QCOMPARE(chunk1.second, 10240);
+    allocator.free(chunk1);
+
+    // a different size of the same class reuses the chunk
+    KisOptimizedByteArray::MemoryChunk chunk2 = allocator.alloc(9000);
+    QCOMPARE(chunk2.first, chunk1.first);
+
+    // a request from another class doesn't steal it
+    allocator.free(chunk2);
+    KisOptimizedByteArray::MemoryChunk chunk3 = allocator.alloc(20000);
+    QVERIFY(chunk3.first != chunk1.first);
+    allocator.free(chunk3);
+
+    const KisOptimizedByteArray::Statistics stats = allocator.statistics();
+    QCOMPARE(stats.systemAllocations, 2);
+    QCOMPARE(stats.pooledAllocations, 1);
+    QCOMPARE(stats.systemDeallocations, 0);
+    QCOMPARE(stats.cachedBytes, qint64(10240 + 20480));
+}
+
+void KisOptimizedByteArrayTest::testSizeClassBudget()
+{
+    Allocator allocator(8192);
+
+    KisOptimizedByteArray::MemoryChunk chunk1 = allocator.alloc(4096);
+    KisOptimizedByteArray::MemoryChunk chunk2 = allocator.alloc(4096);
+    KisOptimizedByteArray::MemoryChunk chunk3 = allocator.alloc(4096);
+
+    allocator.free(chunk1);
+    allocator.free(chunk2);
+    allocator.free(chunk3);
+
+    const KisOptimizedByteArray::Statistics stats = allocator.statistics();
+    QCOMPARE(stats.systemAllocations, 3);
+    QCOMPARE(stats.systemDeallocations, 1);
+    QCOMPARE(stats.cachedBytes, qint64(8192));
+}
+
+void KisOptimizedByteArrayTest::testResizeWithSizeClassAllocator()
+{
+    QSharedPointer<Allocator> allocator(new Allocator());
+
+    {
+        KisOptimizedByteArray array(allocator);
+        array.fill(0x7f, 5000);
+        QCOMPARE(array.size(), 5000);
+        QCOMPARE(array.constData()[4999], quint8(0x7f));
+
+        // fits into the same chunk
+        array.resize(5100);
+        QCOMPARE(array.constData()[4999], quint8(0x7f));
+
+        KisOptimizedByteArray copy(array);
+        copy.data()[0] = 0x10;
+        QCOMPARE(array.constData()[0], quint8(0x7f));
+        QCOMPARE(copy.constData()[0], quint8(0x10));
+    }
+
+    const KisOptimizedByteArray::Statistics stats = allocator->statistics();
+    QCOMPARE(stats.systemAllocations, 2);
+    QCOMPARE(stats.cachedBytes, qint64(2 * 5120));
+}
+
+SIMPLE_TEST_MAIN(KisOptimizedByteArrayTest)
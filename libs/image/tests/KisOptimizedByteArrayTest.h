@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDBYTEARRAYTEST_H
+#define KISOPTIMIZEDBYTEARRAYTEST_H
+
+#include <simpletest.h>
+
+class KisOptimizedByteArrayTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testSizeClasses();
+    void testSizeClassReuse();
+    void testSizeClassBudget();
+    void testResizeWithSizeClassAllocator();
+};
+
+#endif // KISOPTIMIZEDBYTEARRAYTEST_H
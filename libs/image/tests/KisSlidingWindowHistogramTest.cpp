@@ -0,0 +1,191 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisSlidingWindowHistogramTest.h"
+
+#include <algorithm>
+#include <random>
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <KisSlidingWindowHistogram.h>
+#include <krita_utils.h>
+
+namespace {
+
+/**
+ * Records the mode, the median and the minimum of every window and
+ * counts the add/remove calls passed to the policy
+ */
+struct RecordingPolicy
+{
+    RecordingPolicy(const QRect &rc)
+        : rc(rc)
+        , mode(rc.width() * rc.height(), -2)
+        , median(rc.width() * rc.height(), -2)
+        , minimum(rc.width() * rc.height(), -2)
+    {
+    }
+
+    void reset() {
+        numPixels = 0;
+    }
+
+    void add(int, int) {
+        numPixels++;
+    }
+
+    void remove(int, int) {
+        numPixels--;
+    }
+
+    void writePixel(int x, int y, const KisSlidingWindowHistogram &histogram) {
+        QCOMPARE(histogram.total(), numPixels);
+
+        const int index = (y - rc.top()) * rc.width() + x - rc.left();
+        mode[index] = histogram.mostFrequentBin();
+        median[index] = histogram.medianBin();
+        minimum[index] = histogram.rankBin(0);
+    }
+
+    QRect rc;
+    int numPixels {0};
+    QVector<int> mode;
+    QVector<int> median;
+    QVector<int> minimum;
+};
+
+}
+
+void KisSlidingWindowHistogramTest::testRankLookups()
+{
+    KisSlidingWindowHistogram histogram(10);
+
+    QCOMPARE(histogram.mostFrequentBin(), -1);
+    QCOMPARE(histogram.medianBin(), -1);
+
+    histogram.add(7);
+    histogram.add(2);
+    histogram.add(2);
+    histogram.add(5);
+    histogram.add(7);
+
+    QCOMPARE(histogram.total(), 5);
+
+    // the lowest bin wins on a tie
+    QCOMPARE(histogram.mostFrequentBin(), 2);
+
+    QCOMPARE(histogram.rankBin(0), 2);
+    QCOMPARE(histogram.rankBin(1), 2);
+    QCOMPARE(histogram.rankBin(2), 5);
+    QCOMPARE(histogram.rankBin(4), 7);
+    QCOMPARE(histogram.medianBin(), 5);
+
+    histogram.remove(5);
+
+    // the lower median for an even number of elements
+    QCOMPARE(histogram.medianBin(), 2);
+
+    histogram.remove(2);
+    QCOMPARE(histogram.mostFrequentBin(), 7);
+
+    histogram.reset();
+    QCOMPARE(histogram.total(), 0);
+    QCOMPARE(histogram.rankBin(0), -1);
+}
+
+void KisSlidingWindowHistogramTest::testSlideAlongRows_data()
+{
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("r0") << 0;
+    QTest::newRow("r1") << 1;
+    QTest::newRow("r3") << 3;
+    QTest::newRow("r7") << 7;
+}
+
+void KisSlidingWindowHistogramTest::testSlideAlongRows()
+{
+    QFETCH(int, radius);
+
+    const int numBins = 16;
+    const QRect rc(10, -5, 37, 23);
+    const QRect dataRect = kisGrowRect(rc, radius + 2);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(-1, numBins - 1);
+
+    QVector<int> bins(dataRect.width() * dataRect.height());
+    for (int &bin : bins) {
+        bin = dis(gen);
+    }
+
+    RecordingPolicy policy(rc);
+    KisSlidingWindowHistogram histogram(numBins);
+    histogram.slideAlongRows(rc, radius, dataRect, bins.constData(), policy);
+
+    for (int y = rc.top(); y <= rc.bottom(); y++) {
+        for (int x = rc.left(); x <= rc.right(); x++) {
+            QVector<int> window;
+            QVector<int> counts(numBins, 0);
+
+            for (int wy = y - radius; wy <= y + radius; wy++) {
+                for (int wx = x - radius; wx <= x + radius; wx++) {
+                    const int bin = bins[(wy - dataRect.top()) * dataRect.width() + wx - dataRect.left()];
+                    if (bin >= 0) {
+                        window.append(bin);
+                        counts[bin]++;
+                    }
+                }
+            }
+
+            std::sort(window.begin(), window.end());
+
+            const int expectedMode = window.isEmpty() ? -1 :
+                std::max_element(counts.begin(), counts.end()) - counts.begin();
+            const int expectedMedian = window.isEmpty() ? -1 : window[(window.size() - 1) / 2];
+            const int expectedMinimum = window.isEmpty() ? -1 : window.first();
+
+            const int index = (y - rc.top()) * rc.width() + x - rc.left();
+
+            QCOMPARE(policy.mode[index], expectedMode);
+            QCOMPARE(policy.median[index], expectedMedian);
+            QCOMPARE(policy.minimum[index], expectedMinimum);
+        }
+    }
+}
+
+void KisSlidingWindowHistogramTest::testRowStrips()
+{
+    const QRect rc(3, 7, 50, 1000);
+
+    QMutex mutex;
+    QVector<QRect> strips;
+
+    KritaUtils::runOnRowStrips(rc,
+        [&] (const QRect &strip) {
+            QMutexLocker l(&mutex);
+            strips.append(strip);
+        }, nullptr, 16);
+
+    QVector<int> rowHits(rc.height(), 0);
+
+    Q_FOREACH (const QRect &strip, strips) {
+        QCOMPARE(strip.left(), rc.left());
+        QCOMPARE(strip.width(), rc.width());
+        QVERIFY(strip.height() >= 16);
+        QVERIFY(strip.height() < 32);
+
+        for (int y = strip.top(); y <= strip.bottom(); y++) {
+            rowHits[y - rc.top()]++;
+        }
+    }
+
+    QCOMPARE(rowHits, QVector<int>(rc.height(), 1));
+}
+
+SIMPLE_TEST_MAIN(KisSlidingWindowHistogramTest)
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSLIDINGWINDOWHISTOGRAMTEST_H
+#define KISSLIDINGWINDOWHISTOGRAMTEST_H
+
+#include <simpletest.h>
+
+class KisSlidingWindowHistogramTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRankLookups();
+    void testSlideAlongRows_data();
+    void testSlideAlongRows();
+    void testRowStrips();
+};
+
+#endif // KISSLIDINGWINDOWHISTOGRAMTEST_H
@@ -0,0 +1,218 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisSummedAreaTableTest.h"
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <KisSummedAreaTable.h>
+#include <kis_paint_device.h>
+#include <kis_pixel_selection.h>
+#include <kis_selection_filters.h>
+#include <kistest.h>
+#include "testing_timed_default_bounds.h"
+
+namespace {
+
+KisPaintDeviceSP createTestDevice(const QRect &imageRect)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(imageRect));
+
+    dev->fill(imageRect, KoColor(Qt::white, cs));
+    dev->fill(QRect(40, 30, 300, 120), KoColor(Qt::red, cs));
+    dev->fill(QRect(250, 100, 200, 250), KoColor(QColor(0, 0, 255, 128), cs));
+    dev->fill(QRect(500, 0, 20, 400), KoColor(Qt::transparent, cs));
+
+    return dev;
+}
+
+/**
+ * Sums up the premultiplied normalized channels of \p rc pixel by pixel
+ */
+double bruteForceSum(KisPaintDeviceSP dev, const QRect &rc, int channel)
+{
+    const KoColorSpace *cs = dev->colorSpace();
+    const int pixelSize = cs->pixelSize();
+
+    QVector<quint8> bytes(rc.width() * rc.height() * pixelSize);
+    dev->readBytes(bytes.data(), rc);
+
+    QVector<float> channels(cs->channelCount());
+    double sum = 0.0;
+
+    for (int i = 0; i < rc.width() * rc.height(); i++) {
+        cs->normalisedChannelsValue(bytes.constData() + i * pixelSize, channels);
+        const float alpha = channels[cs->alphaPos()];
+        sum += channel == cs->alphaPos() ? alpha : channels[channel] * alpha;
+    }
+
+    return sum;
+}
+
+/**
+ * Feathers \p rc of \p selection with the exact separable gaussian
+ * kernel of the feathering, repeating the pixels of the border
+ */
+QVector<qreal> exactFeather(KisPixelSelectionSP selection, const QRect &rc, qint32 radius)
+{
+    QVector<qreal> weights;
+    qreal weightsSum = 0.0;
+    for (qint32 d = -radius; d <= radius; d++) {
+        weights << exp(-qreal(d * d) / (2.0 * radius * radius));
+        weightsSum += weights.last();
+    }
+
+    QVector<quint8> bytes(rc.width() * rc.height());
+    selection->readBytes(bytes.data(), rc);
+
+    QVector<qreal> horizontal(bytes.size());
+    QVector<qreal> result(bytes.size());
+
+    for (int y = 0; y < rc.height(); y++) {
+        for (int x = 0; x < rc.width(); x++) {
+            qreal value = 0.0;
+            for (qint32 d = -radius; d <= radius; d++) {
+                value += weights[d + radius] * bytes[y * rc.width() + qBound(0, x + d, rc.width() - 1)];
+            }
+            horizontal[y * rc.width() + x] = value / weightsSum;
+        }
+    }
+
+    for (int y = 0; y < rc.height(); y++) {
+        for (int x = 0; x < rc.width(); x++) {
+            qreal value = 0.0;
+            for (qint32 d = -radius; d <= radius; d++) {
+                value += weights[d + radius] * horizontal[qBound(0, y + d, rc.height() - 1) * rc.width() + x];
+            }
+            result[y * rc.width() + x] = value / weightsSum;
+        }
+    }
+
+    return result;
+}
+
+}
+
+void KisSummedAreaTableTest::testSumsMatchPixels()
+{
+    const QRect imageRect(0, 0, 600, 400);
+    KisPaintDeviceSP dev = createTestDevice(imageRect);
+
+    // the table is taller than one strip, so the strips are carried over
+    const QRect tableRect(10, 5, 580, 390);
+    KisSummedAreaTable table(dev, tableRect);
+
+    QCOMPARE(table.rect(), tableRect);
+    QCOMPARE(table.channelCount(), 4);
+
+    const QVector<QRect> rects = {
+        QRect(10, 5, 1, 1),
+        QRect(10, 5, 580, 390),
+        QRect(35, 25, 20, 10),
+        QRect(240, 90, 300, 300),
+        QRect(495, 200, 95, 1),
+        QRect(100, 60, 1, 300)
+    };
+
+    Q_FOREACH (const QRect &rc, rects) {
+        for (int c = 0; c < 4; c++) {
+            const double expected = bruteForceSum(dev, rc, c);
+            QVERIFY2(qAbs(table.sum(c, rc) - expected) < 1e-3,
+                     QString("Different sum of channel %1 in (%2, %3, %4, %5): expected %6, got %7")
+                     .arg(c).arg(rc.x()).arg(rc.y()).arg(rc.width()).arg(rc.height())
+                     .arg(expected).arg(table.sum(c, rc)).toLatin1());
+        }
+    }
+}
+
+void KisSummedAreaTableTest::testMeanIsWeightedByOpacity()
+{
+    const QRect imageRect(0, 0, 100, 100);
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(imageRect));
+    dev->fill(QRect(0, 0, 50, 100), KoColor(Qt::red, cs));
+    dev->fill(QRect(50, 0, 50, 100), KoColor(QColor(0, 0, 255, 0), cs));
+
+    KisSummedAreaTable table(dev, imageRect);
+
+    // the transparent half doesn't change the color, only the opacity
+    KoColor mean(cs);
+    table.meanPixel(imageRect, mean.data());
+    QCOMPARE(mean.toQColor().rgb(), QColor(Qt::red).rgb());
+    QVERIFY(qAbs(mean.toQColor().alpha() - 128) <= 1);
+
+    table.meanPixel(QRect(10, 10, 20, 20), mean.data());
+    QCOMPARE(mean.toQColor(), QColor(Qt::red));
+
+    // a fully transparent area has no color
+    table.meanPixel(QRect(60, 10, 20, 20), mean.data());
+    QCOMPARE(mean.toQColor(), QColor(0, 0, 0, 0));
+}
+
+void KisSummedAreaTableTest::testRepeatedBorder()
+{
+    const QRect imageRect(0, 0, 100, 100);
+    KisPaintDeviceSP dev = createTestDevice(imageRect);
+    dev->fill(QRect(0, 0, 1, 1), KoColor(Qt::green, dev->colorSpace()));
+
+    const QRect tableRect = imageRect.adjusted(-10, -10, 10, 10);
+    const QRect dataRect = KisSummedAreaTable::repeatedBorderDataRect(dev, imageRect);
+    QCOMPARE(dataRect, imageRect);
+
+    KisSummedAreaTable table(dev, tableRect, dataRect);
+
+    // the corner pixel is repeated over the whole corner of the border
+    KoColor mean(dev->colorSpace());
+    table.meanPixel(QRect(-10, -10, 11, 11), mean.data());
+    QCOMPARE(mean.toQColor(), QColor(Qt::green));
+
+    // the rows of the border repeat the edge of the image
+    const int greenChannel = 1;
+    QCOMPARE(table.sum(greenChannel, QRect(-10, 0, 10, 1)), 10.0);
+    QCOMPARE(table.sum(greenChannel, QRect(0, 100, 1, 10)), bruteForceSum(dev, QRect(0, 99, 1, 1), greenChannel) * 10);
+}
+
+void KisSummedAreaTableTest::testFeatherWithBoxPasses()
+{
+    const QRect imageRect(0, 0, 300, 300);
+    const qint32 radius = 40;
+
+    KisPixelSelectionSP selection = new KisPixelSelection(new TestUtil::TestingTimedDefaultBounds(imageRect));
+    selection->select(QRect(80, 60, 120, 90));
+    selection->select(QRect(0, 240, 300, 60));
+
+    const QVector<qreal> expected = exactFeather(selection, imageRect, radius);
+
+    KisFeatherSelectionFilter filter(radius);
+    filter.process(selection, imageRect);
+
+    QVector<quint8> bytes(imageRect.width() * imageRect.height());
+    selection->readBytes(bytes.data(), imageRect);
+
+    qreal maxDifference = 0.0;
+    qreal meanDifference = 0.0;
+
+    for (int i = 0; i < bytes.size(); i++) {
+        const qreal difference = qAbs(bytes[i] - expected[i]) / MAX_SELECTED;
+        maxDifference = qMax(maxDifference, difference);
+        meanDifference += difference;
+    }
+    meanDifference /= bytes.size();
+
+    // the box passes are smoother than the gaussian cut at one sigma,
+    // but they should stay close to it everywhere
+    QVERIFY2(meanDifference < 0.025, QString("Mean difference is too big: %1").arg(meanDifference).toLatin1());
+    QVERIFY2(maxDifference < 0.08, QString("Max difference is too big: %1").arg(maxDifference).toLatin1());
+}
+
+KISTEST_MAIN(KisSummedAreaTableTest)
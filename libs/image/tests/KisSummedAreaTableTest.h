@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSUMMEDAREATABLETEST_H
+#define KISSUMMEDAREATABLETEST_H
+
+#include <simpletest.h>
+
+class KisSummedAreaTableTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testSumsMatchPixels();
+    void testMeanIsWeightedByOpacity();
+    void testRepeatedBorder();
+    void testFeatherWithBoxPasses();
+};
+
+#endif // KISSUMMEDAREATABLETEST_H
@@ -17,6 +17,7 @@
 #include "kis_group_layer.h"
 #include "kis_paint_device.h"
 #include "kis_paint_layer.h"
+#include "kis_layer_projection_plane.h"
 #include "kis_types.h"
 #include "kis_image.h"
 #include <KisGlobalResourcesInterface.h>
@@ -132,4 +133,60 @@ void KisFilterMaskTest::testProjectionSelectedTransparentPixels()
     }
 }
 
+void KisFilterMaskTest::testFusedMasks()
+{
+    TestUtil::MaskParent p(QRect(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT));
+    KisImageSP image = p.image;
+    KisPaintLayerSP layer = p.layer;
+
+    QImage qimage(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+    QImage inverted(QString(FILES_DATA_DIR) + '/' + "inverted_hakonepa.png");
+    layer->paintDevice()->convertFromQImage(qimage, 0, 0, 0);
+
+    KisFilterSP f = KisFilterRegistry::instance()->value("invert");
+    Q_ASSERT(f);
+    KisFilterConfigurationSP  kfc = f->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    Q_ASSERT(kfc);
+
+    const QRect leftHalf(0, 0, qimage.width() / 2, qimage.height());
+    const QRect rightHalf(leftHalf.right() + 1, 0, qimage.width() - leftHalf.width(), qimage.height());
+
+    /**
+     * Both masks are color transformations, so they are applied in
+     * one pass. The result should be the same as if they were applied
+     * one by one.
+     */
+    KisFilterMaskSP mask1 = new KisFilterMask(image, "mask1");
+    image->addNode(mask1, layer);
+    mask1->setFilter(kfc->cloneWithResourcesSnapshot());
+    mask1->createNodeProgressProxy();
+    mask1->initSelection(layer);
+    mask1->select(qimage.rect(), MAX_SELECTED);
+
+    KisFilterMaskSP mask2 = new KisFilterMask(image, "mask2");
+    image->addNode(mask2, layer);
+    mask2->setFilter(kfc->cloneWithResourcesSnapshot());
+    mask2->createNodeProgressProxy();
+    mask2->initSelection(layer);
+    mask2->select(qimage.rect(), MIN_SELECTED);
+    mask2->select(leftHalf, MAX_SELECTED);
+
+    layer->projectionPlane()->recalculate(qimage.rect(), layer, KisRenderPassFlag::None);
+
+    KisPaintDeviceSP projection = layer->projection();
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, qimage.copy(leftHalf),
+                                  projection->convertToQImage(0, leftHalf))) {
+        projection->convertToQImage(0, qimage.rect()).save("filtermasktest4.png");
+        QFAIL(QString("Failed to restore the original image, first different pixel: %1,%2 ").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+
+    if (!TestUtil::compareQImages(errpoint, inverted.copy(rightHalf),
+                                  projection->convertToQImage(0, rightHalf))) {
+        projection->convertToQImage(0, qimage.rect()).save("filtermasktest4.png");
+        QFAIL(QString("Failed to create inverted image, first different pixel: %1,%2 ").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 SIMPLE_TEST_MAIN(KisFilterMaskTest)
@@ -21,6 +21,7 @@
 #include <KoProgressUpdater.h>
 #include <KoUpdater.h>
 #include "testing_timed_default_bounds.h"
+#include "krita_utils.h"
 
 class TestFilter : public KisFilter
 {
@@ -238,4 +239,39 @@ void KisFilterTest::testBlurFilterApplicationRect()
 }
 
 
+void KisFilterTest::testParallelPatchesMatchSinglePass()
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QImage qimage(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+
+    KisPaintDeviceSP refDev = new KisPaintDevice(cs);
+    refDev->convertFromQImage(qimage, 0, 100, 300);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(*refDev);
+
+    KisFilterSP f = KisFilterRegistry::instance()->value("sharpen");
+    QVERIFY(f);
+    QVERIFY(f->supportsThreading());
+
+    KisFilterConfigurationSP kfc =
+        f->defaultConfiguration(KisGlobalResourcesInterface::instance())->cloneWithResourcesSnapshot();
+
+    /**
+     * The rect is not aligned to the patches, so the filter is
+     * split into the patches of different sizes, and every patch
+     * reads the original pixels of its neighbours
+     */
+    const QRect applyRect(113, 317, 600, 400);
+    QVERIFY(KritaUtils::splitRectIntoPatches(applyRect, KritaUtils::optimalPatchSize()).size() > 1);
+
+    f->processImpl(refDev, applyRect, kfc);
+    f->processImplInParallel(dev, applyRect, kfc);
+
+    QPoint errpoint;
+    if (!TestUtil::comparePaintDevices(errpoint, refDev, dev)) {
+        QFAIL(QString("Patch-parallel result differs at %1,%2").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 SIMPLE_TEST_MAIN(KisFilterTest)
@@ -208,6 +208,44 @@ void KisImageTest::testConvertImageColorSpace()
     image->waitForDone();
 }
 
+void KisImageTest::testConvertLayerColorSpaceWithJobs()
+{
+    const KoColorSpace *rgb8 = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *lab16 = KoColorSpaceRegistry::instance()->lab16();
+
+    QImage qimage(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+    KisImageSP image = new KisImage(0, qimage.width() + 20, qimage.height() + 20, rgb8, "stest");
+
+    KisPaintLayerSP paint1 = new KisPaintLayer(image, "paint1", OPACITY_OPAQUE_U8, rgb8);
+    // unalign with tile boundaries
+    paint1->paintDevice()->convertFromQImage(qimage, 0, 10, 10);
+
+    image->addNode(paint1, image->root());
+    image->initialRefreshGraph();
+
+    KisPaintDeviceSP refDev = new KisPaintDevice(*paint1->paintDevice());
+    refDev->convertTo(lab16);
+
+    /**
+     * The conversion is split into concurrent patch jobs, which are
+     * executed by the worker threads of the image
+     */
+    image->convertLayerColorSpace(paint1, lab16,
+                                  KoColorConversionTransformation::internalRenderingIntent(),
+                                  KoColorConversionTransformation::internalConversionFlags());
+    image->waitForDone();
+
+    QVERIFY(*lab16 == *paint1->colorSpace());
+    QVERIFY(*lab16 == *paint1->paintDevice()->colorSpace());
+    QCOMPARE(paint1->paintDevice()->pixelSize(), lab16->pixelSize());
+    QCOMPARE(paint1->paintDevice()->exactBounds(), QRect(10, 10, qimage.width(), qimage.height()));
+
+    QPoint errpoint;
+    if (!TestUtil::comparePaintDevices(errpoint, refDev, paint1->paintDevice())) {
+        QFAIL(QString("Converted pixels differ at %1,%2").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 void KisImageTest::testAssignImageProfile()
 {
     const KoColorSpace *rgb8 = KoColorSpaceRegistry::instance()->rgb8();
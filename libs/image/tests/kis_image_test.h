@@ -20,6 +20,7 @@ private Q_SLOTS:
     void benchmarkCreation();
     void testBlockLevelOfDetail();
     void testConvertImageColorSpace();
+    void testConvertLayerColorSpaceWithJobs();
     void testAssignImageProfile();
     void testGlobalSelection();
     void testCloneImage();
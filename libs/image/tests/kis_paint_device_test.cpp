@@ -31,6 +31,7 @@
 #include "config-limit-long-tests.h"
 #include "testimage.h"
 #include "kis_default_bounds.h"
+#include "KisFakeRunnableStrokeJobsExecutor.h"
 
 
 class KisFakePaintDeviceWriter : public KisPaintDeviceWriter {
@@ -285,6 +286,44 @@ void KisPaintDeviceTest::testColorSpaceConversion()
     delete cmd;
 }
 
+void KisPaintDeviceTest::testColorSpaceConversionWithJobs()
+{
+    QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+    const KoColorSpace* srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace* dstCs = KoColorSpaceRegistry::instance()->lab16();
+
+    KisPaintDeviceSP refDev = new KisPaintDevice(srcCs);
+    refDev->convertFromQImage(image, 0);
+    refDev->moveTo(10, 10);   // Unalign with tile boundaries
+
+    KisPaintDeviceSP dev = new KisPaintDevice(*refDev);
+
+    refDev->convertTo(dstCs);
+
+    KisFakeRunnableStrokeJobsExecutor executor;
+    KUndo2Command* cmd = new KUndo2Command();
+    dev->convertTo(dstCs,
+                   KoColorConversionTransformation::internalRenderingIntent(),
+                   KoColorConversionTransformation::internalConversionFlags(),
+                   cmd, nullptr, &executor);
+
+    QCOMPARE(dev->exactBounds(), QRect(10, 10, image.width(), image.height()));
+    QCOMPARE(dev->pixelSize(), dstCs->pixelSize());
+    QVERIFY(*dev->colorSpace() == *dstCs);
+
+    QPoint errpoint;
+    QVERIFY(TestUtil::comparePaintDevices(errpoint, refDev, dev));
+
+    cmd->redo();
+    cmd->undo();
+
+    QCOMPARE(dev->exactBounds(), QRect(10, 10, image.width(), image.height()));
+    QCOMPARE(dev->pixelSize(), srcCs->pixelSize());
+    QVERIFY(*dev->colorSpace() == *srcCs);
+
+    delete cmd;
+}
+
 
 void KisPaintDeviceTest::testRoundtripConversion()
 {
@@ -32,6 +32,7 @@ private Q_SLOTS:
     void testMakeClone();
     void testBltPerformance();
     void testColorSpaceConversion();
+    void testColorSpaceConversionWithJobs();
     void testDeviceDuplication();
     void testTranslate();
     void testOpacity();
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
 
+#include <QScopedPointer>
+
 #include "DebugPigment.h"
 #include "KoConfig.h"
 
@@ -24,6 +27,8 @@
 
 #include "KisDitherOp.h"
 #include "KisDitherMaths.h"
+#include "KisOptimizedDitherKernelFactory.h"
+#include "KoOptimizedPixelDataScalerFactory.h"
 
 template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class KisDitherOpImpl : public KisDitherOp
 {
@@ -35,6 +40,11 @@ public:
         : m_srcDepthId(srcId)
         , m_dstDepthId(dstId)
     {
+        if (dType != DITHER_NONE) {
+            m_rowKernel.reset(KisOptimizedDitherKernelFactory::create(srcId, dstId));
+        } else if (!std::is_same<srcCSTraits, dstCSTraits>::value) {
+            m_rowScaler.reset(KoOptimizedPixelDataScalerFactory::create(srcId, dstId, srcCSTraits::channels_nb));
+        }
     }
 
     void dither(const quint8 *src, quint8 *dst, int x, int y) const override
@@ -65,6 +75,23 @@ public:
 private:
     const KoID m_srcDepthId, m_dstDepthId;
 
+    /**
+     * Vectorized row kernel, it is present only for the ops that
+     * actually dither, i.e. that have an integer destination
+     */
+    QScopedPointer<KisOptimizedDitherKernelBase> m_rowKernel;
+
+    /**
+     * Vectorized depth conversion for the non-dithering ops
+     */
+    QScopedPointer<KoOptimizedPixelDataScalerBase> m_rowScaler;
+
+    /**
+     * Both dithering matrices are periodic with the period that divides
+     * 64 pixels, so the row kernel can use a 64-pixel pattern
+     */
+    static constexpr int rowPatternPixels = 64;
+
     template<DitherType t = dType, typename std::enable_if<t == DITHER_NONE && std::is_same<srcCSTraits, dstCSTraits>::value, void>::type * = nullptr> inline void ditherImpl(const quint8 *src, quint8 *dst, int, int) const
     {
         memcpy(dst, src, srcCSTraits::pixelSize);
@@ -113,6 +140,11 @@ private:
     template<DitherType t = dType, typename std::enable_if<t == DITHER_NONE && !std::is_same<srcCSTraits, dstCSTraits>::value, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int, int, int columns, int rows) const
     {
+        if (m_rowScaler) {
+            m_rowScaler->convert(srcRowStart, srcRowStride, dstRowStart, dstRowStride, rows, columns);
+            return;
+        }
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
@@ -142,6 +174,31 @@ private:
 
         float s = scale();
 
+        if (m_rowKernel) {
+            const int patternLength = rowPatternPixels * srcCSTraits::channels_nb;
+            float pattern[rowPatternPixels * srcCSTraits::channels_nb + KisOptimizedDitherKernelBase::patternPadding];
+
+            for (int a = 0; a < rows; ++a) {
+                for (int p = 0; p < rowPatternPixels; ++p) {
+                    const float f = factor(x + p, y + a);
+
+                    for (uint channelIndex = 0; channelIndex < srcCSTraits::channels_nb; ++channelIndex) {
+                        pattern[p * srcCSTraits::channels_nb + channelIndex] = f;
+                    }
+                }
+
+                std::copy(pattern, pattern + KisOptimizedDitherKernelBase::patternPadding, pattern + patternLength);
+
+                m_rowKernel->ditherRow(nativeSrc, nativeDst, columns * srcCSTraits::channels_nb,
+                                       pattern, patternLength, s);
+
+                nativeSrc += srcRowStride;
+                nativeDst += dstRowStride;
+            }
+
+            return;
+        }
+
         for (int a = 0; a < rows; ++a) {
             const srcChannelsType *srcPtr = srcCSTraits::nativeArray(nativeSrc);
             dstChannelsType *dstPtr = dstCSTraits::nativeArray(nativeDst);
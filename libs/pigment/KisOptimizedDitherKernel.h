@@ -0,0 +1,129 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERKERNEL_H
+#define KISOPTIMIZEDDITHERKERNEL_H
+
+#include "KisOptimizedDitherKernelBase.h"
+
+#include <limits>
+
+#include "KoMultiArchBuildSupport.h"
+#include "KoColorSpaceMaths.h"
+#include "KisDitherMaths.h"
+
+template<typename src_channel_type,
+         typename dst_channel_type,
+         typename _impl = xsimd::current_arch,
+         typename EnableDummyType = void>
+class KisOptimizedDitherKernel : public KisOptimizedDitherKernelBase
+{
+public:
+    static inline void ditherScalar(const src_channel_type *src, dst_channel_type *dst, int numValues,
+                                    const float *pattern, int patternOffset, int patternLength,
+                                    float scale)
+    {
+        for (int i = 0; i < numValues; i++) {
+            float c = KoColorSpaceMaths<src_channel_type, float>::scaleToA(src[i]);
+            c = KisDitherMaths::apply_dither(c, pattern[patternOffset], scale);
+            dst[i] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(c);
+
+            if (++patternOffset >= patternLength) {
+                patternOffset = 0;
+            }
+        }
+    }
+
+    void ditherRow(const quint8 *src, quint8 *dst, int numValues,
+                   const float *pattern, int patternLength,
+                   float scale) const override
+    {
+        ditherScalar(reinterpret_cast<const src_channel_type*>(src),
+                     reinterpret_cast<dst_channel_type*>(dst),
+                     numValues, pattern, 0, patternLength, scale);
+    }
+};
+
+#if !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+/**
+ * The vectorized version does exactly the same math as the scalar one,
+ * including the rounding mode of float2int(). The only difference may
+ * come from the compiler fusing the blending into an FMA, which changes
+ * the result by at most one step of the destination depth. Only integer
+ * destinations are supported, since floating point destinations are
+ * never dithered.
+ */
+template<typename src_channel_type, typename dst_channel_type, typename _impl>
+class KisOptimizedDitherKernel<src_channel_type, dst_channel_type, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value &&
+                                std::numeric_limits<dst_channel_type>::is_integer>::type>
+    : public KisOptimizedDitherKernelBase
+{
+    using float_v = xsimd::batch<float, _impl>;
+    using int_v = xsimd::batch<int, _impl>;
+
+    static inline float_v loadSource(const src_channel_type *src)
+    {
+        float values[float_v::size];
+        for (size_t i = 0; i < float_v::size; i++) {
+            values[i] = KoColorSpaceMaths<src_channel_type, float>::scaleToA(src[i]);
+        }
+        return float_v::load_unaligned(values);
+    }
+
+public:
+    void ditherRow(const quint8 *srcBytes, quint8 *dstBytes, int numValues,
+                   const float *pattern, int patternLength,
+                   float scale) const override
+    {
+        const src_channel_type *src = reinterpret_cast<const src_channel_type*>(srcBytes);
+        dst_channel_type *dst = reinterpret_cast<dst_channel_type*>(dstBytes);
+
+        const int vectorSize = static_cast<int>(float_v::size);
+        const int numBlocks = numValues / vectorSize;
+
+        const float_v scale_v(scale);
+        const float_v unitValue(float(KoColorSpaceMathsTraits<dst_channel_type>::unitValue));
+        const float_v zero(0.0f);
+        const float_v half(0.5f);
+
+        int patternOffset = 0;
+
+        for (int i = 0; i < numBlocks; i++) {
+            const float_v c = loadSource(src);
+            const float_v d = float_v::load_unaligned(pattern + patternOffset);
+
+            // the same expression as in KisDitherMaths::apply_dither()
+            const float_v dithered = c + (d - c) * scale_v;
+
+            const float_v v = xsimd::min(xsimd::max(dithered * unitValue, zero), unitValue);
+            const int_v result = xsimd::to_int(v + half);
+
+            int values[int_v::size];
+            result.store_unaligned(values);
+
+            for (size_t j = 0; j < int_v::size; j++) {
+                dst[j] = static_cast<dst_channel_type>(values[j]);
+            }
+
+            src += vectorSize;
+            dst += vectorSize;
+
+            patternOffset += vectorSize;
+            while (patternOffset >= patternLength) {
+                patternOffset -= patternLength;
+            }
+        }
+
+        KisOptimizedDitherKernel<src_channel_type, dst_channel_type, xsimd::generic>::ditherScalar(
+            src, dst, numValues % vectorSize, pattern, patternOffset, patternLength, scale);
+    }
+};
+
+#endif /* !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KISOPTIMIZEDDITHERKERNEL_H
@@ -0,0 +1,50 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERKERNELBASE_H
+#define KISOPTIMIZEDDITHERKERNELBASE_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Dithers a row of channel values while reducing the bit depth
+ *
+ * The kernel doesn't know anything about the pixel layout or the
+ * dithering matrix. It processes a flat array of channel values and
+ * takes the dithering factors from \p pattern, which is prepared by
+ * KisDitherOpImpl for every row: the factor of every pixel is repeated
+ * for all its channels.
+ *
+ * The actual implementation is placed in class `KisOptimizedDitherKernel`.
+ * To create a kernel, call KisOptimizedDitherKernelFactory, it will
+ * create a version optimized for your CPU architecture.
+ */
+class KRITAPIGMENT_EXPORT KisOptimizedDitherKernelBase
+{
+public:
+    /**
+     * The number of extra values that should follow the pattern in
+     * memory. They must repeat the beginning of the pattern, so that
+     * the kernel could read a full vector from any offset inside it.
+     */
+    static constexpr int patternPadding = 64;
+
+    virtual ~KisOptimizedDitherKernelBase();
+
+    /**
+     * Dithers \p numValues channel values from \p src into \p dst.
+     *
+     * Value `i` uses factor `pattern[i % patternLength]`.
+     * \p patternLength must be not less than \ref patternPadding.
+     * \p scale is the dithering strength, i.e. 1 / 2^dstDepth.
+     */
+    virtual void ditherRow(const quint8 *src, quint8 *dst, int numValues,
+                           const float *pattern, int patternLength,
+                           float scale) const = 0;
+};
+
+#endif // KISOPTIMIZEDDITHERKERNELBASE_H
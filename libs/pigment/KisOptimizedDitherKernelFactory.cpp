@@ -0,0 +1,42 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherKernelFactory.h"
+
+#include <KoColorModelStandardIdsUtils.h>
+
+#include "KisOptimizedDitherKernelFactoryImpl.h"
+
+template <typename src_channel_type>
+struct CreateDitherKernel
+{
+    KisOptimizedDitherKernelBase *operator() (const KoID &dstDepthId) {
+        if (dstDepthId == Integer8BitsColorDepthID) {
+            return createOptimizedClass<
+                KisOptimizedDitherKernelFactoryImpl<src_channel_type, quint8>>();
+        } else if (dstDepthId == Integer16BitsColorDepthID) {
+            return createOptimizedClass<
+                KisOptimizedDitherKernelFactoryImpl<src_channel_type, quint16>>();
+        }
+
+        return nullptr;
+    }
+};
+
+KisOptimizedDitherKernelBase *KisOptimizedDitherKernelFactory::create(const KoID &srcDepthId, const KoID &dstDepthId)
+{
+    if (srcDepthId != Integer8BitsColorDepthID &&
+        srcDepthId != Integer16BitsColorDepthID &&
+#ifdef HAVE_OPENEXR
+        srcDepthId != Float16BitsColorDepthID &&
+#endif
+        srcDepthId != Float32BitsColorDepthID) {
+
+        return nullptr;
+    }
+
+    return channelTypeForColorDepthId<CreateDitherKernel>(srcDepthId, dstDepthId);
+}
@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERKERNELFACTORY_H
+#define KISOPTIMIZEDDITHERKERNELFACTORY_H
+
+#include "kritapigment_export.h"
+#include <KoID.h>
+#include <KisOptimizedDitherKernelBase.h>
+
+/**
+ * \see KisOptimizedDitherKernelBase
+ */
+class KRITAPIGMENT_EXPORT KisOptimizedDitherKernelFactory
+{
+public:
+    /**
+     * @return a kernel for the pair of depths or nullptr if the
+     *         destination depth is not an integer one
+     */
+    static KisOptimizedDitherKernelBase* create(const KoID &srcDepthId, const KoID &dstDepthId);
+};
+
+#endif // KISOPTIMIZEDDITHERKERNELFACTORY_H
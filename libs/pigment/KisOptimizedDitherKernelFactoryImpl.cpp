@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherKernelFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KisOptimizedDitherKernel.h"
+
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+template<typename src_channel_type, typename dst_channel_type>
+template<typename _impl>
+KisOptimizedDitherKernelBase *
+KisOptimizedDitherKernelFactoryImpl<src_channel_type, dst_channel_type>::create()
+{
+    return new KisOptimizedDitherKernel<src_channel_type, dst_channel_type, _impl>();
+}
+
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint8,  quint8>::create<xsimd::current_arch>();
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint16, quint8>::create<xsimd::current_arch>();
+#ifdef HAVE_OPENEXR
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<half,    quint8>::create<xsimd::current_arch>();
+#endif
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<float,   quint8>::create<xsimd::current_arch>();
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint8,  quint16>::create<xsimd::current_arch>();
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<quint16, quint16>::create<xsimd::current_arch>();
+#ifdef HAVE_OPENEXR
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<half,    quint16>::create<xsimd::current_arch>();
+#endif
+template KisOptimizedDitherKernelBase* KisOptimizedDitherKernelFactoryImpl<float,   quint16>::create<xsimd::current_arch>();
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
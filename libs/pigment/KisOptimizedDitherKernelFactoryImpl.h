@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERKERNELFACTORYIMPL_H
+#define KISOPTIMIZEDDITHERKERNELFACTORYIMPL_H
+
+#include <KisOptimizedDitherKernelBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename src_channel_type, typename dst_channel_type>
+class KRITAPIGMENT_EXPORT KisOptimizedDitherKernelFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KisOptimizedDitherKernelBase *create();
+};
+
+#endif // KISOPTIMIZEDDITHERKERNELFACTORYIMPL_H
@@ -11,6 +11,8 @@
 #include <QMutexLocker>
 #include <QThreadStorage>
 
+#include <algorithm>
+
 #include <KoColorSpace.h>
 
 struct KoColorConversionCacheKey {
@@ -61,13 +63,108 @@ struct KoColorConversionCache::CachedTransformation {
     QAtomicInt use;
 };
 
-typedef QPair<KoColorConversionCacheKey, KoCachedColorConversionTransformation> FastPathCacheItem;
+/**
+ * A small per-thread front cache for the most recently used
+ * transformations. The lookup in the front cache doesn't take any locks
+ * and compares the color spaces by pointer only, so the worker threads
+ * don't contend on the shared cache mutex when converting pixels.
+ *
+ * The entries do not hold a reference to the cached transformation,
+ * instead the whole front cache is invalidated as soon as the shared
+ * epoch counter changes. The epoch is bumped before the shared cache
+ * deletes any transformation (i.e. when a color space is destroyed or
+ * a profile is changed).
+ */
+namespace {
+struct ThreadLocalCache {
+    static constexpr int size = 8;
+
+    struct Entry {
+        const KoColorSpace* src = nullptr;
+        const KoColorSpace* dst = nullptr;
+        KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::IntentPerceptual;
+        KoColorConversionTransformation::ConversionFlags conversionFlags;
+        KoColorConversionCache::CachedTransformation *transfo = nullptr;
+    };
+
+    KoColorConversionCache::CachedTransformation* find(const KoColorSpace* src,
+                                                       const KoColorSpace* dst,
+                                                       KoColorConversionTransformation::Intent renderingIntent,
+                                                       KoColorConversionTransformation::ConversionFlags conversionFlags)
+    {
+        for (int i = 0; i < numEntries; i++) {
+            const Entry &entry = entries[i];
+
+            if (entry.src == src && entry.dst == dst &&
+                entry.renderingIntent == renderingIntent &&
+                entry.conversionFlags == conversionFlags) {
+
+                KoColorConversionCache::CachedTransformation *transfo = entry.transfo;
+
+                // move the entry to the front to keep the hot
+                // transformations at the beginning of the list
+                if (i > 0) {
+                    std::rotate(entries, entries + i, entries + i + 1);
+                }
+
+                return transfo;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void insert(const KoColorSpace* src,
+                const KoColorSpace* dst,
+                KoColorConversionTransformation::Intent renderingIntent,
+                KoColorConversionTransformation::ConversionFlags conversionFlags,
+                KoColorConversionCache::CachedTransformation *transfo)
+    {
+        numEntries = qMin(numEntries + 1, size);
+        std::rotate(entries, entries + numEntries - 1, entries + numEntries);
+
+        Entry &entry = entries[0];
+        entry.src = src;
+        entry.dst = dst;
+        entry.renderingIntent = renderingIntent;
+        entry.conversionFlags = conversionFlags;
+        entry.transfo = transfo;
+    }
+
+    void clear() {
+        numEntries = 0;
+    }
+
+    Entry entries[size];
+    int numEntries = 0;
+    int epoch = 0;
+};
+}
 
 struct KoColorConversionCache::Private {
     QMultiHash< KoColorConversionCacheKey, CachedTransformation*> cache;
     QMutex cacheMutex;
 
-    QThreadStorage<FastPathCacheItem*> fastStorage;
+    QAtomicInt epoch;
+    QThreadStorage<ThreadLocalCache*> threadLocalCache;
+
+    ThreadLocalCache* localCache() {
+        ThreadLocalCache *cache = threadLocalCache.localData();
+
+        if (!cache) {
+            cache = new ThreadLocalCache();
+            cache->epoch = epoch.loadAcquire();
+            threadLocalCache.setLocalData(cache);
+        } else {
+            const int currentEpoch = epoch.loadAcquire();
+            if (cache->epoch != currentEpoch) {
+                cache->clear();
+                cache->epoch = currentEpoch;
+            }
+        }
+
+        return cache;
+    }
 };
 
 
@@ -88,18 +185,16 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
                                                                               KoColorConversionTransformation::Intent _renderingIntent,
                                                                               KoColorConversionTransformation::ConversionFlags _conversionFlags)
 {
-    KoColorConversionCacheKey key(src, dst, _renderingIntent, _conversionFlags);
+    ThreadLocalCache *localCache = d->localCache();
 
-    FastPathCacheItem *cacheItem =
-        d->fastStorage.localData();
+    CachedTransformation *cachedTransfo =
+        localCache->find(src, dst, _renderingIntent, _conversionFlags);
 
-    if (cacheItem) {
-        if (cacheItem->first == key) {
-            return cacheItem->second;
-        }
+    if (cachedTransfo) {
+        return KoCachedColorConversionTransformation(cachedTransfo);
     }
 
-    cacheItem = 0;
+    KoColorConversionCacheKey key(src, dst, _renderingIntent, _conversionFlags);
 
     QMutexLocker lock(&d->cacheMutex);
     QList< CachedTransformation* > cachedTransfos = d->cache.values(key);
@@ -108,26 +203,36 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
             ct->transfo->setSrcColorSpace(src);
             ct->transfo->setDstColorSpace(dst);
 
-            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
+            cachedTransfo = ct;
             break;
         }
     }
-    if (!cacheItem) {
+    if (!cachedTransfo) {
         KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
-        CachedTransformation* ct = new CachedTransformation(transfo);
-        d->cache.insert(key, ct);
-        cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(ct));
+        cachedTransfo = new CachedTransformation(transfo);
+        d->cache.insert(key, cachedTransfo);
     }
 
-    d->fastStorage.setLocalData(cacheItem);
-    return cacheItem->second;
+    /**
+     * The epoch could have been changed by another thread while we
+     * were waiting for the lock, but it cannot change while we hold it,
+     * so we add the entry only if the front cache is still valid.
+     */
+    if (localCache->epoch == d->epoch.loadAcquire()) {
+        localCache->insert(src, dst, _renderingIntent, _conversionFlags, cachedTransfo);
+    }
+
+    return KoCachedColorConversionTransformation(cachedTransfo);
 }
 
 void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
 {
-    d->fastStorage.setLocalData(0);
-
     QMutexLocker lock(&d->cacheMutex);
+
+    // invalidate the front caches of all the threads before
+    // deleting anything they could point to
+    d->epoch.fetchAndAddOrdered(1);
+
     QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator endIt = d->cache.end();
     for (QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator it = d->cache.begin(); it != endIt;) {
         if (it.key().src == cs || it.key().dst == cs) {
@@ -140,6 +245,11 @@ void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
     }
 }
 
+void KoColorConversionCache::invalidateThreadLocalCaches()
+{
+    d->epoch.fetchAndAddOrdered(1);
+}
+
 //--------- KoCachedColorConversionTransformation ----------//
 
 KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(KoColorConversionCache::CachedTransformation* transfo)
@@ -45,6 +45,15 @@ public:
      * @param src source color space
      */
     void colorSpaceIsDestroyed(const KoColorSpace* src);
+
+    /**
+     * Drops the per-thread front caches of all the threads. The threads
+     * will refetch the transformations from the shared cache on the next
+     * call to cachedConverter(). Should be called when a profile is added
+     * or removed, so that the threads don't keep using a transformation
+     * for a stale color space pointer.
+     */
+    void invalidateThreadLocalCaches();
 private:
     struct Private;
     Private* const d;
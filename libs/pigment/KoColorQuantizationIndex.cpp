@@ -0,0 +1,316 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoColorQuantizationIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVarLengthArray>
+#include <QWeakPointer>
+
+#include <kis_assert.h>
+#include <kis_global.h>
+
+namespace {
+
+/**
+ * The grid has up to 32 cells along every axis. Finer grids don't
+ * decrease the number of candidates much, but take more time to build.
+ */
+constexpr int maxGridBits = 5;
+
+struct SharedIndexCache
+{
+    QMutex mutex;
+    QHash<QByteArray, QWeakPointer<const KoColorQuantizationIndex>> indexes;
+};
+
+Q_GLOBAL_STATIC(SharedIndexCache, s_indexCache)
+
+inline void computeDistances(const float *x, const float *y, const float *z, int numCandidates,
+                             float qx, float qy, float qz, float *result)
+{
+    for (int i = 0; i < numCandidates; i++) {
+        const float dx = x[i] - qx;
+        const float dy = y[i] - qy;
+        const float dz = z[i] - qz;
+        result[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+inline int findMinimum(const float *distances, int numCandidates)
+{
+    int best = 0;
+    for (int i = 1; i < numCandidates; i++) {
+        if (distances[i] < distances[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+}
+
+KoColorQuantizationIndex::KoColorQuantizationIndex(const QVector<quint16> &coordinates,
+                                                   int maxNeighbours,
+                                                   const QVector3D &weights)
+    : m_size(coordinates.size() / 3)
+    , m_maxNeighbours(qMax(1, maxNeighbours))
+    , m_weights(weights)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(coordinates.size() % 3 == 0);
+    buildGrid(coordinates);
+}
+
+QSharedPointer<const KoColorQuantizationIndex>
+KoColorQuantizationIndex::fromCache(const QVector<quint16> &coordinates,
+                                    int maxNeighbours,
+                                    const QVector3D &weights)
+{
+    QByteArray key(reinterpret_cast<const char*>(coordinates.constData()),
+                   coordinates.size() * int(sizeof(quint16)));
+    key += '|' + QByteArray::number(maxNeighbours);
+    key += '|' + QByteArray::number(weights.x());
+    key += '|' + QByteArray::number(weights.y());
+    key += '|' + QByteArray::number(weights.z());
+
+    QMutexLocker l(&s_indexCache->mutex);
+
+    QSharedPointer<const KoColorQuantizationIndex> index =
+        s_indexCache->indexes.value(key).toStrongRef();
+
+    if (!index) {
+        index.reset(new KoColorQuantizationIndex(coordinates, maxNeighbours, weights));
+
+        auto it = s_indexCache->indexes.begin();
+        while (it != s_indexCache->indexes.end()) {
+            it = it->isNull() ? s_indexCache->indexes.erase(it) : std::next(it);
+        }
+
+        s_indexCache->indexes.insert(key, index.toWeakRef());
+    }
+
+    return index;
+}
+
+int KoColorQuantizationIndex::size() const
+{
+    return m_size;
+}
+
+int KoColorQuantizationIndex::maxNeighbours() const
+{
+    return m_maxNeighbours;
+}
+
+void KoColorQuantizationIndex::buildGrid(const QVector<quint16> &coordinates)
+{
+    if (!m_size) return;
+
+    int gridBits = 0;
+    const double targetGridSize = 4.0 * std::cbrt(double(m_size));
+    while (gridBits < maxGridBits && (1 << gridBits) < targetGridSize) {
+        gridBits++;
+    }
+
+    m_gridSize = 1 << gridBits;
+    m_gridShift = 16 - gridBits;
+
+    const int cellWidth = 1 << m_gridShift;
+    const float weights[3] = {m_weights.x(), m_weights.y(), m_weights.z()};
+
+    /**
+     * The distance from a cell to an entry is the sum of the per-axis
+     * terms, so the terms are precomputed for every slab of the grid
+     * along every axis
+     */
+    QVector<double> minTerms[3];
+    QVector<double> maxTerms[3];
+
+    for (int axis = 0; axis < 3; axis++) {
+        minTerms[axis].resize(m_gridSize * m_size);
+        maxTerms[axis].resize(m_gridSize * m_size);
+
+        for (int slab = 0; slab < m_gridSize; slab++) {
+            const double lo = slab * cellWidth;
+            const double hi = lo + cellWidth - 1;
+
+            for (int i = 0; i < m_size; i++) {
+                const double value = coordinates[3 * i + axis];
+                const double outside = value < lo ? lo - value : value > hi ? value - hi : 0.0;
+                const double farthest = qMax(value - lo, hi - value);
+
+                minTerms[axis][slab * m_size + i] = pow2(weights[axis] * outside);
+                maxTerms[axis][slab * m_size + i] = pow2(weights[axis] * farthest);
+            }
+        }
+    }
+
+    const int numNeighbours = qMin(m_maxNeighbours, m_size);
+
+    QVector<double> minDistances(m_size);
+    QVector<double> maxDistances(m_size);
+    QVector<double> smallestMaxDistances(numNeighbours);
+
+    m_cells.resize(m_gridSize * m_gridSize * m_gridSize);
+
+    int cellIndex = 0;
+    for (int iz = 0; iz < m_gridSize; iz++) {
+        for (int iy = 0; iy < m_gridSize; iy++) {
+            for (int ix = 0; ix < m_gridSize; ix++, cellIndex++) {
+                const double *minX = minTerms[0].constData() + ix * m_size;
+                const double *minY = minTerms[1].constData() + iy * m_size;
+                const double *minZ = minTerms[2].constData() + iz * m_size;
+                const double *maxX = maxTerms[0].constData() + ix * m_size;
+                const double *maxY = maxTerms[1].constData() + iy * m_size;
+                const double *maxZ = maxTerms[2].constData() + iz * m_size;
+
+                for (int i = 0; i < m_size; i++) {
+                    minDistances[i] = minX[i] + minY[i] + minZ[i];
+                    maxDistances[i] = maxX[i] + maxY[i] + maxZ[i];
+                }
+
+                /**
+                 * Every point of the cell has at least numNeighbours
+                 * entries within the threshold, so the entries further
+                 * from the cell can never be among the nearest ones.
+                 * The threshold is slightly relaxed to be on the safe
+                 * side of the rounding in the float distances.
+                 */
+                std::fill(smallestMaxDistances.begin(), smallestMaxDistances.end(),
+                          std::numeric_limits<double>::max());
+
+                for (int i = 0; i < m_size; i++) {
+                    double distance = maxDistances[i];
+                    for (int n = 0; n < numNeighbours; n++) {
+                        if (distance < smallestMaxDistances[n]) {
+                            std::swap(distance, smallestMaxDistances[n]);
+                        }
+                    }
+                }
+
+                const double threshold = smallestMaxDistances[numNeighbours - 1] * (1.0 + 1e-5) + 1.0;
+
+                m_cells[cellIndex].begin = m_indices.size();
+
+                for (int i = 0; i < m_size; i++) {
+                    if (minDistances[i] <= threshold) {
+                        m_x.append(weights[0] * coordinates[3 * i]);
+                        m_y.append(weights[1] * coordinates[3 * i + 1]);
+                        m_z.append(weights[2] * coordinates[3 * i + 2]);
+                        m_indices.append(i);
+                    }
+                }
+
+                m_cells[cellIndex].end = m_indices.size();
+            }
+        }
+    }
+}
+
+const KoColorQuantizationIndex::CellRange& KoColorQuantizationIndex::cellFor(const quint16 *color) const
+{
+    const int ix = color[0] >> m_gridShift;
+    const int iy = color[1] >> m_gridShift;
+    const int iz = color[2] >> m_gridShift;
+
+    return m_cells[(iz * m_gridSize + iy) * m_gridSize + ix];
+}
+
+int KoColorQuantizationIndex::nearest(const quint16 *color) const
+{
+    int index = -1;
+    nearest(color, 1, &index, nullptr);
+    return index;
+}
+
+int KoColorQuantizationIndex::nearest(const quint16 *color, int count, int *indices, float *distances) const
+{
+    count = qMin(count, qMin(m_maxNeighbours, m_size));
+    if (count <= 0) return 0;
+
+    const CellRange &cell = cellFor(color);
+    const int numCandidates = cell.end - cell.begin;
+
+    QVarLengthArray<float, 64> candidateDistances(numCandidates);
+    computeDistances(m_x.constData() + cell.begin,
+                     m_y.constData() + cell.begin,
+                     m_z.constData() + cell.begin,
+                     numCandidates,
+                     m_weights.x() * color[0],
+                     m_weights.y() * color[1],
+                     m_weights.z() * color[2],
+                     candidateDistances.data());
+
+    QVarLengthArray<int, 4> best;
+    QVarLengthArray<float, 4> bestDistances;
+
+    for (int i = 0; i < numCandidates; i++) {
+        const float distance = candidateDistances[i];
+
+        int pos = best.size();
+        while (pos > 0 && distance < bestDistances[pos - 1]) {
+            pos--;
+        }
+
+        if (pos >= count) continue;
+
+        best.insert(pos, cell.begin + i);
+        bestDistances.insert(pos, distance);
+
+        if (best.size() > count) {
+            best.removeLast();
+            bestDistances.removeLast();
+        }
+    }
+
+    for (int i = 0; i < best.size(); i++) {
+        indices[i] = m_indices[best[i]];
+        if (distances) {
+            distances[i] = std::sqrt(bestDistances[i]);
+        }
+    }
+
+    return best.size();
+}
+
+void KoColorQuantizationIndex::nearestBatch(const quint16 *colors, int stride, int numColors, int *indices) const
+{
+    if (!m_size) {
+        std::fill(indices, indices + numColors, -1);
+        return;
+    }
+
+    QVarLengthArray<float, 64> candidateDistances;
+
+    for (int i = 0; i < numColors; i++, colors += stride) {
+        const CellRange &cell = cellFor(colors);
+        const int numCandidates = cell.end - cell.begin;
+
+        if (numCandidates == 1) {
+            indices[i] = m_indices[cell.begin];
+            continue;
+        }
+
+        candidateDistances.resize(numCandidates);
+        computeDistances(m_x.constData() + cell.begin,
+                         m_y.constData() + cell.begin,
+                         m_z.constData() + cell.begin,
+                         numCandidates,
+                         m_weights.x() * colors[0],
+                         m_weights.y() * colors[1],
+                         m_weights.z() * colors[2],
+                         candidateDistances.data());
+
+        indices[i] = m_indices[cell.begin + findMinimum(candidateDistances.constData(), numCandidates)];
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOCOLORQUANTIZATIONINDEX_H
+#define KOCOLORQUANTIZATIONINDEX_H
+
+#include <QSharedPointer>
+#include <QVector3D>
+#include <QVector>
+
+#include "kritapigment_export.h"
+
+/**
+ * @brief Looks up the nearest palette entries for the colors
+ *
+ * The entries are points with three 16-bit coordinates in the search
+ * space of the palette (e.g. the L, a, b channels of Lab16). The
+ * distance between the colors is euclidean with an optional weight
+ * for every axis.
+ *
+ * The search space is split into a dense grid of cells. For every
+ * cell the index precomputes the list of the entries that may be
+ * among the nearest ones for at least one point of the cell: the
+ * entries whose distance to the cell is not greater than the largest
+ * distance from the cell to the closest entry. A lookup only refines
+ * the result among these candidates. Most of the cells far from the
+ * cell boundaries of the Voronoi diagram have a single candidate.
+ *
+ * The distances are compared as floats. When several entries are at
+ * the same distance, the one with the lowest index wins, the same as
+ * with a linear scan. For colors almost exactly in the middle between
+ * two entries the float rounding may pick the other one of them than
+ * an exact (or an R-tree) search would.
+ *
+ * The index is immutable and can be used from several threads at once.
+ */
+class KRITAPIGMENT_EXPORT KoColorQuantizationIndex
+{
+public:
+    /**
+     * Creates an index of the entries \p coordinates (three values per
+     * entry) that can look up up to \p maxNeighbours nearest entries
+     * at once.
+     */
+    KoColorQuantizationIndex(const QVector<quint16> &coordinates,
+                             int maxNeighbours = 1,
+                             const QVector3D &weights = QVector3D(1.0f, 1.0f, 1.0f));
+
+    /**
+     * Building the grid takes a noticeable time for large palettes, so
+     * the filters that are applied to every patch or every frame share
+     * the indexes through this method. The index is kept while someone
+     * holds a reference to it.
+     */
+    static QSharedPointer<const KoColorQuantizationIndex> fromCache(const QVector<quint16> &coordinates,
+                                                                    int maxNeighbours = 1,
+                                                                    const QVector3D &weights = QVector3D(1.0f, 1.0f, 1.0f));
+
+    int size() const;
+    int maxNeighbours() const;
+
+    /**
+     * @return the index of the entry nearest to \p color or -1 if the
+     *         index is empty
+     */
+    int nearest(const quint16 *color) const;
+
+    /**
+     * Finds \p count nearest entries to \p color (at most
+     * maxNeighbours()) and writes their indices and distances into
+     * \p indices and \p distances in the order of increasing distance.
+     * \p distances may be null.
+     *
+     * @return the number of the entries found
+     */
+    int nearest(const quint16 *color, int count, int *indices, float *distances) const;
+
+    /**
+     * Looks up the nearest entries for \p numColors colors. The color
+     * coordinates are the first three values of every \p stride values
+     * of \p colors, so the pixels of a 16-bit color space can be passed
+     * directly.
+     */
+    void nearestBatch(const quint16 *colors, int stride, int numColors, int *indices) const;
+
+private:
+    struct CellRange {
+        int begin;
+        int end;
+    };
+
+    const CellRange& cellFor(const quint16 *color) const;
+    void buildGrid(const QVector<quint16> &coordinates);
+
+private:
+    int m_size {0};
+    int m_maxNeighbours {1};
+    QVector3D m_weights;
+    int m_gridShift {16};
+    int m_gridSize {1};
+
+    QVector<CellRange> m_cells;
+
+    /**
+     * The candidates of all the cells, stored as structure of arrays
+     * so that the distance loop over the candidates of a cell gets
+     * vectorized
+     */
+    QVector<float> m_x;
+    QVector<float> m_y;
+    QVector<float> m_z;
+    QVector<int> m_indices;
+};
+
+#endif // KOCOLORQUANTIZATIONINDEX_H
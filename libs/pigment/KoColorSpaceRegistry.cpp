@@ -317,6 +317,10 @@ void KoColorSpaceRegistry::addProfile(KoColorProfile *p)
     if (p->valid()) {
         addProfileToMap(p);
         d->colorConversionSystem->insertColorProfile(p);
+
+        if (d->colorConversionCache) {
+            d->colorConversionCache->invalidateThreadLocalCaches();
+        }
     }
 }
 
@@ -329,6 +333,10 @@ void KoColorSpaceRegistry::removeProfile(KoColorProfile* profile)
 {
     d->profileStorage.removeProfile(profile);
     // FIXME: how about removing it from conversion system?
+
+    if (d->colorConversionCache) {
+        d->colorConversionCache->invalidateThreadLocalCaches();
+    }
 }
 
 const KoColorSpace* KoColorSpaceRegistry::Private::getCachedColorSpaceImpl(const QString & csID, const QString & profileName) const
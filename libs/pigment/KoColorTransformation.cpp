@@ -31,6 +31,11 @@ void KoColorTransformation::setParameter(int id, const QVariant& parameter)
     qFatal("No parameter for this transformation");
 }
 
+KoColorTransformation::PixelDependency KoColorTransformation::pixelDependency() const
+{
+    return ArbitraryDependency;
+}
+
 void KoColorTransformation::setParameters(const QHash<QString, QVariant> & parameters)
 {
     for (QHash<QString, QVariant>::const_iterator it = parameters.begin(); it != parameters.end(); ++it) {
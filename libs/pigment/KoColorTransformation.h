@@ -32,6 +32,26 @@ class QVariant;
  */
 class KRITAPIGMENT_EXPORT KoColorTransformation
 {
+public:
+    /**
+     * Describes which input channels every output channel depends on.
+     * The values are ordered from the most generic to the most
+     * restrictive one, so the dependency of a chain of
+     * transformations is the minimum of the dependencies of its
+     * members.
+     *
+     * \see KoColorTransformationLutCompiler
+     */
+    enum PixelDependency {
+        /// any output channel may depend on any input channel
+        ArbitraryDependency = 0,
+        /// color channels depend on color channels only and the
+        /// alpha channel depends on the alpha channel only
+        ColorDependency,
+        /// every output channel depends on the same input channel only
+        ChannelwiseDependency
+    };
+
 public:
     virtual ~KoColorTransformation();
     /**
@@ -64,6 +84,16 @@ public:
 
     /// @return true
     virtual bool isValid() const { return true; }
+
+    /**
+     * @return the dependency between the input and output channels
+     * of the transformation. The transformations that can guarantee
+     * something stronger than ArbitraryDependency can be baked into
+     * lookup tables by KoColorTransformationLutCompiler.
+     *
+     * The default implementation returns ArbitraryDependency.
+     */
+    virtual PixelDependency pixelDependency() const;
 };
 
 #endif
@@ -0,0 +1,278 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoColorTransformationLutCompiler.h"
+
+#include <algorithm>
+
+#include <QScopedPointer>
+
+#include "KoColorModelStandardIds.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceMaths.h"
+#include "KoColorTransformation.h"
+#include "KoOptimizedColorLut3DFactory.h"
+
+namespace {
+
+enum LutMode {
+    NoLut,
+    ChannelwiseLut,
+    ColorLut3D
+};
+
+LutMode lutModeForChain(const KoColorSpace *cs,
+                        const QVector<const KoColorTransformation*> &transformations,
+                        bool allowApproximation)
+{
+    if (transformations.isEmpty()) return NoLut;
+
+    if (cs->colorDepthId() != Integer8BitsColorDepthID &&
+        cs->colorDepthId() != Integer16BitsColorDepthID) {
+
+        return NoLut;
+    }
+
+    KoColorTransformation::PixelDependency dependency = KoColorTransformation::ChannelwiseDependency;
+
+    Q_FOREACH (const KoColorTransformation *t, transformations) {
+        if (!t) return NoLut;
+        dependency = qMin(dependency, t->pixelDependency());
+    }
+
+    if (dependency == KoColorTransformation::ChannelwiseDependency) {
+        return ChannelwiseLut;
+    }
+
+    if (dependency == KoColorTransformation::ColorDependency &&
+        allowApproximation &&
+        cs->channelCount() == 4 &&
+        cs->alphaPos() == 3) {
+
+        return ColorLut3D;
+    }
+
+    return NoLut;
+}
+
+void applyChain(const QVector<const KoColorTransformation*> &transformations,
+                const quint8 *src, quint8 *dst, int numPixels)
+{
+    for (int i = 0; i < transformations.size(); i++) {
+        transformations[i]->transform(i == 0 ? src : dst, dst, numPixels);
+    }
+}
+
+template <typename channels_type>
+int numChannelValues()
+{
+    return int(KoColorSpaceMathsTraits<channels_type>::unitValue) + 1;
+}
+
+/**
+ * Every channel is looked up in its own table. The table is just the
+ * result of the chain applied to the pixels of the form (v, v, ..., v),
+ * so the value of channel `c` is found at `table[v * channelCount + c]`.
+ */
+template <typename channels_type>
+class KoChannelwiseLutTransformation : public KoColorTransformation
+{
+public:
+    KoChannelwiseLutTransformation(const KoColorSpace *cs,
+                                   const QVector<const KoColorTransformation*> &transformations)
+        : m_channelCount(cs->channelCount())
+    {
+        const int numValues = numChannelValues<channels_type>();
+
+        QVector<channels_type> probes(numValues * m_channelCount);
+        for (int v = 0; v < numValues; v++) {
+            std::fill_n(probes.data() + v * m_channelCount, m_channelCount, channels_type(v));
+        }
+
+        m_table.resize(probes.size());
+        applyChain(transformations,
+                   reinterpret_cast<const quint8*>(probes.constData()),
+                   reinterpret_cast<quint8*>(m_table.data()),
+                   numValues);
+    }
+
+    void transform(const quint8 *srcU8, quint8 *dstU8, qint32 nPixels) const override
+    {
+        const channels_type *src = reinterpret_cast<const channels_type*>(srcU8);
+        channels_type *dst = reinterpret_cast<channels_type*>(dstU8);
+        const channels_type *table = m_table.constData();
+
+        const int numValues = nPixels * m_channelCount;
+
+        for (int i = 0; i < numValues; i += m_channelCount) {
+            for (int c = 0; c < m_channelCount; c++) {
+                dst[i + c] = table[src[i + c] * m_channelCount + c];
+            }
+        }
+    }
+
+    PixelDependency pixelDependency() const override
+    {
+        return ChannelwiseDependency;
+    }
+
+private:
+    const int m_channelCount;
+    QVector<channels_type> m_table;
+};
+
+/**
+ * The color channels are interpolated in a 3D LUT, sampled with the
+ * alpha channel set to the unit value, and the alpha channel is looked
+ * up in a 1D table. The table is omitted when the chain keeps the alpha
+ * channel untouched, which is the most common case.
+ */
+template <typename channels_type>
+class KoColorLut3DTransformation : public KoColorTransformation
+{
+public:
+    KoColorLut3DTransformation(const KoColorSpace *cs,
+                               const QVector<const KoColorTransformation*> &transformations,
+                               int gridSize)
+        : m_gridSize(gridSize)
+        , m_applicator(KoOptimizedColorLut3DFactory::create(cs->colorDepthId()))
+    {
+        const channels_type unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+        const int step = int(unitValue) / (gridSize - 1);
+        const int numNodes = gridSize * gridSize * gridSize;
+
+        QVector<channels_type> probes(numNodes * 4);
+        channels_type *probe = probes.data();
+
+        for (int i2 = 0; i2 < gridSize; i2++) {
+            for (int i1 = 0; i1 < gridSize; i1++) {
+                for (int i0 = 0; i0 < gridSize; i0++) {
+                    probe[0] = channels_type(i0 * step);
+                    probe[1] = channels_type(i1 * step);
+                    probe[2] = channels_type(i2 * step);
+                    probe[3] = unitValue;
+                    probe += 4;
+                }
+            }
+        }
+
+        QVector<channels_type> result(probes.size());
+        applyChain(transformations,
+                   reinterpret_cast<const quint8*>(probes.constData()),
+                   reinterpret_cast<quint8*>(result.data()),
+                   numNodes);
+
+        m_lut.resize(numNodes * 3);
+        for (int i = 0; i < numNodes; i++) {
+            for (int c = 0; c < 3; c++) {
+                m_lut[i * 3 + c] = KoColorSpaceMaths<channels_type, float>::scaleToA(result[i * 4 + c]);
+            }
+        }
+
+        const int numValues = numChannelValues<channels_type>();
+
+        QVector<channels_type> alphaProbes(numValues * 4, channels_type(0));
+        for (int v = 0; v < numValues; v++) {
+            alphaProbes[v * 4 + 3] = channels_type(v);
+        }
+
+        QVector<channels_type> alphaResult(alphaProbes.size());
+        applyChain(transformations,
+                   reinterpret_cast<const quint8*>(alphaProbes.constData()),
+                   reinterpret_cast<quint8*>(alphaResult.data()),
+                   numValues);
+
+        bool alphaIsPreserved = true;
+        for (int v = 0; v < numValues; v++) {
+            if (alphaResult[v * 4 + 3] != channels_type(v)) {
+                alphaIsPreserved = false;
+                break;
+            }
+        }
+
+        if (!alphaIsPreserved) {
+            m_alphaTable.resize(numValues);
+            for (int v = 0; v < numValues; v++) {
+                m_alphaTable[v] = alphaResult[v * 4 + 3];
+            }
+        }
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override
+    {
+        m_applicator->apply(src, dst, nPixels, m_lut.constData(), m_gridSize);
+
+        if (!m_alphaTable.isEmpty()) {
+            channels_type *pixel = reinterpret_cast<channels_type*>(dst);
+            const channels_type *table = m_alphaTable.constData();
+
+            for (int i = 0; i < nPixels; i++) {
+                pixel[3] = table[pixel[3]];
+                pixel += 4;
+            }
+        }
+    }
+
+    PixelDependency pixelDependency() const override
+    {
+        return ColorDependency;
+    }
+
+private:
+    const int m_gridSize;
+    QScopedPointer<KoOptimizedColorLut3DBase> m_applicator;
+    QVector<float> m_lut;
+    QVector<channels_type> m_alphaTable;
+};
+
+template <typename channels_type>
+KoColorTransformation* compileForChannelType(const KoColorSpace *cs,
+                                             const QVector<const KoColorTransformation*> &transformations,
+                                             LutMode mode)
+{
+    if (mode == ChannelwiseLut) {
+        return new KoChannelwiseLutTransformation<channels_type>(cs, transformations);
+    } else if (mode == ColorLut3D) {
+        return new KoColorLut3DTransformation<channels_type>(cs, transformations,
+                                                            KoColorTransformationLutCompiler::gridSize3D);
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
+qint64 KoColorTransformationLutCompiler::compilationCost(const KoColorSpace *cs,
+                                                         const QVector<const KoColorTransformation*> &transformations,
+                                                         bool allowApproximation)
+{
+    const LutMode mode = lutModeForChain(cs, transformations, allowApproximation);
+    const qint64 numValues = cs->colorDepthId() == Integer8BitsColorDepthID ?
+        numChannelValues<quint8>() : numChannelValues<quint16>();
+
+    if (mode == ChannelwiseLut) {
+        return numValues;
+    } else if (mode == ColorLut3D) {
+        return qint64(gridSize3D) * gridSize3D * gridSize3D + numValues;
+    }
+
+    return -1;
+}
+
+KoColorTransformation* KoColorTransformationLutCompiler::compile(const KoColorSpace *cs,
+                                                                 const QVector<const KoColorTransformation*> &transformations,
+                                                                 bool allowApproximation)
+{
+    const LutMode mode = lutModeForChain(cs, transformations, allowApproximation);
+
+    if (cs->colorDepthId() == Integer8BitsColorDepthID) {
+        return compileForChannelType<quint8>(cs, transformations, mode);
+    } else if (cs->colorDepthId() == Integer16BitsColorDepthID) {
+        return compileForChannelType<quint16>(cs, transformations, mode);
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,79 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOCOLORTRANSFORMATIONLUTCOMPILER_H
+#define KOCOLORTRANSFORMATIONLUTCOMPILER_H
+
+#include <QVector>
+
+#include "kritapigment_export.h"
+
+class KoColorSpace;
+class KoColorTransformation;
+
+/**
+ * @brief Bakes a chain of color transformations into lookup tables
+ *
+ * Most of the adjustment filters run rather heavy math for every pixel
+ * (HSV conversions, pow(), LCMS curves), though the result depends on
+ * the color of the pixel only. KoColorTransformationLutCompiler
+ * samples such a chain once and returns a transformation that only
+ * looks the result up:
+ *
+ * - when every member of the chain reports
+ *   KoColorTransformation::ChannelwiseDependency, the chain is
+ *   baked into a 1D table per channel. The result is exactly the
+ *   same as the one of the original chain;
+ *
+ * - when the members report KoColorTransformation::ColorDependency,
+ *   the color channels are baked into a 3D LUT with trilinear
+ *   interpolation (see KoOptimizedColorLut3DBase) and the alpha
+ *   channel into a 1D table. The result is an approximation.
+ *   This mode is supported only for 4-channel color spaces with the
+ *   alpha channel placed last.
+ *
+ * Only 8- and 16-bit integer color spaces are supported, since
+ * floating point values are not bounded.
+ *
+ * The compiled transformation owns no references to the original chain
+ * and can be used from several threads at once.
+ */
+class KRITAPIGMENT_EXPORT KoColorTransformationLutCompiler
+{
+public:
+    /**
+     * @return the number of pixels the chain of \p transformations
+     *         should process to build the tables, or -1 if the chain
+     *         cannot be compiled for \p cs. The callers can compare it
+     *         with the size of the area they are going to process to
+     *         decide if the compilation is worth it.
+     */
+    static qint64 compilationCost(const KoColorSpace *cs,
+                                  const QVector<const KoColorTransformation*> &transformations,
+                                  bool allowApproximation = true);
+
+    /**
+     * @return a transformation equivalent to sequential application of
+     *         \p transformations, or nullptr if the chain cannot be
+     *         compiled for \p cs. The transformations are used only
+     *         during the call, the result doesn't keep them.
+     *
+     * \p allowApproximation allows to use a 3D LUT for the chains
+     * that are not channelwise
+     */
+    static KoColorTransformation* compile(const KoColorSpace *cs,
+                                          const QVector<const KoColorTransformation*> &transformations,
+                                          bool allowApproximation = true);
+
+    /**
+     * The number of the nodes of the 3D LUT along every axis. The
+     * distance between the nodes is an integer both for 8- and 16-bit
+     * channels, so the nodes are sampled exactly.
+     */
+    static const int gridSize3D = 52;
+};
+
+#endif // KOCOLORTRANSFORMATIONLUTCOMPILER_H
@@ -52,6 +52,17 @@ void KoCompositeColorTransformation::transform(const quint8 *src, quint8 *dst, q
     }
 }
 
+KoColorTransformation::PixelDependency KoCompositeColorTransformation::pixelDependency() const
+{
+    PixelDependency dependency = ChannelwiseDependency;
+
+    Q_FOREACH (const KoColorTransformation *t, m_d->transformations) {
+        dependency = qMin(dependency, t->pixelDependency());
+    }
+
+    return dependency;
+}
+
 KoColorTransformation* KoCompositeColorTransformation::createOptimizedCompositeTransform(const QVector<KoColorTransformation*> transforms)
 {
     KoColorTransformation *finalTransform = 0;
@@ -43,6 +43,8 @@ public:
 
     void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override;
 
+    PixelDependency pixelDependency() const override;
+
     /**
      * Append a transform to a composite. If \p transform is null,
      * nothing happens.
@@ -95,7 +95,7 @@ public:
         }
     }
 
-private:
+protected:
     class MixerImpl;
 
     struct ArrayOfPointers {
@@ -290,6 +290,23 @@ private:
             normalizeFactor += weightsWrapper.normalizeFactor();
         }
 
+        /**
+         * Add sums that were accumulated externally, e.g. by a vectorized
+         * implementation. \p colorTotals is indexed by the channel position,
+         * the value at the alpha position is ignored.
+         */
+        void addAccumulatedData(const mix_type *colorTotals, mix_type alphaTotal, qint64 weightsSum)
+        {
+            for (int i = 0; i < (int)_CSTrait::channels_nb; i++) {
+                if (i != _CSTrait::alpha_pos) {
+                    totals[i] += colorTotals[i];
+                }
+            }
+
+            totalAlpha += alphaTotal;
+            normalizeFactor += weightsSum;
+        }
+
         qint64 currentWeightsSum() const
         {
             return normalizeFactor;
@@ -0,0 +1,206 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedColorLut3D_H
+#define KoOptimizedColorLut3D_H
+
+#include "KoOptimizedColorLut3DBase.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include "KoMultiArchBuildSupport.h"
+#include "KoColorSpaceMaths.h"
+
+template<typename channels_type,
+         typename _impl = xsimd::current_arch,
+         typename EnableDummyType = void>
+class KoOptimizedColorLut3D : public KoOptimizedColorLut3DBase
+{
+public:
+    static inline void applyScalar(const channels_type *src, channels_type *dst, int numPixels,
+                                   const float *lut, int gridSize)
+    {
+        const float unitValue = float(KoColorSpaceMathsTraits<channels_type>::unitValue);
+        const float lastNode = float(gridSize - 1);
+        const int strideY = 3 * gridSize;
+        const int strideZ = 3 * gridSize * gridSize;
+
+        for (int i = 0; i < numPixels; i++) {
+            int index[3];
+            float fraction[3];
+
+            for (int k = 0; k < 3; k++) {
+                // the nodes are placed exactly at the integer positions
+                const float x = qBound(0.0f, float(src[k]), unitValue) * lastNode / unitValue;
+                index[k] = std::min(int(x), gridSize - 2);
+                fraction[k] = x - float(index[k]);
+            }
+
+            const float *p = lut + 3 * index[0] + strideY * index[1] + strideZ * index[2];
+            const channels_type alpha = src[3];
+
+            for (int c = 0; c < 3; c++) {
+                const float c00 = p[c] + (p[3 + c] - p[c]) * fraction[0];
+                const float c10 = p[strideY + c] + (p[strideY + 3 + c] - p[strideY + c]) * fraction[0];
+                const float c01 = p[strideZ + c] + (p[strideZ + 3 + c] - p[strideZ + c]) * fraction[0];
+                const float c11 = p[strideZ + strideY + c] + (p[strideZ + strideY + 3 + c] - p[strideZ + strideY + c]) * fraction[0];
+
+                const float c0 = c00 + (c10 - c00) * fraction[1];
+                const float c1 = c01 + (c11 - c01) * fraction[1];
+
+                dst[c] = KoColorSpaceMaths<float, channels_type>::scaleToA(c0 + (c1 - c0) * fraction[2]);
+            }
+
+            dst[3] = alpha;
+
+            src += 4;
+            dst += 4;
+        }
+    }
+
+    void apply(const quint8 *src, quint8 *dst, int numPixels,
+               const float *lut, int gridSize) const override
+    {
+        applyScalar(reinterpret_cast<const channels_type*>(src),
+                    reinterpret_cast<channels_type*>(dst),
+                    numPixels, lut, gridSize);
+    }
+};
+
+#if !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+/**
+ * Every lane processes a separate pixel. There is no portable gather
+ * instruction in all the supported versions of xsimd, so the corners
+ * of the cells are fetched lane by lane, but the index and the
+ * interpolation math is vectorized.
+ */
+template<typename channels_type, typename _impl>
+class KoOptimizedColorLut3D<channels_type, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KoOptimizedColorLut3DBase
+{
+    using float_v = xsimd::batch<float, _impl>;
+    using int_v = xsimd::batch<int, _impl>;
+
+    static constexpr int vectorSize = static_cast<int>(float_v::size);
+
+    static inline float_v lerp(const float_v &a, const float_v &b, const float_v &t)
+    {
+        return a + (b - a) * t;
+    }
+
+public:
+    void apply(const quint8 *srcBytes, quint8 *dstBytes, int numPixels,
+               const float *lut, int gridSize) const override
+    {
+        const channels_type *src = reinterpret_cast<const channels_type*>(srcBytes);
+        channels_type *dst = reinterpret_cast<channels_type*>(dstBytes);
+
+        const int numBlocks = numPixels / vectorSize;
+
+        const float_v unitValue(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        const float_v lastNode(float(gridSize - 1));
+        const float_v zero(0.0f);
+        const float_v half(0.5f);
+        const int_v lastCell(gridSize - 2);
+
+        const int strideY = 3 * gridSize;
+        const int strideZ = 3 * gridSize * gridSize;
+
+        const int cornerOffsets[8] = {
+            0,
+            3,
+            strideY,
+            strideY + 3,
+            strideZ,
+            strideZ + 3,
+            strideZ + strideY,
+            strideZ + strideY + 3
+        };
+
+        for (int block = 0; block < numBlocks; block++) {
+            float channels[3][vectorSize];
+            channels_type alpha[vectorSize];
+
+            for (int j = 0; j < vectorSize; j++) {
+                channels[0][j] = float(src[4 * j + 0]);
+                channels[1][j] = float(src[4 * j + 1]);
+                channels[2][j] = float(src[4 * j + 2]);
+                alpha[j] = src[4 * j + 3];
+            }
+
+            float_v fraction[3];
+            int_v offset(0);
+
+            const int_v strides[3] = {int_v(3), int_v(strideY), int_v(strideZ)};
+
+            for (int k = 0; k < 3; k++) {
+                float_v x = float_v::load_unaligned(channels[k]);
+
+                if constexpr (!std::numeric_limits<channels_type>::is_integer) {
+                    x = xsimd::min(xsimd::max(x, zero), unitValue);
+                }
+
+                x = x * lastNode / unitValue;
+                // NaNs of the float channels convert into garbage indices
+                const int_v index = xsimd::max(xsimd::min(xsimd::to_int(x), lastCell), int_v(0));
+                fraction[k] = x - xsimd::to_float(index);
+                offset += index * strides[k];
+            }
+
+            int offsets[vectorSize];
+            offset.store_unaligned(offsets);
+
+            using result_type = typename std::conditional<std::numeric_limits<channels_type>::is_integer, int, float>::type;
+            result_type result[3][vectorSize];
+
+            for (int c = 0; c < 3; c++) {
+                float corners[8][vectorSize];
+
+                for (int j = 0; j < vectorSize; j++) {
+                    const float *p = lut + offsets[j] + c;
+                    for (int corner = 0; corner < 8; corner++) {
+                        corners[corner][j] = p[cornerOffsets[corner]];
+                    }
+                }
+
+                const float_v c00 = lerp(float_v::load_unaligned(corners[0]), float_v::load_unaligned(corners[1]), fraction[0]);
+                const float_v c10 = lerp(float_v::load_unaligned(corners[2]), float_v::load_unaligned(corners[3]), fraction[0]);
+                const float_v c01 = lerp(float_v::load_unaligned(corners[4]), float_v::load_unaligned(corners[5]), fraction[0]);
+                const float_v c11 = lerp(float_v::load_unaligned(corners[6]), float_v::load_unaligned(corners[7]), fraction[0]);
+
+                const float_v value = lerp(lerp(c00, c10, fraction[1]), lerp(c01, c11, fraction[1]), fraction[2]);
+
+                if constexpr (std::numeric_limits<channels_type>::is_integer) {
+                    const float_v clamped = xsimd::min(xsimd::max(value * unitValue, zero), unitValue);
+                    xsimd::to_int(clamped + half).store_unaligned(result[c]);
+                } else {
+                    value.store_unaligned(result[c]);
+                }
+            }
+
+            for (int j = 0; j < vectorSize; j++) {
+                dst[4 * j + 0] = static_cast<channels_type>(result[0][j]);
+                dst[4 * j + 1] = static_cast<channels_type>(result[1][j]);
+                dst[4 * j + 2] = static_cast<channels_type>(result[2][j]);
+                dst[4 * j + 3] = alpha[j];
+            }
+
+            src += 4 * vectorSize;
+            dst += 4 * vectorSize;
+        }
+
+        KoOptimizedColorLut3D<channels_type, xsimd::generic>::applyScalar(
+            src, dst, numPixels % vectorSize, lut, gridSize);
+    }
+};
+
+#endif /* !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KoOptimizedColorLut3D_H
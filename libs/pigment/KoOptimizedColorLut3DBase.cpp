@@ -0,0 +1,11 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedColorLut3DBase.h"
+
+KoOptimizedColorLut3DBase::~KoOptimizedColorLut3DBase()
+{
+}
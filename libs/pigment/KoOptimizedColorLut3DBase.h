@@ -0,0 +1,44 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedColorLut3DBase_H
+#define KoOptimizedColorLut3DBase_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Applies a 3D color lookup table to 4-channel pixels
+ *
+ * The pixels are expected to have three color channels followed by
+ * the alpha channel. The color channels are used as coordinates in the
+ * LUT directly, in the order they are stored in the pixel, and the
+ * result is found with trilinear interpolation. The alpha channel is
+ * copied as it is.
+ *
+ * The LUT has \p gridSize nodes along every axis and stores three
+ * normalized floats per node. The node `(i0, i1, i2)` is placed at
+ * offset `3 * ((i2 * gridSize + i1) * gridSize + i0)` and corresponds
+ * to the channel values `i * unitValue / (gridSize - 1)`.
+ *
+ * Floating point channels are clamped into the unit range before the
+ * lookup, the result is stored without clamping. The callers that
+ * need a wider range should apply a shaper to the pixels first.
+ *
+ * The actual implementation is placed in class `KoOptimizedColorLut3D`.
+ * To create an instance, call KoOptimizedColorLut3DFactory, it will
+ * create a version optimized for your CPU architecture.
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedColorLut3DBase
+{
+public:
+    virtual ~KoOptimizedColorLut3DBase();
+
+    virtual void apply(const quint8 *src, quint8 *dst, int numPixels,
+                       const float *lut, int gridSize) const = 0;
+};
+
+#endif // KoOptimizedColorLut3DBase_H
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedColorLut3DFactory.h"
+
+#include <KoColorModelStandardIds.h>
+
+#include "KoOptimizedColorLut3DFactoryImpl.h"
+
+KoOptimizedColorLut3DBase *KoOptimizedColorLut3DFactory::create(const KoID &depthId)
+{
+    if (depthId == Integer8BitsColorDepthID) {
+        return createOptimizedClass<KoOptimizedColorLut3DFactoryImpl<quint8>>();
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return createOptimizedClass<KoOptimizedColorLut3DFactoryImpl<quint16>>();
+    } else if (depthId == Float32BitsColorDepthID) {
+        return createOptimizedClass<KoOptimizedColorLut3DFactoryImpl<float>>();
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedColorLut3DFACTORY_H
+#define KoOptimizedColorLut3DFACTORY_H
+
+#include <KoID.h>
+#include "KoOptimizedColorLut3DBase.h"
+
+/**
+ * \see KoOptimizedColorLut3DBase
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedColorLut3DFactory
+{
+public:
+    /**
+     * @return an applicator for the channel depth or nullptr if
+     *         the depth is not supported (U8, U16 and F32 are)
+     */
+    static KoOptimizedColorLut3DBase* create(const KoID &depthId);
+};
+
+#endif // KoOptimizedColorLut3DFACTORY_H
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedColorLut3DFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedColorLut3D.h"
+
+template<typename channels_type>
+template<typename _impl>
+KoOptimizedColorLut3DBase *
+KoOptimizedColorLut3DFactoryImpl<channels_type>::create()
+{
+    return new KoOptimizedColorLut3D<channels_type, _impl>();
+}
+
+template KoOptimizedColorLut3DBase* KoOptimizedColorLut3DFactoryImpl<quint8>::create<xsimd::current_arch>();
+template KoOptimizedColorLut3DBase* KoOptimizedColorLut3DFactoryImpl<quint16>::create<xsimd::current_arch>();
+template KoOptimizedColorLut3DBase* KoOptimizedColorLut3DFactoryImpl<float>::create<xsimd::current_arch>();
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedColorLut3DFACTORYIMPL_H
+#define KoOptimizedColorLut3DFACTORYIMPL_H
+
+#include <KoOptimizedColorLut3DBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename channels_type>
+class KRITAPIGMENT_EXPORT KoOptimizedColorLut3DFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoOptimizedColorLut3DBase* create();
+};
+
+#endif // KoOptimizedColorLut3DFACTORYIMPL_H
@@ -0,0 +1,383 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOP_H
+#define KOOPTIMIZEDMIXCOLORSOP_H
+
+#include <limits>
+
+#include "KoMixColorsOpImpl.h"
+#include "KoColorSpaceTraits.h"
+#include "KoMultiArchBuildSupport.h"
+
+/**
+ * Accumulates color sums for RGBA-like pixels, that is, pixels with
+ * four channels and alpha placed at the last position.
+ *
+ * The generic version is a plain scalar loop that does exactly the same
+ * math as KoMixColorsOpImpl. Vectorized versions are specialized below.
+ *
+ * When \p weights is null, every pixel has implicit weight of 1.
+ */
+template<typename channels_type, typename _impl, typename EnableDummyType = void>
+struct KoMixColorsAccumulator
+{
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+
+    static inline void accumulateScalar(const quint8 *data, const qint16 *weights, int nPixels,
+                                        mix_type *totals, mix_type &totalAlpha)
+    {
+        const channels_type *pixel = reinterpret_cast<const channels_type*>(data);
+
+        for (int i = 0; i < nPixels; i++) {
+            mix_type alphaTimesWeight = pixel[3];
+            if (weights) {
+                alphaTimesWeight *= weights[i];
+            }
+
+            totals[0] += pixel[0] * alphaTimesWeight;
+            totals[1] += pixel[1] * alphaTimesWeight;
+            totals[2] += pixel[2] * alphaTimesWeight;
+            totalAlpha += alphaTimesWeight;
+
+            pixel += 4;
+        }
+    }
+
+    static void accumulate(const quint8 *data, const qint16 *weights, int nPixels,
+                           mix_type *totals, mix_type &totalAlpha)
+    {
+        accumulateScalar(data, weights, nPixels, totals, totalAlpha);
+    }
+};
+
+#if !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+namespace KoMixColorsAccumulatorDetail {
+
+template<typename V>
+inline qint64 horizontalSumInt(const V &v)
+{
+    typename V::value_type values[V::size];
+    v.store_unaligned(values);
+
+    qint64 result = 0;
+    for (size_t i = 0; i < V::size; i++) {
+        result += values[i];
+    }
+    return result;
+}
+
+template<typename V>
+inline double horizontalSumFloat(const V &v)
+{
+    typename V::value_type values[V::size];
+    v.store_unaligned(values);
+
+    double result = 0.0;
+    for (size_t i = 0; i < V::size; i++) {
+        result += values[i];
+    }
+    return result;
+}
+
+/**
+ * Loads channel \p channel of V::size consecutive 4-channel pixels
+ */
+template<typename V, typename channels_type>
+inline V loadChannel(const channels_type *pixels, int channel)
+{
+    typename V::value_type values[V::size];
+    for (size_t i = 0; i < V::size; i++) {
+        values[i] = static_cast<typename V::value_type>(pixels[4 * i + channel]);
+    }
+    return V::load_unaligned(values);
+}
+
+}
+
+/**
+ * 8-bit version works in 32-bit integer lanes, so the result is exactly
+ * the same as the one of the scalar version. The lanes are flushed into
+ * 64-bit totals before they have a chance to overflow.
+ */
+template<typename _impl>
+struct KoMixColorsAccumulator<quint8, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+{
+    using mix_type = typename KoColorSpaceMathsTraits<quint8>::mixtype;
+    using int_v = xsimd::batch<int, _impl>;
+    using uint_v = xsimd::batch<unsigned int, _impl>;
+
+    static void accumulate(const quint8 *data, const qint16 *weights, int nPixels,
+                           mix_type *totals, mix_type &totalAlpha)
+    {
+        using namespace KoMixColorsAccumulatorDetail;
+
+        const int vectorSize = static_cast<int>(int_v::size);
+        const int numBlocks = nPixels / vectorSize;
+
+        /**
+         * Every lane receives at most `255 * 255 * maxWeight` per block,
+         * so we know exactly how many blocks we can sum before flushing
+         */
+        qint64 maxWeight = 1;
+        if (weights) {
+            for (int i = 0; i < numBlocks * vectorSize; i++) {
+                maxWeight = qMax(maxWeight, qAbs(qint64(weights[i])));
+            }
+        }
+        const int blocksPerFlush =
+            qMax(1, int(qint64(std::numeric_limits<int>::max()) / (255 * 255 * maxWeight)));
+
+        const uint_v mask(0xFF);
+
+        int block = 0;
+        while (block < numBlocks) {
+            const int blocksInChunk = qMin(blocksPerFlush, numBlocks - block);
+
+            int_v sum0(0), sum1(0), sum2(0), sumAlpha(0);
+
+            for (int i = 0; i < blocksInChunk; i++) {
+                const auto pixels = uint_v::load_unaligned(reinterpret_cast<const quint32*>(data));
+
+                const int_v c0 = xsimd::bitwise_cast_compat<int>(pixels & mask);
+                const int_v c1 = xsimd::bitwise_cast_compat<int>((pixels >> 8) & mask);
+                const int_v c2 = xsimd::bitwise_cast_compat<int>((pixels >> 16) & mask);
+                int_v alphaTimesWeight = xsimd::bitwise_cast_compat<int>(pixels >> 24);
+
+                if (weights) {
+                    alphaTimesWeight *= xsimd::load_and_extend<int_v>(weights);
+                    weights += vectorSize;
+                }
+
+                sum0 += c0 * alphaTimesWeight;
+                sum1 += c1 * alphaTimesWeight;
+                sum2 += c2 * alphaTimesWeight;
+                sumAlpha += alphaTimesWeight;
+
+                data += vectorSize * 4;
+            }
+
+            totals[0] += horizontalSumInt(sum0);
+            totals[1] += horizontalSumInt(sum1);
+            totals[2] += horizontalSumInt(sum2);
+            totalAlpha += horizontalSumInt(sumAlpha);
+
+            block += blocksInChunk;
+        }
+
+        KoMixColorsAccumulator<quint8, xsimd::generic>::accumulateScalar(
+            data, weights, nPixels % vectorSize, totals, totalAlpha);
+    }
+};
+
+/**
+ * 16-bit version is exact as well. A product of a 16-bit color and
+ * a 16-bit alpha doesn't fit into a signed 32-bit lane, so the color
+ * is split into high and low bytes, which are accumulated separately.
+ *
+ * Weighted mixing of 16-bit colors would need 64-bit lanes, so it falls
+ * back to the scalar version.
+ */
+template<typename _impl>
+struct KoMixColorsAccumulator<quint16, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+{
+    using mix_type = typename KoColorSpaceMathsTraits<quint16>::mixtype;
+    using int_v = xsimd::batch<int, _impl>;
+
+    static void accumulate(const quint8 *data, const qint16 *weights, int nPixels,
+                           mix_type *totals, mix_type &totalAlpha)
+    {
+        using namespace KoMixColorsAccumulatorDetail;
+
+        if (weights) {
+            KoMixColorsAccumulator<quint16, xsimd::generic>::accumulateScalar(
+                data, weights, nPixels, totals, totalAlpha);
+            return;
+        }
+
+        const int vectorSize = static_cast<int>(int_v::size);
+        const int numBlocks = nPixels / vectorSize;
+
+        // 255 * 65535 per block, i.e. 128 blocks fit into a signed lane
+        const int blocksPerFlush = 128;
+
+        const int_v lowByteMask(0xFF);
+
+        const quint16 *pixels = reinterpret_cast<const quint16*>(data);
+
+        int block = 0;
+        while (block < numBlocks) {
+            const int blocksInChunk = qMin(blocksPerFlush, numBlocks - block);
+
+            int_v sumHigh[3] = {int_v(0), int_v(0), int_v(0)};
+            int_v sumLow[3] = {int_v(0), int_v(0), int_v(0)};
+            int_v sumAlpha(0);
+
+            for (int i = 0; i < blocksInChunk; i++) {
+                const int_v alpha = loadChannel<int_v>(pixels, 3);
+
+                for (int ch = 0; ch < 3; ch++) {
+                    const int_v c = loadChannel<int_v>(pixels, ch);
+                    sumHigh[ch] += (c >> 8) * alpha;
+                    sumLow[ch] += (c & lowByteMask) * alpha;
+                }
+                sumAlpha += alpha;
+
+                pixels += vectorSize * 4;
+            }
+
+            for (int ch = 0; ch < 3; ch++) {
+                totals[ch] += 256 * horizontalSumInt(sumHigh[ch]) + horizontalSumInt(sumLow[ch]);
+            }
+            totalAlpha += horizontalSumInt(sumAlpha);
+
+            block += blocksInChunk;
+        }
+
+        KoMixColorsAccumulator<quint16, xsimd::generic>::accumulateScalar(
+            reinterpret_cast<const quint8*>(pixels), nullptr, nPixels % vectorSize, totals, totalAlpha);
+    }
+};
+
+/**
+ * Floating point version accumulates in float lanes and flushes
+ * them into double totals regularly to keep the precision close
+ * to the scalar version.
+ */
+template<typename channels_type, typename _impl>
+struct KoMixColorsAccumulator<channels_type, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value &&
+                                !std::numeric_limits<channels_type>::is_integer>::type>
+{
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+    using float_v = xsimd::batch<float, _impl>;
+
+    static void accumulate(const quint8 *data, const qint16 *weights, int nPixels,
+                           mix_type *totals, mix_type &totalAlpha)
+    {
+        using namespace KoMixColorsAccumulatorDetail;
+
+        const int vectorSize = static_cast<int>(float_v::size);
+        const int numBlocks = nPixels / vectorSize;
+        const int blocksPerFlush = 64;
+
+        const channels_type *pixels = reinterpret_cast<const channels_type*>(data);
+
+        int block = 0;
+        while (block < numBlocks) {
+            const int blocksInChunk = qMin(blocksPerFlush, numBlocks - block);
+
+            float_v sum0(0.0f), sum1(0.0f), sum2(0.0f), sumAlpha(0.0f);
+
+            for (int i = 0; i < blocksInChunk; i++) {
+                float_v alphaTimesWeight = loadChannel<float_v>(pixels, 3);
+
+                if (weights) {
+                    alphaTimesWeight *= xsimd::load_and_extend<float_v>(weights);
+                    weights += vectorSize;
+                }
+
+                sum0 = xsimd::fma(loadChannel<float_v>(pixels, 0), alphaTimesWeight, sum0);
+                sum1 = xsimd::fma(loadChannel<float_v>(pixels, 1), alphaTimesWeight, sum1);
+                sum2 = xsimd::fma(loadChannel<float_v>(pixels, 2), alphaTimesWeight, sum2);
+                sumAlpha += alphaTimesWeight;
+
+                pixels += vectorSize * 4;
+            }
+
+            totals[0] += horizontalSumFloat(sum0);
+            totals[1] += horizontalSumFloat(sum1);
+            totals[2] += horizontalSumFloat(sum2);
+            totalAlpha += horizontalSumFloat(sumAlpha);
+
+            block += blocksInChunk;
+        }
+
+        KoMixColorsAccumulator<channels_type, xsimd::generic>::accumulateScalar(
+            reinterpret_cast<const quint8*>(pixels), weights, nPixels % vectorSize, totals, totalAlpha);
+    }
+};
+
+#endif /* !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+/**
+ * A version of KoMixColorsOpImpl for RGBA-like color spaces (four channels,
+ * alpha at the last position) that mixes contiguous arrays of pixels with
+ * vector instructions. Mixing of arrays of pointers is left to the base
+ * class, since it cannot be vectorized efficiently anyway.
+ */
+template<typename _channels_type_, typename _impl>
+class KoOptimizedMixColorsOp : public KoMixColorsOpImpl<KoColorSpaceTrait<_channels_type_, 4, 3>>
+{
+    using Traits = KoColorSpaceTrait<_channels_type_, 4, 3>;
+    using BaseClass = KoMixColorsOpImpl<Traits>;
+    using MixDataResult = typename BaseClass::MixDataResult;
+    using Accumulator = KoMixColorsAccumulator<_channels_type_, _impl>;
+    using mix_type = typename KoColorSpaceMathsTraits<_channels_type_>::mixtype;
+
+    static void accumulate(MixDataResult &result, const quint8 *data, const qint16 *weights, int nPixels, qint64 weightsSum)
+    {
+        mix_type totals[4] = {0, 0, 0, 0};
+        mix_type totalAlpha = 0;
+
+        Accumulator::accumulate(data, weights, nPixels, totals, totalAlpha);
+        result.addAccumulatedData(totals, totalAlpha, weightsSum);
+    }
+
+    class OptimizedMixer : public KoMixColorsOp::Mixer
+    {
+    public:
+        void accumulate(const quint8 *data, const qint16 *weights, int weightSum, int nPixels) override
+        {
+            KoOptimizedMixColorsOp::accumulate(m_result, data, weights, nPixels, weightSum);
+        }
+
+        void accumulateAverage(const quint8 *data, int nPixels) override
+        {
+            KoOptimizedMixColorsOp::accumulate(m_result, data, nullptr, nPixels, nPixels);
+        }
+
+        void computeMixedColor(quint8 *data) override
+        {
+            m_result.computeMixedColor(data);
+        }
+
+        qint64 currentWeightsSum() const override
+        {
+            return m_result.currentWeightsSum();
+        }
+
+    private:
+        MixDataResult m_result;
+    };
+
+public:
+    using BaseClass::mixColors;
+
+    KoMixColorsOp::Mixer* createMixer() const override
+    {
+        return new OptimizedMixer();
+    }
+
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum = 255) const override
+    {
+        MixDataResult result;
+        accumulate(result, colors, weights, nColors, weightSum);
+        result.computeMixedColor(dst);
+    }
+
+    void mixColors(const quint8 *colors, int nColors, quint8 *dst) const override
+    {
+        MixDataResult result;
+        accumulate(result, colors, nullptr, nColors, nColors);
+        result.computeMixedColor(dst);
+    }
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOP_H
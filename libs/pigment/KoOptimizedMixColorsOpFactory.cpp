@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedMixColorsOpFactory.h"
+
+#include <KoColorModelStandardIdsUtils.h>
+
+#include "KoOptimizedMixColorsOpFactoryImpl.h"
+
+template <typename channels_type>
+struct CreateMixColorsOp
+{
+    KoMixColorsOp *operator() () {
+        return createOptimizedClass<
+            KoOptimizedMixColorsOpFactoryImpl<channels_type>>();
+    }
+};
+
+KoMixColorsOp *KoOptimizedMixColorsOpFactory::create(KoID depthId, int numChannels, int alphaPos)
+{
+    if (numChannels != 4 || alphaPos != 3) return nullptr;
+
+    return channelTypeForColorDepthId<CreateMixColorsOp>(depthId);
+}
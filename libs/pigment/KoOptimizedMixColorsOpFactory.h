@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOPFACTORY_H
+#define KOOPTIMIZEDMIXCOLORSOPFACTORY_H
+
+#include "kritapigment_export.h"
+#include <KoID.h>
+#include <KoMixColorsOp.h>
+
+/**
+ * Creates a version of KoMixColorsOp optimized for the current CPU
+ * architecture. Only RGBA-like layouts (four channels with alpha at
+ * the last position) are vectorized, for all the other layouts the
+ * factory returns nullptr and the caller should use KoMixColorsOpImpl.
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactory
+{
+public:
+    static KoMixColorsOp* create(KoID depthId, int numChannels, int alphaPos);
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOPFACTORY_H
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
+#define KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
+
+#include <KoMixColorsOp.h>
+#include <KoMultiArchBuildSupport.h>
+#include "kritapigment_export.h"
+
+template<typename _channels_type_>
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoMixColorsOp *create();
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
@@ -0,0 +1,275 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScaler_H
+#define KoOptimizedPixelDataScaler_H
+
+#include "KoOptimizedPixelDataScalerBase.h"
+
+#include <limits>
+#include <type_traits>
+
+#include "KoMultiArchBuildSupport.h"
+#include "KoColorSpaceMaths.h"
+#include "KoOptimizedPixelDataScalerU8ToU16.h"
+
+#include <xsimd_extensions/xsimd.hpp>
+
+/**
+ * F16C is always available on the CPUs that support AVX2, so
+ * the AVX2 pass is built with it (MSVC doesn't need any special
+ * flags for that)
+ */
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define KO_PIXEL_DATA_SCALER_HAS_F16C 1
+#else
+#define KO_PIXEL_DATA_SCALER_HAS_F16C 0
+#endif
+
+template<typename channel_type>
+struct KoPixelDataScalerIsHalf : std::false_type {};
+
+#ifdef HAVE_OPENEXR
+template<>
+struct KoPixelDataScalerIsHalf<half> : std::true_type {};
+#endif
+
+template<typename src_channel_type,
+         typename dst_channel_type,
+         typename _impl = xsimd::current_arch,
+         typename EnableDummyType = void>
+struct KoPixelDataScalerKernel
+{
+    static inline void convertScalar(const src_channel_type *src, dst_channel_type *dst, int numValues)
+    {
+        for (int i = 0; i < numValues; i++) {
+            dst[i] = KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(src[i]);
+        }
+    }
+
+    static inline void convert(const src_channel_type *src, dst_channel_type *dst, int numValues)
+    {
+        convertScalar(src, dst, numValues);
+    }
+};
+
+#if !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+/**
+ * Every value is converted into a float lane and then into the
+ * destination type. The intermediate operations are chosen to
+ * reproduce the rounding of the corresponding
+ * KoColorSpaceMaths<src, dst>::scaleToA() exactly:
+ *
+ * - integers are converted into floats with a division, like KoLuts do
+ * - floats are converted into integers with clamping and float2int()
+ * - halfs are converted into integers with clamping and truncation
+ *   after rounding the scaled value to half
+ * - halfs are converted with F16C, which rounds to nearest even,
+ *   exactly like half(float)
+ *
+ * U8 <-> U16 conversions don't need any floating point math, they
+ * are handled by KoOptimizedPixelDataScalerU8ToU16.
+ */
+template<typename src_channel_type, typename dst_channel_type, typename _impl>
+struct KoPixelDataScalerKernel<src_channel_type, dst_channel_type, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+{
+    using float_v = xsimd::batch<float, _impl>;
+    using int_v = xsimd::batch<int, _impl>;
+
+    static constexpr bool useF16C = KO_PIXEL_DATA_SCALER_HAS_F16C && float_v::size == 8;
+
+    static inline float_v loadHalf(const src_channel_type *src)
+    {
+#if KO_PIXEL_DATA_SCALER_HAS_F16C
+        if constexpr (useF16C) {
+            return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+        }
+#endif
+        float values[float_v::size];
+        for (size_t i = 0; i < float_v::size; i++) {
+            values[i] = float(src[i]);
+        }
+        return float_v::load_unaligned(values);
+    }
+
+    template<typename half_type>
+    static inline void storeHalf(const float_v &value, half_type *dst)
+    {
+#if KO_PIXEL_DATA_SCALER_HAS_F16C
+        if constexpr (useF16C) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                             _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+            return;
+        }
+#endif
+        float values[float_v::size];
+        value.store_unaligned(values);
+        for (size_t i = 0; i < float_v::size; i++) {
+            dst[i] = half_type(values[i]);
+        }
+    }
+
+    static inline float_v roundToHalf(const float_v &value)
+    {
+#if KO_PIXEL_DATA_SCALER_HAS_F16C
+        if constexpr (useF16C) {
+            return _mm256_cvtph_ps(_mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+        }
+#endif
+        float values[float_v::size];
+        value.store_unaligned(values);
+        for (size_t i = 0; i < float_v::size; i++) {
+            values[i] = float(src_channel_type(values[i]));
+        }
+        return float_v::load_unaligned(values);
+    }
+
+    static inline float_v load(const src_channel_type *src)
+    {
+        if constexpr (std::numeric_limits<src_channel_type>::is_integer) {
+            const float_v unitValue(float(KoColorSpaceMathsTraits<src_channel_type>::unitValue));
+            return xsimd::to_float(xsimd::load_and_extend<int_v>(src)) / unitValue;
+        } else if constexpr (KoPixelDataScalerIsHalf<src_channel_type>::value) {
+            return loadHalf(src);
+        } else {
+            return float_v::load_unaligned(src);
+        }
+    }
+
+    static inline void store(const float_v &value, dst_channel_type *dst)
+    {
+        if constexpr (std::numeric_limits<dst_channel_type>::is_integer) {
+            const float_v unitValue(float(KoColorSpaceMathsTraits<dst_channel_type>::unitValue));
+            const float_v zero(0.0f);
+
+            int_v result;
+
+            if constexpr (KoPixelDataScalerIsHalf<src_channel_type>::value) {
+                float_v v = value * unitValue;
+
+                /**
+                 * scaleToA<half, quint8>() stores the scaled value in
+                 * a half, scaleToA<half, quint16>() doesn't
+                 */
+                if constexpr (std::is_same<dst_channel_type, quint8>::value) {
+                    v = roundToHalf(v);
+                }
+
+                result = xsimd::to_int(xsimd::min(xsimd::max(v, zero), unitValue));
+            } else {
+                const float_v v = xsimd::min(xsimd::max(value * unitValue, zero), unitValue);
+                result = xsimd::to_int(v + float_v(0.5f));
+            }
+
+            int values[int_v::size];
+            result.store_unaligned(values);
+
+            for (size_t i = 0; i < int_v::size; i++) {
+                dst[i] = static_cast<dst_channel_type>(values[i]);
+            }
+        } else if constexpr (KoPixelDataScalerIsHalf<dst_channel_type>::value) {
+            storeHalf(value, dst);
+        } else {
+            value.store_unaligned(dst);
+        }
+    }
+
+    static inline void convert(const src_channel_type *src, dst_channel_type *dst, int numValues)
+    {
+        const int vectorSize = static_cast<int>(float_v::size);
+        const int numBlocks = numValues / vectorSize;
+
+        for (int i = 0; i < numBlocks; i++) {
+            store(load(src), dst);
+
+            src += vectorSize;
+            dst += vectorSize;
+        }
+
+        KoPixelDataScalerKernel<src_channel_type, dst_channel_type, xsimd::generic>::convertScalar(
+            src, dst, numValues % vectorSize);
+    }
+};
+
+#endif /* !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+template<typename src_channel_type,
+         typename dst_channel_type,
+         typename _impl = xsimd::current_arch>
+class KoOptimizedPixelDataScaler : public KoOptimizedPixelDataScalerBase
+{
+public:
+    KoOptimizedPixelDataScaler(int channelsPerPixel)
+        : KoOptimizedPixelDataScalerBase(channelsPerPixel)
+    {
+    }
+
+    void convert(const quint8 *src, int srcRowStride,
+                 quint8 *dst, int dstRowStride,
+                 int numRows, int numColumns) const override
+    {
+        const int numValues = m_channelsPerPixel * numColumns;
+
+        for (int row = 0; row < numRows; row++) {
+            KoPixelDataScalerKernel<src_channel_type, dst_channel_type, _impl>::convert(
+                reinterpret_cast<const src_channel_type *>(src),
+                reinterpret_cast<dst_channel_type *>(dst),
+                numValues);
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+};
+
+/**
+ * U8 <-> U16 conversion is already implemented by
+ * KoOptimizedPixelDataScalerU8ToU16, just reuse it
+ */
+template<bool u8ToU16, typename _impl>
+class KoOptimizedPixelDataScalerIntegerAdapter : public KoOptimizedPixelDataScalerBase
+{
+public:
+    KoOptimizedPixelDataScalerIntegerAdapter(int channelsPerPixel)
+        : KoOptimizedPixelDataScalerBase(channelsPerPixel)
+        , m_scaler(channelsPerPixel)
+    {
+    }
+
+    void convert(const quint8 *src, int srcRowStride,
+                 quint8 *dst, int dstRowStride,
+                 int numRows, int numColumns) const override
+    {
+        if (u8ToU16) {
+            m_scaler.convertU8ToU16(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        } else {
+            m_scaler.convertU16ToU8(src, srcRowStride, dst, dstRowStride, numRows, numColumns);
+        }
+    }
+
+private:
+    KoOptimizedPixelDataScalerU8ToU16<_impl> m_scaler;
+};
+
+template<typename _impl>
+class KoOptimizedPixelDataScaler<quint8, quint16, _impl>
+    : public KoOptimizedPixelDataScalerIntegerAdapter<true, _impl>
+{
+public:
+    using KoOptimizedPixelDataScalerIntegerAdapter<true, _impl>::KoOptimizedPixelDataScalerIntegerAdapter;
+};
+
+template<typename _impl>
+class KoOptimizedPixelDataScaler<quint16, quint8, _impl>
+    : public KoOptimizedPixelDataScalerIntegerAdapter<false, _impl>
+{
+public:
+    using KoOptimizedPixelDataScalerIntegerAdapter<false, _impl>::KoOptimizedPixelDataScalerIntegerAdapter;
+};
+
+#endif // KoOptimizedPixelDataScaler_H
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerBase.h"
+
+KoOptimizedPixelDataScalerBase::KoOptimizedPixelDataScalerBase(int channelsPerPixel)
+    : m_channelsPerPixel(channelsPerPixel)
+{
+}
+
+KoOptimizedPixelDataScalerBase::~KoOptimizedPixelDataScalerBase()
+{
+}
+
+int KoOptimizedPixelDataScalerBase::channelsPerPixel() const
+{
+    return m_channelsPerPixel;
+}
@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerBase_H
+#define KoOptimizedPixelDataScalerBase_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Converts pixel data between two channel depths
+ *
+ * It is a generalization of KoOptimizedPixelDataScalerU8ToU16Base
+ * for all pairs of U8, U16, F16 and F32 depths. The result is
+ * exactly the same as the one of KoColorSpaceMaths<src, dst>::scaleToA()
+ * applied to every channel, so the scaler can be used as a drop-in
+ * replacement for the scalar loops in the depth conversion code.
+ *
+ * The actual implementation is placed in class
+ * `KoOptimizedPixelDataScaler`.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedPixelDataScalerBase> scaler(
+ *     KoOptimizedPixelDataScalerFactory::create(Float32BitsColorDepthID,
+ *                                               Integer8BitsColorDepthID,
+ *                                               4));
+ *
+ * if (scaler) {
+ *     scaler->convert(src, srcRowStride,
+ *                     dst, dstRowStride,
+ *                     numRows, numColumns);
+ * }
+ * \endcode
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerBase
+{
+public:
+    KoOptimizedPixelDataScalerBase(int channelsPerPixel);
+
+    virtual ~KoOptimizedPixelDataScalerBase();
+
+    virtual void convert(const quint8 *src, int srcRowStride,
+                         quint8 *dst, int dstRowStride,
+                         int numRows, int numColumns) const = 0;
+
+    int channelsPerPixel() const;
+
+protected:
+    int m_channelsPerPixel;
+};
+
+#endif // KoOptimizedPixelDataScalerBase_H
@@ -0,0 +1,58 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerFactory.h"
+
+#include <type_traits>
+
+#include <KoColorModelStandardIdsUtils.h>
+
+#include "KoOptimizedPixelDataScalerFactoryImpl.h"
+
+namespace {
+
+bool isSupportedDepth(const KoID &depthId)
+{
+    return depthId == Integer8BitsColorDepthID ||
+        depthId == Integer16BitsColorDepthID ||
+#ifdef HAVE_OPENEXR
+        depthId == Float16BitsColorDepthID ||
+#endif
+        depthId == Float32BitsColorDepthID;
+}
+
+template <typename src_channel_type>
+struct CreatePixelDataScaler
+{
+    template <typename dst_channel_type>
+    struct CreateForDestination
+    {
+        KoOptimizedPixelDataScalerBase *operator() (int channelsPerPixel) {
+            if constexpr (std::is_same<src_channel_type, dst_channel_type>::value) {
+                Q_UNUSED(channelsPerPixel);
+                return nullptr;
+            } else {
+                return createOptimizedClass<
+                    KoOptimizedPixelDataScalerFactoryImpl<src_channel_type, dst_channel_type>>(channelsPerPixel);
+            }
+        }
+    };
+
+    KoOptimizedPixelDataScalerBase *operator() (const KoID &dstDepthId, int channelsPerPixel) {
+        return channelTypeForColorDepthId<CreateForDestination>(dstDepthId, channelsPerPixel);
+    }
+};
+
+} // namespace
+
+KoOptimizedPixelDataScalerBase *KoOptimizedPixelDataScalerFactory::create(const KoID &srcDepthId, const KoID &dstDepthId, int channelsPerPixel)
+{
+    if (!isSupportedDepth(srcDepthId) || !isSupportedDepth(dstDepthId)) {
+        return nullptr;
+    }
+
+    return channelTypeForColorDepthId<CreatePixelDataScaler>(srcDepthId, dstDepthId, channelsPerPixel);
+}
@@ -0,0 +1,28 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerFACTORY_H
+#define KoOptimizedPixelDataScalerFACTORY_H
+
+#include <KoID.h>
+#include "KoOptimizedPixelDataScalerBase.h"
+
+/**
+ * \see KoOptimizedPixelDataScalerBase
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerFactory
+{
+public:
+    /**
+     * @return a scaler for the pair of depths or nullptr if one of
+     *         the depths is not supported or the depths are equal
+     */
+    static KoOptimizedPixelDataScalerBase* create(const KoID &srcDepthId,
+                                                  const KoID &dstDepthId,
+                                                  int channelsPerPixel);
+};
+
+#endif // KoOptimizedPixelDataScalerFACTORY_H
@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedPixelDataScaler.h"
+
+#include <KoConfig.h>
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+template<typename src_channel_type, typename dst_channel_type>
+template<typename _impl>
+KoOptimizedPixelDataScalerBase *
+KoOptimizedPixelDataScalerFactoryImpl<src_channel_type, dst_channel_type>::create(int channelsPerPixel)
+{
+    return new KoOptimizedPixelDataScaler<src_channel_type, dst_channel_type, _impl>(channelsPerPixel);
+}
+
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<quint8,  quint16>::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<quint8,  float  >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<quint16, quint8 >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<quint16, float  >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<float,   quint8 >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<float,   quint16>::create<xsimd::current_arch>(int);
+
+#ifdef HAVE_OPENEXR
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<quint8,  half   >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<quint16, half   >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<half,    quint8 >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<half,    quint16>::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<half,    float  >::create<xsimd::current_arch>(int);
+template KoOptimizedPixelDataScalerBase* KoOptimizedPixelDataScalerFactoryImpl<float,   half   >::create<xsimd::current_arch>(int);
+#endif
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
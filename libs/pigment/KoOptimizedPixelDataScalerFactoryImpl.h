@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerFACTORYIMPL_H
+#define KoOptimizedPixelDataScalerFACTORYIMPL_H
+
+#include <KoOptimizedPixelDataScalerBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename src_channel_type, typename dst_channel_type>
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoOptimizedPixelDataScalerBase* create(int);
+};
+
+#endif // KoOptimizedPixelDataScalerFACTORYIMPL_H
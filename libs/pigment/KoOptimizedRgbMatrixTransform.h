@@ -0,0 +1,111 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedRgbMatrixTransform_H
+#define KoOptimizedRgbMatrixTransform_H
+
+#include "KoOptimizedRgbMatrixTransformBase.h"
+
+#include "KoMultiArchBuildSupport.h"
+
+template<typename _impl = xsimd::current_arch,
+         typename EnableDummyType = void>
+class KoOptimizedRgbMatrixTransform : public KoOptimizedRgbMatrixTransformBase
+{
+public:
+    static inline void applyScalar(float *red, float *green, float *blue,
+                                   int numPixels,
+                                   const float *m,
+                                   bool clampToUnitRange)
+    {
+        for (int i = 0; i < numPixels; i++) {
+            const float r = red[i];
+            const float g = green[i];
+            const float b = blue[i];
+
+            float dr = m[0] * r + m[1] * g + m[2] * b;
+            float dg = m[3] * r + m[4] * g + m[5] * b;
+            float db = m[6] * r + m[7] * g + m[8] * b;
+
+            if (clampToUnitRange) {
+                dr = qBound(0.0f, dr, 1.0f);
+                dg = qBound(0.0f, dg, 1.0f);
+                db = qBound(0.0f, db, 1.0f);
+            }
+
+            red[i] = dr;
+            green[i] = dg;
+            blue[i] = db;
+        }
+    }
+
+    void applyMatrix(float *red, float *green, float *blue,
+                     int numPixels,
+                     const float *matrix,
+                     bool clampToUnitRange) const override
+    {
+        applyScalar(red, green, blue, numPixels, matrix, clampToUnitRange);
+    }
+};
+
+#if !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE)
+
+template<typename _impl>
+class KoOptimizedRgbMatrixTransform<
+        _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KoOptimizedRgbMatrixTransformBase
+{
+    using float_v = xsimd::batch<float, _impl>;
+
+public:
+    void applyMatrix(float *red, float *green, float *blue,
+                     int numPixels,
+                     const float *m,
+                     bool clampToUnitRange) const override
+    {
+        const int block1 = numPixels / static_cast<int>(float_v::size);
+        const int block2 = numPixels % static_cast<int>(float_v::size);
+
+        const float_v m0(m[0]), m1(m[1]), m2(m[2]);
+        const float_v m3(m[3]), m4(m[4]), m5(m[5]);
+        const float_v m6(m[6]), m7(m[7]), m8(m[8]);
+
+        const float_v zero(0.0f);
+        const float_v one(1.0f);
+
+        for (int i = 0; i < block1; i++) {
+            const auto r = float_v::load_unaligned(red);
+            const auto g = float_v::load_unaligned(green);
+            const auto b = float_v::load_unaligned(blue);
+
+            auto dr = xsimd::fma(m2, b, xsimd::fma(m1, g, m0 * r));
+            auto dg = xsimd::fma(m5, b, xsimd::fma(m4, g, m3 * r));
+            auto db = xsimd::fma(m8, b, xsimd::fma(m7, g, m6 * r));
+
+            if (clampToUnitRange) {
+                dr = xsimd::min(xsimd::max(dr, zero), one);
+                dg = xsimd::min(xsimd::max(dg, zero), one);
+                db = xsimd::min(xsimd::max(db, zero), one);
+            }
+
+            dr.store_unaligned(red);
+            dg.store_unaligned(green);
+            db.store_unaligned(blue);
+
+            red += float_v::size;
+            green += float_v::size;
+            blue += float_v::size;
+        }
+
+        KoOptimizedRgbMatrixTransform<xsimd::generic>::applyScalar(
+            red, green, blue, block2, m, clampToUnitRange);
+    }
+};
+
+#endif /* !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) */
+
+#endif // KoOptimizedRgbMatrixTransform_H
@@ -0,0 +1,54 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedRgbMatrixTransformBase_H
+#define KoOptimizedRgbMatrixTransformBase_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Applies a 3x3 matrix to planar RGB float data
+ *
+ * This is the linear stage of a matrix-shaper color conversion, i.e.
+ * a conversion between two RGB profiles that are defined only by
+ * their primaries and their tone curves. The color engine linearizes
+ * the source channels into three separate planes, passes them through
+ * this class and then applies the destination tone curves.
+ *
+ * The actual implementation is placed in class
+ * `KoOptimizedRgbMatrixTransform`. To create an instance, call the
+ * factory, it will create a version optimized for your CPU architecture.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedRgbMatrixTransformBase> op(
+ *     KoOptimizedRgbMatrixTransformFactory::create());
+ *
+ * // matrix is stored in row-major order
+ * op->applyMatrix(red, green, blue, numPixels, matrix, true);
+ * \endcode
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedRgbMatrixTransformBase
+{
+public:
+    virtual ~KoOptimizedRgbMatrixTransformBase();
+
+    /**
+     * Multiplies every (r, g, b) triplet by \p matrix in place.
+     *
+     * \p matrix is a row-major 3x3 matrix, i.e. the resulting red
+     * channel is `matrix[0] * r + matrix[1] * g + matrix[2] * b`.
+     *
+     * When \p clampToUnitRange is true, the result is clamped into
+     * [0.0, 1.0] range, which is what integer destinations need.
+     */
+    virtual void applyMatrix(float *red, float *green, float *blue,
+                             int numPixels,
+                             const float *matrix,
+                             bool clampToUnitRange) const = 0;
+};
+
+#endif // KoOptimizedRgbMatrixTransformBase_H
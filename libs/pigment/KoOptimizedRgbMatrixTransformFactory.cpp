@@ -0,0 +1,14 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedRgbMatrixTransformFactory.h"
+
+#include "KoOptimizedRgbMatrixTransformFactoryImpl.h"
+
+KoOptimizedRgbMatrixTransformBase *KoOptimizedRgbMatrixTransformFactory::create()
+{
+    return createOptimizedClass<KoOptimizedRgbMatrixTransformFactoryImpl>();
+}
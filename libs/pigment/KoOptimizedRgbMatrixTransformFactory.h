@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedRgbMatrixTransformFACTORY_H
+#define KoOptimizedRgbMatrixTransformFACTORY_H
+
+#include "KoOptimizedRgbMatrixTransformBase.h"
+
+/**
+ * \see KoOptimizedRgbMatrixTransformBase
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedRgbMatrixTransformFactory
+{
+public:
+    static KoOptimizedRgbMatrixTransformBase* create();
+};
+
+#endif // KoOptimizedRgbMatrixTransformFACTORY_H
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedRgbMatrixTransformFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedRgbMatrixTransform.h"
+
+template<>
+KoOptimizedRgbMatrixTransformBase *
+KoOptimizedRgbMatrixTransformFactoryImpl::create<xsimd::current_arch>()
+{
+    return new KoOptimizedRgbMatrixTransform<xsimd::current_arch>();
+}
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
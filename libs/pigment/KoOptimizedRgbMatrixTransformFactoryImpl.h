@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedRgbMatrixTransformFACTORYIMPL_H
+#define KoOptimizedRgbMatrixTransformFACTORYIMPL_H
+
+#include <KoOptimizedRgbMatrixTransformBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoOptimizedRgbMatrixTransformFactoryImpl
+{
+public:
+    template<typename _impl>
+    static KoOptimizedRgbMatrixTransformBase* create();
+};
+
+#endif // KoOptimizedRgbMatrixTransformFACTORYIMPL_H
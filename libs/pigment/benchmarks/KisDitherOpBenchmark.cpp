@@ -0,0 +1,127 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KisDitherOpBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QVector>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KisDitherOp.h>
+
+const int NUM_COLUMNS = 512;
+const int NUM_ROWS = 256;
+
+void addBenchmarkRows()
+{
+    QTest::addColumn<KoID>("srcDepthId");
+    QTest::addColumn<KoID>("dstDepthId");
+    QTest::addColumn<int>("ditherType");
+
+    const QVector<QPair<KoID, KoID>> depths = {
+        {Float32BitsColorDepthID, Integer8BitsColorDepthID},
+        {Float32BitsColorDepthID, Integer16BitsColorDepthID},
+        {Integer16BitsColorDepthID, Integer8BitsColorDepthID}
+    };
+
+    Q_FOREACH (const auto &depth, depths) {
+        QTest::addRow("%s-%s-bayer", depth.first.id().toLatin1().constData(), depth.second.id().toLatin1().constData())
+            << depth.first << depth.second << int(DITHER_BAYER);
+        QTest::addRow("%s-%s-blue-noise", depth.first.id().toLatin1().constData(), depth.second.id().toLatin1().constData())
+            << depth.first << depth.second << int(DITHER_BLUE_NOISE);
+    }
+}
+
+struct DitherBuffers
+{
+    DitherBuffers(const KoColorSpace *srcCs, const KoColorSpace *dstCs)
+        : srcRowStride(NUM_COLUMNS * srcCs->pixelSize())
+        , dstRowStride(NUM_COLUMNS * dstCs->pixelSize())
+        , src(srcRowStride * NUM_ROWS)
+        , dst(dstRowStride * NUM_ROWS)
+    {
+        const int srcPixelSize = srcCs->pixelSize();
+        QVector<float> channels(srcCs->channelCount());
+
+        for (int i = 0; i < NUM_COLUMNS * NUM_ROWS; i++) {
+            for (int c = 0; c < channels.size(); c++) {
+                channels[c] = float((i * (c + 3)) % 1021) / 1020.0f;
+            }
+            srcCs->fromNormalisedChannelsValue(src.data() + i * srcPixelSize, channels);
+        }
+    }
+
+    const int srcRowStride;
+    const int dstRowStride;
+    QVector<quint8> src;
+    QVector<quint8> dst;
+};
+
+const KisDitherOp *fetchDitherOp(const KoColorSpace **srcCs, const KoColorSpace **dstCs)
+{
+    QFETCH(KoID, srcDepthId);
+    QFETCH(KoID, dstDepthId);
+    QFETCH(int, ditherType);
+
+    *srcCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), srcDepthId.id(), 0);
+    *dstCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), dstDepthId.id(), 0);
+
+    return (*srcCs)->ditherOp(dstDepthId.id(), DitherType(ditherType));
+}
+
+void KisDitherOpBenchmark::benchmarkPixelDither_data()
+{
+    addBenchmarkRows();
+}
+
+void KisDitherOpBenchmark::benchmarkPixelDither()
+{
+    const KoColorSpace *srcCs = nullptr;
+    const KoColorSpace *dstCs = nullptr;
+    const KisDitherOp *op = fetchDitherOp(&srcCs, &dstCs);
+    QVERIFY(op);
+
+    DitherBuffers buffers(srcCs, dstCs);
+
+    QBENCHMARK {
+        for (int y = 0; y < NUM_ROWS; y++) {
+            const quint8 *srcPtr = buffers.src.constData() + y * buffers.srcRowStride;
+            quint8 *dstPtr = buffers.dst.data() + y * buffers.dstRowStride;
+
+            for (int x = 0; x < NUM_COLUMNS; x++) {
+                op->dither(srcPtr, dstPtr, x, y);
+                srcPtr += srcCs->pixelSize();
+                dstPtr += dstCs->pixelSize();
+            }
+        }
+    }
+}
+
+void KisDitherOpBenchmark::benchmarkRowDither_data()
+{
+    addBenchmarkRows();
+}
+
+void KisDitherOpBenchmark::benchmarkRowDither()
+{
+    const KoColorSpace *srcCs = nullptr;
+    const KoColorSpace *dstCs = nullptr;
+    const KisDitherOp *op = fetchDitherOp(&srcCs, &dstCs);
+    QVERIFY(op);
+
+    DitherBuffers buffers(srcCs, dstCs);
+
+    QBENCHMARK {
+        op->dither(buffers.src.constData(), buffers.srcRowStride,
+                   buffers.dst.data(), buffers.dstRowStride,
+                   0, 0, NUM_COLUMNS, NUM_ROWS);
+    }
+}
+
+SIMPLE_TEST_MAIN(KisDitherOpBenchmark)
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _KIS_DITHER_OP_BENCHMARK_H_
+#define _KIS_DITHER_OP_BENCHMARK_H_
+
+#include <QObject>
+
+class KisDitherOpBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkPixelDither_data();
+    void benchmarkPixelDither();
+    void benchmarkRowDither_data();
+    void benchmarkRowDither();
+};
+
+#endif
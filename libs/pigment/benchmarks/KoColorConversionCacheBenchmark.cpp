@@ -0,0 +1,90 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoColorConversionCacheBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QVector>
+
+#include <KoColorSpaceRegistry.h>
+#include <KoColorSpace.h>
+
+/**
+ * The number of pixels is kept tiny on purpose: we measure the
+ * overhead of fetching the transformation from the cache, not the
+ * conversion itself (e.g. like the color sampler does)
+ */
+const int NUM_PIXELS = 4;
+const int NUM_CALLS_PER_THREAD = 200000;
+
+void KoColorConversionCacheBenchmark::benchmarkConversionCalls_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("16 threads") << 16;
+    QTest::newRow("32 threads") << 32;
+}
+
+void KoColorConversionCacheBenchmark::benchmarkConversionCalls()
+{
+    QFETCH(int, numThreads);
+
+    const KoColorSpace *rgb8 = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *rgb16 = KoColorSpaceRegistry::instance()->rgb16();
+    const KoColorSpace *lab16 = KoColorSpaceRegistry::instance()->lab16();
+
+    auto worker = [rgb8, rgb16, lab16] () {
+        QVector<quint8> src(NUM_PIXELS * rgb8->pixelSize(), 0x7f);
+        QVector<quint8> dst(NUM_PIXELS * qMax(rgb16->pixelSize(), lab16->pixelSize()));
+
+        // interleave several conversions, like the workers of
+        // a layer conversion and the display converter do
+        for (int i = 0; i < NUM_CALLS_PER_THREAD; i++) {
+            const KoColorSpace *dstCs = i & 0x1 ? rgb16 : lab16;
+            rgb8->convertPixelsTo(src.constData(), dst.data(), dstCs, NUM_PIXELS,
+                                  KoColorConversionTransformation::internalRenderingIntent(),
+                                  KoColorConversionTransformation::internalConversionFlags());
+        }
+    };
+
+    // warm up the shared cache
+    worker();
+
+    qint64 elapsedNSecs = 0;
+
+    QBENCHMARK {
+        QVector<QThread*> threads;
+        for (int i = 0; i < numThreads; i++) {
+            threads.append(QThread::create(worker));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        Q_FOREACH (QThread *thread, threads) {
+            thread->start();
+        }
+
+        Q_FOREACH (QThread *thread, threads) {
+            thread->wait();
+        }
+
+        elapsedNSecs = timer.nsecsElapsed();
+        qDeleteAll(threads);
+    }
+
+    const qreal callsPerSecond =
+        qreal(numThreads) * NUM_CALLS_PER_THREAD / (qMax(qint64(1), elapsedNSecs) / 1e9);
+
+    qDebug() << numThreads << "threads:" << qRound64(callsPerSecond) << "conversion calls/sec";
+}
+
+SIMPLE_TEST_MAIN(KoColorConversionCacheBenchmark)
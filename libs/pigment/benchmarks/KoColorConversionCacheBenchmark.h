@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _KO_COLOR_CONVERSION_CACHE_BENCHMARK_H_
+#define _KO_COLOR_CONVERSION_CACHE_BENCHMARK_H_
+
+#include <QObject>
+
+class KoColorConversionCacheBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkConversionCalls_data();
+    void benchmarkConversionCalls();
+};
+
+#endif
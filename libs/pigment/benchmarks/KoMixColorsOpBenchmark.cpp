@@ -0,0 +1,120 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoMixColorsOpBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QVector>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorModelStandardIdsUtils.h>
+#include <KoColorSpaceTraits.h>
+#include <KoMixColorsOpImpl.h>
+#include <KoOptimizedMixColorsOpFactory.h>
+
+/**
+ * Every benchmark iteration mixes the same total number of pixels,
+ * split into chunks of `numSamples` pixels, so the results for
+ * different sample counts are directly comparable
+ */
+const int TOTAL_PIXELS = 1 << 20;
+
+template <typename channels_type>
+struct CreateScalarMixColorsOp
+{
+    KoMixColorsOp *operator() () {
+        return new KoMixColorsOpImpl<KoColorSpaceTrait<channels_type, 4, 3>>();
+    }
+};
+
+template <typename channels_type>
+struct ChannelSize
+{
+    int operator() () {
+        return sizeof(channels_type);
+    }
+};
+
+void addBenchmarkRows()
+{
+    QTest::addColumn<KoID>("depthId");
+    QTest::addColumn<int>("numSamples");
+    QTest::addColumn<bool>("useWeights");
+
+    const QVector<KoID> depths = {Integer8BitsColorDepthID, Integer16BitsColorDepthID, Float32BitsColorDepthID};
+    const QVector<int> sampleCounts = {4, 16, 64, 256, 1024, 16384};
+
+    Q_FOREACH (const KoID &depth, depths) {
+        Q_FOREACH (int numSamples, sampleCounts) {
+            QTest::addRow("%s-%d-average", depth.id().toLatin1().constData(), numSamples) << depth << numSamples << false;
+            QTest::addRow("%s-%d-weighted", depth.id().toLatin1().constData(), numSamples) << depth << numSamples << true;
+        }
+    }
+}
+
+void runBenchmark(KoMixColorsOp *op)
+{
+    QFETCH(KoID, depthId);
+    QFETCH(int, numSamples);
+    QFETCH(bool, useWeights);
+
+    const int pixelSize = 4 * channelTypeForColorDepthId<ChannelSize>(depthId);
+
+    QVector<quint8> pixels(numSamples * pixelSize);
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = quint8(i * 37 + 11);
+    }
+
+    QVector<qint16> weights(numSamples);
+    int weightSum = 0;
+    for (int i = 0; i < numSamples; i++) {
+        weights[i] = (i * 13) % 256;
+        weightSum += weights[i];
+    }
+
+    QVector<quint8> result(pixelSize);
+    const int numChunks = TOTAL_PIXELS / numSamples;
+
+    QBENCHMARK {
+        for (int i = 0; i < numChunks; i++) {
+            if (useWeights) {
+                op->mixColors(pixels.constData(), weights.constData(), numSamples, result.data(), weightSum);
+            } else {
+                op->mixColors(pixels.constData(), numSamples, result.data());
+            }
+        }
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkScalar_data()
+{
+    addBenchmarkRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkScalar()
+{
+    QFETCH(KoID, depthId);
+
+    QScopedPointer<KoMixColorsOp> op(channelTypeForColorDepthId<CreateScalarMixColorsOp>(depthId));
+    runBenchmark(op.data());
+}
+
+void KoMixColorsOpBenchmark::benchmarkOptimized_data()
+{
+    addBenchmarkRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkOptimized()
+{
+    QFETCH(KoID, depthId);
+
+    QScopedPointer<KoMixColorsOp> op(KoOptimizedMixColorsOpFactory::create(depthId, 4, 3));
+    QVERIFY(op);
+    runBenchmark(op.data());
+}
+
+SIMPLE_TEST_MAIN(KoMixColorsOpBenchmark)
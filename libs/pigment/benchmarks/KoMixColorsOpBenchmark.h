@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _KO_MIX_COLORS_OP_BENCHMARK_H_
+#define _KO_MIX_COLORS_OP_BENCHMARK_H_
+
+#include <QObject>
+
+class KoMixColorsOpBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkScalar_data();
+    void benchmarkScalar();
+    void benchmarkOptimized_data();
+    void benchmarkOptimized();
+};
+
+#endif
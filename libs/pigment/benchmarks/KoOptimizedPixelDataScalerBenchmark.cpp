@@ -0,0 +1,142 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QScopedPointer>
+#include <QVector>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorModelStandardIdsUtils.h>
+#include <KoColorSpaceMaths.h>
+#include <KoOptimizedPixelDataScalerFactory.h>
+
+const int NUM_CHANNELS = 4;
+const int NUM_COLUMNS = 256;
+const int NUM_ROWS = 256;
+
+template <typename channel_type>
+struct ChannelSize
+{
+    int operator() () {
+        return sizeof(channel_type);
+    }
+};
+
+template <typename src_channel_type>
+struct ConvertScalar
+{
+    template <typename dst_channel_type>
+    struct ToDestination
+    {
+        void operator() (const quint8 *src, quint8 *dst, int numValues) {
+            const src_channel_type *srcValues = reinterpret_cast<const src_channel_type*>(src);
+            dst_channel_type *dstValues = reinterpret_cast<dst_channel_type*>(dst);
+
+            for (int i = 0; i < numValues; i++) {
+                dstValues[i] = KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(srcValues[i]);
+            }
+        }
+    };
+
+    void operator() (const KoID &dstDepthId, const quint8 *src, quint8 *dst, int numValues) {
+        channelTypeForColorDepthId<ToDestination>(dstDepthId, src, dst, numValues);
+    }
+};
+
+void addBenchmarkRows()
+{
+    QTest::addColumn<KoID>("srcDepthId");
+    QTest::addColumn<KoID>("dstDepthId");
+
+    const QVector<KoID> depths = {
+        Integer8BitsColorDepthID,
+        Integer16BitsColorDepthID,
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID,
+#endif
+        Float32BitsColorDepthID
+    };
+
+    Q_FOREACH (const KoID &src, depths) {
+        Q_FOREACH (const KoID &dst, depths) {
+            if (src == dst) continue;
+
+            QTest::addRow("%s-%s", src.id().toLatin1().constData(), dst.id().toLatin1().constData())
+                << src << dst;
+        }
+    }
+}
+
+struct ScalerBuffers
+{
+    ScalerBuffers(const KoID &srcDepthId, const KoID &dstDepthId)
+        : srcRowStride(NUM_COLUMNS * NUM_CHANNELS * channelTypeForColorDepthId<ChannelSize>(srcDepthId))
+        , dstRowStride(NUM_COLUMNS * NUM_CHANNELS * channelTypeForColorDepthId<ChannelSize>(dstDepthId))
+        , src(srcRowStride * NUM_ROWS)
+        , dst(dstRowStride * NUM_ROWS)
+    {
+        /**
+         * Zeroed data is a valid value for every channel type,
+         * the conversion speed doesn't depend on the values
+         */
+    }
+
+    const int srcRowStride;
+    const int dstRowStride;
+    QVector<quint8> src;
+    QVector<quint8> dst;
+};
+
+void KoOptimizedPixelDataScalerBenchmark::benchmarkScalar_data()
+{
+    addBenchmarkRows();
+}
+
+void KoOptimizedPixelDataScalerBenchmark::benchmarkScalar()
+{
+    QFETCH(KoID, srcDepthId);
+    QFETCH(KoID, dstDepthId);
+
+    ScalerBuffers buffers(srcDepthId, dstDepthId);
+
+    QBENCHMARK {
+        for (int row = 0; row < NUM_ROWS; row++) {
+            channelTypeForColorDepthId<ConvertScalar>(srcDepthId,
+                                                      dstDepthId,
+                                                      buffers.src.constData() + row * buffers.srcRowStride,
+                                                      buffers.dst.data() + row * buffers.dstRowStride,
+                                                      NUM_COLUMNS * NUM_CHANNELS);
+        }
+    }
+}
+
+void KoOptimizedPixelDataScalerBenchmark::benchmarkOptimized_data()
+{
+    addBenchmarkRows();
+}
+
+void KoOptimizedPixelDataScalerBenchmark::benchmarkOptimized()
+{
+    QFETCH(KoID, srcDepthId);
+    QFETCH(KoID, dstDepthId);
+
+    ScalerBuffers buffers(srcDepthId, dstDepthId);
+
+    QScopedPointer<KoOptimizedPixelDataScalerBase> scaler(
+        KoOptimizedPixelDataScalerFactory::create(srcDepthId, dstDepthId, NUM_CHANNELS));
+    QVERIFY(scaler);
+
+    QBENCHMARK {
+        scaler->convert(buffers.src.constData(), buffers.srcRowStride,
+                        buffers.dst.data(), buffers.dstRowStride,
+                        NUM_ROWS, NUM_COLUMNS);
+    }
+}
+
+SIMPLE_TEST_MAIN(KoOptimizedPixelDataScalerBenchmark)
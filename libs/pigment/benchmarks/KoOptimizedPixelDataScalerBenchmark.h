@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _KO_OPTIMIZED_PIXEL_DATA_SCALER_BENCHMARK_H_
+#define _KO_OPTIMIZED_PIXEL_DATA_SCALER_BENCHMARK_H_
+
+#include <QObject>
+
+class KoOptimizedPixelDataScalerBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkScalar_data();
+    void benchmarkScalar();
+    void benchmarkOptimized_data();
+    void benchmarkOptimized();
+};
+
+#endif
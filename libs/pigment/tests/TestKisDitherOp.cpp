@@ -0,0 +1,108 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKisDitherOp.h"
+
+#include <simpletest.h>
+
+#include <QRandomGenerator>
+#include <QVector>
+
+#include <KoColorModelStandardIdsUtils.h>
+#include <KoRgbColorSpaceTraits.h>
+
+#include "KisDitherOpImpl.h"
+
+namespace {
+
+template<typename SrcTraits, typename DstTraits, DitherType dType>
+void compareRowAndPixelDither(int x, int y, int columns, int rows)
+{
+    using src_channels_type = typename SrcTraits::channels_type;
+    using dst_channels_type = typename DstTraits::channels_type;
+
+    KisDitherOpImpl<SrcTraits, DstTraits, dType> op(colorDepthIdForChannelType<src_channels_type>(),
+                                                     colorDepthIdForChannelType<dst_channels_type>());
+
+    const int srcRowStride = columns * SrcTraits::pixelSize;
+    const int dstRowStride = columns * DstTraits::pixelSize;
+
+    QVector<quint8> src(srcRowStride * rows);
+    QVector<quint8> rowDst(dstRowStride * rows, 0);
+    QVector<quint8> pixelDst(dstRowStride * rows, 0);
+
+    QRandomGenerator random(12345);
+    src_channels_type *srcValues = reinterpret_cast<src_channels_type *>(src.data());
+    for (int i = 0; i < columns * rows * SrcTraits::channels_nb; i++) {
+        // include a few values out of the unit range to check the clamping
+        const qreal value = random.bounded(1.2) - 0.1;
+        srcValues[i] = KoColorSpaceMaths<float, src_channels_type>::scaleToA(value);
+    }
+
+    op.dither(src.constData(), srcRowStride, rowDst.data(), dstRowStride, x, y, columns, rows);
+
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < columns; col++) {
+            op.dither(src.constData() + row * srcRowStride + col * SrcTraits::pixelSize,
+                      pixelDst.data() + row * dstRowStride + col * DstTraits::pixelSize,
+                      x + col,
+                      y + row);
+        }
+    }
+
+    /**
+     * The per-arch objects are built with -ffp-contract=fast, so the
+     * vectorized kernel may fuse the dither blending into an FMA and
+     * round differently by one step of the destination depth
+     */
+    const dst_channels_type *rowValues = reinterpret_cast<const dst_channels_type *>(rowDst.constData());
+    const dst_channels_type *pixelValues = reinterpret_cast<const dst_channels_type *>(pixelDst.constData());
+
+    for (int i = 0; i < columns * rows * DstTraits::channels_nb; i++) {
+        if (qAbs(int(rowValues[i]) - int(pixelValues[i])) > 1) {
+            qDebug() << "value" << i << "row dither" << rowValues[i] << "pixel dither" << pixelValues[i];
+            QFAIL("row dither differs from the per-pixel dither");
+        }
+    }
+}
+
+template<DitherType dType>
+void compareAllDepths(int x, int y, int columns, int rows)
+{
+    compareRowAndPixelDither<KoRgbF32Traits, KoRgbU8Traits, dType>(x, y, columns, rows);
+    compareRowAndPixelDither<KoRgbF32Traits, KoRgbU16Traits, dType>(x, y, columns, rows);
+    compareRowAndPixelDither<KoRgbU16Traits, KoRgbU8Traits, dType>(x, y, columns, rows);
+    compareRowAndPixelDither<KoRgbU8Traits, KoRgbU8Traits, dType>(x, y, columns, rows);
+}
+
+} // namespace
+
+void TestKisDitherOp::testRowDitherMatchesPixelDither_data()
+{
+    QTest::addColumn<int>("x");
+    QTest::addColumn<int>("y");
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("rows");
+
+    QTest::newRow("single-pixel") << 0 << 0 << 1 << 1;
+    QTest::newRow("short-row") << 3 << 5 << 7 << 3;
+    QTest::newRow("pattern-wrap") << 61 << 17 << 130 << 4;
+    QTest::newRow("negative-offset") << -37 << -2 << 200 << 3;
+    QTest::newRow("large") << 0 << 0 << 512 << 9;
+}
+
+void TestKisDitherOp::testRowDitherMatchesPixelDither()
+{
+    QFETCH(int, x);
+    QFETCH(int, y);
+    QFETCH(int, columns);
+    QFETCH(int, rows);
+
+    compareAllDepths<DITHER_BAYER>(x, y, columns, rows);
+    compareAllDepths<DITHER_BLUE_NOISE>(x, y, columns, rows);
+}
+
+QTEST_GUILESS_MAIN(TestKisDitherOp)
@@ -0,0 +1,212 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoColorQuantizationIndex.h"
+
+#include <simpletest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include <QVector3D>
+#include <QVector>
+
+#include <KoColorQuantizationIndex.h>
+
+namespace {
+
+const int NUM_QUERIES = 20000;
+
+double weightedDistance(const quint16 *a, const quint16 *b, const QVector3D &weights)
+{
+    const double dx = weights.x() * (double(a[0]) - b[0]);
+    const double dy = weights.y() * (double(a[1]) - b[1]);
+    const double dz = weights.z() * (double(a[2]) - b[2]);
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * The stable sort keeps the lower indices first among the entries
+ * at the same distance
+ */
+QVector<int> linearScan(const QVector<quint16> &entries, const quint16 *color,
+                        const QVector3D &weights, QVector<double> *distances)
+{
+    const int numEntries = entries.size() / 3;
+
+    distances->resize(numEntries);
+    for (int i = 0; i < numEntries; i++) {
+        (*distances)[i] = weightedDistance(entries.constData() + 3 * i, color, weights);
+    }
+
+    QVector<int> order(numEntries);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [distances] (int lhs, int rhs) {
+                         return (*distances)[lhs] < (*distances)[rhs];
+                     });
+    return order;
+}
+
+}
+
+void TestKoColorQuantizationIndex::testMatchesLinearScan_data()
+{
+    QTest::addColumn<int>("numEntries");
+    QTest::addColumn<int>("maxNeighbours");
+    QTest::addColumn<QVector3D>("weights");
+
+    QTest::newRow("1-nearest") << 1 << 1 << QVector3D(1, 1, 1);
+    QTest::newRow("16-nearest") << 16 << 1 << QVector3D(1, 1, 1);
+    QTest::newRow("256-nearest") << 256 << 1 << QVector3D(1, 1, 1);
+    QTest::newRow("256-weighted") << 256 << 1 << QVector3D(2.0f, 0.5f, 1.0f);
+    QTest::newRow("2-two") << 2 << 2 << QVector3D(1, 1, 1);
+    QTest::newRow("64-two") << 64 << 2 << QVector3D(1, 1, 1);
+    QTest::newRow("1000-two") << 1000 << 2 << QVector3D(1, 1, 1);
+}
+
+void TestKoColorQuantizationIndex::testMatchesLinearScan()
+{
+    QFETCH(int, numEntries);
+    QFETCH(int, maxNeighbours);
+    QFETCH(QVector3D, weights);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(0, 65535);
+
+    QVector<quint16> entries(numEntries * 3);
+    for (quint16 &value : entries) {
+        value = quint16(dis(gen));
+    }
+
+    QVector<quint16> queries(NUM_QUERIES * 4);
+    for (quint16 &value : queries) {
+        value = quint16(dis(gen));
+    }
+
+    KoColorQuantizationIndex index(entries, maxNeighbours, weights);
+    QCOMPARE(index.size(), numEntries);
+
+    QVector<int> batchResult(NUM_QUERIES);
+    index.nearestBatch(queries.constData(), 4, NUM_QUERIES, batchResult.data());
+
+    QVector<double> expectedDistances;
+
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        const quint16 *color = queries.constData() + 4 * i;
+        const QVector<int> expected = linearScan(entries, color, weights, &expectedDistances);
+
+        int indices[2] = {-1, -1};
+        float distances[2] = {-1.0f, -1.0f};
+
+        const int count = qMin(maxNeighbours, numEntries);
+        QCOMPARE(index.nearest(color, maxNeighbours, indices, distances), count);
+
+        /**
+         * The index computes the distances in floats, so the entries at
+         * almost the same distance may come in a different order
+         */
+        for (int n = 0; n < count; n++) {
+            if (indices[n] != expected[n]) {
+                QVERIFY(qAbs(expectedDistances[indices[n]] - expectedDistances[expected[n]]) < 1e-3 * expectedDistances[expected[n]] + 1e-3);
+            }
+            QVERIFY(qAbs(distances[n] - expectedDistances[expected[n]]) < 1e-3 * expectedDistances[expected[n]] + 1e-2);
+        }
+
+        QCOMPARE(index.nearest(color), indices[0]);
+        QCOMPARE(batchResult[i], indices[0]);
+    }
+}
+
+void TestKoColorQuantizationIndex::testTies()
+{
+    const QVector<quint16> entries = {
+        1000, 1000, 1000,
+        3000, 1000, 1000,
+        3000, 1000, 1000,
+        5000, 1000, 1000
+    };
+
+    KoColorQuantizationIndex index(entries, 2);
+
+    const quint16 middle[3] = {2000, 1000, 1000};
+    QCOMPARE(index.nearest(middle), 0);
+
+    int indices[2];
+    QCOMPARE(index.nearest(middle, 2, indices, nullptr), 2);
+    QCOMPARE(indices[0], 0);
+    QCOMPARE(indices[1], 1);
+
+    const quint16 duplicate[3] = {3000, 1000, 1000};
+    QCOMPARE(index.nearest(duplicate, 2, indices, nullptr), 2);
+    QCOMPARE(indices[0], 1);
+    QCOMPARE(indices[1], 2);
+}
+
+void TestKoColorQuantizationIndex::testTiesAtCellBoundary()
+{
+    /**
+     * Two entries make a grid of 8 cells along every axis, i.e. the
+     * cells are 8192 wide. The entries lie in the neighbouring cells
+     * at the same distance from the boundary between them, so a color
+     * at the boundary has an exact tie. The lowest index should win
+     * whichever cell the color falls into.
+     */
+    const QVector<QVector<quint16>> entrySets = {
+        {8000, 1000, 1000,  8384, 1000, 1000},
+        {8384, 1000, 1000,  8000, 1000, 1000}
+    };
+
+    const quint16 boundary[3] = {8192, 1000, 1000};
+    const quint16 beforeBoundary[3] = {8191, 1000, 1000};
+
+    Q_FOREACH (const QVector<quint16> &points, entrySets) {
+        KoColorQuantizationIndex index(points);
+
+        QCOMPARE(index.nearest(boundary), 0);
+
+        int batchResult = -1;
+        index.nearestBatch(boundary, 3, 1, &batchResult);
+        QCOMPARE(batchResult, 0);
+
+        const int expected = points[0] == 8000 ? 0 : 1;
+        QCOMPARE(index.nearest(beforeBoundary), expected);
+
+        index.nearestBatch(beforeBoundary, 3, 1, &batchResult);
+        QCOMPARE(batchResult, expected);
+    }
+}
+
+void TestKoColorQuantizationIndex::testEmpty()
+{
+    KoColorQuantizationIndex index(QVector<quint16>(), 2);
+
+    const quint16 color[3] = {0, 0, 0};
+    int indices[2] = {-1, -1};
+
+    QCOMPARE(index.size(), 0);
+    QCOMPARE(index.nearest(color), -1);
+    QCOMPARE(index.nearest(color, 2, indices, nullptr), 0);
+
+    int batchResult = 0;
+    index.nearestBatch(color, 3, 1, &batchResult);
+    QCOMPARE(batchResult, -1);
+}
+
+void TestKoColorQuantizationIndex::testCache()
+{
+    QSharedPointer<const KoColorQuantizationIndex> cached1 =
+        KoColorQuantizationIndex::fromCache({1, 2, 3, 4, 5, 6});
+    QSharedPointer<const KoColorQuantizationIndex> cached2 =
+        KoColorQuantizationIndex::fromCache({1, 2, 3, 4, 5, 6});
+
+    QCOMPARE(cached1.data(), cached2.data());
+    QCOMPARE(cached1->size(), 2);
+}
+
+SIMPLE_TEST_MAIN(TestKoColorQuantizationIndex)
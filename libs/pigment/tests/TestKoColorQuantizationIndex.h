@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOCOLORQUANTIZATIONINDEX_H
+#define TESTKOCOLORQUANTIZATIONINDEX_H
+
+#include <QObject>
+
+class TestKoColorQuantizationIndex : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testMatchesLinearScan_data();
+    void testMatchesLinearScan();
+    void testTies();
+    void testTiesAtCellBoundary();
+    void testEmpty();
+    void testCache();
+};
+
+#endif // TESTKOCOLORQUANTIZATIONINDEX_H
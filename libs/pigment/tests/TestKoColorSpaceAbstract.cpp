@@ -6,8 +6,10 @@
 
 #include "KoColorSpaceAbstract.h"
 #include "KoColorSpaceTraits.h"
+#include "KoOptimizedMixColorsOpFactory.h"
 
 #include <cfloat>
+#include <random>
 
 #include <simpletest.h>
 
@@ -420,6 +422,100 @@ QBitArray makeChannelFlags(std::initializer_list<bool> flags)
     return result;
 }
 
+template <typename channels_type>
+void testOptimizedMixColorsOpImpl(int numPixels)
+{
+    using Traits = KoColorSpaceTrait<channels_type, 4, 3>;
+
+    QScopedPointer<KoMixColorsOp> referenceOp(new KoMixColorsOpImpl<Traits>());
+    QScopedPointer<KoMixColorsOp> optimizedOp(
+        KoOptimizedMixColorsOpFactory::create(colorDepthIdForChannelType<channels_type>(), 4, 3));
+    QVERIFY(optimizedOp);
+
+    std::mt19937 gen(numPixels);
+    std::uniform_real_distribution<float> channelDis(0.0f, 1.0f);
+    std::uniform_int_distribution<int> weightDis(0, 255);
+
+    QVector<channels_type> pixels(numPixels * Traits::channels_nb);
+    QVector<qint16> weights(numPixels);
+    int weightSum = 0;
+
+    for (int i = 0; i < numPixels * Traits::channels_nb; i++) {
+        pixels[i] = KoColorSpaceMaths<float, channels_type>::scaleToA(channelDis(gen));
+    }
+
+    for (int i = 0; i < numPixels; i++) {
+        weights[i] = weightDis(gen);
+        weightSum += weights[i];
+    }
+
+    const quint8 *data = reinterpret_cast<const quint8*>(pixels.constData());
+
+    auto compareResults = [] (const channels_type *reference, const channels_type *result) {
+        for (int i = 0; i < Traits::channels_nb; i++) {
+            if (std::numeric_limits<channels_type>::is_integer) {
+                QCOMPARE(result[i], reference[i]);
+            } else {
+                QVERIFY(qAbs(float(result[i]) - float(reference[i])) < 1e-5f);
+            }
+        }
+    };
+
+    channels_type reference[Traits::channels_nb];
+    channels_type result[Traits::channels_nb];
+
+    referenceOp->mixColors(data, numPixels, reinterpret_cast<quint8*>(reference));
+    optimizedOp->mixColors(data, numPixels, reinterpret_cast<quint8*>(result));
+    compareResults(reference, result);
+
+    referenceOp->mixColors(data, weights.constData(), numPixels, reinterpret_cast<quint8*>(reference), weightSum);
+    optimizedOp->mixColors(data, weights.constData(), numPixels, reinterpret_cast<quint8*>(result), weightSum);
+    compareResults(reference, result);
+
+    QScopedPointer<KoMixColorsOp::Mixer> referenceMixer(referenceOp->createMixer());
+    QScopedPointer<KoMixColorsOp::Mixer> optimizedMixer(optimizedOp->createMixer());
+
+    referenceMixer->accumulateAverage(data, numPixels);
+    optimizedMixer->accumulateAverage(data, numPixels);
+    referenceMixer->accumulate(data, weights.constData(), weightSum, numPixels);
+    optimizedMixer->accumulate(data, weights.constData(), weightSum, numPixels);
+
+    QCOMPARE(optimizedMixer->currentWeightsSum(), referenceMixer->currentWeightsSum());
+
+    referenceMixer->computeMixedColor(reinterpret_cast<quint8*>(reference));
+    optimizedMixer->computeMixedColor(reinterpret_cast<quint8*>(result));
+    compareResults(reference, result);
+}
+
+void TestKoColorSpaceAbstract::testOptimizedMixColorsOp_data()
+{
+    QTest::addColumn<KoID>("depthId");
+    QTest::addColumn<int>("numPixels");
+
+    const QVector<KoID> depths = {Integer8BitsColorDepthID, Integer16BitsColorDepthID, Float32BitsColorDepthID};
+    const QVector<int> sizes = {1, 7, 64, 1000, 100000};
+
+    Q_FOREACH (const KoID &depth, depths) {
+        Q_FOREACH (int size, sizes) {
+            QTest::addRow("%s-%d", depth.id().toLatin1().constData(), size) << depth << size;
+        }
+    }
+}
+
+void TestKoColorSpaceAbstract::testOptimizedMixColorsOp()
+{
+    QFETCH(KoID, depthId);
+    QFETCH(int, numPixels);
+
+    if (depthId == Integer8BitsColorDepthID) {
+        testOptimizedMixColorsOpImpl<quint8>(numPixels);
+    } else if (depthId == Integer16BitsColorDepthID) {
+        testOptimizedMixColorsOpImpl<quint16>(numPixels);
+    } else {
+        testOptimizedMixColorsOpImpl<float>(numPixels);
+    }
+}
+
 void TestKoColorSpaceAbstract::testBitBltCrossColorSpaceWithChannelFlags_data()
 {
     QTest::addColumn<KoColor>("srcColor");
@@ -0,0 +1,292 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoColorTransformationLutCompiler.h"
+
+#include <simpletest.h>
+
+#include <QScopedPointer>
+#include <QVector>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorTransformation.h>
+#include <KoColorTransformationLutCompiler.h>
+#include <KoCompositeColorTransformation.h>
+
+namespace {
+
+const int NUM_PIXELS = 4099;
+
+/**
+ * Inverts the color channels and halves the alpha channel
+ */
+template <typename channel_type>
+class TestChannelwiseTransformation : public KoColorTransformation
+{
+public:
+    void transform(const quint8 *srcU8, quint8 *dstU8, qint32 nPixels) const override
+    {
+        const channel_type *src = reinterpret_cast<const channel_type*>(srcU8);
+        channel_type *dst = reinterpret_cast<channel_type*>(dstU8);
+        const int unitValue = KoColorSpaceMathsTraits<channel_type>::unitValue;
+
+        for (int i = 0; i < nPixels * 4; i += 4) {
+            dst[i + 0] = channel_type(unitValue - src[i + 0]);
+            dst[i + 1] = channel_type(unitValue - src[i + 1]);
+            dst[i + 2] = channel_type(unitValue - src[i + 2]);
+            dst[i + 3] = channel_type(src[i + 3] / 2);
+        }
+    }
+
+    PixelDependency pixelDependency() const override
+    {
+        return ChannelwiseDependency;
+    }
+};
+
+/**
+ * Rotates the color channels and replaces the last one with the
+ * average of all the channels. Optionally inverts the alpha channel.
+ */
+template <typename channel_type>
+class TestColorTransformation : public KoColorTransformation
+{
+public:
+    TestColorTransformation(bool invertAlpha)
+        : m_invertAlpha(invertAlpha)
+    {
+    }
+
+    void transform(const quint8 *srcU8, quint8 *dstU8, qint32 nPixels) const override
+    {
+        const channel_type *src = reinterpret_cast<const channel_type*>(srcU8);
+        channel_type *dst = reinterpret_cast<channel_type*>(dstU8);
+        const int unitValue = KoColorSpaceMathsTraits<channel_type>::unitValue;
+
+        for (int i = 0; i < nPixels * 4; i += 4) {
+            const int average = (int(src[i + 0]) + src[i + 1] + src[i + 2]) / 3;
+            const channel_type first = src[i + 0];
+
+            dst[i + 0] = src[i + 2];
+            dst[i + 1] = first;
+            dst[i + 2] = channel_type(average);
+            dst[i + 3] = m_invertAlpha ? channel_type(unitValue - src[i + 3]) : src[i + 3];
+        }
+    }
+
+    PixelDependency pixelDependency() const override
+    {
+        return ColorDependency;
+    }
+
+private:
+    bool m_invertAlpha;
+};
+
+class TestArbitraryTransformation : public KoColorTransformation
+{
+public:
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override
+    {
+        memcpy(dst, src, nPixels * 4);
+    }
+};
+
+template <typename channel_type>
+QVector<channel_type> sourcePixels()
+{
+    const int maxValue = int(KoColorSpaceMathsTraits<channel_type>::unitValue);
+
+    QVector<channel_type> pixels(NUM_PIXELS * 4);
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = channel_type((qint64(i) * 7919) % (maxValue + 1));
+    }
+
+    // make sure the extremes are tested as well
+    std::fill_n(pixels.begin(), 4, channel_type(0));
+    std::fill_n(pixels.begin() + 4, 4, channel_type(maxValue));
+
+    return pixels;
+}
+
+template <typename channel_type>
+int maxDifference(const QVector<const KoColorTransformation*> &chain,
+                  const KoColorTransformation *compiled,
+                  bool *alphaIsExact)
+{
+    const QVector<channel_type> src = sourcePixels<channel_type>();
+    QVector<channel_type> expected(src.size());
+    QVector<channel_type> result(src.size());
+
+    for (int i = 0; i < chain.size(); i++) {
+        const channel_type *from = i == 0 ? src.constData() : expected.constData();
+        chain[i]->transform(reinterpret_cast<const quint8*>(from),
+                            reinterpret_cast<quint8*>(expected.data()), NUM_PIXELS);
+    }
+
+    compiled->transform(reinterpret_cast<const quint8*>(src.constData()),
+                        reinterpret_cast<quint8*>(result.data()), NUM_PIXELS);
+
+    int difference = 0;
+    *alphaIsExact = true;
+
+    for (int i = 0; i < src.size(); i++) {
+        difference = qMax(difference, qAbs(int(expected[i]) - int(result[i])));
+
+        if (i % 4 == 3 && expected[i] != result[i]) {
+            *alphaIsExact = false;
+        }
+    }
+
+    return difference;
+}
+
+const KoColorSpace* colorSpaceForDepth(const KoID &depthId)
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthId.id(), 0);
+}
+
+}
+
+void TestKoColorTransformationLutCompiler::testChannelwise_data()
+{
+    QTest::addColumn<QString>("depthId");
+
+    QTest::newRow("U8") << Integer8BitsColorDepthID.id();
+    QTest::newRow("U16") << Integer16BitsColorDepthID.id();
+}
+
+void TestKoColorTransformationLutCompiler::testChannelwise()
+{
+    QFETCH(QString, depthId);
+
+    const KoColorSpace *cs = colorSpaceForDepth(KoID(depthId));
+    QVERIFY(cs);
+
+    const bool isU8 = depthId == Integer8BitsColorDepthID.id();
+
+    QScopedPointer<KoColorTransformation> first(isU8 ?
+        static_cast<KoColorTransformation*>(new TestChannelwiseTransformation<quint8>()) :
+        static_cast<KoColorTransformation*>(new TestChannelwiseTransformation<quint16>()));
+    QScopedPointer<KoColorTransformation> second(isU8 ?
+        static_cast<KoColorTransformation*>(new TestChannelwiseTransformation<quint8>()) :
+        static_cast<KoColorTransformation*>(new TestChannelwiseTransformation<quint16>()));
+
+    const QVector<const KoColorTransformation*> chain({first.data(), second.data()});
+
+    QCOMPARE(KoColorTransformationLutCompiler::compilationCost(cs, chain),
+             qint64(isU8 ? 256 : 65536));
+
+    QScopedPointer<KoColorTransformation> compiled(KoColorTransformationLutCompiler::compile(cs, chain));
+    QVERIFY(compiled);
+    QCOMPARE(compiled->pixelDependency(), KoColorTransformation::ChannelwiseDependency);
+
+    bool alphaIsExact = false;
+    const int difference = isU8 ?
+        maxDifference<quint8>(chain, compiled.data(), &alphaIsExact) :
+        maxDifference<quint16>(chain, compiled.data(), &alphaIsExact);
+
+    QCOMPARE(difference, 0);
+    QVERIFY(alphaIsExact);
+}
+
+void TestKoColorTransformationLutCompiler::testColorLut3D_data()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<bool>("invertAlpha");
+
+    QTest::newRow("U8") << Integer8BitsColorDepthID.id() << false;
+    QTest::newRow("U8-alpha") << Integer8BitsColorDepthID.id() << true;
+    QTest::newRow("U16") << Integer16BitsColorDepthID.id() << false;
+    QTest::newRow("U16-alpha") << Integer16BitsColorDepthID.id() << true;
+}
+
+void TestKoColorTransformationLutCompiler::testColorLut3D()
+{
+    QFETCH(QString, depthId);
+    QFETCH(bool, invertAlpha);
+
+    const KoColorSpace *cs = colorSpaceForDepth(KoID(depthId));
+    QVERIFY(cs);
+
+    const bool isU8 = depthId == Integer8BitsColorDepthID.id();
+
+    QScopedPointer<KoColorTransformation> transformation(isU8 ?
+        static_cast<KoColorTransformation*>(new TestColorTransformation<quint8>(invertAlpha)) :
+        static_cast<KoColorTransformation*>(new TestColorTransformation<quint16>(invertAlpha)));
+
+    const QVector<const KoColorTransformation*> chain({transformation.data()});
+
+    QVERIFY(KoColorTransformationLutCompiler::compilationCost(cs, chain) > 0);
+    QCOMPARE(KoColorTransformationLutCompiler::compilationCost(cs, chain, false), qint64(-1));
+    QVERIFY(!KoColorTransformationLutCompiler::compile(cs, chain, false));
+
+    QScopedPointer<KoColorTransformation> compiled(KoColorTransformationLutCompiler::compile(cs, chain));
+    QVERIFY(compiled);
+    QCOMPARE(compiled->pixelDependency(), KoColorTransformation::ColorDependency);
+
+    bool alphaIsExact = false;
+    const int difference = isU8 ?
+        maxDifference<quint8>(chain, compiled.data(), &alphaIsExact) :
+        maxDifference<quint16>(chain, compiled.data(), &alphaIsExact);
+
+    /**
+     * The test transformation is linear, so the interpolation is
+     * exact except for the rounding of the average in the nodes
+     */
+    QVERIFY2(difference <= 2, QString("difference: %1").arg(difference).toLatin1());
+    QVERIFY(alphaIsExact);
+}
+
+void TestKoColorTransformationLutCompiler::testChainDependency()
+{
+    QVector<KoColorTransformation*> transformations;
+    transformations << new TestChannelwiseTransformation<quint8>();
+    transformations << new TestChannelwiseTransformation<quint8>();
+
+    QScopedPointer<KoColorTransformation> composite(
+        KoCompositeColorTransformation::createOptimizedCompositeTransform(transformations));
+    QCOMPARE(composite->pixelDependency(), KoColorTransformation::ChannelwiseDependency);
+
+    transformations.clear();
+    transformations << new TestChannelwiseTransformation<quint8>();
+    transformations << new TestColorTransformation<quint8>(false);
+
+    composite.reset(KoCompositeColorTransformation::createOptimizedCompositeTransform(transformations));
+    QCOMPARE(composite->pixelDependency(), KoColorTransformation::ColorDependency);
+
+    transformations.clear();
+    transformations << new TestColorTransformation<quint8>(false);
+    transformations << new TestArbitraryTransformation();
+
+    composite.reset(KoCompositeColorTransformation::createOptimizedCompositeTransform(transformations));
+    QCOMPARE(composite->pixelDependency(), KoColorTransformation::ArbitraryDependency);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QVector<const KoColorTransformation*> chain({composite.data()});
+
+    QCOMPARE(KoColorTransformationLutCompiler::compilationCost(cs, chain), qint64(-1));
+    QVERIFY(!KoColorTransformationLutCompiler::compile(cs, chain));
+}
+
+void TestKoColorTransformationLutCompiler::testUnsupported()
+{
+    TestChannelwiseTransformation<quint8> transformation;
+    const QVector<const KoColorTransformation*> chain({&transformation});
+
+    const KoColorSpace *floatCs = KoColorSpaceRegistry::instance()->alpha32f();
+    QCOMPARE(KoColorTransformationLutCompiler::compilationCost(floatCs, chain), qint64(-1));
+    QVERIFY(!KoColorTransformationLutCompiler::compile(floatCs, chain));
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QCOMPARE(KoColorTransformationLutCompiler::compilationCost(cs, {}), qint64(-1));
+    QVERIFY(!KoColorTransformationLutCompiler::compile(cs, {}));
+}
+
+SIMPLE_TEST_MAIN(TestKoColorTransformationLutCompiler)
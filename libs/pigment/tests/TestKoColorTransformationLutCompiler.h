@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOCOLORTRANSFORMATIONLUTCOMPILER_H
+#define TESTKOCOLORTRANSFORMATIONLUTCOMPILER_H
+
+#include <QObject>
+
+class TestKoColorTransformationLutCompiler : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testChannelwise_data();
+    void testChannelwise();
+    void testColorLut3D_data();
+    void testColorLut3D();
+    void testChainDependency();
+    void testUnsupported();
+};
+
+#endif // TESTKOCOLORTRANSFORMATIONLUTCOMPILER_H
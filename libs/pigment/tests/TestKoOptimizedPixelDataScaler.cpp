@@ -0,0 +1,154 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoOptimizedPixelDataScaler.h"
+
+#include <simpletest.h>
+
+#include <QScopedPointer>
+#include <QVector>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorModelStandardIdsUtils.h>
+#include <KoColorSpaceMaths.h>
+#include <KoOptimizedPixelDataScalerFactory.h>
+
+namespace {
+
+const int NUM_CHANNELS = 4;
+
+/**
+ * Fills the source with the values covering the whole range of the
+ * type, including the ones outside of the unit range for the floating
+ * point types
+ */
+template <typename channel_type>
+struct FillSource
+{
+    void operator() (quint8 *data, int numValues) {
+        channel_type *values = reinterpret_cast<channel_type*>(data);
+
+        if (std::numeric_limits<channel_type>::is_integer) {
+            const int maxValue = int(KoColorSpaceMathsTraits<channel_type>::unitValue);
+            for (int i = 0; i < numValues; i++) {
+                values[i] = channel_type((i * 7919) % (maxValue + 1));
+            }
+        } else {
+            for (int i = 0; i < numValues; i++) {
+                values[i] = channel_type(-0.25f + 1.5f * float((i * 7919) % 65536) / 65535.0f);
+            }
+        }
+    }
+};
+
+template <typename channel_type>
+struct ChannelSize
+{
+    int operator() () {
+        return sizeof(channel_type);
+    }
+};
+
+template <typename src_channel_type>
+struct ConvertReference
+{
+    template <typename dst_channel_type>
+    struct ToDestination
+    {
+        void operator() (const quint8 *src, quint8 *dst, int numValues) {
+            const src_channel_type *srcValues = reinterpret_cast<const src_channel_type*>(src);
+            dst_channel_type *dstValues = reinterpret_cast<dst_channel_type*>(dst);
+
+            for (int i = 0; i < numValues; i++) {
+                dstValues[i] = KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(srcValues[i]);
+            }
+        }
+    };
+
+    void operator() (const KoID &dstDepthId, const quint8 *src, quint8 *dst, int numValues) {
+        channelTypeForColorDepthId<ToDestination>(dstDepthId, src, dst, numValues);
+    }
+};
+
+} // namespace
+
+void TestKoOptimizedPixelDataScaler::testConversion_data()
+{
+    QTest::addColumn<KoID>("srcDepthId");
+    QTest::addColumn<KoID>("dstDepthId");
+
+    const QVector<KoID> depths = {
+        Integer8BitsColorDepthID,
+        Integer16BitsColorDepthID,
+#ifdef HAVE_OPENEXR
+        Float16BitsColorDepthID,
+#endif
+        Float32BitsColorDepthID
+    };
+
+    Q_FOREACH (const KoID &src, depths) {
+        Q_FOREACH (const KoID &dst, depths) {
+            if (src == dst) continue;
+
+            QTest::addRow("%s-%s", src.id().toLatin1().constData(), dst.id().toLatin1().constData())
+                << src << dst;
+        }
+    }
+}
+
+void TestKoOptimizedPixelDataScaler::testConversion()
+{
+    QFETCH(KoID, srcDepthId);
+    QFETCH(KoID, dstDepthId);
+
+    QScopedPointer<KoOptimizedPixelDataScalerBase> scaler(
+        KoOptimizedPixelDataScalerFactory::create(srcDepthId, dstDepthId, NUM_CHANNELS));
+    QVERIFY(scaler);
+
+    const int srcChannelSize = channelTypeForColorDepthId<ChannelSize>(srcDepthId);
+    const int dstChannelSize = channelTypeForColorDepthId<ChannelSize>(dstDepthId);
+
+    // an odd number of columns to test the scalar tail too
+    const int numColumns = 4099;
+    const int numRows = 3;
+
+    // rows are padded to check that the strides are respected
+    const int srcRowStride = (numColumns + 3) * NUM_CHANNELS * srcChannelSize;
+    const int dstRowStride = (numColumns + 5) * NUM_CHANNELS * dstChannelSize;
+
+    QVector<quint8> src(srcRowStride * numRows);
+    QVector<quint8> dst(dstRowStride * numRows, 0);
+    QVector<quint8> reference(dstRowStride * numRows, 0);
+
+    channelTypeForColorDepthId<FillSource>(srcDepthId, src.data(), src.size() / srcChannelSize);
+
+    scaler->convert(src.constData(), srcRowStride, dst.data(), dstRowStride, numRows, numColumns);
+
+    for (int row = 0; row < numRows; row++) {
+        channelTypeForColorDepthId<ConvertReference>(srcDepthId,
+                                                     dstDepthId,
+                                                     src.constData() + row * srcRowStride,
+                                                     reference.data() + row * dstRowStride,
+                                                     numColumns * NUM_CHANNELS);
+    }
+
+    for (int i = 0; i < dst.size(); i++) {
+        if (dst[i] != reference[i]) {
+            qDebug() << "byte" << i << "row" << i / dstRowStride
+                     << "optimized" << dst[i] << "reference" << reference[i];
+            QFAIL("the optimized conversion differs from KoColorSpaceMaths");
+        }
+    }
+}
+
+void TestKoOptimizedPixelDataScaler::testUnsupportedDepths()
+{
+    QVERIFY(!KoOptimizedPixelDataScalerFactory::create(Integer8BitsColorDepthID, Integer8BitsColorDepthID, 4));
+    QVERIFY(!KoOptimizedPixelDataScalerFactory::create(Float64BitsColorDepthID, Integer8BitsColorDepthID, 4));
+    QVERIFY(!KoOptimizedPixelDataScalerFactory::create(Float32BitsColorDepthID, Float64BitsColorDepthID, 4));
+}
+
+QTEST_GUILESS_MAIN(TestKoOptimizedPixelDataScaler)
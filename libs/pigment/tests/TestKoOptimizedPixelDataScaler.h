@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDPIXELDATASCALER_H
+#define TESTKOOPTIMIZEDPIXELDATASCALER_H
+
+#include <QObject>
+
+class TestKoOptimizedPixelDataScaler : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testConversion_data();
+    void testConversion();
+    void testUnsupportedDepths();
+};
+
+#endif // TESTKOOPTIMIZEDPIXELDATASCALER_H
@@ -84,6 +84,7 @@
 #include "kis_canvas_updates_compressor.h"
 
 #include <KisStrokeSpeedMonitor.h>
+#include <KisStrokeLatencyTracker.h>
 #include "opengl/kis_opengl_canvas_debugger.h"
 
 #include "kis_wrapped_rect.h"
@@ -874,6 +875,11 @@ void KisCanvas2::updateCanvasProjection()
         const QRect vRect = std::accumulate(viewportRects.constBegin(), viewportRects.constEnd(),
                                             QRect(), std::bit_or<QRect>());
 
+        KisStrokeLatencyTracker *latencyTracker = KisStrokeLatencyTracker::instance();
+        Q_FOREACH (KisUpdateInfoSP info, infoObjects) {
+            latencyTracker->notifyImageRectUploaded(info->dirtyImageRect());
+        }
+
         tryIssueCanvasUpdates(vRect);
     };
 
@@ -44,6 +44,7 @@
 
 #include <KoCanvasController.h>
 #include <KisRepaintDebugger.h>
+#include <KisStrokeLatencyTracker.h>
 #include <KisDisplayConfig.h>
 
 class KisQPainterCanvas::Private
@@ -121,6 +122,8 @@ void KisQPainterCanvas::paintEvent(QPaintEvent * ev)
 
     gc.end();
     m_d->repaintDbg.paint(this, ev);
+
+    KisStrokeLatencyTracker::instance()->notifyFramePresented();
 }
 
 void KisQPainterCanvas::drawImage(QPainter & gc, const QRect &updateWidgetRect) const
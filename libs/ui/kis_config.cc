@@ -1730,6 +1730,16 @@ void KisConfig::setOcioLutEdgeSize(int value)
     m_cfg.writeEntry("Krita/Ocio/LutEdgeSize", value);
 }
 
+bool KisConfig::ocioUseCpuLut(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("Krita/Ocio/UseCpuLut", false));
+}
+
+void KisConfig::setOcioUseCpuLut(bool value)
+{
+    m_cfg.writeEntry("Krita/Ocio/UseCpuLut", value);
+}
+
 bool KisConfig::ocioLockColorVisualRepresentation(bool defaultValue) const
 {
     return (defaultValue ? false : m_cfg.readEntry("Krita/Ocio/OcioLockColorVisualRepresentation", false));
@@ -2027,6 +2037,36 @@ void KisConfig::setTrackTabletEventLatency(bool value)
     m_cfg.writeEntry("trackTabletEventLatency", value);
 }
 
+bool KisConfig::trackStrokeLatency(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("trackStrokeLatency", false));
+}
+
+void KisConfig::setTrackStrokeLatency(bool value)
+{
+    m_cfg.writeEntry("trackStrokeLatency", value);
+}
+
+bool KisConfig::useStrokePrediction(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("useStrokePrediction", false));
+}
+
+void KisConfig::setUseStrokePrediction(bool value)
+{
+    m_cfg.writeEntry("useStrokePrediction", value);
+}
+
+int KisConfig::strokePredictionTime(bool defaultValue) const
+{
+    return (defaultValue ? 16 : m_cfg.readEntry("strokePredictionTime", 16));
+}
+
+void KisConfig::setStrokePredictionTime(int value)
+{
+    m_cfg.writeEntry("strokePredictionTime", value);
+}
+
 bool KisConfig::ignoreHighFunctionKeys(bool defaultValue) const
 {
     return (defaultValue ? true : m_cfg.readEntry("ignoreHighFunctionKeys", true));
@@ -432,6 +432,9 @@ public:
     int ocioLutEdgeSize(bool defaultValue = false) const;
     void setOcioLutEdgeSize(int value);
 
+    bool ocioUseCpuLut(bool defaultValue = false) const;
+    void setOcioUseCpuLut(bool value);
+
     bool ocioLockColorVisualRepresentation(bool defaultValue = false) const;
     void setOcioLockColorVisualRepresentation(bool value);
 
@@ -527,6 +530,15 @@ public:
     bool trackTabletEventLatency(bool defaultValue = false) const;
     void setTrackTabletEventLatency(bool value);
 
+    bool trackStrokeLatency(bool defaultValue = false) const;
+    void setTrackStrokeLatency(bool value);
+
+    bool useStrokePrediction(bool defaultValue = false) const;
+    void setUseStrokePrediction(bool value);
+
+    int strokePredictionTime(bool defaultValue = false) const;
+    void setStrokePredictionTime(int value);
+
     bool ignoreHighFunctionKeys(bool defaultValue = false) const;
     void setIgnoreHighFunctionKeys(bool value);
 
@@ -33,6 +33,7 @@
 // krita/ui
 #include "KisViewManager.h"
 #include "kis_canvas2.h"
+#include "kis_coordinates_converter.h"
 #include <kis_bookmarked_configuration_manager.h>
 
 #include "kis_action.h"
@@ -301,9 +302,19 @@ void KisFilterManager::apply(KisFilterConfigurationSP _filterConfig)
                                                                     KisFilterConfigurationSP(filterConfig),
                                                                     resources,
                                                                     d->externalCancelUpdatesStorage.toWeakRef());
+    /**
+     * In the progressive preview mode the visible part of the canvas is
+     * filtered and shown first, the rest of the layer is refined later
+     */
+    QRect priorityRect;
+
     {
         KConfigGroup group( KSharedConfig::openConfig(), "filterdialog");
         strategy->setForceLodModeIfPossible(group.readEntry("forceLodMode", true));
+
+        if (group.readEntry("progressivePreview", true) && d->view->canvasBase()) {
+            priorityRect = d->view->canvasBase()->coordinatesConverter()->widgetRectInImagePixels().toAlignedRect();
+        }
     }
 
     d->currentStrokeId =
@@ -311,7 +322,7 @@ void KisFilterManager::apply(KisFilterConfigurationSP _filterConfig)
 
     // Apply filter preview to active, visible frame only.
     KisImageConfig imgConf(true);
-    image->addJob(d->currentStrokeId, new KisFilterStrokeStrategy::FilterJobData());
+    image->addJob(d->currentStrokeId, new KisFilterStrokeStrategy::FilterJobData(-1, priorityRect));
 
     {
         KisFilterStrokeStrategy::IdleBarrierData *data =
@@ -19,6 +19,7 @@
 #include "kis_debug.h"
 #include <KisViewManager.h>
 #include "KisRepaintDebugger.h"
+#include <KisStrokeLatencyTracker.h>
 
 #include "KisOpenGLModeProber.h"
 #include "KisOpenGLContextSwitchLock.h"
@@ -259,6 +260,8 @@ void KisOpenGLCanvas2::paintGL()
     // rendering, which a QtQuick2-based canvas will need.
     d->glSyncObject.reset(new KisOpenGLSync());
 
+    KisStrokeLatencyTracker::instance()->notifyFramePresented();
+
     if (!OPENGL_SUCCESS) {
         KisConfig cfg(false);
         cfg.writeEntry("canvasState", "OPENGL_SUCCESS");
@@ -0,0 +1,154 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokeLatencyTrackerTest.h"
+
+#include "KisStrokeLatencyTracker.h"
+#include "kis_config.h"
+#include "kis_debug.h"
+
+namespace {
+/**
+ * A tracker with a manually controlled clock
+ */
+class TestingStrokeLatencyTracker : public KisStrokeLatencyTracker
+{
+public:
+    qint64 time = 0;
+
+protected:
+    qint64 currentTimestamp() const override {
+        return time;
+    }
+
+    void print(const QString &message) override {
+        Q_UNUSED(message);
+    }
+};
+}
+
+void KisStrokeLatencyTrackerTest::initTestCase()
+{
+    KisConfig cfg(false);
+    m_savedTrackStrokeLatency = cfg.trackStrokeLatency();
+    cfg.setTrackStrokeLatency(true);
+}
+
+void KisStrokeLatencyTrackerTest::cleanupTestCase()
+{
+    KisConfig cfg(false);
+    cfg.setTrackStrokeLatency(m_savedTrackStrokeLatency);
+}
+
+void KisStrokeLatencyTrackerTest::testStrokeEstimate()
+{
+    TestingStrokeLatencyTracker tracker;
+
+    tracker.notifyStrokeStarted();
+    QVERIFY(tracker.isEnabled());
+
+    tracker.time = 0;
+    tracker.notifyInputEvent(QPointF(10, 10));
+    tracker.time = 10;
+    tracker.notifyInputEvent(QPointF(20, 10));
+    tracker.time = 20;
+    tracker.notifyInputEvent(QPointF(100, 10));
+
+    // only the first two events are on canvas
+    tracker.time = 30;
+    tracker.notifyImageRectUploaded(QRect(0, 0, 50, 50));
+
+    // the uploaded rect is not shown yet
+    QCOMPARE(tracker.lastStrokeNumSamples(), 0);
+
+    tracker.time = 40;
+    tracker.notifyFramePresented();
+
+    tracker.notifyStrokeFinished();
+
+    // the stroke is not reported until its tail reaches the screen
+    QCOMPARE(tracker.lastStrokeNumSamples(), 0);
+
+    tracker.time = 50;
+    tracker.notifyImageRectUploaded(QRect(50, 0, 100, 50));
+    tracker.time = 60;
+    tracker.notifyFramePresented();
+
+    // latencies are 40, 30 and 40 ms
+    QCOMPARE(tracker.lastStrokeNumSamples(), 3);
+    QCOMPARE(tracker.lastStrokeMeanLatency(), 110.0 / 3);
+    QCOMPARE(tracker.lastStrokeMaxLatency(), 40);
+}
+
+void KisStrokeLatencyTrackerTest::testLostEvents()
+{
+    TestingStrokeLatencyTracker tracker;
+
+    tracker.notifyStrokeStarted();
+
+    tracker.time = 0;
+    tracker.notifyInputEvent(QPointF(10, 10));
+    tracker.time = 10;
+    tracker.notifyInputEvent(QPointF(-100, -100));
+    tracker.notifyStrokeFinished();
+
+    tracker.time = 20;
+    tracker.notifyImageRectUploaded(QRect(0, 0, 50, 50));
+    tracker.notifyFramePresented();
+
+    // the event outside the image is still pending
+    QCOMPARE(tracker.lastStrokeNumSamples(), 0);
+
+    // ... until it gets outdated
+    tracker.time = 5000;
+    tracker.notifyFramePresented();
+
+    QCOMPARE(tracker.lastStrokeNumSamples(), 1);
+    QCOMPARE(tracker.lastStrokeMeanLatency(), 20.0);
+    QCOMPARE(tracker.lastStrokeMaxLatency(), 20);
+}
+
+void KisStrokeLatencyTrackerTest::testResetOnNewStroke()
+{
+    TestingStrokeLatencyTracker tracker;
+
+    tracker.notifyStrokeStarted();
+
+    tracker.time = 0;
+    tracker.notifyInputEvent(QPointF(10, 10));
+    tracker.time = 10;
+    tracker.notifyInputEvent(QPointF(100, 10));
+    tracker.notifyStrokeFinished();
+
+    tracker.time = 20;
+    tracker.notifyImageRectUploaded(QRect(0, 0, 50, 50));
+    tracker.notifyFramePresented();
+    QCOMPARE(tracker.lastStrokeNumSamples(), 0);
+
+    // a new stroke drops the tail of the previous one
+    // and reports what has already been shown
+    tracker.time = 100;
+    tracker.notifyStrokeStarted();
+
+    QCOMPARE(tracker.lastStrokeNumSamples(), 1);
+    QCOMPARE(tracker.lastStrokeMeanLatency(), 20.0);
+    QCOMPARE(tracker.lastStrokeMaxLatency(), 20);
+
+    // the dropped event doesn't leak into the new stroke
+    tracker.time = 110;
+    tracker.notifyInputEvent(QPointF(10, 10));
+    tracker.notifyStrokeFinished();
+
+    tracker.time = 115;
+    tracker.notifyImageRectUploaded(QRect(0, 0, 200, 50));
+    tracker.notifyFramePresented();
+
+    QCOMPARE(tracker.lastStrokeNumSamples(), 1);
+    QCOMPARE(tracker.lastStrokeMeanLatency(), 5.0);
+    QCOMPARE(tracker.lastStrokeMaxLatency(), 5);
+}
+
+SIMPLE_TEST_MAIN(KisStrokeLatencyTrackerTest)
@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTROKELATENCYTRACKERTEST_H
+#define KISSTROKELATENCYTRACKERTEST_H
+
+#include <simpletest.h>
+
+class KisStrokeLatencyTrackerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testStrokeEstimate();
+    void testLostEvents();
+    void testResetOnNewStroke();
+
+private:
+    bool m_savedTrackStrokeLatency = false;
+};
+
+#endif // KISSTROKELATENCYTRACKERTEST_H
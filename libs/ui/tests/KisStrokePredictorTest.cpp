@@ -0,0 +1,77 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokePredictorTest.h"
+
+#include "KisStrokePredictor.h"
+#include "kis_debug.h"
+
+void KisStrokePredictorTest::testNoPrediction()
+{
+    KisStrokePredictor predictor;
+    QVERIFY(!predictor.hasPrediction());
+
+    predictor.addSample(QPointF(10, 10), 0);
+    QVERIFY(!predictor.hasPrediction());
+    QCOMPARE(predictor.predictedPosition(16), QPointF(10, 10));
+
+    // the stylus doesn't move
+    predictor.addSample(QPointF(10, 10), 8);
+    QVERIFY(!predictor.hasPrediction());
+
+    predictor.reset();
+    QVERIFY(!predictor.hasPrediction());
+    QCOMPARE(predictor.lastPosition(), QPointF());
+}
+
+void KisStrokePredictorTest::testLinearMotion()
+{
+    KisStrokePredictor predictor;
+
+    // 1 px/ms along X and 0.5 px/ms along Y
+    for (int i = 0; i <= 4; i++) {
+        predictor.addSample(QPointF(10 + 8 * i, 20 + 4 * i), 8 * i);
+    }
+
+    QVERIFY(predictor.hasPrediction());
+    QCOMPARE(predictor.lastPosition(), QPointF(42, 36));
+    QCOMPARE(predictor.predictedPosition(16), QPointF(58, 44));
+    QCOMPARE(predictor.predictedPosition(0), QPointF(42, 36));
+}
+
+void KisStrokePredictorTest::testHorizonLimit()
+{
+    KisStrokePredictor predictor;
+
+    predictor.addSample(QPointF(0, 0), 0);
+    predictor.addSample(QPointF(10, 0), 10);
+
+    // the predictor never looks farther ahead than its history
+    QCOMPARE(predictor.predictedPosition(100), QPointF(20, 0));
+}
+
+void KisStrokePredictorTest::testOutdatedSamples()
+{
+    KisStrokePredictor predictor(20);
+
+    // the stylus was moving fast at first...
+    predictor.addSample(QPointF(0, 0), 0);
+    predictor.addSample(QPointF(100, 0), 10);
+
+    // ... and then slowed down
+    predictor.addSample(QPointF(110, 0), 20);
+    predictor.addSample(QPointF(120, 0), 30);
+    predictor.addSample(QPointF(130, 0), 40);
+
+    // only the last 20 ms are taken into account
+    QCOMPARE(predictor.predictedPosition(10), QPointF(140, 0));
+
+    // the clock went backwards, e.g. a new stroke has been started
+    predictor.addSample(QPointF(0, 0), 0);
+    QVERIFY(!predictor.hasPrediction());
+}
+
+SIMPLE_TEST_MAIN(KisStrokePredictorTest)
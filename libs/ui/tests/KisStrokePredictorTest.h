@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTROKEPREDICTORTEST_H
+#define KISSTROKEPREDICTORTEST_H
+
+#include <simpletest.h>
+
+class KisStrokePredictorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testNoPrediction();
+    void testLinearMotion();
+    void testHorizonLimit();
+    void testOutdatedSamples();
+};
+
+#endif // KISSTROKEPREDICTORTEST_H
@@ -0,0 +1,189 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokeLatencyTracker.h"
+
+#include <QGlobalStatic>
+#include <QElapsedTimer>
+#include <QPointF>
+#include <QRect>
+#include <QVector>
+
+#include <kis_debug.h>
+#include "kis_config.h"
+
+
+Q_GLOBAL_STATIC(KisStrokeLatencyTracker, s_instance)
+
+namespace {
+// events that didn't reach the screen in this time are considered lost,
+// e.g. they were outside the image bounds
+static const qint64 maxPendingTime = 2000;
+static const int maxPendingEvents = 1024;
+}
+
+struct KisStrokeLatencyTracker::Private
+{
+    struct PendingEvent {
+        QPointF pos;
+        qint64 timestamp = 0;
+        bool rendered = false;
+    };
+
+    bool enabled = false;
+    bool strokeActive = false;
+    bool hasUnreportedStroke = false;
+
+    QVector<PendingEvent> pendingEvents;
+
+    int strokeNumSamples = 0;
+    qint64 strokeLatencySum = 0;
+    qint64 strokeMaxLatency = 0;
+
+    int lastStrokeNumSamples = 0;
+    qreal lastStrokeMeanLatency = 0.0;
+    qint64 lastStrokeMaxLatency = 0;
+};
+
+KisStrokeLatencyTracker::KisStrokeLatencyTracker()
+    : m_d(new Private())
+{
+}
+
+KisStrokeLatencyTracker::~KisStrokeLatencyTracker()
+{
+}
+
+KisStrokeLatencyTracker *KisStrokeLatencyTracker::instance()
+{
+    return s_instance;
+}
+
+bool KisStrokeLatencyTracker::isEnabled() const
+{
+    return m_d->enabled;
+}
+
+void KisStrokeLatencyTracker::notifyStrokeStarted()
+{
+    if (m_d->hasUnreportedStroke) {
+        // the tail of the previous stroke has never reached the screen
+        notifyStrokeFinished();
+        m_d->pendingEvents.clear();
+        notifyFramePresented();
+    }
+
+    m_d->enabled = KisConfig(true).trackStrokeLatency();
+    if (!m_d->enabled) return;
+
+    m_d->strokeActive = true;
+    m_d->hasUnreportedStroke = true;
+    m_d->pendingEvents.clear();
+
+    m_d->strokeNumSamples = 0;
+    m_d->strokeLatencySum = 0;
+    m_d->strokeMaxLatency = 0;
+}
+
+void KisStrokeLatencyTracker::notifyStrokeFinished()
+{
+    m_d->strokeActive = false;
+}
+
+void KisStrokeLatencyTracker::notifyInputEvent(const QPointF &imagePos)
+{
+    if (!m_d->enabled || !m_d->strokeActive) return;
+
+    if (m_d->pendingEvents.size() >= maxPendingEvents) {
+        m_d->pendingEvents.removeFirst();
+    }
+
+    Private::PendingEvent event;
+    event.pos = imagePos;
+    event.timestamp = currentTimestamp();
+    m_d->pendingEvents.append(event);
+}
+
+void KisStrokeLatencyTracker::notifyImageRectUploaded(const QRect &imageRect)
+{
+    if (m_d->pendingEvents.isEmpty()) return;
+
+    for (auto it = m_d->pendingEvents.begin(); it != m_d->pendingEvents.end(); ++it) {
+        if (!it->rendered && imageRect.contains(it->pos.toPoint())) {
+            it->rendered = true;
+        }
+    }
+}
+
+void KisStrokeLatencyTracker::notifyFramePresented()
+{
+    if (!m_d->hasUnreportedStroke) return;
+
+    const qint64 now = currentTimestamp();
+
+    auto it = m_d->pendingEvents.begin();
+    while (it != m_d->pendingEvents.end()) {
+        if (it->rendered) {
+            const qint64 latency = now - it->timestamp;
+
+            m_d->strokeNumSamples++;
+            m_d->strokeLatencySum += latency;
+            m_d->strokeMaxLatency = qMax(m_d->strokeMaxLatency, latency);
+
+            KisLatencyTracker::push(it->timestamp);
+
+            it = m_d->pendingEvents.erase(it);
+        } else if (now - it->timestamp > maxPendingTime) {
+            it = m_d->pendingEvents.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!m_d->strokeActive && m_d->pendingEvents.isEmpty()) {
+        m_d->hasUnreportedStroke = false;
+
+        m_d->lastStrokeNumSamples = m_d->strokeNumSamples;
+        m_d->lastStrokeMeanLatency =
+            m_d->strokeNumSamples > 0 ?
+            qreal(m_d->strokeLatencySum) / m_d->strokeNumSamples : 0.0;
+        m_d->lastStrokeMaxLatency = m_d->strokeMaxLatency;
+
+        if (m_d->lastStrokeNumSamples > 0) {
+            print(QString("stroke input-to-photon latency: %1 events, mean %2 ms, max %3 ms")
+                  .arg(m_d->lastStrokeNumSamples)
+                  .arg(m_d->lastStrokeMeanLatency, 0, 'f', 1)
+                  .arg(m_d->lastStrokeMaxLatency));
+        }
+    }
+}
+
+int KisStrokeLatencyTracker::lastStrokeNumSamples() const
+{
+    return m_d->lastStrokeNumSamples;
+}
+
+qreal KisStrokeLatencyTracker::lastStrokeMeanLatency() const
+{
+    return m_d->lastStrokeMeanLatency;
+}
+
+qint64 KisStrokeLatencyTracker::lastStrokeMaxLatency() const
+{
+    return m_d->lastStrokeMaxLatency;
+}
+
+qint64 KisStrokeLatencyTracker::currentTimestamp() const
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+    return elapsed.msecsSinceReference();
+}
+
+void KisStrokeLatencyTracker::print(const QString &message)
+{
+    dbgUI << qUtf8Printable(message);
+}
@@ -0,0 +1,73 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTROKELATENCYTRACKER_H
+#define KISSTROKELATENCYTRACKER_H
+
+#include <QScopedPointer>
+
+#include <kis_latency_tracker.h>
+#include "kritaui_export.h"
+
+class QPointF;
+class QRect;
+
+/**
+ * KisStrokeLatencyTracker measures input-to-photon latency of freehand
+ * strokes, that is, the time between a stylus event arriving to the
+ * tool and the first canvas frame that shows the stroke painted at the
+ * position of the event.
+ *
+ * The tracker follows every input event through three stages:
+ *
+ * 1) notifyInputEvent() registers the position of the event
+ *
+ * 2) notifyImageRectUploaded() marks all the events inside the rect as
+ *    rendered, when the canvas has received the projection of the rect
+ *
+ * 3) notifyFramePresented() pushes the latency of all rendered events
+ *    into the tracker when the canvas widget has painted a frame
+ *
+ * The latency is reported in the rolling statistics of KisLatencyTracker
+ * and, per stroke, when the stroke is finished. All the methods should
+ * be called from the GUI thread only.
+ *
+ * The tracking is enabled with "trackStrokeLatency" option of kritarc.
+ */
+class KRITAUI_EXPORT KisStrokeLatencyTracker : public KisLatencyTracker
+{
+public:
+    KisStrokeLatencyTracker();
+    ~KisStrokeLatencyTracker() override;
+
+    static KisStrokeLatencyTracker* instance();
+
+    bool isEnabled() const;
+
+    void notifyStrokeStarted();
+    void notifyStrokeFinished();
+
+    void notifyInputEvent(const QPointF &imagePos);
+    void notifyImageRectUploaded(const QRect &imageRect);
+    void notifyFramePresented();
+
+    /**
+     * Statistics of the last finished stroke
+     */
+    int lastStrokeNumSamples() const;
+    qreal lastStrokeMeanLatency() const;
+    qint64 lastStrokeMaxLatency() const;
+
+protected:
+    qint64 currentTimestamp() const override;
+    void print(const QString &message) override;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISSTROKELATENCYTRACKER_H
@@ -0,0 +1,76 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisStrokePredictor.h"
+
+namespace {
+// events closer in time than that are considered to be a single event
+static const qreal minTimeDelta = 1.0;
+}
+
+KisStrokePredictor::KisStrokePredictor(qreal sampleWindow)
+    : m_sampleWindow(sampleWindow)
+{
+}
+
+void KisStrokePredictor::reset()
+{
+    m_samples.clear();
+}
+
+void KisStrokePredictor::addSample(const QPointF &pos, qreal time)
+{
+    if (!m_samples.isEmpty() && time < m_samples.last().time) {
+        // the clock went backwards, the history is useless now
+        m_samples.clear();
+    }
+
+    m_samples.append({pos, time});
+
+    int numOutdated = 0;
+    while (numOutdated < m_samples.size() - 2 &&
+           time - m_samples[numOutdated + 1].time >= m_sampleWindow) {
+
+        numOutdated++;
+    }
+
+    if (numOutdated) {
+        m_samples.remove(0, numOutdated);
+    }
+}
+
+bool KisStrokePredictor::hasPrediction() const
+{
+    return m_samples.size() >= 2 && !velocity().isNull();
+}
+
+QPointF KisStrokePredictor::lastPosition() const
+{
+    return !m_samples.isEmpty() ? m_samples.last().pos : QPointF();
+}
+
+QPointF KisStrokePredictor::velocity() const
+{
+    if (m_samples.size() < 2) return QPointF();
+
+    const Sample &first = m_samples.first();
+    const Sample &last = m_samples.last();
+
+    const qreal timeDelta = last.time - first.time;
+    if (timeDelta < minTimeDelta) return QPointF();
+
+    return (last.pos - first.pos) / timeDelta;
+}
+
+QPointF KisStrokePredictor::predictedPosition(qreal horizon) const
+{
+    if (m_samples.size() < 2) return lastPosition();
+
+    const qreal historyLength = m_samples.last().time - m_samples.first().time;
+    const qreal effectiveHorizon = qBound(0.0, horizon, historyLength);
+
+    return m_samples.last().pos + velocity() * effectiveHorizon;
+}
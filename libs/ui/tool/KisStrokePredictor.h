@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSTROKEPREDICTOR_H
+#define KISSTROKEPREDICTOR_H
+
+#include <QPointF>
+#include <QVector>
+
+#include "kritaui_export.h"
+
+/**
+ * KisStrokePredictor extrapolates the position of the stylus a few
+ * milliseconds ahead of the last input event. The prediction is a plain
+ * linear extrapolation of the velocity measured over a short window of
+ * the most recent events.
+ *
+ * The predicted position is never used for the real stroke, it is only
+ * shown as a provisional overlay on the canvas until the real events
+ * arrive and the rendered stroke catches up.
+ */
+class KRITAUI_EXPORT KisStrokePredictor
+{
+public:
+    /**
+     * @param sampleWindow the time (in ms) of the events history used
+     *        for measuring the velocity of the stylus
+     */
+    KisStrokePredictor(qreal sampleWindow = 40.0);
+
+    void reset();
+
+    /**
+     * Add an input event with position \p pos (in image pixels) and
+     * timestamp \p time (in ms since the start of the stroke)
+     */
+    void addSample(const QPointF &pos, qreal time);
+
+    /**
+     * @return true if there is enough data for the prediction and the
+     *         stylus is actually moving
+     */
+    bool hasPrediction() const;
+
+    /**
+     * @return the position of the most recent input event
+     */
+    QPointF lastPosition() const;
+
+    /**
+     * @return the predicted position of the stylus in \p horizon ms after
+     *         the most recent input event. The horizon is limited by the
+     *         length of the sampled history, so the predictor never looks
+     *         farther ahead than it has looked back.
+     */
+    QPointF predictedPosition(qreal horizon) const;
+
+private:
+    struct Sample {
+        QPointF pos;
+        qreal time = 0.0;
+    };
+
+    QPointF velocity() const;
+
+private:
+    qreal m_sampleWindow;
+    QVector<Sample> m_samples;
+};
+
+#endif // KISSTROKEPREDICTOR_H
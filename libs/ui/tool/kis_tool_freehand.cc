@@ -48,6 +48,8 @@
 #include "kis_tool_freehand_helper.h"
 #include "strokes/freehand_stroke.h"
 #include "kis_tool_utils.h"
+#include <KisQPainterStateSaver.h>
+#include <kis_global.h>
 
 using namespace std::placeholders; // For _1 placeholder
 
@@ -66,6 +68,7 @@ KisToolFreehand::KisToolFreehand(KoCanvasBase * canvas, const QCursor & cursor,
                                          new KisSmoothingOptions(useSavedSmoothing));
 
     connect(m_helper, SIGNAL(requestExplicitUpdateOutline()), SLOT(explicitUpdateOutline()));
+    connect(m_helper, SIGNAL(requestStrokePredictionUpdate()), SLOT(updateStrokePrediction()));
 
     connect(qobject_cast<KisCanvas2*>(canvas)->viewManager(), SIGNAL(brushOutlineToggled()), SLOT(explicitUpdateOutline()));
 
@@ -144,6 +147,8 @@ void KisToolFreehand::resetHelper(KisToolFreehandHelper *helper)
 {
     delete m_helper;
     m_helper = helper;
+
+    connect(m_helper, SIGNAL(requestStrokePredictionUpdate()), SLOT(updateStrokePrediction()));
 }
 
 bool KisToolFreehand::supportsPaintingAssistants() const
@@ -183,11 +188,13 @@ void KisToolFreehand::initStroke(KoPointerEvent *event)
 void KisToolFreehand::doStroke(KoPointerEvent *event)
 {
     m_helper->paintEvent(event);
+    updateStrokePrediction();
 }
 
 void KisToolFreehand::endStroke()
 {
     m_helper->endPaint();
+    updateStrokePrediction();
     bool paintOpIgnoredEvent = currentPaintOpPreset()->settings()->mouseReleaseEvent();
     Q_UNUSED(paintOpIgnoredEvent);
 }
@@ -475,6 +482,59 @@ void KisToolFreehand::explicitUpdateOutline()
     requestUpdateOutline(m_outlineDocPoint, 0);
 }
 
+void KisToolFreehand::paint(QPainter &gc, const KoViewConverter &converter)
+{
+    const QLineF prediction = m_helper->strokePrediction();
+
+    if (!prediction.isNull() && currentPaintOpPreset()) {
+        /**
+         * The prediction is only a hint of where the stroke is going to be
+         * in a few milliseconds, so paint it as a plain line of the brush
+         * size. It is replaced by the real stroke when the next events
+         * arrive.
+         */
+        KisPaintOpSettingsSP settings = currentPaintOpPreset()->settings();
+
+        const QPointF viewStart = pixelToView(prediction.p1());
+        const QPointF viewEnd = pixelToView(prediction.p2());
+        const qreal viewWidth =
+            kisDistance(pixelToView(QPointF()),
+                        pixelToView(QPointF(settings->paintOpSize(), 0.0)));
+
+        QColor color = currentFgColor().toQColor();
+        color.setAlphaF(color.alphaF() * settings->paintOpOpacity());
+
+        KisQPainterStateSaver saver(&gc);
+        gc.setRenderHint(QPainter::Antialiasing);
+        gc.setPen(QPen(color, qMax(1.0, viewWidth), Qt::SolidLine, Qt::RoundCap));
+        gc.drawLine(viewStart, viewEnd);
+    }
+
+    KisToolPaint::paint(gc, converter);
+}
+
+void KisToolFreehand::updateStrokePrediction()
+{
+    const QLineF prediction = m_helper->strokePrediction();
+
+    QRectF newRect;
+
+    if (!prediction.isNull() && currentPaintOpPreset()) {
+        const qreal radius = 0.5 * currentPaintOpPreset()->settings()->paintOpSize() + 2.0;
+        newRect = kisGrowRect(QRectF(prediction.p1(), prediction.p2()).normalized(), radius);
+    }
+
+    if (!m_strokePredictionRect.isEmpty()) {
+        updateCanvasPixelRect(m_strokePredictionRect);
+    }
+
+    if (!newRect.isEmpty()) {
+        updateCanvasPixelRect(newRect);
+    }
+
+    m_strokePredictionRect = newRect;
+}
+
 KisOptimizedBrushOutline KisToolFreehand::getOutlinePath(const QPointF &documentPos,
                                              const KoPointerEvent *event,
                                              KisPaintOpSettings::OutlineMode outlineMode)
@@ -46,6 +46,8 @@ public Q_SLOTS:
 protected:
     bool trySampleByPaintOp(KoPointerEvent *event, AlternateAction action);
 
+    void paint(QPainter &gc, const KoViewConverter &converter) override;
+
     bool primaryActionSupportsHiResEvents() const override;
     void beginPrimaryAction(KoPointerEvent *event) override;
     void continuePrimaryAction(KoPointerEvent *event) override;
@@ -86,6 +88,12 @@ protected Q_SLOTS:
     void setSnapEraser(bool assistant);
     void slotDoResizeBrush(qreal newSize);
 
+    /**
+     * Requests the canvas update of the old and the new positions of
+     * the provisional stroke prediction overlay
+     */
+    void updateStrokePrediction();
+
 private:
     friend class KisToolFreehandPaintingInformationBuilder;
 
@@ -120,6 +128,7 @@ private:
     QPoint m_initialGestureGlobalPoint;
 
     bool m_paintopBasedSamplingInAction {false};
+    QRectF m_strokePredictionRect;
     KisSignalCompressorWithParam<qreal> m_brushResizeCompressor;
 
     std::optional<KoPointerEventWrapper> m_beginAlternateActionEvent;
@@ -26,6 +26,8 @@
 #include "kis_update_time_monitor.h"
 #include "kis_stabilized_events_sampler.h"
 #include "KisStabilizerDelayedPaintHelper.h"
+#include "KisStrokePredictor.h"
+#include "KisStrokeLatencyTracker.h"
 #include "kis_config.h"
 
 #include "kis_random_source.h"
@@ -108,6 +110,11 @@ struct KisToolFreehandHelper::Private
     KisStabilizedEventsSampler stabilizedSampler;
     KisStabilizerDelayedPaintHelper stabilizerDelayedPaintHelper;
 
+    // Provisional prediction of the stroke shown on the canvas
+    KisStrokePredictor strokePredictor;
+    bool useStrokePrediction = false;
+    qreal strokePredictionTime = 0.0;
+
     qreal effectiveSmoothnessDistance(qreal speed) const;
 };
 
@@ -316,6 +323,14 @@ void KisToolFreehandHelper::initPaintImpl(qreal startAngle,
     m_d->hasLastDrawnPixel = false;
     m_d->pixelInLineCount = 0;
 
+    {
+        KisConfig cfg(true);
+        m_d->useStrokePrediction = cfg.useStrokePrediction();
+        m_d->strokePredictionTime = cfg.strokePredictionTime();
+    }
+    m_d->strokePredictor.reset();
+    KisStrokeLatencyTracker::instance()->notifyStrokeStarted();
+
     if (airbrushing) {
         m_d->airbrushingTimer.setInterval(computeAirbrushTimerInterval());
         m_d->airbrushingTimer.start();
@@ -452,10 +467,28 @@ void KisToolFreehandHelper::paintEvent(KoPointerEvent *event)
             m_d->infoBuilder->continueStroke(event,
                                              elapsedStrokeTime());
     KisUpdateTimeMonitor::instance()->reportMouseMove(info.pos());
+    KisStrokeLatencyTracker::instance()->notifyInputEvent(info.pos());
+
+    if (m_d->useStrokePrediction) {
+        m_d->strokePredictor.addSample(info.pos(), info.currentTime());
+    }
 
     paint(info);
 }
 
+QLineF KisToolFreehandHelper::strokePrediction() const
+{
+    if (!m_d->useStrokePrediction ||
+        !isRunning() ||
+        !m_d->strokePredictor.hasPrediction()) {
+
+        return QLineF();
+    }
+
+    return QLineF(m_d->strokePredictor.lastPosition(),
+                  m_d->strokePredictor.predictedPosition(m_d->strokePredictionTime));
+}
+
 
 void KisToolFreehandHelper::paint(KisPaintInformation &info)
 { 
@@ -702,6 +735,9 @@ void KisToolFreehandHelper::endPaint()
     m_d->strokesFacade->endStroke(m_d->strokeId);
     m_d->strokeId.clear();
     m_d->infoBuilder->reset();
+
+    m_d->strokePredictor.reset();
+    KisStrokeLatencyTracker::instance()->notifyStrokeFinished();
 }
 
 void KisToolFreehandHelper::cancelPaint()
@@ -732,6 +768,10 @@ void KisToolFreehandHelper::cancelPaint()
     m_d->strokesFacade->cancelStroke(m_d->strokeId);
     m_d->strokeId.clear();
 
+    m_d->strokePredictor.reset();
+    Q_EMIT requestStrokePredictionUpdate();
+
+    KisStrokeLatencyTracker::instance()->notifyStrokeFinished();
 }
 
 int KisToolFreehandHelper::elapsedStrokeTime() const
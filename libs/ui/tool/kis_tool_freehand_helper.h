@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QVector>
+#include <QLineF>
 
 #include "kis_types.h"
 #include "kritaui_export.h"
@@ -67,6 +68,14 @@ public:
     void paintEvent(KoPointerEvent *event );
     void endPaint();
 
+    /**
+     * Returns the provisional prediction of the stroke as a segment from
+     * the position of the last input event to the predicted position of
+     * the stylus (in image pixels). The segment is null if the prediction
+     * is disabled in the settings or the stylus is not moving.
+     */
+    QLineF strokePrediction() const;
+
     KisOptimizedBrushOutline paintOpOutline(const QPointF &savedCursorPos,
                                             const KoPointerEvent *event,
                                             const KisPaintOpSettingsSP globalSettings,
@@ -81,6 +90,13 @@ Q_SIGNALS:
      */
     void requestExplicitUpdateOutline();
 
+    /**
+     * The signal is emitted when the stroke prediction is dropped
+     * outside of the tool's own event handlers, e.g. when the stroke
+     * is cancelled, so that the tool removes the stale overlay
+     */
+    void requestStrokePredictionUpdate();
+
 protected:
     void cancelPaint();
     int elapsedStrokeTime() const;
@@ -6,6 +6,8 @@
 
 #include "kis_filter_stroke_strategy.h"
 
+#include <algorithm>
+
 #include <filter/kis_filter.h>
 #include <filter/kis_filter_configuration.h>
 #include <krita_utils.h>
@@ -16,6 +18,8 @@
 #include <KisRunnableStrokeJobUtils.h>
 #include <KisRunnableStrokeJobsInterface.h>
 #include <KoCompositeOpRegistry.h>
+#include <KisRegion.h>
+#include <kis_global.h>
 #include "kis_image_config.h"
 #include "kis_image_animation_interface.h"
 #include "kis_painter.h"
@@ -74,6 +78,7 @@ struct SubTaskSharedData {
         , m_storage(new KisLayerUtils::SwitchFrameCommand::SharedStorage()){
 
         m_frameTime = filterFrameData->frameTime;
+        m_priorityRect = filterFrameData->priorityRect;
         m_shouldSwitchTime = filterFrameData->frameTime != -1;
 
         m_shouldRedraw = !m_shouldSwitchTime || filterFrameData->frameTime == KisLayerUtils::fetchLayerActiveRasterFrameTime(m_node);
@@ -104,6 +109,8 @@ struct SubTaskSharedData {
 
     bool shouldRedraw() { return m_shouldRedraw; }
 
+    QRect priorityRect() { return m_priorityRect; }
+
     KisLayerUtils::SwitchFrameCommand::SharedStorageSP storage() { return m_storage; }
 
 public:
@@ -112,6 +119,9 @@ public:
     QSharedPointer<KisTransaction> filterDeviceTransaction;
     QRect processRect;
 
+    bool refineProgressively = false;
+    QRect refinedRect;
+
 private:
     KisImageSP m_image;
     KisNodeSP m_node;
@@ -123,10 +133,21 @@ private:
     bool m_shouldSwitchTime;
     bool m_shouldRedraw;
     int m_frameTime;
+    QRect m_priorityRect;
     KisLayerUtils::SwitchFrameCommand::SharedStorageSP m_storage;
 
 };
 
+/**
+ * A part of the layer that is filtered and shown on its own during the
+ * progressive refinement of the preview
+ */
+struct RefinementChunkData {
+    QRect rect;
+    KisPaintDeviceSP device;
+    QSharedPointer<KisTransaction> transaction;
+};
+
 using namespace KritaUtils;
 
 KisFilterStrokeStrategy::KisFilterStrokeStrategy(KisFilterSP filter, KisFilterConfigurationSP filterConfig, KisResourcesSnapshotSP resources)
@@ -238,14 +259,120 @@ void KisFilterStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
                 }
             }
 
+            shared->refineProgressively =
+                shared->shouldRedraw() &&
+                !shared->shouldSwitchTime() &&
+                shared->filter()->supportsThreading() &&
+                shared->processRect.intersects(shared->priorityRect()) &&
+                !shared->priorityRect().contains(shared->processRect) &&
+                shared->filterDeviceBounds.intersects(
+                    shared->filter()->neededRect(shared->processRect, shared->filterConfig().data(), shared->levelOfDetail()));
+
+            QVector<KisRunnableStrokeJobData*> processJobs;
+
+            if (shared->refineProgressively) {
+                /**
+                 * The visible part of the layer is filtered and shown first,
+                 * then the rest is filtered in chunks, the nearest ones first.
+                 * Every chunk is filtered on its own copy of the original
+                 * pixels, so the order of the chunks doesn't change the
+                 * result. The chunks are copied back in batches, one batch
+                 * per barrier, so that the patches of several chunks can be
+                 * processed in parallel between the barriers. When the
+                 * preview is restarted with new settings, the batches that
+                 * haven't been started yet are dropped together with the
+                 * cancelled stroke.
+                 */
+                const QRect visibleRect = shared->processRect & shared->priorityRect();
+
+                QVector<QRect> chunks;
+                Q_FOREACH (const QRect &rc, KisRegion::fromQRegion(QRegion(shared->processRect) - QRegion(visibleRect)).rects()) {
+                    chunks += KritaUtils::splitRectIntoPatches(rc, 2 * KritaUtils::optimalPatchSize());
+                }
+
+                const QPointF center = QRectF(visibleRect).center();
+                std::sort(chunks.begin(), chunks.end(),
+                          [center] (const QRect &lhs, const QRect &rhs) {
+                              return kisSquareDistance(QRectF(lhs).center(), center) <
+                                  kisSquareDistance(QRectF(rhs).center(), center);
+                          });
+
+                QVector<QVector<QRect>> batches;
+                batches << QVector<QRect>({visibleRect});
+
+                const int chunksPerBatch = qMax(1, KisImageConfig(true).maxNumberOfThreads());
+                for (int i = 0; i < chunks.size(); i += chunksPerBatch) {
+                    batches << chunks.mid(i, chunksPerBatch);
+                }
+
+                Q_FOREACH (const QVector<QRect> &batchRects, batches) {
+                    QVector<QSharedPointer<RefinementChunkData>> batch;
+
+                    Q_FOREACH (const QRect &rect, batchRects) {
+                        if (rect.isEmpty()) continue;
+
+                        QSharedPointer<RefinementChunkData> chunk(new RefinementChunkData());
+                        chunk->rect = rect;
+                        batch << chunk;
+                    }
+
+                    if (batch.isEmpty()) continue;
+
+                    addJobSequential(processJobs, [shared, batch](){
+                        Q_FOREACH (QSharedPointer<RefinementChunkData> chunk, batch) {
+                            chunk->device = new KisPaintDevice(*shared->filterDevice);
+                            chunk->transaction.reset(new KisTransaction(chunk->device));
+                        }
+                    });
+
+                    Q_FOREACH (QSharedPointer<RefinementChunkData> chunk, batch) {
+                        Q_FOREACH (const QRect &patch, KritaUtils::splitRectIntoPatches(chunk->rect, KritaUtils::optimalPatchSize())) {
+                            if (!patch.isEmpty()) {
+                                addJobConcurrent(processJobs, [patch, shared, chunk, progress](){
+                                    shared->filter()->processImpl(chunk->device, patch,
+                                                                  shared->filterConfig().data(),
+                                                                  progress->updater());
+                                });
+                            }
+                        }
+                    }
+
+                    addJobSequential(processJobs, [this, shared, batch](){
+                        QRect batchRect;
+
+                        QScopedPointer<KisTransaction> workingTransaction( new KisTransaction(shared->targetDevice()) );
+                        Q_FOREACH (QSharedPointer<RefinementChunkData> chunk, batch) {
+                            KisPainter::copyAreaOptimized(chunk->rect.topLeft(), chunk->device, shared->targetDevice(), chunk->rect, shared->selection());
+                            batchRect |= chunk->rect;
+                        }
+                        runAndSaveCommand( toQShared(workingTransaction->endAndTake()), KisStrokeJobData::BARRIER, KisStrokeJobData::EXCLUSIVE );
+
+                        Q_FOREACH (QSharedPointer<RefinementChunkData> chunk, batch) {
+                            chunk->transaction.reset();
+                            chunk->device = 0;
+                        }
+
+                        QRect extraUpdateRect;
+                        qSwap(extraUpdateRect, m_d->nextExternalUpdateRect);
+
+                        shared->node()->setDirty(batchRect | extraUpdateRect);
+
+                        // the already refined area should be restored on cancellation
+                        shared->refinedRect |= batchRect;
+                        m_d->nextExternalUpdateRect = shared->refinedRect;
+                    });
+                }
+
+                runnableJobsInterface()->addRunnableJobs(processJobs);
+                return;
+            }
+
             // Filter device needs a transaction to prevent grid-patch artifacts from multithreaded read/write.
             shared->filterDeviceTransaction.reset(new KisTransaction(shared->filterDevice));
 
 
             // Actually process the device
 
-            QVector<KisRunnableStrokeJobData*> processJobs;
-
             if (shared->filter()->supportsThreading()) {
                 // Split stroke into patches...
                 QSize size = KritaUtils::optimalPatchSize();
@@ -275,6 +402,9 @@ void KisFilterStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
         });
 
         addJobSequential(jobs, [this, shared](){
+            // the chunks have already been copied and updated one by one
+            if (shared->refineProgressively) return;
+
             // We will first apply the transaction to the temporary filterDevice
             runAndSaveCommand(toQShared(shared->filterDeviceTransaction->endAndTake()), KisStrokeJobData::BARRIER, KisStrokeJobData::NORMAL);
             shared->filterDeviceTransaction.reset();
@@ -17,9 +17,10 @@ class KRITAUI_EXPORT KisFilterStrokeStrategy : public KisStrokeStrategyUndoComma
 public:
     class FilterJobData : public KisStrokeJobData {
     public:
-        FilterJobData(int frameTime = -1)
+        FilterJobData(int frameTime = -1, const QRect &priorityRect = QRect())
             : KisStrokeJobData(CONCURRENT),
-              frameTime(frameTime)
+              frameTime(frameTime),
+              priorityRect(priorityRect)
         {}
 
         KisStrokeJobData* createLodClone(int levelOfDetail) override {
@@ -28,13 +29,24 @@ public:
 
         int frameTime;
 
+        /**
+         * The area that should be filtered and shown first, usually the
+         * visible part of the canvas. When it is set and the filter can
+         * process its rect in parts, the rest of the layer is refined
+         * progressively after this area has been updated.
+         */
+        QRect priorityRect;
+
     private:
         FilterJobData(const FilterJobData &rhs, int levelOfDetail)
             : KisStrokeJobData(rhs)
             , frameTime(rhs.frameTime)
-         {
-             KisLodTransform t(levelOfDetail);
-         }
+        {
+            KisLodTransform t(levelOfDetail);
+            if (rhs.priorityRect.isValid()) {
+                priorityRect = t.map(rhs.priorityRect);
+            }
+        }
     };
 
     class IdleBarrierData : public KisStrokeJobData {
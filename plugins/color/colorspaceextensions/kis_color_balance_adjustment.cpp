@@ -70,6 +70,11 @@ void transform(const quint8 *srcU8, quint8 *dstU8, qint32 nPixels) const overrid
     }
 }
 
+PixelDependency pixelDependency() const override
+{
+    return ColorDependency;
+}
+
 
 QList<QString> parameters() const override
 {
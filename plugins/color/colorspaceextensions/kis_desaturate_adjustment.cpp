@@ -95,6 +95,11 @@ public:
         }
     }
 
+    PixelDependency pixelDependency() const override
+    {
+        return ColorDependency;
+    }
+
     QList<QString> parameters() const override
     {
       QList<QString> list;
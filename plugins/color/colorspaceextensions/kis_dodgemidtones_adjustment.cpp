@@ -54,6 +54,11 @@ public:
         }
     }
 
+    PixelDependency pixelDependency() const override
+    {
+        return ChannelwiseDependency;
+    }
+
     QList<QString> parameters() const override
     {
     	QList<QString> list;
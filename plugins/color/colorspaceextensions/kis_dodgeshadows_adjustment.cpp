@@ -56,6 +56,11 @@ public:
         }
     }
 
+	PixelDependency pixelDependency() const override
+	{
+        return ChannelwiseDependency;
+	}
+
 	QList<QString> parameters() const override
 	{
         QList<QString> list;
@@ -548,6 +548,11 @@ public:
         }*/
     }
 
+    PixelDependency pixelDependency() const override
+    {
+        return ColorDependency;
+    }
+
     QList<QString> parameters() const override
     {
       QList<QString> list;
@@ -647,6 +652,31 @@ public:
         m_lumaBlue(0.0)
     {}
 
+    /**
+     * A curve that is driven by the channel it modifies touches only
+     * that channel. Any other combination mixes the color channels
+     * with each other or, when the alpha channel is involved, with
+     * the alpha.
+     */
+    PixelDependency pixelDependency() const override
+    {
+        const int driverChannel = m_relative ? m_driverChannel : m_channel;
+
+        if (driverChannel == KisHSVCurve::AllColors) {
+            return ArbitraryDependency;
+        }
+
+        if (m_channel == driverChannel && m_channel <= KisHSVCurve::Alpha) {
+            return ChannelwiseDependency;
+        }
+
+        if (m_channel == KisHSVCurve::Alpha || driverChannel == KisHSVCurve::Alpha) {
+            return ArbitraryDependency;
+        }
+
+        return ColorDependency;
+    }
+
     QList<QString> parameters() const override
     {
       QList<QString> list;
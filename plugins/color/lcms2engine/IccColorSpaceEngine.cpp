@@ -8,11 +8,48 @@
 #include "IccColorSpaceEngine.h"
 
 #include <klocalizedstring.h>
+#include <KConfigGroup>
+#include <KSharedConfig>
 
 #include <KoColorModelStandardIds.h>
 #include <kis_assert.h>
 
 #include "LcmsColorSpace.h"
+#include "LcmsLutTransformation.h"
+#include "LcmsMatrixShaperTransformation.h"
+
+namespace {
+
+/**
+ * Native matrix-shaper transforms can be disabled by
+ * "useNativeMatrixShaperTransforms=false" in kritarc, e.g. to
+ * check if some color issue is caused by them or by LCMS.
+ */
+bool useNativeMatrixShaperTransforms()
+{
+    static const bool value = [] () {
+        KConfigGroup cfg = KSharedConfig::openConfig()->group("");
+        return cfg.readEntry("useNativeMatrixShaperTransforms", true);
+    }();
+
+    return value;
+}
+
+/**
+ * Native LUT transforms for CMYK and Lab can be disabled by
+ * "useNativeLutTransforms=false" in kritarc
+ */
+bool useNativeLutTransforms()
+{
+    static const bool value = [] () {
+        KConfigGroup cfg = KSharedConfig::openConfig()->group("");
+        return cfg.readEntry("useNativeLutTransforms", true);
+    }();
+
+    return value;
+}
+
+}
 
 // -- KoLcmsColorConversionTransformation --
 
@@ -255,10 +292,33 @@ KoColorConversionTransformation *IccColorSpaceEngine::createColorTransformation(
     KIS_ASSERT(dynamic_cast<const IccColorProfile *>(srcColorSpace->profile()));
     KIS_ASSERT(dynamic_cast<const IccColorProfile *>(dstColorSpace->profile()));
 
+    LcmsColorProfileContainer *srcProfile = dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms();
+    LcmsColorProfileContainer *dstProfile = dynamic_cast<const IccColorProfile *>(dstColorSpace->profile())->asLcms();
+
+    if (useNativeMatrixShaperTransforms()) {
+        KoColorConversionTransformation *transformation =
+            LcmsMatrixShaperTransformation::tryCreate(srcColorSpace, srcProfile,
+                                                      dstColorSpace, dstProfile,
+                                                      renderingIntent, conversionFlags);
+        if (transformation) {
+            return transformation;
+        }
+    }
+
+    if (useNativeLutTransforms()) {
+        KoColorConversionTransformation *transformation =
+            LcmsLutTransformation::tryCreate(srcColorSpace, srcProfile,
+                                             dstColorSpace, dstProfile,
+                                             renderingIntent, conversionFlags);
+        if (transformation) {
+            return transformation;
+        }
+    }
+
     return new KoLcmsColorConversionTransformation(
-                srcColorSpace, computeColorSpaceType(srcColorSpace),
-                dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms(), dstColorSpace, computeColorSpaceType(dstColorSpace),
-                dynamic_cast<const IccColorProfile *>(dstColorSpace->profile())->asLcms(), renderingIntent, conversionFlags);
+                srcColorSpace, computeColorSpaceType(srcColorSpace), srcProfile,
+                dstColorSpace, computeColorSpaceType(dstColorSpace), dstProfile,
+                renderingIntent, conversionFlags);
 
 }
 KoColorProofingConversionTransformation *IccColorSpaceEngine::createColorProofingTransformation(const KoColorSpace *srcColorSpace,
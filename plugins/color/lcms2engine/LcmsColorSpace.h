@@ -82,6 +82,7 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
             profiles[0] = 0;
             profiles[1] = 0;
             profiles[2] = 0;
+            dependency = ArbitraryDependency;
         }
 
         ~KoLcmsColorTransformation() override
@@ -138,11 +139,17 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
             }
         }
 
+        PixelDependency pixelDependency() const override
+        {
+            return dependency;
+        }
+
         const KoColorSpace *m_colorSpace;
         cmsHPROFILE csProfile;
         cmsHPROFILE profiles[3];
         cmsHTRANSFORM cmstransform;
         cmsHTRANSFORM cmsAlphaTransform;
+        PixelDependency dependency;
     };
 
     struct KisLcmsLastTransformation {
@@ -319,6 +326,7 @@ public:
                              KoColorConversionTransformation::adjustmentRenderingIntent(),
                              KoColorConversionTransformation::adjustmentConversionFlags());
         adj->csProfile = d->profile->lcmsProfile();
+        adj->dependency = KoColorTransformation::ColorDependency;
         return adj;
     }
 
@@ -356,6 +364,8 @@ public:
 
         delete [] transferFunctions;
         delete [] alphaTransferFunctions;
+
+        adj->dependency = KoColorTransformation::ChannelwiseDependency;
         return adj;
     }
 
@@ -0,0 +1,339 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "LcmsLutTransformation.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <lcms2.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QWeakPointer>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorProfile.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <kis_assert.h>
+
+#include "LcmsColorProfileContainer.h"
+
+namespace {
+
+/**
+ * The grid sizes are chosen so that (size - 1) divides both 255 and
+ * 65535. Then every node of the grid is sampled at an exact 16-bit
+ * value and every 8-bit input value falls either exactly on a node or
+ * at a fixed fraction between them.
+ */
+constexpr int gridSize3D = 52;
+constexpr int gridSize4D = 18;
+
+constexpr int outputChannels = 3;
+
+struct LutGrid
+{
+    int inputChannels {0};
+    int gridSize {0};
+    int strides[4] {0, 0, 0, 0};
+    QVector<quint16> nodes;
+};
+
+struct SharedGridCache
+{
+    QMutex mutex;
+    QHash<QByteArray, QWeakPointer<const LutGrid>> grids;
+};
+
+Q_GLOBAL_STATIC(SharedGridCache, s_gridCache)
+
+bool useLutForDepth(const KoID &depthId)
+{
+    return depthId == Integer8BitsColorDepthID ||
+            depthId == Integer16BitsColorDepthID;
+}
+
+/**
+ * The format the grid is sampled in. The channels are ordered the
+ * same way as in the Krita's integer color spaces (BGR for RGB), so
+ * the axes of the grid correspond to the channels in memory.
+ */
+cmsUInt32Number samplingFormat(const KoID &modelId, bool isSource)
+{
+    if (modelId == RGBAColorModelID) {
+        return TYPE_BGR_16;
+    } else if (modelId == LABAColorModelID) {
+        return TYPE_Lab_16;
+    } else if (modelId == CMYKAColorModelID && isSource) {
+        return TYPE_CMYK_16;
+    }
+
+    return 0;
+}
+
+LutGrid* sampleGrid(cmsHPROFILE srcProfile, cmsUInt32Number srcFormat,
+                    cmsHPROFILE dstProfile, cmsUInt32Number dstFormat,
+                    cmsUInt32Number renderingIntent,
+                    cmsUInt32Number flags)
+{
+    cmsHTRANSFORM transform = cmsCreateTransform(srcProfile, srcFormat,
+                                                 dstProfile, dstFormat,
+                                                 renderingIntent, flags);
+    if (!transform) return nullptr;
+
+    QScopedPointer<LutGrid> grid(new LutGrid);
+
+    grid->inputChannels = T_CHANNELS(srcFormat);
+    grid->gridSize = grid->inputChannels == 4 ? gridSize4D : gridSize3D;
+
+    int numNodes = 1;
+    for (int c = 0; c < grid->inputChannels; c++) {
+        grid->strides[c] = outputChannels * numNodes;
+        numNodes *= grid->gridSize;
+    }
+
+    const int nodeStep = 65535 / (grid->gridSize - 1);
+
+    QVector<quint16> probes(numNodes * grid->inputChannels);
+    quint16 *probe = probes.data();
+
+    for (int i = 0; i < numNodes; i++) {
+        int index = i;
+        for (int c = 0; c < grid->inputChannels; c++) {
+            *probe++ = quint16(index % grid->gridSize * nodeStep);
+            index /= grid->gridSize;
+        }
+    }
+
+    grid->nodes.resize(numNodes * outputChannels);
+    cmsDoTransform(transform, probes.constData(), grid->nodes.data(), numNodes);
+    cmsDeleteTransform(transform);
+
+    return grid.take();
+}
+
+/**
+ * Interpolates on the simplex of the grid cell that contains the
+ * point. For three dimensions it is the usual tetrahedral
+ * interpolation: the fractions are sorted in descending order and
+ * the path from the lowest corner of the cell to the highest one goes
+ * along the axes in the same order. The same works for four
+ * dimensions with a 5-vertex simplex.
+ */
+template <int inputChannels>
+inline void interpolateOnSimplex(const quint16 *cell, const float fraction[inputChannels],
+                                 const int strides[inputChannels], float result[outputChannels])
+{
+    int axes[inputChannels];
+    for (int i = 0; i < inputChannels; i++) {
+        int j = i;
+        while (j > 0 && fraction[axes[j - 1]] < fraction[i]) {
+            axes[j] = axes[j - 1];
+            j--;
+        }
+        axes[j] = i;
+    }
+
+    float weight = 1.0f - fraction[axes[0]];
+    for (int c = 0; c < outputChannels; c++) {
+        result[c] = weight * cell[c];
+    }
+
+    int offset = 0;
+    for (int i = 0; i < inputChannels; i++) {
+        offset += strides[axes[i]];
+        weight = i < inputChannels - 1 ?
+            fraction[axes[i]] - fraction[axes[i + 1]] : fraction[axes[i]];
+
+        for (int c = 0; c < outputChannels; c++) {
+            result[c] += weight * cell[offset + c];
+        }
+    }
+}
+
+}
+
+struct LcmsLutTransformation::Private
+{
+    using TransformFunc = void (Private::*)(const quint8 *, quint8 *, qint32) const;
+
+    QSharedPointer<const LutGrid> grid;
+    TransformFunc transformFunc {nullptr};
+
+    template <typename src_channel_type, typename dst_channel_type, int inputChannels>
+    void transformImpl(const quint8 *src, quint8 *dst, qint32 numPixels) const;
+
+    template <typename src_channel_type, int inputChannels>
+    bool initTransformFunc(const KoID &dstDepth);
+
+    bool initTransformFunc(const KoID &srcDepth, const KoID &dstDepth);
+};
+
+template <typename src_channel_type, typename dst_channel_type, int inputChannels>
+void LcmsLutTransformation::Private::transformImpl(const quint8 *srcU8, quint8 *dstU8, qint32 numPixels) const
+{
+    const src_channel_type *src = reinterpret_cast<const src_channel_type*>(srcU8);
+    dst_channel_type *dst = reinterpret_cast<dst_channel_type*>(dstU8);
+
+    const int lastCell = grid->gridSize - 2;
+    const float positionScale = float(grid->gridSize - 1) / KoColorSpaceMathsTraits<src_channel_type>::unitValue;
+
+    const float dstUnitValue = KoColorSpaceMathsTraits<dst_channel_type>::unitValue;
+    const float resultScale = dstUnitValue / 65535.0f;
+
+    const quint16 *nodes = grid->nodes.constData();
+    const int *strides = grid->strides;
+
+    for (qint32 i = 0; i < numPixels; i++) {
+        int offset = 0;
+        float fraction[inputChannels];
+
+        for (int c = 0; c < inputChannels; c++) {
+            const float x = src[c] * positionScale;
+            const int index = std::min(int(x), lastCell);
+            fraction[c] = x - float(index);
+            offset += index * strides[c];
+        }
+
+        float result[outputChannels];
+        interpolateOnSimplex<inputChannels>(nodes + offset, fraction, strides, result);
+
+        for (int c = 0; c < outputChannels; c++) {
+            dst[c] = dst_channel_type(qBound(0.0f, result[c] * resultScale + 0.5f, dstUnitValue));
+        }
+        dst[outputChannels] = KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(src[inputChannels]);
+
+        src += inputChannels + 1;
+        dst += outputChannels + 1;
+    }
+}
+
+template <typename src_channel_type, int inputChannels>
+bool LcmsLutTransformation::Private::initTransformFunc(const KoID &dstDepth)
+{
+    if (dstDepth == Integer8BitsColorDepthID) {
+        transformFunc = &Private::transformImpl<src_channel_type, quint8, inputChannels>;
+    } else if (dstDepth == Integer16BitsColorDepthID) {
+        transformFunc = &Private::transformImpl<src_channel_type, quint16, inputChannels>;
+    }
+
+    return transformFunc != nullptr;
+}
+
+bool LcmsLutTransformation::Private::initTransformFunc(const KoID &srcDepth, const KoID &dstDepth)
+{
+    const bool isCmyk = grid->inputChannels == 4;
+
+    if (srcDepth == Integer8BitsColorDepthID) {
+        return isCmyk ?
+            initTransformFunc<quint8, 4>(dstDepth) :
+            initTransformFunc<quint8, 3>(dstDepth);
+    } else if (srcDepth == Integer16BitsColorDepthID) {
+        return isCmyk ?
+            initTransformFunc<quint16, 4>(dstDepth) :
+            initTransformFunc<quint16, 3>(dstDepth);
+    }
+
+    return false;
+}
+
+LcmsLutTransformation::LcmsLutTransformation(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                                             Intent renderingIntent,
+                                             ConversionFlags conversionFlags,
+                                             Private *d)
+    : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags)
+    , m_d(d)
+{
+}
+
+LcmsLutTransformation::~LcmsLutTransformation()
+{
+}
+
+LcmsLutTransformation *LcmsLutTransformation::tryCreate(const KoColorSpace *srcCs, const LcmsColorProfileContainer *srcProfile,
+                                                        const KoColorSpace *dstCs, const LcmsColorProfileContainer *dstProfile,
+                                                        Intent renderingIntent,
+                                                        ConversionFlags conversionFlags)
+{
+    if (!useLutForDepth(srcCs->colorDepthId()) ||
+        !useLutForDepth(dstCs->colorDepthId()) ||
+        srcCs->colorModelId() == dstCs->colorModelId()) {
+
+        return nullptr;
+    }
+
+    const cmsUInt32Number srcFormat = samplingFormat(srcCs->colorModelId(), true);
+    const cmsUInt32Number dstFormat = samplingFormat(dstCs->colorModelId(), false);
+
+    if (!srcFormat || !dstFormat) return nullptr;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(srcCs->channelCount() == T_CHANNELS(srcFormat) + 1, nullptr);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(dstCs->channelCount() == T_CHANNELS(dstFormat) + 1, nullptr);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(T_CHANNELS(dstFormat) == outputChannels, nullptr);
+
+    /**
+     * Linear profiles need much denser grids in the shadows, Krita
+     * disables LCMS optimizations for them for the same reason
+     */
+    if (srcProfile->isLinear() || dstProfile->isLinear() ||
+        conversionFlags.testFlag(HighQuality) ||
+        conversionFlags.testFlag(NoOptimization)) {
+
+        return nullptr;
+    }
+
+    /**
+     * The nodes are sampled with the exact (non-optimized) pipeline.
+     * The alpha channel is not sampled at all, it is copied by the
+     * transformation itself.
+     */
+    ConversionFlags samplingFlags = conversionFlags | NoOptimization;
+    samplingFlags.setFlag(CopyAlpha, false);
+
+    const QByteArray key =
+        srcCs->profile()->uniqueId() + '|' + dstCs->profile()->uniqueId() + '|' +
+        QByteArray::number(srcFormat) + '|' + QByteArray::number(dstFormat) + '|' +
+        QByteArray::number(int(renderingIntent)) + '|' + QByteArray::number(int(samplingFlags));
+
+    QScopedPointer<Private> d(new Private);
+
+    {
+        QMutexLocker l(&s_gridCache->mutex);
+
+        d->grid = s_gridCache->grids.value(key).toStrongRef();
+
+        if (!d->grid) {
+            LutGrid *grid = sampleGrid(srcProfile->lcmsProfile(), srcFormat,
+                                       dstProfile->lcmsProfile(), dstFormat,
+                                       renderingIntent, samplingFlags);
+            if (!grid) return nullptr;
+
+            d->grid.reset(grid);
+
+            auto it = s_gridCache->grids.begin();
+            while (it != s_gridCache->grids.end()) {
+                it = it->isNull() ? s_gridCache->grids.erase(it) : std::next(it);
+            }
+
+            s_gridCache->grids.insert(key, d->grid.toWeakRef());
+        }
+    }
+
+    if (!d->initTransformFunc(srcCs->colorDepthId(), dstCs->colorDepthId())) {
+        return nullptr;
+    }
+
+    return new LcmsLutTransformation(srcCs, dstCs, renderingIntent, conversionFlags, d.take());
+}
+
+void LcmsLutTransformation::transform(const quint8 *src, quint8 *dst, qint32 numPixels) const
+{
+    ((*m_d).*(m_d->transformFunc))(src, dst, numPixels);
+}
@@ -0,0 +1,66 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef LCMSLUTTRANSFORMATION_H
+#define LCMSLUTTRANSFORMATION_H
+
+#include <QScopedPointer>
+
+#include <KoColorConversionTransformation.h>
+
+class LcmsColorProfileContainer;
+
+/**
+ * A native conversion from CMYK, Lab or RGB into RGB or Lab that
+ * interpolates in a precomputed grid
+ *
+ * The conversions between the device spaces with LUT-based profiles
+ * (e.g. CMYK press profiles) go through a full multidimensional LCMS
+ * pipeline for every pixel, which makes editing of print-prep
+ * documents and their display really slow.
+ *
+ * The transformation samples the LCMS pipeline into a grid of 16-bit
+ * nodes once (52^3 for three input channels, 18^4 for CMYK) and then
+ * interpolates the pixels on a simplex (tetrahedron for 3D, its
+ * 5-vertex analogue for 4D). The grid is shared between all the
+ * transformations with the same profiles, intent and flags, so the
+ * display converter, the export and the per-thread copies of the
+ * transformations kept by KoColorConversionCache don't sample it
+ * again.
+ *
+ * Only 8- and 16-bit integer color spaces are supported. The
+ * conversions with linear profiles or with HighQuality flag are left
+ * to LCMS, since a grid of this size is not precise enough for them.
+ */
+class LcmsLutTransformation : public KoColorConversionTransformation
+{
+public:
+    ~LcmsLutTransformation() override;
+
+    /**
+     * @return a new transformation or nullptr if the pair of color
+     *         spaces or the conversion parameters are not supported
+     */
+    static LcmsLutTransformation* tryCreate(const KoColorSpace *srcCs, const LcmsColorProfileContainer *srcProfile,
+                                            const KoColorSpace *dstCs, const LcmsColorProfileContainer *dstProfile,
+                                            Intent renderingIntent,
+                                            ConversionFlags conversionFlags);
+
+    void transform(const quint8 *src, quint8 *dst, qint32 numPixels) const override;
+
+private:
+    struct Private;
+
+    LcmsLutTransformation(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                          Intent renderingIntent,
+                          ConversionFlags conversionFlags,
+                          Private *d);
+
+private:
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // LCMSLUTTRANSFORMATION_H
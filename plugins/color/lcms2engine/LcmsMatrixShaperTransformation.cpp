@@ -0,0 +1,426 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "LcmsMatrixShaperTransformation.h"
+
+#include <cmath>
+#include <type_traits>
+
+#include <lcms2.h>
+
+#include <QVector>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoBgrColorSpaceTraits.h>
+#include <KoRgbColorSpaceTraits.h>
+#include <KoOptimizedRgbMatrixTransformFactory.h>
+#include <kis_assert.h>
+
+#include "LcmsColorProfileContainer.h"
+
+namespace {
+
+/**
+ * The number of intervals in the sampled tone curves. The curves are
+ * sampled on a quadratic grid, that is, the table is indexed by sqrt(x).
+ * It gives enough precision near black, where the inverted gamma curves
+ * are the steepest, without increasing the size of the table.
+ */
+constexpr int curveTableIntervals = 4096;
+
+/**
+ * The size of the planar block the pixels are processed in
+ */
+constexpr int pixelsPerBlock = 256;
+
+class SampledToneCurve
+{
+public:
+    SampledToneCurve() = default;
+    SampledToneCurve(const SampledToneCurve &rhs) = delete;
+    SampledToneCurve& operator=(const SampledToneCurve &rhs) = delete;
+
+    ~SampledToneCurve()
+    {
+        if (m_curve) {
+            cmsFreeToneCurve(m_curve);
+        }
+    }
+
+    /**
+     * Takes ownership of \p curve and samples it
+     */
+    void reset(cmsToneCurve *curve, bool sampleU8)
+    {
+        KIS_SAFE_ASSERT_RECOVER_RETURN(!m_curve);
+        m_curve = curve;
+
+        m_table.resize(curveTableIntervals + 1);
+        for (int i = 0; i <= curveTableIntervals; i++) {
+            const float t = float(i) / curveTableIntervals;
+            m_table[i] = cmsEvalToneCurveFloat(m_curve, t * t);
+        }
+
+        if (sampleU8) {
+            m_u8Table.resize(256);
+            for (int i = 0; i < 256; i++) {
+                m_u8Table[i] = cmsEvalToneCurveFloat(m_curve, float(i) / 255.0f);
+            }
+        }
+    }
+
+    inline float value(float x) const
+    {
+        if (x >= 0.0f && x <= 1.0f) {
+            const float s = std::sqrt(x) * curveTableIntervals;
+            const int i = qMin(int(s), curveTableIntervals - 1);
+            const float f = s - float(i);
+            return m_table[i] + f * (m_table[i + 1] - m_table[i]);
+        }
+
+        // out-of-range values are possible for floating point
+        // color spaces only, they are rare, so just ask LCMS
+        return cmsEvalToneCurveFloat(m_curve, x);
+    }
+
+    template <typename T>
+    inline float decode(T x) const
+    {
+        return value(KoColorSpaceMaths<T, float>::scaleToA(x));
+    }
+
+    inline float decode(quint8 x) const
+    {
+        return m_u8Table[x];
+    }
+
+private:
+    cmsToneCurve *m_curve {nullptr};
+    QVector<float> m_table;
+    QVector<float> m_u8Table;
+};
+
+bool useNativeTransformForDepth(const KoID &depthId)
+{
+    return depthId == Integer8BitsColorDepthID ||
+            depthId == Integer16BitsColorDepthID ||
+#ifdef HAVE_OPENEXR
+            depthId == Float16BitsColorDepthID ||
+#endif
+            depthId == Float32BitsColorDepthID;
+}
+
+bool hasLutTags(cmsHPROFILE profile, bool isInput)
+{
+    const cmsTagSignature inputTags[] = {
+        cmsSigAToB0Tag, cmsSigAToB1Tag, cmsSigAToB2Tag,
+        cmsSigDToB0Tag, cmsSigDToB1Tag, cmsSigDToB2Tag
+    };
+
+    const cmsTagSignature outputTags[] = {
+        cmsSigBToA0Tag, cmsSigBToA1Tag, cmsSigBToA2Tag,
+        cmsSigBToD0Tag, cmsSigBToD1Tag, cmsSigBToD2Tag
+    };
+
+    const cmsTagSignature *tags = isInput ? inputTags : outputTags;
+
+    for (int i = 0; i < 6; i++) {
+        if (cmsIsTag(profile, tags[i])) return true;
+    }
+
+    return false;
+}
+
+bool isSimpleMatrixShaper(cmsHPROFILE profile, bool isInput)
+{
+    return cmsGetColorSpace(profile) == cmsSigRgbData &&
+            cmsGetPCS(profile) == cmsSigXYZData &&
+            cmsIsMatrixShaper(profile) &&
+            !hasLutTags(profile, isInput);
+}
+
+bool readColorantMatrix(cmsHPROFILE profile, double m[9])
+{
+    const cmsCIEXYZ *red = static_cast<const cmsCIEXYZ*>(cmsReadTag(profile, cmsSigRedColorantTag));
+    const cmsCIEXYZ *green = static_cast<const cmsCIEXYZ*>(cmsReadTag(profile, cmsSigGreenColorantTag));
+    const cmsCIEXYZ *blue = static_cast<const cmsCIEXYZ*>(cmsReadTag(profile, cmsSigBlueColorantTag));
+
+    if (!red || !green || !blue) return false;
+
+    m[0] = red->X; m[1] = green->X; m[2] = blue->X;
+    m[3] = red->Y; m[4] = green->Y; m[5] = blue->Y;
+    m[6] = red->Z; m[7] = green->Z; m[8] = blue->Z;
+
+    return true;
+}
+
+bool invertMatrix(const double m[9], double result[9])
+{
+    const double c0 = m[4] * m[8] - m[5] * m[7];
+    const double c1 = m[5] * m[6] - m[3] * m[8];
+    const double c2 = m[3] * m[7] - m[4] * m[6];
+
+    const double det = m[0] * c0 + m[1] * c1 + m[2] * c2;
+    if (std::abs(det) < 1e-12) return false;
+
+    const double invDet = 1.0 / det;
+
+    result[0] = c0 * invDet;
+    result[1] = (m[2] * m[7] - m[1] * m[8]) * invDet;
+    result[2] = (m[1] * m[5] - m[2] * m[4]) * invDet;
+    result[3] = c1 * invDet;
+    result[4] = (m[0] * m[8] - m[2] * m[6]) * invDet;
+    result[5] = (m[2] * m[3] - m[0] * m[5]) * invDet;
+    result[6] = c2 * invDet;
+    result[7] = (m[1] * m[6] - m[0] * m[7]) * invDet;
+    result[8] = (m[0] * m[4] - m[1] * m[3]) * invDet;
+
+    return true;
+}
+
+const cmsToneCurve* readTrc(cmsHPROFILE profile, int channel)
+{
+    const cmsTagSignature tags[] = {cmsSigRedTRCTag, cmsSigGreenTRCTag, cmsSigBlueTRCTag};
+    return static_cast<const cmsToneCurve*>(cmsReadTag(profile, tags[channel]));
+}
+
+bool hasZeroBlackPoint(cmsHPROFILE profile)
+{
+    for (int i = 0; i < 3; i++) {
+        const cmsToneCurve *curve = readTrc(profile, i);
+        if (!curve || std::abs(cmsEvalToneCurveFloat(curve, 0.0f)) > 1e-6f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+struct LcmsMatrixShaperTransformation::Private
+{
+    using TransformFunc = void (Private::*)(const quint8 *, quint8 *, qint32) const;
+
+    SampledToneCurve srcCurves[3];
+    SampledToneCurve dstCurves[3];
+    float matrix[9];
+    QScopedPointer<KoOptimizedRgbMatrixTransformBase> matrixOp;
+    TransformFunc transformFunc {nullptr};
+
+    template <class SrcTraits, class DstTraits>
+    void transformImpl(const quint8 *src, quint8 *dst, qint32 numPixels) const;
+
+    template <class SrcTraits>
+    bool initTransformFunc(const KoID &dstDepth);
+
+    bool initTransformFunc(const KoID &srcDepth, const KoID &dstDepth);
+};
+
+template <class SrcTraits, class DstTraits>
+void LcmsMatrixShaperTransformation::Private::transformImpl(const quint8 *src, quint8 *dst, qint32 numPixels) const
+{
+    using src_channel_type = typename SrcTraits::channels_type;
+    using dst_channel_type = typename DstTraits::channels_type;
+
+    const bool clampToUnitRange = std::is_integral<dst_channel_type>::value;
+
+    float red[pixelsPerBlock];
+    float green[pixelsPerBlock];
+    float blue[pixelsPerBlock];
+    float alpha[pixelsPerBlock];
+
+    while (numPixels > 0) {
+        const int blockSize = qMin(numPixels, pixelsPerBlock);
+
+        const src_channel_type *srcPtr = reinterpret_cast<const src_channel_type*>(src);
+        for (int i = 0; i < blockSize; i++) {
+            red[i] = srcCurves[0].decode(srcPtr[SrcTraits::red_pos]);
+            green[i] = srcCurves[1].decode(srcPtr[SrcTraits::green_pos]);
+            blue[i] = srcCurves[2].decode(srcPtr[SrcTraits::blue_pos]);
+            alpha[i] = KoColorSpaceMaths<src_channel_type, float>::scaleToA(srcPtr[SrcTraits::alpha_pos]);
+            srcPtr += SrcTraits::channels_nb;
+        }
+
+        matrixOp->applyMatrix(red, green, blue, blockSize, matrix, clampToUnitRange);
+
+        dst_channel_type *dstPtr = reinterpret_cast<dst_channel_type*>(dst);
+        for (int i = 0; i < blockSize; i++) {
+            dstPtr[DstTraits::red_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(dstCurves[0].value(red[i]));
+            dstPtr[DstTraits::green_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(dstCurves[1].value(green[i]));
+            dstPtr[DstTraits::blue_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(dstCurves[2].value(blue[i]));
+            dstPtr[DstTraits::alpha_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(alpha[i]);
+            dstPtr += DstTraits::channels_nb;
+        }
+
+        src += blockSize * SrcTraits::pixelSize;
+        dst += blockSize * DstTraits::pixelSize;
+        numPixels -= blockSize;
+    }
+}
+
+template <class SrcTraits>
+bool LcmsMatrixShaperTransformation::Private::initTransformFunc(const KoID &dstDepth)
+{
+    if (dstDepth == Integer8BitsColorDepthID) {
+        transformFunc = &Private::transformImpl<SrcTraits, KoBgrU8Traits>;
+    } else if (dstDepth == Integer16BitsColorDepthID) {
+        transformFunc = &Private::transformImpl<SrcTraits, KoBgrU16Traits>;
+#ifdef HAVE_OPENEXR
+    } else if (dstDepth == Float16BitsColorDepthID) {
+        transformFunc = &Private::transformImpl<SrcTraits, KoRgbF16Traits>;
+#endif
+    } else if (dstDepth == Float32BitsColorDepthID) {
+        transformFunc = &Private::transformImpl<SrcTraits, KoRgbF32Traits>;
+    }
+
+    return transformFunc != nullptr;
+}
+
+bool LcmsMatrixShaperTransformation::Private::initTransformFunc(const KoID &srcDepth, const KoID &dstDepth)
+{
+    if (srcDepth == Integer8BitsColorDepthID) {
+        return initTransformFunc<KoBgrU8Traits>(dstDepth);
+    } else if (srcDepth == Integer16BitsColorDepthID) {
+        return initTransformFunc<KoBgrU16Traits>(dstDepth);
+#ifdef HAVE_OPENEXR
+    } else if (srcDepth == Float16BitsColorDepthID) {
+        return initTransformFunc<KoRgbF16Traits>(dstDepth);
+#endif
+    } else if (srcDepth == Float32BitsColorDepthID) {
+        return initTransformFunc<KoRgbF32Traits>(dstDepth);
+    }
+
+    return false;
+}
+
+LcmsMatrixShaperTransformation::LcmsMatrixShaperTransformation(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                                                               Intent renderingIntent,
+                                                               ConversionFlags conversionFlags,
+                                                               Private *d)
+    : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags)
+    , m_d(d)
+{
+}
+
+LcmsMatrixShaperTransformation::~LcmsMatrixShaperTransformation()
+{
+}
+
+LcmsMatrixShaperTransformation *LcmsMatrixShaperTransformation::tryCreate(const KoColorSpace *srcCs, const LcmsColorProfileContainer *srcProfile,
+                                                                          const KoColorSpace *dstCs, const LcmsColorProfileContainer *dstProfile,
+                                                                          Intent renderingIntent,
+                                                                          ConversionFlags conversionFlags)
+{
+    if (srcCs->colorModelId() != RGBAColorModelID ||
+        dstCs->colorModelId() != RGBAColorModelID ||
+        !useNativeTransformForDepth(srcCs->colorDepthId()) ||
+        !useNativeTransformForDepth(dstCs->colorDepthId())) {
+
+        return nullptr;
+    }
+
+    /**
+     * LCMS already has a highly optimized fixed-point path for 8-bit
+     * matrix-shaper conversions, it is enabled unless one of the profiles
+     * is linear (then Krita disables LCMS optimizations for precision
+     * reasons)
+     */
+    if (srcCs->colorDepthId() == Integer8BitsColorDepthID &&
+        dstCs->colorDepthId() == Integer8BitsColorDepthID &&
+        !srcProfile->isLinear() && !dstProfile->isLinear()) {
+
+        return nullptr;
+    }
+
+    cmsHPROFILE srcLcms = srcProfile->lcmsProfile();
+    cmsHPROFILE dstLcms = dstProfile->lcmsProfile();
+
+    if (!isSimpleMatrixShaper(srcLcms, true) || !isSimpleMatrixShaper(dstLcms, false)) {
+        return nullptr;
+    }
+
+    /**
+     * Absolute colorimetric intent needs white point scaling, just
+     * let LCMS handle that.
+     *
+     * Black point compensation (requested explicitly or implied by LCMS
+     * for perceptual intent in V4 profiles) is a no-op only when both
+     * profiles have the same black point. For matrix-shaper profiles
+     * with zero black it happens when either the black is detected by
+     * the curves (explicit BPC) or both of the profiles have the same
+     * fixed V4 perceptual black point.
+     */
+    if (renderingIntent == IntentAbsoluteColorimetric) {
+        return nullptr;
+    }
+
+    if (!hasZeroBlackPoint(srcLcms) || !hasZeroBlackPoint(dstLcms)) {
+        return nullptr;
+    }
+
+    if ((renderingIntent == IntentPerceptual || renderingIntent == IntentSaturation) &&
+        (cmsGetProfileVersion(srcLcms) >= 4.0) != (cmsGetProfileVersion(dstLcms) >= 4.0)) {
+
+        return nullptr;
+    }
+
+    double srcMatrix[9];
+    double dstMatrix[9];
+    double dstInverseMatrix[9];
+
+    if (!readColorantMatrix(srcLcms, srcMatrix) ||
+        !readColorantMatrix(dstLcms, dstMatrix) ||
+        !invertMatrix(dstMatrix, dstInverseMatrix)) {
+
+        return nullptr;
+    }
+
+    QScopedPointer<Private> d(new Private);
+
+    if (!d->initTransformFunc(srcCs->colorDepthId(), dstCs->colorDepthId())) {
+        return nullptr;
+    }
+
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            double value = 0.0;
+            for (int k = 0; k < 3; k++) {
+                value += dstInverseMatrix[row * 3 + k] * srcMatrix[k * 3 + col];
+            }
+            d->matrix[row * 3 + col] = float(value);
+        }
+    }
+
+    const bool srcIsU8 = srcCs->colorDepthId() == Integer8BitsColorDepthID;
+
+    for (int i = 0; i < 3; i++) {
+        const cmsToneCurve *srcCurve = readTrc(srcLcms, i);
+        const cmsToneCurve *dstCurve = readTrc(dstLcms, i);
+
+        cmsToneCurve *srcCurveCopy = cmsDupToneCurve(srcCurve);
+        cmsToneCurve *dstCurveInverted = cmsReverseToneCurve(dstCurve);
+
+        if (!srcCurveCopy || !dstCurveInverted) {
+            if (srcCurveCopy) cmsFreeToneCurve(srcCurveCopy);
+            if (dstCurveInverted) cmsFreeToneCurve(dstCurveInverted);
+            return nullptr;
+        }
+
+        d->srcCurves[i].reset(srcCurveCopy, srcIsU8);
+        d->dstCurves[i].reset(dstCurveInverted, false);
+    }
+
+    d->matrixOp.reset(KoOptimizedRgbMatrixTransformFactory::create());
+
+    return new LcmsMatrixShaperTransformation(srcCs, dstCs, renderingIntent, conversionFlags, d.take());
+}
+
+void LcmsMatrixShaperTransformation::transform(const quint8 *src, quint8 *dst, qint32 numPixels) const
+{
+    ((*m_d).*(m_d->transformFunc))(src, dst, numPixels);
+}
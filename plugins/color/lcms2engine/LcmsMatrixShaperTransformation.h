@@ -0,0 +1,62 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef LCMSMATRIXSHAPERTRANSFORMATION_H
+#define LCMSMATRIXSHAPERTRANSFORMATION_H
+
+#include <QScopedPointer>
+
+#include <KoColorConversionTransformation.h>
+
+class LcmsColorProfileContainer;
+
+/**
+ * A native conversion between two RGB matrix-shaper profiles
+ *
+ * Most of RGB profiles used in Krita (sRGB, Rec. 709, Rec. 2020,
+ * their linear versions and so on) are defined by three tone curves
+ * and a 3x3 colorant matrix only. The conversion between such profiles
+ * doesn't need a generic LCMS pipeline: it is just "linearize source
+ * channels, multiply by a matrix, apply inverted destination curves".
+ *
+ * The curves are sampled into tables on construction and the matrix
+ * stage is done by the vectorized KoOptimizedRgbMatrixTransformBase,
+ * which is selected for the current CPU architecture.
+ *
+ * The transformation is created only when it is guaranteed to give the
+ * same result as LCMS (within the rounding error), otherwise tryCreate()
+ * returns null and the caller should fall back to a normal LCMS
+ * transform.
+ */
+class LcmsMatrixShaperTransformation : public KoColorConversionTransformation
+{
+public:
+    ~LcmsMatrixShaperTransformation() override;
+
+    /**
+     * @return a new transformation or nullptr if the pair of color
+     *         spaces or the conversion parameters are not supported
+     */
+    static LcmsMatrixShaperTransformation* tryCreate(const KoColorSpace *srcCs, const LcmsColorProfileContainer *srcProfile,
+                                                     const KoColorSpace *dstCs, const LcmsColorProfileContainer *dstProfile,
+                                                     Intent renderingIntent,
+                                                     ConversionFlags conversionFlags);
+
+    void transform(const quint8 *src, quint8 *dst, qint32 numPixels) const override;
+
+private:
+    struct Private;
+
+    LcmsMatrixShaperTransformation(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                                   Intent renderingIntent,
+                                   ConversionFlags conversionFlags,
+                                   Private *d);
+
+private:
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // LCMSMATRIXSHAPERTRANSFORMATION_H
@@ -0,0 +1,252 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsLutTransformation.h"
+
+#include <cmath>
+#include <random>
+
+#include <lcms2.h>
+
+#include <simpletest.h>
+#include <testpigment.h>
+
+#include "kis_debug.h"
+#include "kis_assert.h"
+
+#include <KoColorConversionTransformation.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorProfile.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+namespace {
+
+const int numTestPixels = 256 * 256;
+
+cmsUInt32Number lcmsTypeFor(const KoColorSpace *cs)
+{
+    const cmsUInt32Number bytes =
+        cs->colorDepthId() == Integer8BitsColorDepthID ? BYTES_SH(1) : BYTES_SH(2);
+
+    if (cs->colorModelId() == RGBAColorModelID) {
+        return COLORSPACE_SH(PT_RGB) | EXTRA_SH(1) | CHANNELS_SH(3) | DOSWAP_SH(1) | SWAPFIRST_SH(1) | bytes;
+    } else if (cs->colorModelId() == LABAColorModelID) {
+        return COLORSPACE_SH(PT_Lab) | EXTRA_SH(1) | CHANNELS_SH(3) | bytes;
+    } else if (cs->colorModelId() == CMYKAColorModelID) {
+        return COLORSPACE_SH(PT_CMYK) | EXTRA_SH(1) | CHANNELS_SH(4) | bytes;
+    }
+
+    qFatal("unsupported color model");
+    return 0;
+}
+
+const KoColorSpace* colorSpaceByKey(const QString &modelId, const QString &depthId)
+{
+    const KoColorProfile *profile =
+        modelId == RGBAColorModelID.id() ?
+        KoColorSpaceRegistry::instance()->p709SRGBProfile() : nullptr;
+
+    return KoColorSpaceRegistry::instance()->colorSpace(modelId, depthId, profile);
+}
+
+QVector<quint8> generateRandomPixels(const KoColorSpace *cs, int numPixels)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+
+    QVector<quint8> pixels(numPixels * cs->pixelSize());
+    QVector<float> channels(cs->channelCount());
+
+    for (int i = 0; i < numPixels; i++) {
+        for (float &c : channels) {
+            c = dis(gen);
+        }
+        cs->fromNormalisedChannelsValue(pixels.data() + i * cs->pixelSize(), channels);
+    }
+
+    return pixels;
+}
+
+struct ConversionSetup
+{
+    ConversionSetup()
+    {
+        QFETCH(QString, srcModelId);
+        QFETCH(QString, srcDepthId);
+        QFETCH(QString, dstModelId);
+        QFETCH(QString, dstDepthId);
+
+        srcCs = colorSpaceByKey(srcModelId, srcDepthId);
+        dstCs = colorSpaceByKey(dstModelId, dstDepthId);
+
+        KIS_ASSERT(srcCs);
+        KIS_ASSERT(dstCs);
+
+        src = generateRandomPixels(srcCs, numTestPixels);
+        dst.resize(numTestPixels * dstCs->pixelSize());
+    }
+
+    cmsHTRANSFORM createLcmsTransform()
+    {
+        const QByteArray srcData = srcCs->profile()->rawData();
+        const QByteArray dstData = dstCs->profile()->rawData();
+
+        cmsHPROFILE srcProfile = cmsOpenProfileFromMem(srcData.constData(), srcData.size());
+        cmsHPROFILE dstProfile = cmsOpenProfileFromMem(dstData.constData(), dstData.size());
+
+        cmsHTRANSFORM transform =
+            cmsCreateTransform(srcProfile, lcmsTypeFor(srcCs),
+                               dstProfile, lcmsTypeFor(dstCs),
+                               INTENT_PERCEPTUAL,
+                               cmsFLAGS_NOOPTIMIZE | cmsFLAGS_COPY_ALPHA);
+
+        cmsCloseProfile(srcProfile);
+        cmsCloseProfile(dstProfile);
+
+        return transform;
+    }
+
+    KoColorConversionTransformation* createKritaTransform()
+    {
+        return srcCs->createColorConverter(dstCs,
+                                           KoColorConversionTransformation::IntentPerceptual,
+                                           KoColorConversionTransformation::Empty);
+    }
+
+    const KoColorSpace *srcCs {nullptr};
+    const KoColorSpace *dstCs {nullptr};
+    QVector<quint8> src;
+    QVector<quint8> dst;
+};
+
+void addConversionRows()
+{
+    QTest::addColumn<QString>("srcModelId");
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstModelId");
+    QTest::addColumn<QString>("dstDepthId");
+
+    const QVector<QPair<KoID, KoID>> modelPairs = {
+        {CMYKAColorModelID, RGBAColorModelID},
+        {CMYKAColorModelID, LABAColorModelID},
+        {LABAColorModelID, RGBAColorModelID},
+        {RGBAColorModelID, LABAColorModelID}
+    };
+
+    const QVector<QPair<KoID, KoID>> depthPairs = {
+        {Integer8BitsColorDepthID, Integer8BitsColorDepthID},
+        {Integer16BitsColorDepthID, Integer8BitsColorDepthID},
+        {Integer8BitsColorDepthID, Integer16BitsColorDepthID},
+        {Integer16BitsColorDepthID, Integer16BitsColorDepthID}
+    };
+
+    for (const auto &models : modelPairs) {
+        for (const auto &depths : depthPairs) {
+            const QString name = QString("%1%2-%3%4")
+                .arg(models.first.id(), depths.first.id(), models.second.id(), depths.second.id());
+
+            QTest::newRow(name.toLatin1())
+                << models.first.id() << depths.first.id()
+                << models.second.id() << depths.second.id();
+        }
+    }
+}
+
+}
+
+void TestLcmsLutTransformation::testMatchesLcms_data()
+{
+    addConversionRows();
+}
+
+void TestLcmsLutTransformation::testMatchesLcms()
+{
+    ConversionSetup s;
+
+    QScopedPointer<KoColorConversionTransformation> transform(s.createKritaTransform());
+    QVERIFY(transform);
+    transform->transform(s.src.constData(), s.dst.data(), numTestPixels);
+
+    QVector<quint8> reference(s.dst.size());
+    cmsHTRANSFORM lcmsTransform = s.createLcmsTransform();
+    QVERIFY(lcmsTransform);
+    cmsDoTransform(lcmsTransform, s.src.constData(), reference.data(), numTestPixels);
+    cmsDeleteTransform(lcmsTransform);
+
+    const int pixelSize = s.dstCs->pixelSize();
+
+    QVector<float> channels(s.dstCs->channelCount());
+    QVector<float> referenceChannels(s.dstCs->channelCount());
+
+    float maxError = 0.0f;
+    double totalError = 0.0;
+
+    for (int i = 0; i < numTestPixels; i++) {
+        s.dstCs->normalisedChannelsValue(s.dst.constData() + i * pixelSize, channels);
+        s.dstCs->normalisedChannelsValue(reference.constData() + i * pixelSize, referenceChannels);
+
+        for (int c = 0; c < channels.size(); c++) {
+            const float error = std::abs(channels[c] - referenceChannels[c]);
+            maxError = qMax(maxError, error);
+            totalError += error;
+        }
+    }
+
+    const double meanError = totalError / (numTestPixels * channels.size());
+
+    /**
+     * CMYK profiles are LUT-based themselves, the interpolation in a
+     * coarser 4D grid may deviate more in the steep areas of the
+     * gamut, but should be still invisible on average
+     */
+    const float maxTolerance =
+        s.srcCs->colorModelId() == CMYKAColorModelID ? 0.02f : 0.01f;
+    const double meanTolerance = 2.0 / 255.0;
+
+    QVERIFY2(maxError <= maxTolerance,
+             QString("max error %1 exceeds tolerance %2").arg(maxError).arg(maxTolerance).toLatin1());
+    QVERIFY2(meanError <= meanTolerance,
+             QString("mean error %1 exceeds tolerance %2").arg(meanError).arg(meanTolerance).toLatin1());
+}
+
+void TestLcmsLutTransformation::benchmarkNative_data()
+{
+    addConversionRows();
+}
+
+void TestLcmsLutTransformation::benchmarkNative()
+{
+    ConversionSetup s;
+
+    QScopedPointer<KoColorConversionTransformation> transform(s.createKritaTransform());
+    QVERIFY(transform);
+
+    QBENCHMARK {
+        transform->transform(s.src.constData(), s.dst.data(), numTestPixels);
+    }
+}
+
+void TestLcmsLutTransformation::benchmarkLcms_data()
+{
+    addConversionRows();
+}
+
+void TestLcmsLutTransformation::benchmarkLcms()
+{
+    ConversionSetup s;
+
+    cmsHTRANSFORM lcmsTransform = s.createLcmsTransform();
+    QVERIFY(lcmsTransform);
+
+    QBENCHMARK {
+        cmsDoTransform(lcmsTransform, s.src.constData(), s.dst.data(), numTestPixels);
+    }
+
+    cmsDeleteTransform(lcmsTransform);
+}
+
+KISTEST_MAIN(TestLcmsLutTransformation)
@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTLCMSLUTTRANSFORMATION_H
+#define TESTLCMSLUTTRANSFORMATION_H
+
+#include <QObject>
+
+class TestLcmsLutTransformation : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMatchesLcms_data();
+    void testMatchesLcms();
+
+    void benchmarkNative_data();
+    void benchmarkNative();
+    void benchmarkLcms_data();
+    void benchmarkLcms();
+};
+
+#endif // TESTLCMSLUTTRANSFORMATION_H
@@ -0,0 +1,260 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsMatrixShaperTransformation.h"
+
+#include <cmath>
+#include <random>
+
+#include <lcms2.h>
+
+#include <simpletest.h>
+#include <testpigment.h>
+
+#include "kis_debug.h"
+#include "kis_assert.h"
+
+#include <KoColorConversionTransformation.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorProfile.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+namespace {
+
+const int numTestPixels = 256 * 256;
+
+cmsUInt32Number lcmsTypeForDepth(const KoID &depth)
+{
+    if (depth == Integer8BitsColorDepthID) {
+        return TYPE_BGRA_8;
+    } else if (depth == Integer16BitsColorDepthID) {
+        return TYPE_BGRA_16;
+    } else if (depth == Float32BitsColorDepthID) {
+        return TYPE_RGBA_FLT;
+    }
+
+    qFatal("unsupported color depth");
+    return 0;
+}
+
+float toleranceForDepth(const KoID &depth)
+{
+    if (depth == Integer8BitsColorDepthID) {
+        return 1.0f / 255.0f;
+    } else if (depth == Integer16BitsColorDepthID) {
+        return 64.0f / 65535.0f;
+    }
+
+    return 1e-3f;
+}
+
+const KoColorProfile *profileByKey(const QString &key)
+{
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    if (key == "srgb") {
+        return registry->p709SRGBProfile();
+    } else if (key == "rec709-linear") {
+        return registry->p709G10Profile();
+    } else if (key == "rec2020-linear") {
+        return registry->p2020G10Profile();
+    }
+
+    return nullptr;
+}
+
+QVector<quint8> generateRandomPixels(const KoColorSpace *cs, int numPixels)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+
+    QVector<quint8> pixels(numPixels * cs->pixelSize());
+    QVector<float> channels(cs->channelCount());
+
+    for (int i = 0; i < numPixels; i++) {
+        for (float &c : channels) {
+            c = dis(gen);
+        }
+        cs->fromNormalisedChannelsValue(pixels.data() + i * cs->pixelSize(), channels);
+    }
+
+    return pixels;
+}
+
+struct ConversionSetup
+{
+    ConversionSetup()
+    {
+        QFETCH(QString, srcProfileKey);
+        QFETCH(QString, dstProfileKey);
+        QFETCH(QString, srcDepthId);
+        QFETCH(QString, dstDepthId);
+
+        srcDepth = KoID(srcDepthId);
+        dstDepth = KoID(dstDepthId);
+
+        srcCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), srcDepthId, profileByKey(srcProfileKey));
+        dstCs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), dstDepthId, profileByKey(dstProfileKey));
+
+        KIS_ASSERT(srcCs);
+        KIS_ASSERT(dstCs);
+
+        src = generateRandomPixels(srcCs, numTestPixels);
+        dst.resize(numTestPixels * dstCs->pixelSize());
+    }
+
+    cmsHTRANSFORM createLcmsTransform()
+    {
+        const QByteArray srcData = srcCs->profile()->rawData();
+        const QByteArray dstData = dstCs->profile()->rawData();
+
+        cmsHPROFILE srcProfile = cmsOpenProfileFromMem(srcData.constData(), srcData.size());
+        cmsHPROFILE dstProfile = cmsOpenProfileFromMem(dstData.constData(), dstData.size());
+
+        cmsHTRANSFORM transform =
+            cmsCreateTransform(srcProfile, lcmsTypeForDepth(srcDepth),
+                               dstProfile, lcmsTypeForDepth(dstDepth),
+                               INTENT_RELATIVE_COLORIMETRIC,
+                               cmsFLAGS_NOOPTIMIZE | cmsFLAGS_COPY_ALPHA);
+
+        cmsCloseProfile(srcProfile);
+        cmsCloseProfile(dstProfile);
+
+        return transform;
+    }
+
+    KoColorConversionTransformation* createKritaTransform()
+    {
+        return srcCs->createColorConverter(dstCs,
+                                           KoColorConversionTransformation::IntentRelativeColorimetric,
+                                           KoColorConversionTransformation::Empty);
+    }
+
+    KoID srcDepth;
+    KoID dstDepth;
+    const KoColorSpace *srcCs {nullptr};
+    const KoColorSpace *dstCs {nullptr};
+    QVector<quint8> src;
+    QVector<quint8> dst;
+};
+
+void addConversionRows()
+{
+    QTest::addColumn<QString>("srcProfileKey");
+    QTest::addColumn<QString>("dstProfileKey");
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+
+    const QStringList profilePairs = {
+        "srgb:rec2020-linear",
+        "rec2020-linear:srgb",
+        "srgb:rec709-linear",
+        "rec709-linear:rec2020-linear"
+    };
+
+    const QVector<QPair<KoID, KoID>> depthPairs = {
+        {Integer16BitsColorDepthID, Integer16BitsColorDepthID},
+        {Integer8BitsColorDepthID, Integer16BitsColorDepthID},
+        {Integer8BitsColorDepthID, Float32BitsColorDepthID},
+        {Integer16BitsColorDepthID, Float32BitsColorDepthID},
+        {Float32BitsColorDepthID, Integer8BitsColorDepthID},
+        {Float32BitsColorDepthID, Integer16BitsColorDepthID},
+        {Float32BitsColorDepthID, Float32BitsColorDepthID}
+    };
+
+    Q_FOREACH (const QString &pair, profilePairs) {
+        const QStringList keys = pair.split(':');
+
+        for (const auto &depths : depthPairs) {
+            const QString name = QString("%1-%2:%3-%4")
+                .arg(keys[0], depths.first.id(), keys[1], depths.second.id());
+
+            QTest::newRow(name.toLatin1())
+                << keys[0] << keys[1] << depths.first.id() << depths.second.id();
+        }
+    }
+}
+
+}
+
+void TestLcmsMatrixShaperTransformation::testMatchesLcms_data()
+{
+    addConversionRows();
+}
+
+void TestLcmsMatrixShaperTransformation::testMatchesLcms()
+{
+    ConversionSetup s;
+
+    QScopedPointer<KoColorConversionTransformation> transform(s.createKritaTransform());
+    QVERIFY(transform);
+    transform->transform(s.src.constData(), s.dst.data(), numTestPixels);
+
+    QVector<quint8> reference(s.dst.size());
+    cmsHTRANSFORM lcmsTransform = s.createLcmsTransform();
+    QVERIFY(lcmsTransform);
+    cmsDoTransform(lcmsTransform, s.src.constData(), reference.data(), numTestPixels);
+    cmsDeleteTransform(lcmsTransform);
+
+    const float tolerance = toleranceForDepth(s.dstDepth);
+    const int pixelSize = s.dstCs->pixelSize();
+
+    QVector<float> channels(s.dstCs->channelCount());
+    QVector<float> referenceChannels(s.dstCs->channelCount());
+
+    float maxError = 0.0f;
+
+    for (int i = 0; i < numTestPixels; i++) {
+        s.dstCs->normalisedChannelsValue(s.dst.constData() + i * pixelSize, channels);
+        s.dstCs->normalisedChannelsValue(reference.constData() + i * pixelSize, referenceChannels);
+
+        for (int c = 0; c < channels.size(); c++) {
+            maxError = qMax(maxError, std::abs(channels[c] - referenceChannels[c]));
+        }
+    }
+
+    QVERIFY2(maxError <= tolerance + 1e-6f,
+             QString("max error %1 exceeds tolerance %2").arg(maxError).arg(tolerance).toLatin1());
+}
+
+void TestLcmsMatrixShaperTransformation::benchmarkNative_data()
+{
+    addConversionRows();
+}
+
+void TestLcmsMatrixShaperTransformation::benchmarkNative()
+{
+    ConversionSetup s;
+
+    QScopedPointer<KoColorConversionTransformation> transform(s.createKritaTransform());
+    QVERIFY(transform);
+
+    QBENCHMARK {
+        transform->transform(s.src.constData(), s.dst.data(), numTestPixels);
+    }
+}
+
+void TestLcmsMatrixShaperTransformation::benchmarkLcms_data()
+{
+    addConversionRows();
+}
+
+void TestLcmsMatrixShaperTransformation::benchmarkLcms()
+{
+    ConversionSetup s;
+
+    cmsHTRANSFORM lcmsTransform = s.createLcmsTransform();
+    QVERIFY(lcmsTransform);
+
+    QBENCHMARK {
+        cmsDoTransform(lcmsTransform, s.src.constData(), s.dst.data(), numTestPixels);
+    }
+
+    cmsDeleteTransform(lcmsTransform);
+}
+
+KISTEST_MAIN(TestLcmsMatrixShaperTransformation)
@@ -0,0 +1,25 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTLCMSMATRIXSHAPERTRANSFORMATION_H
+#define TESTLCMSMATRIXSHAPERTRANSFORMATION_H
+
+#include <QObject>
+
+class TestLcmsMatrixShaperTransformation : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMatchesLcms_data();
+    void testMatchesLcms();
+
+    void benchmarkNative_data();
+    void benchmarkNative();
+    void benchmarkLcms_data();
+    void benchmarkLcms();
+};
+
+#endif // TESTLCMSMATRIXSHAPERTRANSFORMATION_H
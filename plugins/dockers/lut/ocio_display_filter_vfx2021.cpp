@@ -25,6 +25,16 @@
 
 #include <cmath>
 #include <cstring>
+#include <limits>
+#include <vector>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedPointer>
+#include <QStringList>
+
+#include <KoColorModelStandardIds.h>
+#include <KoOptimizedColorLut3DFactory.h>
 
 #include <kis_config.h>
 #include <kis_debug.h>
@@ -44,6 +54,197 @@
 
 #include "kis_context_thread_locale.h"
 
+namespace {
+
+const int processorCacheSize = 16;
+
+/**
+ * 65 nodes along every axis make the interpolation error invisible
+ * for the usual filmic view transforms, while baking takes less time
+ * than filtering a single full HD canvas with the processor
+ */
+const int cpuLutSize = 65;
+const int cpuAlphaLutSize = 4096;
+
+/**
+ * Maps the (possibly HDR) input values into the unit range of the
+ * 3D LUT. It follows the allocation of the input color space, like
+ * the legacy GPU path of OCIO does. If the config doesn't define any
+ * allocation, 24 stops around the middle gray are covered.
+ */
+struct LutShaper {
+    bool isLog = true;
+    float min = -12.0f;
+    float max = 12.0f;
+    float offset = 1.0f / 4096.0f;
+
+    void setFromColorSpace(OCIO::ConstColorSpaceRcPtr colorSpace)
+    {
+        if (!colorSpace) return;
+
+        const int numVars = colorSpace->getAllocationNumVars();
+        if (numVars < 2) return;
+
+        std::vector<float> vars(numVars);
+        colorSpace->getAllocationVars(vars.data());
+
+        if (vars[1] <= vars[0]) return;
+
+        isLog = colorSpace->getAllocation() == OCIO::ALLOCATION_LG2;
+        min = vars[0];
+        max = vars[1];
+        offset = isLog && numVars > 2 ? vars[2] : 0.0f;
+    }
+
+    inline float forward(float x) const
+    {
+        if (isLog) {
+            x = std::log2(std::max(x + offset, std::numeric_limits<float>::min()));
+        }
+        return (x - min) / (max - min);
+    }
+
+    inline float inverse(float t) const
+    {
+        const float x = min + t * (max - min);
+        return isLog ? std::exp2(x) - offset : x;
+    }
+};
+
+}
+
+struct OcioDisplayFilter::ProcessorSet
+{
+    QString cacheKey;
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO::ConstProcessorRcPtr reverseApproximationProcessor;
+    OCIO::ConstProcessorRcPtr forwardApproximationProcessor;
+
+    OCIO::ConstCPUProcessorRcPtr processorCPU;
+    OCIO::ConstCPUProcessorRcPtr reverseApproximationProcessorCPU;
+    OCIO::ConstCPUProcessorRcPtr forwardApproximationProcessorCPU;
+
+    /**
+     * The processor baked into a 3D LUT for the CPU path of the
+     * canvas. It is baked lazily, because the OpenGL canvas uses
+     * the shaders instead.
+     *
+     * The LUT is only an approximation of the processor, so it is
+     * used either for all the pixels or for none of them, otherwise
+     * the patches of the canvas would not match. It is enabled with
+     * "Krita/Ocio/UseCpuLut" option of kritarc.
+     */
+    bool useLut = false;
+    LutShaper shaper;
+
+    QMutex lutMutex;
+    bool lutBaked = false;
+    QVector<float> lut;
+    QVector<float> alphaLut;
+    QScopedPointer<KoOptimizedColorLut3DBase> lutApplicator;
+
+    void bakeLut();
+    bool applyLut(float *pixels, quint32 numPixels);
+};
+
+void OcioDisplayFilter::ProcessorSet::bakeLut()
+{
+    const int numNodes = cpuLutSize * cpuLutSize * cpuLutSize;
+
+    std::vector<float> samples;
+    samples.reserve(numNodes * 4);
+
+    for (int i2 = 0; i2 < cpuLutSize; i2++) {
+        for (int i1 = 0; i1 < cpuLutSize; i1++) {
+            for (int i0 = 0; i0 < cpuLutSize; i0++) {
+                samples.push_back(shaper.inverse(float(i0) / (cpuLutSize - 1)));
+                samples.push_back(shaper.inverse(float(i1) / (cpuLutSize - 1)));
+                samples.push_back(shaper.inverse(float(i2) / (cpuLutSize - 1)));
+                samples.push_back(1.0f);
+            }
+        }
+    }
+
+    std::vector<float> alphaSamples;
+    alphaSamples.reserve(cpuAlphaLutSize * 4);
+
+    for (int i = 0; i < cpuAlphaLutSize; i++) {
+        alphaSamples.push_back(0.0f);
+        alphaSamples.push_back(0.0f);
+        alphaSamples.push_back(0.0f);
+        alphaSamples.push_back(float(i) / (cpuAlphaLutSize - 1));
+    }
+
+    try {
+        AutoSetAndRestoreThreadLocale l;
+
+        OCIO::PackedImageDesc img(samples.data(), numNodes, 1, 4);
+        processorCPU->apply(img);
+
+        OCIO::PackedImageDesc alphaImg(alphaSamples.data(), cpuAlphaLutSize, 1, 4);
+        processorCPU->apply(alphaImg);
+    } catch (OCIO::Exception &e) {
+        warnKrita << "OCIO exception while baking the display LUT:" << e.what();
+        return;
+    }
+
+    lut.resize(numNodes * 3);
+    for (int i = 0; i < numNodes; i++) {
+        lut[3 * i + 0] = samples[4 * i + 0];
+        lut[3 * i + 1] = samples[4 * i + 1];
+        lut[3 * i + 2] = samples[4 * i + 2];
+    }
+
+    alphaLut.resize(cpuAlphaLutSize);
+    for (int i = 0; i < cpuAlphaLutSize; i++) {
+        alphaLut[i] = alphaSamples[4 * i + 3];
+    }
+
+    lutApplicator.reset(KoOptimizedColorLut3DFactory::create(Float32BitsColorDepthID));
+}
+
+bool OcioDisplayFilter::ProcessorSet::applyLut(float *pixels, quint32 numPixels)
+{
+    if (!useLut) return false;
+
+    {
+        QMutexLocker l(&lutMutex);
+        if (!lutBaked) {
+            bakeLut();
+            lutBaked = true;
+        }
+    }
+
+    if (!lutApplicator) return false;
+
+    float *pixel = pixels;
+    for (quint32 i = 0; i < numPixels; i++) {
+        pixel[0] = shaper.forward(pixel[0]);
+        pixel[1] = shaper.forward(pixel[1]);
+        pixel[2] = shaper.forward(pixel[2]);
+        pixel += 4;
+    }
+
+    lutApplicator->apply(reinterpret_cast<const quint8*>(pixels),
+                         reinterpret_cast<quint8*>(pixels),
+                         numPixels, lut.constData(), cpuLutSize);
+
+    const float lastAlphaNode = cpuAlphaLutSize - 1;
+
+    pixel = pixels;
+    for (quint32 i = 0; i < numPixels; i++) {
+        const float x = qBound(0.0f, pixel[3], 1.0f) * lastAlphaNode;
+        const int index = std::min(int(x), cpuAlphaLutSize - 2);
+        const float fraction = x - index;
+
+        pixel[3] = alphaLut[index] + (alphaLut[index + 1] - alphaLut[index]) * fraction;
+        pixel += 4;
+    }
+
+    return true;
+}
+
 OcioDisplayFilter::OcioDisplayFilter(KisExposureGammaCorrectionInterface *interface, QObject *parent)
     : KisDisplayFilter(parent)
     , inputColorSpaceName(0)
@@ -69,17 +270,32 @@ KisExposureGammaCorrectionInterface *OcioDisplayFilter::correctionInterface() co
 
 void OcioDisplayFilter::filter(quint8 *pixels, quint32 numPixels)
 {
+    /**
+     * The processors are switched in the GUI thread while the canvas
+     * updates are filtered in the worker threads, so take a reference
+     * to the current set under the lock and use only it afterwards
+     */
+    QSharedPointer<ProcessorSet> processors;
+    {
+        QMutexLocker l(&m_currentProcessorsLock);
+        processors = m_currentProcessors;
+    }
+
+    if (!processors || !processors->processor) return;
+
+    if (processors->applyLut(reinterpret_cast<float*>(pixels), numPixels)) {
+        return;
+    }
+
     // processes that data _in_ place
-    if (m_processor) {
-        if (numPixels > 16) {
-            // creation of PackedImageDesc is really slow on Windows due to malloc/free
-            OCIO::PackedImageDesc img(reinterpret_cast<float *>(pixels), numPixels, 1, 4);
-            m_processorCPU->apply(img);
-        } else {
-            for (quint32 i = 0; i < numPixels; i++) {
-                m_processorCPU->applyRGBA(reinterpret_cast<float*>(pixels));
-                pixels+=4;
-            }
+    if (numPixels > 16) {
+        // creation of PackedImageDesc is really slow on Windows due to malloc/free
+        OCIO::PackedImageDesc img(reinterpret_cast<float *>(pixels), numPixels, 1, 4);
+        processors->processorCPU->apply(img);
+    } else {
+        for (quint32 i = 0; i < numPixels; i++) {
+            processors->processorCPU->applyRGBA(reinterpret_cast<float*>(pixels));
+            pixels+=4;
         }
     }
 }
@@ -163,6 +379,38 @@ void OcioDisplayFilter::updateProcessor()
         return;
     }
 
+    const double minRange = 0.001;
+    if (qAbs(blackPoint - whitePoint) < minRange) {
+        whitePoint = blackPoint + minRange;
+    }
+
+    const bool useCpuLut = KisConfig(true).ocioUseCpuLut();
+
+    const QString cacheKey = QStringList({
+        config->getCacheID(),
+        inputColorSpaceName,
+        displayDevice,
+        view,
+        look ? look : "",
+        QString::number(swizzle),
+        QString::number(exposure, 'g', 17),
+        QString::number(gamma, 'g', 17),
+        QString::number(blackPoint, 'g', 17),
+        QString::number(whitePoint, 'g', 17),
+        QString::number(useCpuLut)}).join('\n');
+
+    for (int i = 0; i < m_processorCache.size(); i++) {
+        if (m_processorCache[i]->cacheKey == cacheKey) {
+            m_processorCache.move(i, 0);
+            setCurrentProcessors(m_processorCache.first());
+            m_shaderDirty = true;
+            return;
+        }
+    }
+
+    QSharedPointer<ProcessorSet> processors(new ProcessorSet());
+    processors->cacheKey = cacheKey;
+
     OCIO::DisplayViewTransformRcPtr transform = OCIO::DisplayViewTransform::Create();
     transform->setSrc(inputColorSpaceName);
     transform->setDisplay(displayDevice);
@@ -199,11 +447,6 @@ void OcioDisplayFilter::updateProcessor()
     {
         const double exposureGain = pow(2.0, exposure);
 
-        const double minRange = 0.001;
-        if (qAbs(blackPoint - whitePoint) < minRange) {
-            whitePoint = blackPoint + minRange;
-        }
-
         const double oldMin[] = {blackPoint, blackPoint, blackPoint, 0.0};
         const double oldMax[] = {whitePoint, whitePoint, whitePoint, 1.0};
 
@@ -288,8 +531,8 @@ void OcioDisplayFilter::updateProcessor()
 
     try {
         AutoSetAndRestoreThreadLocale l;
-        m_processor = vpt->getProcessor(config, config->getCurrentContext());
-        m_processorCPU = m_processor->getDefaultCPUProcessor();
+        processors->processor = vpt->getProcessor(config, config->getCurrentContext());
+        processors->processorCPU = processors->processor->getDefaultCPUProcessor();
     } catch (OCIO::Exception &e) {
         // XXX: How to not break the OCIO shader now?
         errKrita << "OCIO exception while parsing the current context:" << e.what();
@@ -297,20 +540,47 @@ void OcioDisplayFilter::updateProcessor()
         return;
     }
 
-    m_forwardApproximationProcessor = config->getProcessor(approximateTransform, OCIO::TRANSFORM_DIR_FORWARD);
-    m_forwardApproximationProcessorCPU = m_forwardApproximationProcessor->getDefaultCPUProcessor();
+    processors->forwardApproximationProcessor = config->getProcessor(approximateTransform, OCIO::TRANSFORM_DIR_FORWARD);
+    processors->forwardApproximationProcessorCPU = processors->forwardApproximationProcessor->getDefaultCPUProcessor();
 
     try {
-        m_reverseApproximationProcessor = config->getProcessor(approximateTransform, OCIO::TRANSFORM_DIR_INVERSE);
-        m_reverseApproximationProcessorCPU = m_reverseApproximationProcessor->getDefaultCPUProcessor();
+        processors->reverseApproximationProcessor = config->getProcessor(approximateTransform, OCIO::TRANSFORM_DIR_INVERSE);
+        processors->reverseApproximationProcessorCPU = processors->reverseApproximationProcessor->getDefaultCPUProcessor();
     } catch (...) {
         warnKrita << "OCIO inverted matrix does not exist!";
         // m_reverseApproximationProcessor;
     }
 
+    /**
+     * The alpha-only view puts the alpha channel into the color
+     * channels, which cannot be expressed by a 3D LUT
+     */
+    processors->useLut = useCpuLut && swizzle != A;
+    processors->shaper.setFromColorSpace(config->getColorSpace(inputColorSpaceName));
+
+    m_processorCache.prepend(processors);
+    while (m_processorCache.size() > processorCacheSize) {
+        m_processorCache.removeLast();
+    }
+
+    setCurrentProcessors(processors);
     m_shaderDirty = true;
 }
 
+void OcioDisplayFilter::setCurrentProcessors(QSharedPointer<ProcessorSet> processors)
+{
+    m_processor = processors->processor;
+    m_reverseApproximationProcessor = processors->reverseApproximationProcessor;
+    m_forwardApproximationProcessor = processors->forwardApproximationProcessor;
+
+    m_processorCPU = processors->processorCPU;
+    m_reverseApproximationProcessorCPU = processors->reverseApproximationProcessorCPU;
+    m_forwardApproximationProcessorCPU = processors->forwardApproximationProcessorCPU;
+
+    QMutexLocker l(&m_currentProcessorsLock);
+    m_currentProcessors = processors;
+}
+
 bool OcioDisplayFilter::updateShader()
 {
     if (KisOpenGL::hasOpenGLES()) {
@@ -10,7 +10,10 @@
 
 #include <vector>
 
+#include <QList>
+#include <QMutex>
 #include <QOpenGLShaderProgram>
+#include <QSharedPointer>
 
 #include <OpenColorIO.h>
 #include <OpenColorTransforms.h>
@@ -94,6 +97,9 @@ public:
     bool forceInternalColorManagement;
 
 private:
+    struct ProcessorSet;
+    void setCurrentProcessors(QSharedPointer<ProcessorSet> processors);
+
     OCIO::ConstProcessorRcPtr m_processor;
     OCIO::ConstProcessorRcPtr m_reverseApproximationProcessor;
     OCIO::ConstProcessorRcPtr m_forwardApproximationProcessor;
@@ -102,6 +108,20 @@ private:
     OCIO::ConstCPUProcessorRcPtr m_reverseApproximationProcessorCPU;
     OCIO::ConstCPUProcessorRcPtr m_forwardApproximationProcessorCPU;
 
+    /**
+     * The processors for the recently used combinations of the
+     * settings, the most recent one goes first. Dragging the exposure
+     * or gamma back and forth doesn't rebuild the processors then.
+     */
+    QList<QSharedPointer<ProcessorSet>> m_processorCache;
+
+    /**
+     * The set used by filter(), which is called from the worker
+     * threads, so the pointer is guarded by the lock
+     */
+    QMutex m_currentProcessorsLock;
+    QSharedPointer<ProcessorSet> m_currentProcessors;
+
     KisExposureGammaCorrectionInterface *m_interface;
 
     bool m_lockCurrentColorVisualRepresentation;
@@ -107,4 +107,64 @@ void KisOcioDisplayFilterTest::test()
 
 }
 
+void KisOcioDisplayFilterTest::testProcessorCache()
+{
+    KisExposureGammaCorrectionInterface *egInterface =
+            new KisDumbExposureGammaCorrectionInterface();
+
+    QSharedPointer<OcioDisplayFilter> filter(new OcioDisplayFilter(egInterface));
+
+    QString configFile = TestUtil::fetchDataFileLazy("./psyfiTestingConfig-master/config.ocio");
+    QVERIFY(QFile::exists(configFile));
+
+    OCIO::ConstConfigRcPtr ocioConfig =
+            OCIO::Config::CreateFromFile(configFile.toUtf8());
+
+    filter->config = ocioConfig;
+    filter->inputColorSpaceName = ocioConfig->getColorSpaceNameByIndex(0);
+    filter->displayDevice = ocioConfig->getDisplay(1);
+    filter->view = ocioConfig->getView(filter->displayDevice, 0);
+    filter->gamma = 1.0;
+    filter->exposure = 0.0;
+    filter->swizzle = RGBA;
+    filter->blackPoint = 0.0;
+    filter->whitePoint = 1.0;
+    filter->forceInternalColorManagement = false;
+    filter->setLockCurrentColorVisualRepresentation(false);
+
+    const int numPixels = 4096;
+
+    QVector<float> source(numPixels * 4);
+    for (int i = 0; i < numPixels; i++) {
+        source[4 * i + 0] = float(i) / (numPixels - 1);
+        source[4 * i + 1] = float(i % 16) / 15;
+        source[4 * i + 2] = 2.0f * float(numPixels - 1 - i) / (numPixels - 1);
+        source[4 * i + 3] = float(i % 7) / 6;
+    }
+
+    auto applyFilter = [&] () {
+        QVector<float> pixels = source;
+        filter->filter(reinterpret_cast<quint8*>(pixels.data()), numPixels);
+        return pixels;
+    };
+
+    filter->updateProcessor();
+    const QVector<float> reference = applyFilter();
+
+    filter->exposure = 2.0;
+    filter->updateProcessor();
+    const QVector<float> exposed = applyFilter();
+
+    QVERIFY(exposed != reference);
+
+    // the processors are picked from the cache now
+    filter->exposure = 0.0;
+    filter->updateProcessor();
+    QCOMPARE(applyFilter(), reference);
+
+    filter->exposure = 2.0;
+    filter->updateProcessor();
+    QCOMPARE(applyFilter(), exposed);
+}
+
 SIMPLE_TEST_MAIN(KisOcioDisplayFilterTest)
@@ -14,6 +14,7 @@ class KisOcioDisplayFilterTest : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void test();
+    void testProcessorCache();
 };
 
 #endif /* __KIS_OCIO_DISPLAY_FILTER_TEST_H */
@@ -0,0 +1,121 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisBlurPlanes.h"
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+
+#include <kis_assert.h>
+#include <kis_default_bounds.h>
+#include <kis_global.h>
+#include <kis_paint_device.h>
+
+namespace {
+
+bool isFloatColorSpace(const KoColorSpace *cs)
+{
+    const KoID depth = cs->colorDepthId();
+    return depth == Float16BitsColorDepthID ||
+           depth == Float32BitsColorDepthID ||
+           depth == Float64BitsColorDepthID;
+}
+
+}
+
+KisBlurPlanes::KisBlurPlanes(KisPaintDeviceSP device, const QRect &rect, const QSize &kernelHalfSize)
+    : m_colorSpace(device->colorSpace())
+    , m_channelCount(m_colorSpace->channelCount())
+    , m_alphaPos(m_colorSpace->alphaPos())
+    , m_rect(rect)
+    , m_srcRect(rect.adjusted(-kernelHalfSize.width(), -kernelHalfSize.height(),
+                              kernelHalfSize.width(), kernelHalfSize.height()))
+{
+    // the pixels that can be read from the device, the rest is repeated
+    m_readRect = m_srcRect;
+
+    if (!device->defaultBounds()->wrapAroundMode()) {
+        QRect dataRect = rect | device->defaultBounds()->bounds();
+        KIS_SAFE_ASSERT_RECOVER(device->defaultBounds()->bounds() != KisDefaultBounds().bounds()) {
+            dataRect = rect | device->exactBounds();
+        }
+        m_readRect &= dataRect;
+    }
+
+    const int pixelSize = m_colorSpace->pixelSize();
+    m_readArea = m_readRect.width() * m_readRect.height();
+
+    m_srcPixels.resize(m_readArea * pixelSize);
+    device->readBytes(m_srcPixels.data(), m_readRect);
+
+    m_planes.resize(m_channelCount * m_readArea);
+
+    QVector<float> channels(m_channelCount);
+    const quint8 *pixel = m_srcPixels.constData();
+
+    for (int i = 0; i < m_readArea; ++i, pixel += pixelSize) {
+        m_colorSpace->normalisedChannelsValue(pixel, channels);
+        const float alpha = m_alphaPos >= 0 ? channels[m_alphaPos] : 1.0f;
+
+        for (int c = 0; c < m_channelCount; ++c) {
+            m_planes[c * m_readArea + i] = c == m_alphaPos ? alpha : channels[c] * alpha;
+        }
+    }
+}
+
+void KisBlurPlanes::readSrcRow(int channel, int y, float *dst) const
+{
+    const int readY = qBound(m_readRect.top(), m_srcRect.top() + y, m_readRect.bottom()) - m_readRect.top();
+    const float *readRow = m_planes.constData() + channel * m_readArea + readY * m_readRect.width();
+
+    for (int x = 0; x < m_srcRect.width(); ++x) {
+        const int readX = qBound(m_readRect.left(), m_srcRect.left() + x, m_readRect.right()) - m_readRect.left();
+        dst[x] = readRow[readX];
+    }
+}
+
+void KisBlurPlanes::writeResults(KisPaintDeviceSP device, const QVector<float> &results, const QBitArray &channelFlags) const
+{
+    const int pixelSize = m_colorSpace->pixelSize();
+    const bool clampToUnitRange = !isFloatColorSpace(m_colorSpace);
+    const int width = m_rect.width();
+    const int height = m_rect.height();
+
+    QVector<quint8> dstPixels(width * height * pixelSize);
+    QVector<float> channels(m_channelCount);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int index = y * width + x;
+            const int readIndex = (m_rect.top() - m_readRect.top() + y) * m_readRect.width() + m_rect.left() - m_readRect.left() + x;
+            quint8 *dst = dstPixels.data() + index * pixelSize;
+
+            memcpy(dst, m_srcPixels.constData() + readIndex * pixelSize, pixelSize);
+            m_colorSpace->normalisedChannelsValue(dst, channels);
+
+            float alpha = 1.0f;
+            if (m_alphaPos >= 0) {
+                alpha = qBound(0.0f, results[m_alphaPos * width * height + index], 1.0f);
+            }
+
+            for (int c = 0; c < m_channelCount; ++c) {
+                if (!channelFlags.testBit(c)) continue;
+
+                if (c == m_alphaPos) {
+                    channels[c] = alpha;
+                } else {
+                    float value = alpha > 0.0f ? results[c * width * height + index] / alpha : 0.0f;
+                    value = qMax(0.0f, value);
+                    channels[c] = clampToUnitRange ? qMin(value, 1.0f) : value;
+                }
+            }
+
+            m_colorSpace->fromNormalisedChannelsValue(dst, channels);
+        }
+    }
+
+    device->writeBytes(dstPixels.constData(), m_rect);
+}
@@ -0,0 +1,93 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISBLURPLANES_H
+#define KISBLURPLANES_H
+
+#include <QBitArray>
+#include <QRect>
+#include <QVector>
+
+#include <kis_types.h>
+
+class KoColorSpace;
+
+/**
+ * Planar premultiplied copy of the area of a device that is needed for
+ * blurring a rect with a kernel of the given half size. The channels are
+ * normalized floats, the pixels outside of the data of the device repeat
+ * the border the same way as BORDER_REPEAT mode of KisConvolutionPainter
+ * does.
+ *
+ * The results of the blur are passed back in the same planar layout,
+ * covering rect() only.
+ */
+class KisBlurPlanes
+{
+public:
+    KisBlurPlanes(KisPaintDeviceSP device, const QRect &rect, const QSize &kernelHalfSize);
+
+    /// the area that is going to be written
+    QRect rect() const {
+        return m_rect;
+    }
+
+    /// the area the kernel can reach, the values outside readRect() are repeated
+    QRect srcRect() const {
+        return m_srcRect;
+    }
+
+    /// the area that is actually read from the device
+    QRect readRect() const {
+        return m_readRect;
+    }
+
+    int channelCount() const {
+        return m_channelCount;
+    }
+
+    int alphaPos() const {
+        return m_alphaPos;
+    }
+
+    /// the alpha channel is always processed, since it is used for unpremultiplying
+    bool isChannelProcessed(int channel, const QBitArray &channelFlags) const {
+        return channel == m_alphaPos || channelFlags.testBit(channel);
+    }
+
+    /// the premultiplied value of \p channel at (\p x, \p y) in device coordinates
+    inline float value(int channel, int x, int y) const {
+        x = qBound(m_readRect.left(), x, m_readRect.right()) - m_readRect.left();
+        y = qBound(m_readRect.top(), y, m_readRect.bottom()) - m_readRect.top();
+        return m_planes[channel * m_readArea + y * m_readRect.width() + x];
+    }
+
+    /**
+     * Fills \p dst with srcRect().width() values of \p channel in the row
+     * \p y of srcRect()
+     */
+    void readSrcRow(int channel, int y, float *dst) const;
+
+    /**
+     * Unpremultiplies \p results (channelCount() planes of rect()) and writes
+     * the channels selected in \p channelFlags into \p device. The rest of
+     * the channels keep their original values.
+     */
+    void writeResults(KisPaintDeviceSP device, const QVector<float> &results, const QBitArray &channelFlags) const;
+
+private:
+    const KoColorSpace *m_colorSpace;
+    int m_channelCount;
+    int m_alphaPos;
+    QRect m_rect;
+    QRect m_srcRect;
+    QRect m_readRect;
+    int m_readArea;
+    QVector<quint8> m_srcPixels;
+    QVector<float> m_planes;
+};
+
+#endif // KISBLURPLANES_H
@@ -8,10 +8,14 @@
 
 #include "kis_blur_filter.h"
 
+#include <KoColorSpace.h>
 #include <KoCompositeOp.h>
 
 #include <kis_convolution_kernel.h>
 #include <kis_convolution_painter.h>
+#include <kis_painter.h>
+#include <KisSummedAreaTable.h>
+#include <KoUpdater.h>
 
 #include "kis_wdg_blur.h"
 #include "ui_wdgblur.h"
@@ -24,6 +28,105 @@
 #include "kis_lod_transform.h"
 
 
+namespace {
+
+/**
+ * A rectangle shape at full strength has a constant weight inside,
+ * only its border pixels get smaller weights from the antialiasing
+ * of the edges. Such a kernel is a weighted sum of four boxes: the
+ * full box, the box without the border columns, the box without the
+ * border rows and the box without both, so every pixel is calculated
+ * from a summed-area table in constant time whatever the size of the
+ * kernel is. The weights are sampled from the same mask generator the
+ * convolution kernel is built from.
+ */
+void applyBoxBlur(KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &rect,
+                  int halfWidth, int halfHeight,
+                  const KisMaskGenerator &mask,
+                  const QBitArray &channelFlags,
+                  KoUpdater *progressUpdater)
+{
+    const KoColorSpace *cs = dst->colorSpace();
+    const int pixelSize = cs->pixelSize();
+    const int channelCount = cs->channelCount();
+    const bool allChannels = channelFlags.count(true) == channelCount;
+
+    const qreal innerWeight = 255 - mask.valueAt(0, 0);
+    const qreal columnWeight = 255 - mask.valueAt(halfWidth, 0);
+    const qreal rowWeight = 255 - mask.valueAt(0, halfHeight);
+    const qreal cornerWeight = 255 - mask.valueAt(halfWidth, halfHeight);
+
+    const QVector<qreal> weights = {
+        cornerWeight,
+        rowWeight - cornerWeight,
+        columnWeight - cornerWeight,
+        innerWeight - columnWeight - rowWeight + cornerWeight
+    };
+
+    const QRect srcRect = rect.adjusted(-halfWidth, -halfHeight, halfWidth, halfHeight);
+    const KisSummedAreaTable table(src, srcRect,
+                                   KisSummedAreaTable::repeatedBorderDataRect(dst, rect));
+
+    /**
+     * The filter stroke already runs the patches of the filter on all the
+     * threads of the updater context, so the strips are processed on the
+     * calling thread. They only keep the buffer of the pixels bounded.
+     */
+    const int stripHeight = 64;
+    const int numStrips = (rect.height() + stripHeight - 1) / stripHeight;
+
+    QVector<QRect> boxes(weights.size());
+    QVector<float> mean(channelCount);
+    QVector<float> original(channelCount);
+
+    for (int i = 0; i < numStrips; i++) {
+        if (progressUpdater && progressUpdater->interrupted()) {
+            return;
+        }
+
+        const QRect strip(rect.left(), rect.top() + i * stripHeight,
+                          rect.width(), qMin(stripHeight, rect.height() - i * stripHeight));
+
+        QVector<quint8> bytes(strip.width() * strip.height() * pixelSize);
+        if (!allChannels) {
+            src->readBytes(bytes.data(), strip);
+        }
+
+        quint8 *pixel = bytes.data();
+
+        for (int y = strip.top(); y <= strip.bottom(); ++y) {
+            for (int x = strip.left(); x <= strip.right(); ++x, pixel += pixelSize) {
+                const QRect box(x - halfWidth, y - halfHeight, 2 * halfWidth + 1, 2 * halfHeight + 1);
+                boxes[0] = box;
+                boxes[1] = box.adjusted(1, 0, -1, 0);
+                boxes[2] = box.adjusted(0, 1, 0, -1);
+                boxes[3] = box.adjusted(1, 1, -1, -1);
+
+                table.weightedMeanChannels(boxes, weights, mean);
+
+                if (!allChannels) {
+                    cs->normalisedChannelsValue(pixel, original);
+                    for (int c = 0; c < channelCount; ++c) {
+                        if (!channelFlags.testBit(c)) {
+                            mean[c] = original[c];
+                        }
+                    }
+                }
+
+                cs->fromNormalisedChannelsValue(pixel, mean);
+            }
+        }
+
+        dst->writeBytes(bytes.constData(), strip);
+
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * (i + 1) / numStrips);
+        }
+    }
+}
+
+}
+
 KisBlurFilter::KisBlurFilter() : KisFilter(id(), FiltersCategoryBlurId, i18n("&Blur..."))
 {
     setSupportsPainting(true);
@@ -74,6 +177,14 @@ void KisBlurFilter::processImpl(KisPaintDeviceSP device,
     qreal hFade = strength;
     qreal vFade = strength;
 
+    QBitArray channelFlags;
+    if (config) {
+        channelFlags = config->channelFlags();
+    }
+    if (channelFlags.isEmpty() || !config) {
+        channelFlags = QBitArray(device->colorSpace()->channelCount(), true);
+    }
+
     KisMaskGenerator* kas;
     switch (shape) {
     case 1:
@@ -85,12 +196,27 @@ void KisBlurFilter::processImpl(KisPaintDeviceSP device,
         break;
     }
 
-    QBitArray channelFlags;
-    if (config) {
-        channelFlags = config->channelFlags();
-    }
-    if (channelFlags.isEmpty() || !config) {
-        channelFlags = QBitArray(device->colorSpace()->channelCount(), true);
+    /**
+     * The rotated kernel is sampled from the same grid, so only the
+     * rotations that keep the rectangle in place are calculated as boxes
+     */
+    if (shape == 1 && strength == 1.0 &&
+        (rotate % 180 == 0 || (rotate % 90 == 0 && halfWidth == halfHeight))) {
+
+        /**
+         * The device is blurred in place and the other patches may
+         * already have written their results, so the table is built
+         * from the original pixels
+         */
+        const QRect sourceRect = rect.adjusted(-int(halfWidth), -int(halfHeight), halfWidth, halfHeight);
+
+        KisCachedPaintDevice::Guard d1(device, m_cachedPaintDevice);
+        KisPaintDeviceSP source = d1.device();
+        KisPainter::copyAreaOptimizedOldData(sourceRect.topLeft(), device, source, sourceRect);
+
+        applyBoxBlur(source, device, rect, halfWidth, halfHeight, *kas, channelFlags, progressUpdater);
+        delete kas;
+        return;
     }
 
     KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMaskGenerator(kas, rotate * M_PI / 180.0);
@@ -10,6 +10,7 @@
 #define KIS_BLUR_FILTER_H
 
 #include "filter/kis_filter.h"
+#include "kis_cached_paint_device.h"
 
 class KisBlurFilter : public KisFilter
 {
@@ -31,6 +32,9 @@ public:
     KisConfigWidget * createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP dev, bool useForMasks) const override;
     QRect neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const override;
     QRect changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const override;
+
+private:
+    mutable KisCachedPaintDevice m_cachedPaintDevice;
 };
 
 #endif
@@ -21,14 +21,23 @@
 #include <filter/kis_filter_configuration.h>
 #include <kis_selection.h>
 #include <kis_paint_device.h>
+#include <kis_painter.h>
 #include <kis_processing_information.h>
 #include "kis_lod_transform.h"
+#include "KisBlurPlanes.h"
 
 
 #include <QPainter>
+#include <QtMath>
 
+#include <complex>
 #include <math.h>
 
+#include <KoUpdater.h>
+#include <kis_assert.h>
+#include <kis_default_bounds.h>
+#include <kis_global.h>
+
 
 KisLensBlurFilter::KisLensBlurFilter() : KisFilter(id(), FiltersCategoryBlurId, i18n("&Lens Blur..."))
 {
@@ -36,7 +45,6 @@ KisLensBlurFilter::KisLensBlurFilter() : KisFilter(id(), FiltersCategoryBlurId,
     setSupportsAdjustmentLayers(true);
     setSupportsLevelOfDetail(true);
     setColorSpaceIndependence(FULLY_INDEPENDENT);
-
 }
 
 KisConfigWidget * KisLensBlurFilter::createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP, bool) const
@@ -61,6 +69,7 @@ KisFilterConfigurationSP KisLensBlurFilter::defaultConfiguration(KisResourcesInt
     config->setProperty("irisShape", "Pentagon (5)");
     config->setProperty("irisRadius", 5);
     config->setProperty("irisRotation", 0);
+    config->setProperty("circularApproximation", false);
 
     QSize halfSize = getKernelHalfSize(config, 0);
     config->setProperty("halfWidth", halfSize.width());
@@ -113,6 +122,215 @@ QPolygonF KisLensBlurFilter::getIrisPolygon(const KisFilterConfigurationSP confi
     return transformedIris;
 }
 
+namespace {
+
+/**
+ * The components of the circular kernel. The sum over the components of
+ * A * Re(K(x) K(y)) + B * Im(K(x) K(y)), where K(x) = exp((-a + ib) x^2),
+ * approximates a disk, and every K(x) K(y) is separable. The coefficients
+ * are the 3-component fit by Olli Niemitalo, the ripple inside the disk
+ * is about 3%.
+ */
+struct ComplexGaussianComponent {
+    qreal a;
+    qreal b;
+    qreal A;
+    qreal B;
+};
+
+const ComplexGaussianComponent circularKernelComponents[] = {
+    {2.176490, 5.043495, 1.621035, -2.105439},
+    {1.019306, 9.027613, -0.280860, -0.162882},
+    {2.815110, 1.597273, -0.366471, 10.300301}
+};
+
+/// the value of the kernel at the distance \p r from the center
+qreal circularKernelProfile(qreal r)
+{
+    qreal value = 0.0;
+
+    for (const ComplexGaussianComponent &c : circularKernelComponents) {
+        const std::complex<qreal> k = std::exp(std::complex<qreal>(-c.a, c.b) * (r * r));
+        value += c.A * k.real() + c.B * k.imag();
+    }
+
+    return value;
+}
+
+/**
+ * The size of the fitted disk in the units of the components: the
+ * edge is where the kernel falls to the half of its value in the
+ * center, and further than the extent the kernel doesn't exceed 1% of
+ * that value any more
+ */
+struct CircularKernelShape {
+    CircularKernelShape() {
+        const qreal center = circularKernelProfile(0.0);
+        const qreal step = 0.001;
+
+        edge = 0.0;
+        while (circularKernelProfile(edge) > 0.5 * center) {
+            edge += step;
+        }
+
+        extent = 4.0;
+        while (extent > edge && qAbs(circularKernelProfile(extent)) < 0.01 * center) {
+            extent -= step;
+        }
+    }
+
+    qreal edge;
+    qreal extent;
+};
+
+const CircularKernelShape& circularKernelShape()
+{
+    static const CircularKernelShape shape;
+    return shape;
+}
+
+int circularKernelHalfSize(int radius)
+{
+    const CircularKernelShape &shape = circularKernelShape();
+    return qCeil(shape.extent / shape.edge * radius);
+}
+
+/**
+ * Blurs \p rect of \p src with a disk of \p radius, approximated by
+ * the sum of the separable complex components, and writes the result
+ * into \p dst. Every component takes one horizontal and one vertical
+ * pass, so the cost grows linearly with the radius instead of
+ * quadratically. The border is repeated the same way as the
+ * BORDER_REPEAT mode of KisConvolutionPainter does.
+ */
+void applyCircularApproximation(KisPaintDeviceSP src,
+                                KisPaintDeviceSP dst,
+                                const QRect &rect,
+                                const QBitArray &channelFlags,
+                                int radius,
+                                KoUpdater *progressUpdater)
+{
+    const int numComponents = int(sizeof(circularKernelComponents) / sizeof(ComplexGaussianComponent));
+    const int halfSize = circularKernelHalfSize(radius);
+    const int kernelSize = 2 * halfSize + 1;
+
+    // the kernels and their normalization
+    QVector<float> kernelsRe(numComponents * kernelSize);
+    QVector<float> kernelsIm(numComponents * kernelSize);
+    qreal normalization = 0.0;
+
+    for (int k = 0; k < numComponents; ++k) {
+        const ComplexGaussianComponent &c = circularKernelComponents[k];
+        std::complex<qreal> sum = 0.0;
+
+        for (int i = 0; i < kernelSize; ++i) {
+            const qreal x = circularKernelShape().edge * (i - halfSize) / radius;
+            const std::complex<qreal> value = std::exp(std::complex<qreal>(-c.a, c.b) * (x * x));
+            kernelsRe[k * kernelSize + i] = value.real();
+            kernelsIm[k * kernelSize + i] = value.imag();
+            sum += value;
+        }
+
+        const std::complex<qreal> sum2 = sum * sum;
+        normalization += c.A * sum2.real() + c.B * sum2.imag();
+    }
+
+    const KisBlurPlanes planes(src, rect, QSize(halfSize, halfSize));
+    const int channelCount = planes.channelCount();
+    const QRect srcRect = planes.srcRect();
+
+    const int width = rect.width();
+    const int height = rect.height();
+    const int srcWidth = srcRect.width();
+    const int srcHeight = srcRect.height();
+
+    QVector<float> results(channelCount * width * height, 0.0f);
+    QVector<float> row(srcWidth);
+    QVector<float> horizontalRe(srcHeight * width);
+    QVector<float> horizontalIm(srcHeight * width);
+    QVector<float> accumulatorRe(width);
+    QVector<float> accumulatorIm(width);
+
+    const int totalSteps = channelCount * numComponents;
+    int step = 0;
+
+    for (int c = 0; c < channelCount; ++c) {
+        if (!planes.isChannelProcessed(c, channelFlags)) {
+            step += numComponents;
+            continue;
+        }
+
+        float *result = results.data() + c * width * height;
+
+        for (int k = 0; k < numComponents; ++k, ++step) {
+            if (progressUpdater && progressUpdater->interrupted()) {
+                return;
+            }
+
+            const float *kernelRe = kernelsRe.constData() + k * kernelSize;
+            const float *kernelIm = kernelsIm.constData() + k * kernelSize;
+
+            // horizontal pass over all the rows of the source area
+            for (int y = 0; y < srcHeight; ++y) {
+                planes.readSrcRow(c, y, row.data());
+
+                float *dstRe = horizontalRe.data() + y * width;
+                float *dstIm = horizontalIm.data() + y * width;
+                std::fill(dstRe, dstRe + width, 0.0f);
+                std::fill(dstIm, dstIm + width, 0.0f);
+
+                for (int i = 0; i < kernelSize; ++i) {
+                    const float kRe = kernelRe[i];
+                    const float kIm = kernelIm[i];
+                    const float *src = row.constData() + i;
+
+                    for (int x = 0; x < width; ++x) {
+                        dstRe[x] += kRe * src[x];
+                        dstIm[x] += kIm * src[x];
+                    }
+                }
+            }
+
+            // vertical pass, the complex products are combined into the result
+            const float A = circularKernelComponents[k].A / normalization;
+            const float B = circularKernelComponents[k].B / normalization;
+
+            for (int y = 0; y < height; ++y) {
+                std::fill(accumulatorRe.begin(), accumulatorRe.end(), 0.0f);
+                std::fill(accumulatorIm.begin(), accumulatorIm.end(), 0.0f);
+
+                float *accRe = accumulatorRe.data();
+                float *accIm = accumulatorIm.data();
+
+                for (int j = 0; j < kernelSize; ++j) {
+                    const float kRe = kernelRe[j];
+                    const float kIm = kernelIm[j];
+                    const float *srcRe = horizontalRe.constData() + (y + j) * width;
+                    const float *srcIm = horizontalIm.constData() + (y + j) * width;
+
+                    for (int x = 0; x < width; ++x) {
+                        accRe[x] += kRe * srcRe[x] - kIm * srcIm[x];
+                        accIm[x] += kRe * srcIm[x] + kIm * srcRe[x];
+                    }
+                }
+
+                float *dst = result + y * width;
+                for (int x = 0; x < width; ++x) {
+                    dst[x] += A * accRe[x] + B * accIm[x];
+                }
+            }
+
+            if (progressUpdater) {
+                progressUpdater->setProgress(100 * (step + 1) / totalSteps);
+            }
+        }
+    }
+
+    planes.writeResults(dst, results, channelFlags);
+}
+
+}
+
 void KisLensBlurFilter::processImpl(KisPaintDeviceSP device,
                                     const QRect& rect,
                                     const KisFilterConfigurationSP config,
@@ -130,6 +348,26 @@ void KisLensBlurFilter::processImpl(KisPaintDeviceSP device,
     }
 
     const int lod = device->defaultBounds()->currentLevelOfDetail();
+
+    if (config->getBool("circularApproximation", false)) {
+        const int radius = KisLodTransformScalar(lod).scale(config->getInt("irisRadius", 5));
+        if (radius < 1) return;
+
+        /**
+         * The device is blurred in place and the other patches may
+         * already have written their results, so the neighbourhood
+         * is read from the original pixels
+         */
+        const QRect sourceRect = kisGrowRect(rect, circularKernelHalfSize(radius));
+
+        KisCachedPaintDevice::Guard d1(device, m_cachedPaintDevice);
+        KisPaintDeviceSP source = d1.device();
+        KisPainter::copyAreaOptimizedOldData(sourceRect.topLeft(), device, source, sourceRect);
+
+        applyCircularApproximation(source, device, rect, channelFlags, radius, progressUpdater);
+        return;
+    }
+
     QPolygonF transformedIris = getIrisPolygon(config, lod);
     if (transformedIris.isEmpty()) return;
 
@@ -175,6 +413,11 @@ QRect KisLensBlurFilter::neededRect(const QRect & rect, const KisFilterConfigura
     const int halfWidth = t.scale(_config->getProperty("halfWidth", value) ? value.toUInt() : 5);
     const int halfHeight = t.scale(_config->getProperty("halfHeight", value) ? value.toUInt() : 5);
 
+    if (_config->getBool("circularApproximation", false)) {
+        const int halfSize = circularKernelHalfSize(t.scale(_config->getInt("irisRadius", 5)));
+        return kisGrowRect(rect, halfSize);
+    }
+
     return rect.adjusted(-halfWidth * 2, -halfHeight * 2, halfWidth * 2, halfHeight * 2);
 }
 
@@ -186,5 +429,10 @@ QRect KisLensBlurFilter::changedRect(const QRect & rect, const KisFilterConfigur
     const int halfWidth = t.scale(_config->getProperty("halfWidth", value) ? value.toUInt() : 5);
     const int halfHeight = t.scale(_config->getProperty("halfHeight", value) ? value.toUInt() : 5);
 
+    if (_config->getBool("circularApproximation", false)) {
+        const int halfSize = circularKernelHalfSize(t.scale(_config->getInt("irisRadius", 5)));
+        return kisGrowRect(rect, halfSize);
+    }
+
     return rect.adjusted(-halfWidth, -halfHeight, halfWidth, halfHeight);
 }
@@ -11,6 +11,7 @@
 #define KIS_LENS_BLUR_FILTER_H
 
 #include "filter/kis_filter.h"
+#include "kis_cached_paint_device.h"
 #include "ui_wdg_lens_blur.h"
 
 #include <Eigen/Core>
@@ -42,6 +43,9 @@ public:
 
 private:
     static QPolygonF getIrisPolygon(const KisFilterConfigurationSP config, int lod);
+
+private:
+    mutable KisCachedPaintDevice m_cachedPaintDevice;
 };
 
 #endif
@@ -21,14 +21,19 @@
 #include <filter/kis_filter_configuration.h>
 #include <kis_selection.h>
 #include <kis_paint_device.h>
+#include <kis_painter.h>
 #include <kis_processing_information.h>
 #include "kis_lod_transform.h"
+#include "KisBlurPlanes.h"
 
 
 #include <QPainter>
+#include <QtMath>
 
 #include <math.h>
 
+#include <KoUpdater.h>
+
 
 KisMotionBlurFilter::KisMotionBlurFilter() : KisFilter(id(), FiltersCategoryBlurId, i18n("&Motion Blur..."))
 {
@@ -53,6 +58,13 @@ KisFilterConfigurationSP KisMotionBlurFilter::defaultConfiguration(KisResourcesI
 }
 
 namespace {
+
+/**
+ * The blurs of at least this length (in pixels of the current level of
+ * detail) are calculated with running sums instead of the convolution
+ */
+const qreal runningSumsMinLength = 16.0;
+
 struct MotionBlurProperties
 {
     MotionBlurProperties(KisFilterConfigurationSP config, const KisLodTransformScalar &t)
@@ -64,14 +76,20 @@ struct MotionBlurProperties
         const qreal angleRadians = kisDegreesToRadians(qreal(blurAngle));
 
         // construct image
-        const qreal halfWidth = 0.5 * t.scale(blurLength) * cos(angleRadians);
-        const qreal halfHeight = 0.5 * t.scale(blurLength) * sin(angleRadians);
+        halfWidth = 0.5 * t.scale(blurLength) * cos(angleRadians);
+        halfHeight = 0.5 * t.scale(blurLength) * sin(angleRadians);
 
         kernelHalfSize.rwidth() = ceil(fabs(halfWidth));
         kernelHalfSize.rheight() = ceil(fabs(halfHeight));
         kernelSize = kernelHalfSize * 2 + QSize(1, 1);
         this->blurLength = blurLength;
 
+        // the running sums interpolate between the neighbouring pixels
+        useRunningSums = t.scale(blurLength) >= runningSumsMinLength;
+        if (useRunningSums) {
+            kernelHalfSize += QSize(1, 1);
+        }
+
 
         QPointF p1(0.5 * kernelSize.width(), 0.5 * kernelSize.height());
         QPointF p2(halfWidth, halfHeight);
@@ -79,10 +97,134 @@ struct MotionBlurProperties
     }
 
     int blurLength;
+    qreal halfWidth;
+    qreal halfHeight;
+    bool useRunningSums;
     QSize kernelSize;
     QSize kernelHalfSize;
     QLineF motionLine;
 };
+
+/**
+ * Averages \p rect of \p src along the line from -(halfWidth, halfHeight)
+ * to (halfWidth, halfHeight) and writes the result into \p dst. The cost
+ * per pixel doesn't depend on the length of the line.
+ *
+ * The line is parametrized along its major axis u, so the image is first
+ * resampled into rows that are sheared by the slope of the line (the minor
+ * coordinate v is interpolated linearly). Along these rows the blur is a
+ * plain box filter, which is calculated from the prefix sums of the row.
+ * The result is then sheared back, again with linear interpolation.
+ */
+void applyRunningSumsMotionBlur(KisPaintDeviceSP src,
+                                KisPaintDeviceSP dst,
+                                const QRect &rect,
+                                const QBitArray &channelFlags,
+                                const MotionBlurProperties &props,
+                                KoUpdater *progressUpdater)
+{
+    const bool horizontal = qAbs(props.halfWidth) >= qAbs(props.halfHeight);
+    const qreal majorHalfSize = horizontal ? qAbs(props.halfWidth) : qAbs(props.halfHeight);
+    const qreal slope = horizontal ? props.halfHeight / props.halfWidth : props.halfWidth / props.halfHeight;
+
+    // the box covers the whole taps around the center and two fractional ones
+    const int taps = qFloor(majorHalfSize);
+    const float endWeight = majorHalfSize - taps;
+    const float boxNormalization = 1.0f / (2 * taps + 1 + 2 * endWeight);
+    const int reach = taps + 1;
+
+    const KisBlurPlanes planes(src, rect, props.kernelHalfSize);
+    const int channelCount = planes.channelCount();
+
+    const int u0 = horizontal ? rect.left() : rect.top();
+    const int v0 = horizontal ? rect.top() : rect.left();
+    const int uCount = horizontal ? rect.width() : rect.height();
+    const int vCount = horizontal ? rect.height() : rect.width();
+
+    // the range of the sheared rows the output pixels are interpolated from
+    const qreal minShift = qMin(0.0, (uCount - 1) * slope);
+    const qreal maxShift = qMax(0.0, (uCount - 1) * slope);
+    const int firstRow = qFloor(-maxShift) - 1;
+    const int lastRow = vCount - 1 - qFloor(minShift);
+    const int rowCount = lastRow - firstRow + 1;
+    const int shearedWidth = uCount + 2 * reach;
+
+    QVector<float> sheared(rowCount * shearedWidth);
+    QVector<float> boxes(rowCount * uCount);
+    QVector<double> prefixSums(shearedWidth + 1);
+    QVector<float> results(channelCount * rect.width() * rect.height(), 0.0f);
+
+    for (int c = 0; c < channelCount; ++c) {
+        if (!planes.isChannelProcessed(c, channelFlags)) continue;
+
+        if (progressUpdater && progressUpdater->interrupted()) {
+            return;
+        }
+
+        // resample the channel into the sheared rows
+        for (int i = -reach; i < uCount + reach; ++i) {
+            const qreal shift = i * slope;
+            const int shiftInt = qFloor(shift);
+            const float shiftFrac = shift - shiftInt;
+            const int u = u0 + i;
+
+            float *dst = sheared.data() + i + reach;
+
+            for (int j = 0; j < rowCount; ++j, dst += shearedWidth) {
+                const int v = v0 + firstRow + j + shiftInt;
+
+                const float a = horizontal ? planes.value(c, u, v) : planes.value(c, v, u);
+                const float b = horizontal ? planes.value(c, u, v + 1) : planes.value(c, v + 1, u);
+                *dst = a + shiftFrac * (b - a);
+            }
+        }
+
+        // box filter along the sheared rows
+        for (int j = 0; j < rowCount; ++j) {
+            const float *src = sheared.constData() + j * shearedWidth;
+            float *dst = boxes.data() + j * uCount;
+
+            prefixSums[0] = 0.0;
+            for (int i = 0; i < shearedWidth; ++i) {
+                prefixSums[i + 1] = prefixSums[i] + src[i];
+            }
+
+            for (int i = 0; i < uCount; ++i) {
+                const int center = i + reach;
+                const double sum =
+                    prefixSums[center + taps + 1] - prefixSums[center - taps] +
+                    endWeight * (src[center - taps - 1] + src[center + taps + 1]);
+
+                dst[i] = sum * boxNormalization;
+            }
+        }
+
+        // shear the result back
+        float *result = results.data() + c * rect.width() * rect.height();
+
+        for (int i = 0; i < uCount; ++i) {
+            const qreal shift = i * slope;
+            const int shiftInt = qFloor(shift);
+            const float shiftFrac = shift - shiftInt;
+
+            for (int vi = 0; vi < vCount; ++vi) {
+                const int row = vi - shiftInt - firstRow;
+                const float a = boxes[(row - 1) * uCount + i];
+                const float b = boxes[row * uCount + i];
+
+                const int index = horizontal ? vi * rect.width() + i : i * rect.width() + vi;
+                result[index] = b + shiftFrac * (a - b);
+            }
+        }
+
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * (c + 1) / channelCount);
+        }
+    }
+
+    planes.writeResults(dst, results, channelFlags);
+}
+
 }
 
 void KisMotionBlurFilter::processImpl(KisPaintDeviceSP device,
@@ -113,6 +255,24 @@ void KisMotionBlurFilter::processImpl(KisPaintDeviceSP device,
         channelFlags = QBitArray(device->colorSpace()->channelCount(), true);
     }
 
+    if (props.useRunningSums) {
+        /**
+         * The device is blurred in place and the other patches may
+         * already have written their results, so the neighbourhood
+         * is read from the original pixels
+         */
+        const QRect sourceRect =
+            rect.adjusted(-props.kernelHalfSize.width(), -props.kernelHalfSize.height(),
+                          props.kernelHalfSize.width(), props.kernelHalfSize.height());
+
+        KisCachedPaintDevice::Guard d1(device, m_cachedPaintDevice);
+        KisPaintDeviceSP source = d1.device();
+        KisPainter::copyAreaOptimizedOldData(sourceRect.topLeft(), device, source, sourceRect);
+
+        applyRunningSumsMotionBlur(source, device, rect, channelFlags, props, progressUpdater);
+        return;
+    }
+
     QImage kernelRepresentation(props.kernelSize, QImage::Format_RGB32);
     kernelRepresentation.fill(0);
 
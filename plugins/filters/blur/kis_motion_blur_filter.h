@@ -15,6 +15,8 @@
 
 #include <Eigen/Core>
 
+#include "kis_cached_paint_device.h"
+
 class KisMotionBlurFilter : public KisFilter
 {
 public:
@@ -35,6 +37,9 @@ public:
     KisConfigWidget * createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP dev, bool useForMasks) const override;
     QRect neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const override;
     QRect changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const override;
+
+private:
+    mutable KisCachedPaintDevice m_cachedPaintDevice;
 };
 
 #endif
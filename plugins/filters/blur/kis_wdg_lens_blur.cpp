@@ -38,6 +38,11 @@ KisWdgLensBlur::KisWdgLensBlur(QWidget * parent) : KisConfigWidget(parent)
     connect(m_widget->irisShapeCombo, SIGNAL(currentIndexChanged(int)), SIGNAL(sigConfigurationItemChanged()));
     connect(m_widget->irisRadiusSlider, SIGNAL(valueChanged(int)), SIGNAL(sigConfigurationItemChanged()));
     connect(m_widget->irisRotationSelector, SIGNAL(angleChanged(qreal)), SIGNAL(sigConfigurationItemChanged()));
+    connect(m_widget->circularApproximationCheckBox, SIGNAL(toggled(bool)), SIGNAL(sigConfigurationItemChanged()));
+
+    // the approximation is always circular
+    connect(m_widget->circularApproximationCheckBox, SIGNAL(toggled(bool)), m_widget->irisShapeCombo, SLOT(setDisabled(bool)));
+    connect(m_widget->circularApproximationCheckBox, SIGNAL(toggled(bool)), m_widget->irisRotationSelector, SLOT(setDisabled(bool)));
 }
 
 KisWdgLensBlur::~KisWdgLensBlur()
@@ -51,6 +56,7 @@ KisPropertiesConfigurationSP KisWdgLensBlur::configuration() const
     config->setProperty("irisShape", m_shapeTranslations[m_widget->irisShapeCombo->currentText()]);
     config->setProperty("irisRadius", m_widget->irisRadiusSlider->value());
     config->setProperty("irisRotation", static_cast<int>(m_widget->irisRotationSelector->angle()));
+    config->setProperty("circularApproximation", m_widget->circularApproximationCheckBox->isChecked());
 
     QSize halfSize = KisLensBlurFilter::getKernelHalfSize(config, 0);
     config->setProperty("halfWidth", halfSize.width());
@@ -75,5 +81,6 @@ void KisWdgLensBlur::setConfiguration(const KisPropertiesConfigurationSP config)
     if (config->getProperty("irisRotation", value)) {
         m_widget->irisRotationSelector->setAngle(static_cast<qreal>(value.toInt()));
     }
+    m_widget->circularApproximationCheckBox->setChecked(config->getBool("circularApproximation", false));
 }
 
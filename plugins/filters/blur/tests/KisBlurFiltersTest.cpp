@@ -0,0 +1,271 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisBlurFiltersTest.h"
+
+#include <simpletest.h>
+
+#include <functional>
+
+#include <QPainter>
+#include <QtMath>
+
+#include <Eigen/Core>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_global.h"
+#include "kis_convolution_kernel.h"
+#include "kis_convolution_painter.h"
+#include "kis_mask_generator.h"
+#include "kis_transaction.h"
+#include "filter/kis_filter.h"
+#include "filter/kis_filter_configuration.h"
+#include "filter/kis_filter_registry.h"
+#include <KisGlobalResourcesInterface.h>
+#include "testutil.h"
+#include "testing_timed_default_bounds.h"
+
+namespace {
+
+const KoColorSpace* floatColorSpace()
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(),
+                                                        Float32BitsColorDepthID.id(), 0);
+}
+
+/**
+ * An opaque RGBA float device, the gray value of every pixel
+ * of \p rect is set by \p value
+ */
+KisPaintDeviceSP createDevice(const QRect &rect, std::function<float(int, int)> value)
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(floatColorSpace());
+    dev->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(rect));
+
+    QVector<float> pixels(4 * rect.width() * rect.height());
+    for (int y = 0; y < rect.height(); y++) {
+        for (int x = 0; x < rect.width(); x++) {
+            float *pixel = pixels.data() + 4 * (y * rect.width() + x);
+            pixel[0] = pixel[1] = pixel[2] = value(rect.x() + x, rect.y() + y);
+            pixel[3] = 1.0f;
+        }
+    }
+    dev->writeBytes(reinterpret_cast<const quint8*>(pixels.constData()), rect);
+
+    return dev;
+}
+
+/// the values of the first color channel of \p rect
+QVector<float> readChannel(KisPaintDeviceSP dev, const QRect &rect)
+{
+    QVector<float> pixels(4 * rect.width() * rect.height());
+    dev->readBytes(reinterpret_cast<quint8*>(pixels.data()), rect);
+
+    QVector<float> values(rect.width() * rect.height());
+    for (int i = 0; i < values.size(); i++) {
+        values[i] = pixels[4 * i];
+    }
+    return values;
+}
+
+void applyFilter(KisPaintDeviceSP dev, const QRect &rect,
+                 const QString &filterId, const QVariantMap &properties)
+{
+    KisFilterSP f = KisFilterRegistry::instance()->value(filterId);
+    QVERIFY(f);
+
+    KisFilterConfigurationSP config = f->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    for (auto it = properties.begin(); it != properties.end(); ++it) {
+        config->setProperty(it.key(), it.value());
+    }
+
+    KisTransaction t(dev);
+    f->process(dev, rect, config->cloneWithResourcesSnapshot());
+    t.end();
+}
+
+void compareChannels(const QVector<float> &result, const QVector<float> &reference,
+                     float maxMeanDifference, float maxDifference)
+{
+    QCOMPARE(result.size(), reference.size());
+
+    qreal meanDifference = 0.0;
+    float difference = 0.0f;
+
+    for (int i = 0; i < result.size(); i++) {
+        const float d = qAbs(result[i] - reference[i]);
+        meanDifference += d;
+        difference = qMax(difference, d);
+    }
+    meanDifference /= result.size();
+
+    if (meanDifference > maxMeanDifference || difference > maxDifference) {
+        qDebug() << "mean difference" << meanDifference << "max difference" << difference;
+        QFAIL("the results differ too much");
+    }
+}
+
+}
+
+void KisBlurFiltersTest::testBoxBlurVsConvolution_data()
+{
+    QTest::addColumn<int>("halfWidth");
+    QTest::addColumn<int>("halfHeight");
+    QTest::addColumn<int>("rotate");
+
+    QTest::newRow("square") << 5 << 5 << 0;
+    QTest::newRow("wide") << 8 << 3 << 0;
+    QTest::newRow("wide-180") << 8 << 3 << 180;
+    QTest::newRow("square-90") << 6 << 6 << 90;
+    QTest::newRow("column") << 0 << 4 << 0;
+}
+
+void KisBlurFiltersTest::testBoxBlurVsConvolution()
+{
+    QFETCH(int, halfWidth);
+    QFETCH(int, halfHeight);
+    QFETCH(int, rotate);
+
+    const QRect rect(0, 0, 96, 96);
+    auto pattern = [] (int x, int y) { return float((x / 7 + y / 11) % 2) * 0.5f + float(x + y) / 384.0f; };
+
+    // a rectangle at full strength is calculated from the summed-area table
+    KisPaintDeviceSP dev = createDevice(rect, pattern);
+    applyFilter(dev, rect, "blur",
+                {{"halfWidth", halfWidth}, {"halfHeight", halfHeight},
+                 {"rotate", rotate}, {"strength", 100}, {"shape", 1}});
+
+    /**
+     * The reference is the convolution with the kernel built from the
+     * mask generator, with its antialiased edges
+     */
+    const int width = 2 * halfWidth + 1;
+    const int height = 2 * halfHeight + 1;
+    KisRectangleMaskGenerator mask(width, qreal(height) / width, 1.0, 1.0, 2, true);
+
+    KisPaintDeviceSP src = createDevice(rect, pattern);
+    KisPaintDeviceSP reference = createDevice(rect, pattern);
+
+    KisConvolutionPainter convolutionPainter(reference);
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMaskGenerator(&mask, kisDegreesToRadians(qreal(rotate)));
+    convolutionPainter.applyMatrix(kernel, src, rect.topLeft(), rect.topLeft(), rect.size(), BORDER_REPEAT);
+
+    compareChannels(readChannel(dev, rect), readChannel(reference, rect), 1e-4f, 1e-3f);
+}
+
+void KisBlurFiltersTest::testLensBlurApproximationSize()
+{
+    const QRect rect(0, 0, 64, 64);
+    const QPoint center = rect.center();
+    const int radius = 10;
+
+    KisPaintDeviceSP dev = createDevice(rect,
+        [center] (int x, int y) { return QPoint(x, y) == center ? 1.0f : 0.0f; });
+
+    applyFilter(dev, rect, "lens blur",
+                {{"irisRadius", radius}, {"circularApproximation", true}});
+
+    const QVector<float> result = readChannel(dev, rect);
+    const float centerValue = result[center.y() * rect.width() + center.x()];
+    QVERIFY(centerValue > 0.0f);
+
+    // the disk is all the pixels brighter than the half of the center
+    int diskArea = 0;
+    Q_FOREACH (float value, result) {
+        if (value > 0.5f * centerValue) {
+            diskArea++;
+        }
+    }
+
+    const qreal diskRadius = std::sqrt(diskArea / M_PI);
+    if (qAbs(diskRadius / radius - 1.0) > 0.05) {
+        qDebug() << "disk radius" << diskRadius << "expected" << radius;
+        QFAIL("the bokeh of the approximation has wrong size");
+    }
+}
+
+void KisBlurFiltersTest::testLensBlurApproximationVsExact()
+{
+    const QRect rect(0, 0, 64, 64);
+    auto checkers = [] (int x, int y) { return float((x / 12 + y / 12) % 2); };
+
+    KisPaintDeviceSP approximated = createDevice(rect, checkers);
+    applyFilter(approximated, rect, "lens blur",
+                {{"irisShape", "Octagon (8)"}, {"irisRadius", 6}, {"circularApproximation", true}});
+
+    KisPaintDeviceSP exact = createDevice(rect, checkers);
+    applyFilter(exact, rect, "lens blur",
+                {{"irisShape", "Octagon (8)"}, {"irisRadius", 6},
+                 {"halfWidth", 6}, {"halfHeight", 6}, {"circularApproximation", false}});
+
+    // an octagon is not a disk, and the approximation has a ripple
+    compareChannels(readChannel(approximated, rect), readChannel(exact, rect), 0.03f, 0.15f);
+}
+
+void KisBlurFiltersTest::testMotionBlurRunningSums_data()
+{
+    QTest::addColumn<int>("angle");
+
+    QTest::newRow("0") << 0;
+    QTest::newRow("20") << 20;
+    QTest::newRow("45") << 45;
+    QTest::newRow("70") << 70;
+    QTest::newRow("90") << 90;
+    QTest::newRow("135") << 135;
+}
+
+void KisBlurFiltersTest::testMotionBlurRunningSums()
+{
+    QFETCH(int, angle);
+
+    const QRect rect(0, 0, 96, 96);
+    const int length = 40;
+    auto checkers = [] (int x, int y) { return float((x / 7 + y / 11) % 2); };
+
+    // long blurs are calculated with the running sums
+    KisPaintDeviceSP dev = createDevice(rect, checkers);
+    applyFilter(dev, rect, "motion blur", {{"blurAngle", angle}, {"blurLength", length}});
+
+    /**
+     * The reference is the convolution with the line kernel, built
+     * the same way as the motion blur filter builds it for the short
+     * blurs
+     */
+    const qreal halfWidth = 0.5 * length * cos(kisDegreesToRadians(qreal(angle)));
+    const qreal halfHeight = 0.5 * length * sin(kisDegreesToRadians(qreal(angle)));
+    const QSize kernelSize(2 * qCeil(qAbs(halfWidth)) + 1, 2 * qCeil(qAbs(halfHeight)) + 1);
+
+    QImage kernelImage(kernelSize, QImage::Format_RGB32);
+    kernelImage.fill(0);
+
+    QPainter painter(&kernelImage);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(QColor::fromRgb(255, 255, 255), 1.0));
+    const QPointF center(0.5 * kernelSize.width(), 0.5 * kernelSize.height());
+    painter.drawLine(QLineF(center - QPointF(halfWidth, halfHeight), center + QPointF(halfWidth, halfHeight)));
+    painter.end();
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix(kernelSize.height(), kernelSize.width());
+    for (int j = 0; j < kernelSize.height(); ++j) {
+        for (int i = 0; i < kernelSize.width(); ++i) {
+            matrix(j, i) = qRed(kernelImage.pixel(i, j));
+        }
+    }
+
+    KisPaintDeviceSP src = createDevice(rect, checkers);
+    KisPaintDeviceSP reference = createDevice(rect, checkers);
+
+    KisConvolutionPainter convolutionPainter(reference);
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(matrix, 0, matrix.sum());
+    convolutionPainter.applyMatrix(kernel, src, rect.topLeft(), rect.topLeft(), rect.size(), BORDER_REPEAT);
+
+    // the antialiased line and the interpolated rows sample the line differently
+    compareChannels(readChannel(dev, rect), readChannel(reference, rect), 0.03f, 0.2f);
+}
+
+SIMPLE_TEST_MAIN(KisBlurFiltersTest)
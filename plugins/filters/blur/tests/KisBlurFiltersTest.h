@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_BLUR_FILTERS_TEST_H
+#define KIS_BLUR_FILTERS_TEST_H
+
+#include <simpletest.h>
+
+class KisBlurFiltersTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testBoxBlurVsConvolution_data();
+    void testBoxBlurVsConvolution();
+    void testLensBlurApproximationSize();
+    void testLensBlurApproximationVsExact();
+    void testMotionBlurRunningSums_data();
+    void testMotionBlurRunningSums();
+};
+
+#endif
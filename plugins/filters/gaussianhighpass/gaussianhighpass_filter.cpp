@@ -26,12 +26,13 @@
 #include <KoUpdater.h>
 #include <KoMixColorsOp.h>
 #include "kis_lod_transform.h"
+#include <KoCompositeOp.h>
 #include <KoCompositeOpRegistry.h>
+#include <KisGaussianBlurCache.h>
 
 #include "wdg_gaussianhighpass.h"
 #include "ui_wdggaussianhighpass.h"
 #include "KoColorSpaceTraits.h"
-#include <KisSequentialIteratorProgress.h>
 
 
 KisGaussianHighPassFilter::KisGaussianHighPassFilter() : KisFilter(id(), FiltersCategoryEdgeDetectionId, i18n("&Gaussian High Pass..."))
@@ -58,10 +59,9 @@ KisFilterConfigurationSP KisGaussianHighPassFilter::defaultConfiguration(KisReso
 void KisGaussianHighPassFilter::processImpl(KisPaintDeviceSP device,
                                    const QRect& applyRect,
                                    const KisFilterConfigurationSP config,
-                                   KoUpdater *
+                                   KoUpdater *progressUpdater
                                    ) const
 {
-    QPointer<KoUpdater> convolutionUpdater = 0;
     KIS_SAFE_ASSERT_RECOVER_RETURN(config);
 
     QVariant value;
@@ -72,18 +72,51 @@ void KisGaussianHighPassFilter::processImpl(KisPaintDeviceSP device,
     const QRect gaussNeedRect = this->neededRect(applyRect, config, device->defaultBounds()->currentLevelOfDetail());
 
     KisCachedPaintDevice::Guard d1(device, m_cachedPaintDevice);
-    KisPaintDeviceSP blur = d1.device();
-    KisPainter::copyAreaOptimizedOldData(gaussNeedRect.topLeft(), device, blur, gaussNeedRect);
-    KisGaussianKernel::applyGaussian(blur, applyRect,
-                                     blurAmount, blurAmount,
-                                     channelFlags,
-                                     convolutionUpdater,
-                                     true); // make sure we create an internal transaction on temp device
-    
-    KisPainter painter(device);
-    painter.setCompositeOpId(COMPOSITE_GRAIN_EXTRACT);
-    painter.bitBlt(applyRect.topLeft(), blur, applyRect);
-    painter.end();
+    KisPaintDeviceSP source = d1.device();
+    KisPainter::copyAreaOptimizedOldData(gaussNeedRect.topLeft(), device, source, gaussNeedRect);
+
+    const KoColorSpace *cs = device->colorSpace();
+    const KoCompositeOp *grainExtractOp = cs->compositeOp(COMPOSITE_GRAIN_EXTRACT);
+    const int pixelSize = cs->pixelSize();
+
+    /**
+     * The blur is taken from the shared cache and extracted from the
+     * original pixels of the same cell right away, so the blurred
+     * pixels are never written into a device.
+     *
+     * The filter stroke already runs the patches of the filter on all the
+     * threads of the updater context, so the cells are processed on the
+     * calling thread.
+     */
+    const QVector<QRect> cells = KisGaussianBlurCache::splitIntoCells(applyRect);
+
+    for (int i = 0; i < cells.size(); i++) {
+        if (progressUpdater && progressUpdater->interrupted()) {
+            return;
+        }
+
+        const QRect &cell = cells[i];
+        QVector<quint8> dstBytes(cell.width() * cell.height() * pixelSize);
+        QVector<quint8> blurredBytes(cell.width() * cell.height() * pixelSize);
+
+        source->readBytes(dstBytes.data(), cell);
+        KisGaussianBlurCache::instance()->readBlurredBytes(source, cell,
+                                                           blurAmount,
+                                                           channelFlags,
+                                                           blurredBytes.data());
+
+        grainExtractOp->composite(dstBytes.data(), cell.width() * pixelSize,
+                                  blurredBytes.constData(), cell.width() * pixelSize,
+                                  0, 0,
+                                  cell.height(), cell.width(),
+                                  OPACITY_OPAQUE_F);
+
+        device->writeBytes(dstBytes.constData(), cell);
+
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * (i + 1) / cells.size());
+        }
+    }
 }
 
 
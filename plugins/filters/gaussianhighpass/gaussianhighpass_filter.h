@@ -22,7 +22,7 @@ public:
     void processImpl(KisPaintDeviceSP device,
                      const QRect& applyRect,
                      const KisFilterConfigurationSP config,
-                     KoUpdater *
+                     KoUpdater *progressUpdater
                      ) const override;
 
     static inline KoID id() {
@@ -7,7 +7,13 @@
  *  SPDX-License-Identifier: GPL-2.0-or-later
  */
 
+#include <algorithm>
+
+#include <QMutexLocker>
+
 #include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorProfile.h>
 #include <KoColor.h>
 #include <kis_paint_device.h>
 #include <kis_global.h>
@@ -20,13 +26,12 @@
 #include <KisGlobalResourcesInterface.h>
 #include <KisSequentialIteratorProgress.h>
 #include <KoUpdater.h>
-#include <KoCachedGradient.h>
 
 #include "KisGradientMapFilter.h"
 #include "KisGradientMapFilterConfigWidget.h"
 #include "KisGradientMapFilterConfiguration.h"
-#include "KisGradientMapFilterNearestCachedGradient.h"
-#include "KisGradientMapFilterDitherCachedGradient.h"
+#include "KisGradientMapFilterLut.h"
+#include "KisGradientMapFilterLuminance.h"
 
 KisGradientMapFilter::KisGradientMapFilter()
     : KisFilter(id(), FiltersCategoryMapId, i18n("&Gradient Map..."))
@@ -34,77 +39,56 @@ KisGradientMapFilter::KisGradientMapFilter()
     setSupportsPainting(true);
 }
 
-class BlendColorModePolicy
-{
-public:
-    BlendColorModePolicy(const KoCachedGradient *cachedGradient);
-
-    const quint8* colorAt(qreal t, int x, int y) const;
-
-private:
-    const KoCachedGradient *m_cachedGradient;
-};
-
-BlendColorModePolicy::BlendColorModePolicy(const KoCachedGradient *cachedGradient)
-    : m_cachedGradient(cachedGradient)
-{}
-
-const quint8* BlendColorModePolicy::colorAt(qreal t, int x, int y) const
-{
-    Q_UNUSED(x);
-    Q_UNUSED(y);
-
-    return m_cachedGradient->cachedAt(t);
-}
-
-class NearestColorModePolicy
+class ColorModePolicy
 {
 public:
-    NearestColorModePolicy(const KisGradientMapFilterNearestCachedGradient *cachedGradient);
+    ColorModePolicy(const KisGradientMapFilterLut *lut);
 
-    const quint8* colorAt(qreal t, int x, int y) const;
+    const quint8* colorAt(int index, int x, int y, float *opacity) const;
 
 private:
-    const KisGradientMapFilterNearestCachedGradient *m_cachedGradient;
+    const KisGradientMapFilterLut *m_lut;
 };
 
-NearestColorModePolicy::NearestColorModePolicy(const KisGradientMapFilterNearestCachedGradient *cachedGradient)
-    : m_cachedGradient(cachedGradient)
+ColorModePolicy::ColorModePolicy(const KisGradientMapFilterLut *lut)
+    : m_lut(lut)
 {}
 
-const quint8* NearestColorModePolicy::colorAt(qreal t, int x, int y) const
+const quint8* ColorModePolicy::colorAt(int index, int x, int y, float *opacity) const
 {
     Q_UNUSED(x);
     Q_UNUSED(y);
 
-    return m_cachedGradient->cachedAt(t);
+    *opacity = m_lut->opacity(index);
+    return m_lut->color(index);
 }
 
 class DitherColorModePolicy
 {
 public:
-    DitherColorModePolicy(const KisGradientMapFilterDitherCachedGradient *cachedGradient, KisDitherUtil *ditherUtil);
+    DitherColorModePolicy(const KisGradientMapFilterLut *lut, KisDitherUtil *ditherUtil);
 
-    const quint8* colorAt(qreal t, int x, int y) const;
+    const quint8* colorAt(int index, int x, int y, float *opacity) const;
 
 private:
-    const KisGradientMapFilterDitherCachedGradient *m_cachedGradient;
+    const KisGradientMapFilterLut *m_lut;
     KisDitherUtil *m_ditherUtil;
 };
 
-DitherColorModePolicy::DitherColorModePolicy(const KisGradientMapFilterDitherCachedGradient *cachedGradient, KisDitherUtil *ditherUtil)
-    : m_cachedGradient(cachedGradient)
+DitherColorModePolicy::DitherColorModePolicy(const KisGradientMapFilterLut *lut, KisDitherUtil *ditherUtil)
+    : m_lut(lut)
     , m_ditherUtil(ditherUtil)
 {}
 
-const quint8* DitherColorModePolicy::colorAt(qreal t, int x, int y) const
+const quint8* DitherColorModePolicy::colorAt(int index, int x, int y, float *opacity) const
 {
-    const KisGradientMapFilterDitherCachedGradient::CachedEntry &cachedEntry = m_cachedGradient->cachedAt(t);
-    if (cachedEntry.localT < m_ditherUtil->threshold(QPoint(x, y))) {
-        return cachedEntry.leftStop.data();
+    if (m_lut->localT(index) < m_ditherUtil->threshold(QPoint(x, y))) {
+        *opacity = m_lut->opacity(index);
+        return m_lut->color(index);
     }
     else {
-        return cachedEntry.rightStop.data();
+        *opacity = m_lut->rightOpacity(index);
+        return m_lut->rightColor(index);
     }
 }
 
@@ -120,55 +104,104 @@ void KisGradientMapFilter::processImpl(KisPaintDeviceSP device,
 
     KIS_SAFE_ASSERT_RECOVER_RETURN(filterConfig);
 
-    KoAbstractGradientSP gradient = filterConfig->gradient();
     const int colorMode = filterConfig->colorMode();
-    const KoColorSpace *colorSpace = device->colorSpace();
-    const int cachedGradientSize = device->extent().width() + device->extent().height();
+    QSharedPointer<const KisGradientMapFilterLut> lut = lutFor(filterConfig, device->colorSpace());
 
-    if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Blend) {
-        KoCachedGradient cachedGradient(gradient, cachedGradientSize, colorSpace);
-        BlendColorModePolicy colorModePolicy(&cachedGradient);
-        processImpl(device, applyRect, config, progressUpdater, colorModePolicy);
-
-    } else if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Nearest) {
-        KisGradientMapFilterNearestCachedGradient cachedGradient(gradient, cachedGradientSize, colorSpace);
-        NearestColorModePolicy colorModePolicy(&cachedGradient);
-        processImpl(device, applyRect, config, progressUpdater, colorModePolicy);
-
-    } else /* if colorMode == KisGradientMapFilterConfiguration::ColorMode_Dither */ {
+    if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Dither) {
         KisDitherUtil ditherUtil;
-        KisGradientMapFilterDitherCachedGradient cachedGradient(gradient, cachedGradientSize, colorSpace);
         ditherUtil.setConfiguration(*filterConfig, "dither/");
-        DitherColorModePolicy colorModePolicy(&cachedGradient, &ditherUtil);
-        processImpl(device, applyRect, config, progressUpdater, colorModePolicy);
+        DitherColorModePolicy colorModePolicy(lut.data(), &ditherUtil);
+        processImpl(device, applyRect, *lut, progressUpdater, colorModePolicy);
+    } else {
+        ColorModePolicy colorModePolicy(lut.data());
+        processImpl(device, applyRect, *lut, progressUpdater, colorModePolicy);
     }
 }
 
 template <typename ColorModeStrategy>
 void KisGradientMapFilter::processImpl(KisPaintDeviceSP device,
                                        const QRect& applyRect,
-                                       const KisFilterConfigurationSP config,
+                                       const KisGradientMapFilterLut &lut,
                                        KoUpdater *progressUpdater,
                                        const ColorModeStrategy &colorModeStrategy) const
 {
-    Q_UNUSED(config);
-    
     Q_ASSERT(!device.isNull());
 
     const KoColorSpace *colorSpace = device->colorSpace();
     const int pixelSize = colorSpace->pixelSize();
 
+    KisGradientMapFilterLuminance luminance(colorSpace, lut.size());
+    QVector<int> indices;
+    QVector<float> pixelOpacities;
+
     KisSequentialIteratorProgress it(device, applyRect, progressUpdater);
 
-    while (it.nextPixel()) {
-        const qreal t = colorSpace->intensityF(it.oldRawData());
-        const qreal pixelOpacity = colorSpace->opacityF(it.oldRawData());
-        const quint8 *color = colorModeStrategy.colorAt(t, it.x(), it.y());
-        memcpy(it.rawData(), color, pixelSize);
-        colorSpace->setOpacity(it.rawData(), qMin(pixelOpacity, colorSpace->opacityF(color)), 1);
+    int numPixels = it.nConseqPixels();
+    while (it.nextPixels(numPixels)) {
+        numPixels = it.nConseqPixels();
+
+        indices.resize(numPixels);
+        pixelOpacities.resize(numPixels);
+
+        luminance.compute(it.oldRawData(), numPixels, indices.data(), pixelOpacities.data());
+
+        const int x = it.x();
+        const int y = it.y();
+        quint8 *dst = it.rawData();
+
+        for (int i = 0; i < numPixels; ++i, dst += pixelSize) {
+            float colorOpacity;
+            const quint8 *color = colorModeStrategy.colorAt(indices[i], x + i, y, &colorOpacity);
+            memcpy(dst, color, pixelSize);
+
+            if (pixelOpacities[i] < colorOpacity) {
+                colorSpace->setOpacity(dst, qreal(pixelOpacities[i]), 1);
+            }
+        }
     }
 }
 
+QSharedPointer<const KisGradientMapFilterLut>
+KisGradientMapFilter::lutFor(const KisGradientMapFilterConfiguration *config, const KoColorSpace *colorSpace) const
+{
+    const QString key =
+        QString("%1\n%2\n%3\n%4\n%5\n%6\n%7")
+            .arg(config->version())
+            .arg(config->colorMode())
+            .arg(config->getString("gradientXML"))
+            .arg(config->getString("md5sum"))
+            .arg(config->getString("gradientName"))
+            .arg(colorSpace->id())
+            .arg(colorSpace->profile() ? colorSpace->profile()->name() : QString());
+
+    {
+        QMutexLocker l(&m_lutsMutex);
+
+        for (int i = 0; i < m_luts.size(); ++i) {
+            if (m_luts[i].first == key) {
+                m_luts.move(i, 0);
+                return m_luts.first().second;
+            }
+        }
+    }
+
+    /**
+     * The patches of one update may build the same LUT concurrently,
+     * which is cheaper than making them wait for each other
+     */
+    QSharedPointer<const KisGradientMapFilterLut> lut(
+        new KisGradientMapFilterLut(config->gradient(), config->colorMode(), colorSpace));
+
+    QMutexLocker l(&m_lutsMutex);
+
+    m_luts.prepend(qMakePair(key, lut));
+    while (m_luts.size() > maxCachedLuts) {
+        m_luts.removeLast();
+    }
+
+    return lut;
+}
+
 KisFilterConfigurationSP KisGradientMapFilter::factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const
 {
     return new KisGradientMapFilterConfiguration(resourcesInterface);
@@ -11,12 +11,18 @@
 #ifndef KIS_GRADIENT_MAP_FILTER_H
 #define KIS_GRADIENT_MAP_FILTER_H
 
+#include <QList>
+#include <QMutex>
 #include <QObject>
+#include <QPair>
+#include <QSharedPointer>
 
 #include <filter/kis_filter.h>
 #include <kis_filter_configuration.h>
 
 class KisConfigWidget;
+class KisGradientMapFilterConfiguration;
+class KisGradientMapFilterLut;
 
 class KisGradientMapFilter : public KisFilter
 {
@@ -35,13 +41,27 @@ public:
     template <typename ColorModeStrategy>
     void processImpl(KisPaintDeviceSP device,
                      const QRect& applyRect,
-                     const KisFilterConfigurationSP config,
+                     const KisGradientMapFilterLut &lut,
                      KoUpdater *progressUpdater,
                      const ColorModeStrategy &colorModeStrategy) const;
 
     KisFilterConfigurationSP factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
     KisFilterConfigurationSP defaultConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
     KisConfigWidget* createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP dev, bool useForMasks) const override;
+
+private:
+    /**
+     * Compiling the gradient takes much longer than applying it to a
+     * patch, so the LUTs of the recently used gradients are shared
+     * between the patches and the updates of the filter
+     */
+    QSharedPointer<const KisGradientMapFilterLut> lutFor(const KisGradientMapFilterConfiguration *config,
+                                                         const KoColorSpace *colorSpace) const;
+
+    static const int maxCachedLuts = 4;
+
+    mutable QMutex m_lutsMutex;
+    mutable QList<QPair<QString, QSharedPointer<const KisGradientMapFilterLut>>> m_luts;
 };
 
 #endif
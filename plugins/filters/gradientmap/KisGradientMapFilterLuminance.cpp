@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGradientMapFilterLuminance.h"
+
+#include <algorithm>
+
+#include <KoColorConversionTransformation.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+namespace {
+
+/**
+ * BGRA8 pixels. The integer weights are the ones of
+ * RgbU8ColorSpace::intensity8(), "+ 50" is used for rounding.
+ */
+inline void computeIndicesU8(const quint8 *pixels, int numPixels, int maxIndex, int *indices, float *opacities)
+{
+    for (int i = 0; i < numPixels; ++i) {
+        const int luminance = pixels[4 * i + 2] * 30 + pixels[4 * i + 1] * 59 + pixels[4 * i] * 11;
+        indices[i] = std::min((luminance * maxIndex / 255 + 50) / 100, maxIndex);
+        opacities[i] = pixels[4 * i + 3] / 255.0f;
+    }
+}
+
+/**
+ * BGRA16 pixels with the weights of KoColorSpace::intensityF()
+ */
+inline void computeIndicesU16(const quint16 *pixels, int numPixels, int maxIndex, int *indices, float *opacities)
+{
+    const float scale = maxIndex / 65535.0f;
+
+    for (int i = 0; i < numPixels; ++i) {
+        const float luminance =
+            0.30f * pixels[4 * i + 2] + 0.59f * pixels[4 * i + 1] + 0.11f * pixels[4 * i];
+        indices[i] = std::min(static_cast<int>(luminance * scale + 0.5f), maxIndex);
+        opacities[i] = pixels[4 * i + 3] / 65535.0f;
+    }
+}
+
+}
+
+KisGradientMapFilterLuminance::KisGradientMapFilterLuminance(const KoColorSpace *cs, int lutSize)
+    : m_colorSpace(cs)
+    , m_rgbColorSpace(KoColorSpaceRegistry::instance()->rgb16())
+    , m_maxIndex(lutSize - 1)
+{
+    if (cs->colorModelId() == RGBAColorModelID &&
+        cs->colorDepthId() == Integer8BitsColorDepthID) {
+
+        m_mode = RawRgbU8;
+    } else if (*cs == *m_rgbColorSpace) {
+        m_mode = RawRgbU16;
+    } else {
+        m_mode = ConvertedRgbU16;
+    }
+}
+
+void KisGradientMapFilterLuminance::compute(const quint8 *pixels, int numPixels, int *indices, float *opacities)
+{
+    if (m_mode == RawRgbU8) {
+        computeIndicesU8(pixels, numPixels, m_maxIndex, indices, opacities);
+
+    } else if (m_mode == RawRgbU16) {
+        computeIndicesU16(reinterpret_cast<const quint16*>(pixels), numPixels, m_maxIndex, indices, opacities);
+
+    } else {
+        m_rgbPixels.resize(4 * numPixels);
+
+        m_colorSpace->convertPixelsTo(pixels, reinterpret_cast<quint8*>(m_rgbPixels.data()),
+                                      m_rgbColorSpace, numPixels,
+                                      KoColorConversionTransformation::internalRenderingIntent(),
+                                      KoColorConversionTransformation::internalConversionFlags());
+
+        computeIndicesU16(m_rgbPixels.constData(), numPixels, m_maxIndex, indices, opacities);
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_GRADIENT_MAP_FILTER_LUMINANCE_H
+#define KIS_GRADIENT_MAP_FILTER_LUMINANCE_H
+
+#include <QVector>
+
+class KoColorSpace;
+
+/**
+ * @brief Computes the LUT indices of the luminance of spans of pixels
+ *
+ * The luminance is the same as the one of KoColorSpace::intensityF().
+ * RGBA8 computes it from the raw channels whatever the profile is, the
+ * same as RgbU8ColorSpace::intensityF(), so the 8-bit pixels are read
+ * directly. sRGB RGBA16 pixels are read directly as well. All the other
+ * pixels are converted to sRGB RGBA16 in one batch per span.
+ *
+ * The object keeps a conversion buffer, so every thread needs its own.
+ */
+class KisGradientMapFilterLuminance
+{
+public:
+    KisGradientMapFilterLuminance(const KoColorSpace *cs, int lutSize);
+
+    /**
+     * Writes the LUT indices and the opacities of \p numPixels pixels
+     * of \p pixels into \p indices and \p opacities
+     */
+    void compute(const quint8 *pixels, int numPixels, int *indices, float *opacities);
+
+private:
+    enum Mode {
+        RawRgbU8,
+        RawRgbU16,
+        ConvertedRgbU16
+    };
+
+    const KoColorSpace *m_colorSpace;
+    const KoColorSpace *m_rgbColorSpace;
+    int m_maxIndex;
+    Mode m_mode;
+    QVector<quint16> m_rgbPixels;
+};
+
+#endif
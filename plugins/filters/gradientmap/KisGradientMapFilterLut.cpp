@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGradientMapFilterLut.h"
+
+#include <cstring>
+
+#include <KoCachedGradient.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+
+#include "KisGradientMapFilterConfiguration.h"
+#include "KisGradientMapFilterNearestCachedGradient.h"
+#include "KisGradientMapFilterDitherCachedGradient.h"
+
+KisGradientMapFilterLut::KisGradientMapFilterLut(const KoAbstractGradientSP gradient, int colorMode, const KoColorSpace *cs)
+    : m_size(lutSizeFor(cs))
+    , m_pixelSize(cs->pixelSize())
+    , m_colors(m_size * m_pixelSize)
+    , m_opacities(m_size)
+{
+    const qreal maxIndex = m_size - 1;
+
+    if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Blend) {
+        KoCachedGradient cachedGradient(gradient, m_size, cs);
+        for (int i = 0; i < m_size; ++i) {
+            memcpy(m_colors.data() + i * m_pixelSize, cachedGradient.cachedAt(i / maxIndex), m_pixelSize);
+        }
+
+    } else if (colorMode == KisGradientMapFilterConfiguration::ColorMode_Nearest) {
+        KisGradientMapFilterNearestCachedGradient cachedGradient(gradient, m_size, cs);
+        for (int i = 0; i < m_size; ++i) {
+            memcpy(m_colors.data() + i * m_pixelSize, cachedGradient.cachedAt(i / maxIndex), m_pixelSize);
+        }
+
+    } else /* if colorMode == KisGradientMapFilterConfiguration::ColorMode_Dither */ {
+        m_rightColors.resize(m_size * m_pixelSize);
+        m_rightOpacities.resize(m_size);
+        m_localT.resize(m_size);
+
+        KisGradientMapFilterDitherCachedGradient cachedGradient(gradient, m_size, cs);
+        for (int i = 0; i < m_size; ++i) {
+            const KisGradientMapFilterDitherCachedGradient::CachedEntry &entry = cachedGradient.cachedAt(i / maxIndex);
+            memcpy(m_colors.data() + i * m_pixelSize, entry.leftStop.data(), m_pixelSize);
+            memcpy(m_rightColors.data() + i * m_pixelSize, entry.rightStop.data(), m_pixelSize);
+            m_rightOpacities[i] = cs->opacityF(entry.rightStop.data());
+            m_localT[i] = entry.localT;
+        }
+    }
+
+    for (int i = 0; i < m_size; ++i) {
+        m_opacities[i] = cs->opacityF(color(i));
+    }
+}
+
+int KisGradientMapFilterLut::lutSizeFor(const KoColorSpace *cs)
+{
+    return cs->colorDepthId() == Integer8BitsColorDepthID ? 256 : 65536;
+}
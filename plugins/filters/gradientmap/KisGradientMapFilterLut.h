@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_GRADIENT_MAP_FILTER_LUT_H
+#define KIS_GRADIENT_MAP_FILTER_LUT_H
+
+#include <QVector>
+
+#include <KoAbstractGradient.h>
+
+class KoColorSpace;
+
+/**
+ * @brief The gradient of the gradient map compiled for one color space
+ *
+ * Keeps the colors of the gradient for every possible luminance as
+ * plain pixels of the color space, so that applying the map is just
+ * an index computation and a copy of a pixel. The number of entries
+ * depends on the depth of the color space: 256 entries for the 8-bit
+ * spaces and 65536 entries for the rest (the float luminance is
+ * quantized to 16 bits).
+ *
+ * In the dither mode every entry keeps both stops around the
+ * position and the position between them.
+ */
+class KisGradientMapFilterLut
+{
+public:
+    KisGradientMapFilterLut(const KoAbstractGradientSP gradient, int colorMode, const KoColorSpace *cs);
+
+    static int lutSizeFor(const KoColorSpace *cs);
+
+    inline int size() const {
+        return m_size;
+    }
+
+    /// the color of the entry (or the left stop in the dither mode)
+    inline const quint8* color(int index) const {
+        return m_colors.constData() + index * m_pixelSize;
+    }
+
+    /// the right stop of the entry in the dither mode
+    inline const quint8* rightColor(int index) const {
+        return m_rightColors.constData() + index * m_pixelSize;
+    }
+
+    /// the position of the entry between the stops in the dither mode
+    inline float localT(int index) const {
+        return m_localT[index];
+    }
+
+    /// the opacity of color(index) (of the left stop in the dither mode)
+    inline float opacity(int index) const {
+        return m_opacities[index];
+    }
+
+    inline float rightOpacity(int index) const {
+        return m_rightOpacities[index];
+    }
+
+private:
+    int m_size;
+    int m_pixelSize;
+    QVector<quint8> m_colors;
+    QVector<quint8> m_rightColors;
+    QVector<float> m_localT;
+    QVector<float> m_opacities;
+    QVector<float> m_rightOpacities;
+};
+
+#endif
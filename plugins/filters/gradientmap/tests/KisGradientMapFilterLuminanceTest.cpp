@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGradientMapFilterLuminanceTest.h"
+
+#include <simpletest.h>
+
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "../KisGradientMapFilterLuminance.h"
+
+namespace {
+
+/**
+ * Fills \p numPixels pixels of \p cs with the colors going through
+ * the whole RGB cube and the opacities going through the whole range
+ */
+QVector<quint8> makePixels(const KoColorSpace *cs, int numPixels)
+{
+    QVector<quint8> pixels(numPixels * cs->pixelSize());
+
+    for (int i = 0; i < numPixels; i++) {
+        const QColor color(i * 7 % 256, i * 13 % 256, i * 29 % 256, i * 3 % 256);
+        cs->fromQColor(color, pixels.data() + i * cs->pixelSize());
+    }
+
+    return pixels;
+}
+
+/**
+ * Checks that the LUT indices of the pixels are the luminances
+ * returned by KoColorSpace::intensityF() within \p tolerance
+ */
+void checkAgainstIntensityF(const KoColorSpace *cs, int lutSize, qreal tolerance)
+{
+    const int numPixels = 4096;
+    const QVector<quint8> pixels = makePixels(cs, numPixels);
+
+    QVector<int> indices(numPixels);
+    QVector<float> opacities(numPixels);
+
+    KisGradientMapFilterLuminance luminance(cs, lutSize);
+    luminance.compute(pixels.constData(), numPixels, indices.data(), opacities.data());
+
+    const int maxIndex = lutSize - 1;
+
+    for (int i = 0; i < numPixels; i++) {
+        const quint8 *pixel = pixels.constData() + i * cs->pixelSize();
+        const qreal expectedIndex = cs->intensityF(pixel) * maxIndex;
+
+        if (qAbs(indices[i] - expectedIndex) > tolerance) {
+            qDebug() << cs->name() << "pixel" << i
+                     << "index" << indices[i] << "expected" << expectedIndex;
+            QFAIL("the luminance differs from KoColorSpace::intensityF()");
+        }
+
+        QVERIFY(qAbs(opacities[i] - cs->opacityF(pixel)) < 1e-3);
+    }
+}
+
+}
+
+void KisGradientMapFilterLuminanceTest::testRgbU8()
+{
+    checkAgainstIntensityF(KoColorSpaceRegistry::instance()->rgb8(), 256, 0.5 + 1e-6);
+}
+
+void KisGradientMapFilterLuminanceTest::testRgbU8NonSRGB()
+{
+    /**
+     * RgbU8ColorSpace::intensityF() uses the raw channels whatever the
+     * profile is, the gradient map should do the same
+     */
+    const KoColorSpace *cs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(),
+                                                     Integer8BitsColorDepthID.id(),
+                                                     "sRGB-elle-V2-g10.icc");
+    if (!cs) {
+        QSKIP("the linear sRGB profile is not available");
+    }
+
+    checkAgainstIntensityF(cs, 256, 0.5 + 1e-6);
+}
+
+void KisGradientMapFilterLuminanceTest::testRgbU16()
+{
+    checkAgainstIntensityF(KoColorSpaceRegistry::instance()->rgb16(), 65536, 1.0);
+}
+
+void KisGradientMapFilterLuminanceTest::testConverted()
+{
+    // the conversions of the batch and of intensityF() may round differently
+    checkAgainstIntensityF(KoColorSpaceRegistry::instance()->lab16(), 65536, 0.01 * 65535);
+}
+
+SIMPLE_TEST_MAIN(KisGradientMapFilterLuminanceTest)
@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_GRADIENT_MAP_FILTER_LUMINANCE_TEST_H
+#define KIS_GRADIENT_MAP_FILTER_LUMINANCE_TEST_H
+
+#include <simpletest.h>
+
+class KisGradientMapFilterLuminanceTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRgbU8();
+    void testRgbU8NonSRGB();
+    void testRgbU16();
+    void testConverted();
+};
+
+#endif
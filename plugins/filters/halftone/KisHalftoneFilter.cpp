@@ -7,6 +7,7 @@
  */
 
 #include <QHash>
+#include <QVarLengthArray>
 
 #include <kpluginfactory.h>
 #include <kis_filter_registry.h>
@@ -145,29 +146,18 @@ KisPaintDeviceSP KisHalftoneFilter::makeGeneratorPaintDevice(KisPaintDeviceSP pr
                                                              const KisHalftoneFilterConfiguration *config,
                                                              KoUpdater *progressUpdater) const
 {
+    Q_UNUSED(progressUpdater);
+
     const QString generatorId = config->generatorId(prefix);
     if (generatorId.isEmpty()) {
         return nullptr;
     }
 
-    KisGeneratorSP generator  = KisGeneratorRegistry::instance()->get(generatorId);
-    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(generator, nullptr);
-
     KisFilterConfigurationSP generatorConfiguration = config->generatorConfiguration(prefix);
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(generatorConfiguration, nullptr);
 
-    // Fill the generator device
-    KisPaintDeviceSP generatorDevice = m_grayDevicesCache.getDevice(prototype, KoColorSpaceRegistry::instance()->graya8());
-
-    KisProcessingInformation(generatorDevice, applyRect.topLeft(), KisSelectionSP());
-    generator->generate(
-        KisProcessingInformation(generatorDevice, applyRect.topLeft(),KisSelectionSP()),
-        applyRect.size(),
-        generatorConfiguration,
-        progressUpdater
-    );
-
-    return generatorDevice;
+    // The screen is shared with the other patches, it must not be modified
+    return m_screensCache.screen(generatorId, generatorConfiguration, prototype, applyRect);
 }
 
 bool KisHalftoneFilter::checkUpdaterInterruptedAndSetPercent(KoUpdater *progressUpdater, int percent) const
@@ -186,6 +176,111 @@ bool KisHalftoneFilter::checkUpdaterInterruptedAndSetPercent(KoUpdater *progress
     return false;
 }
 
+namespace {
+
+template <bool invertValues, bool invertResults>
+inline void thresholdValues(const quint8 *values, const qint32 *offsets, int numPixels,
+                            const quint8 *noiseWeightLut, const quint8 *hardnessLut,
+                            quint8 *results)
+{
+    for (int i = 0; i < numPixels; ++i) {
+        const int value = invertValues ? 255 - values[i] : values[i];
+
+        // Combine pixels
+        const int result = qBound(0, value + offsets[i] * noiseWeightLut[value] / 0xFE01, 255);
+
+        // Apply hardness
+        results[i] = invertResults ? 255 - hardnessLut[result] : hardnessLut[result];
+    }
+}
+
+/**
+ * Combines the values of one channel with the screen (GrayA8) a span
+ * of consecutive pixels at a time. The screen is first converted into
+ * the signed offsets of all the pixels of the span, then the values
+ * are thresholded in a branchless loop, so that the compiler can
+ * vectorize the arithmetic around the LUT lookups.
+ */
+class ScreenThreshold
+{
+public:
+    ScreenThreshold(qreal hardness, bool invertValues, bool invertResults)
+        : m_hardnessLut(KisHalftoneFilter::makeHardnessLut(hardness))
+        , m_noiseWeightLut(KisHalftoneFilter::makeNoiseWeightLut(hardness))
+        , m_screenGrayLut(256)
+        , m_screenAlphaLut(256)
+        , m_invertValues(invertValues)
+        , m_invertResults(invertResults)
+    {
+        for (int i = 0; i < 256; ++i) {
+            m_screenGrayLut[i] = i;
+            m_screenAlphaLut[i] = i;
+        }
+    }
+
+    /**
+     * Maps the gray and alpha values of the screen before combining
+     * them with the values (e.g. to convert them into a linear space)
+     */
+    void setScreenLuts(const QVector<quint8> &grayLut, const QVector<quint8> &alphaLut)
+    {
+        m_screenGrayLut = grayLut;
+        m_screenAlphaLut = alphaLut;
+    }
+
+    void apply(const quint8 *screen, const quint8 *values, int numPixels, quint8 *results)
+    {
+        m_offsets.resize(numPixels);
+
+        const quint8 *grayLut = m_screenGrayLut.constData();
+        const quint8 *alphaLut = m_screenAlphaLut.constData();
+        for (int i = 0; i < numPixels; ++i) {
+            m_offsets[i] = (grayLut[screen[2 * i]] - 128) * alphaLut[screen[2 * i + 1]];
+        }
+
+        const quint8 *noiseWeightLut = m_noiseWeightLut.constData();
+        const quint8 *hardnessLut = m_hardnessLut.constData();
+
+        if (m_invertValues && m_invertResults) {
+            thresholdValues<true, true>(values, m_offsets.constData(), numPixels, noiseWeightLut, hardnessLut, results);
+        } else if (m_invertValues) {
+            thresholdValues<true, false>(values, m_offsets.constData(), numPixels, noiseWeightLut, hardnessLut, results);
+        } else if (m_invertResults) {
+            thresholdValues<false, true>(values, m_offsets.constData(), numPixels, noiseWeightLut, hardnessLut, results);
+        } else {
+            thresholdValues<false, false>(values, m_offsets.constData(), numPixels, noiseWeightLut, hardnessLut, results);
+        }
+    }
+
+private:
+    const QVector<quint8> m_hardnessLut;
+    const QVector<quint8> m_noiseWeightLut;
+    QVector<quint8> m_screenGrayLut;
+    QVector<quint8> m_screenAlphaLut;
+    const bool m_invertValues;
+    const bool m_invertResults;
+    QVarLengthArray<qint32, 64> m_offsets;
+};
+
+/**
+ * Calls \p func for every span of consecutive pixels of \p applyRect
+ * with the pixels of \p device and \p screenDevice
+ */
+template <typename Func>
+void processSpans(KisPaintDeviceSP device, KisPaintDeviceSP screenDevice, const QRect &applyRect, Func func)
+{
+    KisSequentialIterator dstIterator(device, applyRect);
+    KisSequentialConstIterator srcIterator(screenDevice, applyRect);
+
+    int numPixels = qMin(dstIterator.nConseqPixels(), srcIterator.nConseqPixels());
+    while (dstIterator.nextPixels(numPixels) && srcIterator.nextPixels(numPixels)) {
+        numPixels = qMin(dstIterator.nConseqPixels(), srcIterator.nConseqPixels());
+        func(dstIterator.rawData(), srcIterator.rawDataConst(), numPixels);
+    }
+}
+
+}
+
 void KisHalftoneFilter::processIntensity(KisPaintDeviceSP device,
                                          const QRect &applyRect,
                                          const KisHalftoneFilterConfiguration *config,
@@ -206,51 +301,40 @@ void KisHalftoneFilter::processIntensity(KisPaintDeviceSP device,
         return;
     }
 
-    // Make the hardness and the noise weight LUT
-    const qreal hardness = config->hardness(prefix) / 100.0;
-    const QVector<quint8> hardnessLut = makeHardnessLut(hardness);
-    const QVector<quint8> noiseWeightLut = makeNoiseWeightLut(hardness);
-
     // Fill the mask device
     KisSelectionSP maskDevice = m_selectionsCache.getSelection();
 
     {
         const bool invert = config->invert(prefix);
+        ScreenThreshold threshold(config->hardness(prefix) / 100.0, false, !invert);
+
+        const KoColorSpace *colorSpace = device->colorSpace();
+        const int pixelSize = colorSpace->pixelSize();
+        QVarLengthArray<quint8, 64> values;
 
         KisSequentialIterator maskIterator(maskDevice->pixelSelection(), applyRect);
-        KisSequentialIterator dstIterator(device, applyRect);
-        KisSequentialIterator srcIterator(generatorDevice, applyRect);
+        KisSequentialConstIterator dstIterator(device, applyRect);
+        KisSequentialConstIterator srcIterator(generatorDevice, applyRect);
 
-        if (!invert) {
-            while (maskIterator.nextPixel() && dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dstGray = device->colorSpace()->intensity8(dstIterator.rawData());
-                int srcGray = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
+        int numPixels = qMin(maskIterator.nConseqPixels(),
+                             qMin(dstIterator.nConseqPixels(), srcIterator.nConseqPixels()));
 
-                // Combine pixels
-                int result = qBound(0, dstGray + (srcGray - 128) * noiseWeightLut[dstGray] * srcAlpha / 0xFE01, 255);
+        while (maskIterator.nextPixels(numPixels) &&
+               dstIterator.nextPixels(numPixels) &&
+               srcIterator.nextPixels(numPixels)) {
 
-                // Apply hardness
-                result = hardnessLut[result];
+            numPixels = qMin(maskIterator.nConseqPixels(),
+                             qMin(dstIterator.nConseqPixels(), srcIterator.nConseqPixels()));
 
-                *maskIterator.rawData() = 255 - result;
+            values.resize(numPixels);
+            const quint8 *dstPixel = dstIterator.rawDataConst();
+            for (int i = 0; i < numPixels; ++i, dstPixel += pixelSize) {
+                values[i] = colorSpace->intensity8(dstPixel);
             }
-        } else {
-            while (maskIterator.nextPixel() && dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dstGray = device->colorSpace()->intensity8(dstIterator.rawData());
-                int srcGray = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
-
-                // Combine pixels
-                int result = qBound(0, dstGray + (srcGray - 128) * noiseWeightLut[dstGray] * srcAlpha / 0xFE01, 255);
 
-                // Apply hardness
-                result = hardnessLut[result];
-
-                *maskIterator.rawData() = result;
-            }
+            // the mask is Alpha8, the results are written directly
+            threshold.apply(srcIterator.rawDataConst(), values.constData(), numPixels, maskIterator.rawData());
         }
-        m_grayDevicesCache.putDevice(generatorDevice);
     }
     if (checkUpdaterInterruptedAndSetPercent(progressUpdater, 50)) {
         return;
@@ -317,97 +401,49 @@ void KisHalftoneFilter::processChannel(KisPaintDeviceSP device,
                                        KoChannelInfo * channelInfo) const
 {
     const int channelPos = channelInfo->pos() / sizeof(ChannelType);
-    // Make the hardness and the noise weight LUT
-    const qreal hardness = config->hardness(prefix) / 100.0;
-    const QVector<quint8> hardnessLut = makeHardnessLut(hardness);
-    const QVector<quint8> noiseWeightLut = makeNoiseWeightLut(hardness);
+    const KoColorSpace *colorSpace = device->colorSpace();
+    const int pixelSize = colorSpace->pixelSize();
+    const ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
+    const ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
 
-    // Fill the device
     const bool invert = config->invert(prefix);
-    KisSequentialIterator dstIterator(device, applyRect);
-    KisSequentialIterator srcIterator(generatorDevice, applyRect);
-
-    const KoColorSpace *colorSpace = device->colorSpace();
+    ScreenThreshold threshold(config->hardness(prefix) / 100.0, !invert, !invert);
 
     if (colorSpace->profile()->isLinear()) {
-        if (!invert) {
-            while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = 255 - device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
-                KoColor c(QColor(src, src, src, srcAlpha), device->colorSpace());
-                src = device->colorSpace()->scaleToU8(c.data(), 0);
-                srcAlpha = device->colorSpace()->scaleToU8(c.data(), device->colorSpace()->alphaPos());
-
-                // Combine pixels
-                int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
-
-                // Apply hardness
-                result = hardnessLut[result];
-
-                ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
-                dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(255 - result, channelMin, channelMax));
-            }
-        } else {
-            while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
-                KoColor c(QColor(src, src, src, srcAlpha), device->colorSpace());
-                src = device->colorSpace()->scaleToU8(c.data(), 0);
-                srcAlpha = device->colorSpace()->scaleToU8(c.data(), device->colorSpace()->alphaPos());
-
-                // Combine pixels
-                int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
-
-                // Apply hardness
-                result = hardnessLut[result];
-
-                ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
-                dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(result, channelMin, channelMax));
-            }
+        // The screen is converted into the color space of the device.
+        // The gray and alpha values are converted independently, so
+        // the conversion of every possible value is cached.
+        QVector<quint8> grayLut(256);
+        QVector<quint8> alphaLut(256);
+        for (int i = 0; i < 256; ++i) {
+            KoColor gray(QColor(i, i, i), colorSpace);
+            KoColor alpha(QColor(0, 0, 0, i), colorSpace);
+            grayLut[i] = colorSpace->scaleToU8(gray.data(), 0);
+            alphaLut[i] = colorSpace->scaleToU8(alpha.data(), colorSpace->alphaPos());
         }
-    } else {
-        if (!invert) {
-            while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = 255 - device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
-
-                // Combine pixels
-                int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
-
-                // Apply hardness
-                result = hardnessLut[result];
-
-                ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
-                dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(255 - result, channelMin, channelMax));
-            }
-        } else {
-            while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-                int dst = device->colorSpace()->scaleToU8(dstIterator.rawData(), channelPos);
-                int src = srcIterator.rawData()[0];
-                int srcAlpha = srcIterator.rawData()[1];
+        threshold.setScreenLuts(grayLut, alphaLut);
+    }
 
-                // Combine pixels
-                int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
+    // Fill the device
+    QVarLengthArray<quint8, 64> values;
 
-                // Apply hardness
-                result = hardnessLut[result];
+    processSpans(device, generatorDevice, applyRect,
+        [&] (quint8 *pixels, const quint8 *screen, int numPixels) {
+            values.resize(numPixels);
 
-                ChannelType *dstPixel = reinterpret_cast<ChannelType*>(dstIterator.rawData());
-                ChannelType channelMin = static_cast<ChannelType>(channelInfo->getUIMin());
-                ChannelType channelMax = static_cast<ChannelType>(channelInfo->getUIMax());
-                dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(result, channelMin, channelMax));
+            quint8 *pixel = pixels;
+            for (int i = 0; i < numPixels; ++i, pixel += pixelSize) {
+                values[i] = colorSpace->scaleToU8(pixel, channelPos);
             }
-        }
-    }
+
+            threshold.apply(screen, values.constData(), numPixels, values.data());
+
+            pixel = pixels;
+            for (int i = 0; i < numPixels; ++i, pixel += pixelSize) {
+                ChannelType *dstPixel = reinterpret_cast<ChannelType*>(pixel);
+                dstPixel[channelPos] = static_cast<ChannelType>(mapU8ToRange(values[i], channelMin, channelMax));
+            }
+        });
 }
 
 void KisHalftoneFilter::processChannels(KisPaintDeviceSP device,
@@ -483,8 +519,6 @@ void KisHalftoneFilter::processChannels(KisPaintDeviceSP device,
         }
         }
 
-        m_grayDevicesCache.putDevice(generatorDevices[i]);
-
         if (checkUpdaterInterruptedAndSetPercent(progressUpdater, progressUpdater->progress() + progressStep)) {
             return;
         }
@@ -515,46 +549,30 @@ void KisHalftoneFilter::processAlpha(KisPaintDeviceSP device,
         return;
     }
 
-    // Make the hardness and the noise weight LUT
-    const qreal hardness = config->hardness(prefix) / 100.0;
-    const QVector<quint8> hardnessLut = makeHardnessLut(hardness);
-    const QVector<quint8> noiseWeightLut = makeNoiseWeightLut(hardness);
-
     // Fill the device
     const bool invert = config->invert(prefix);
-    KisSequentialIterator dstIterator(device, applyRect);
-    KisSequentialIterator srcIterator(generatorDevice, applyRect);
-
-    if (!invert) {
-        while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-            int dst = 255 - device->colorSpace()->opacityU8(dstIterator.rawData());
-            int src = srcIterator.rawData()[0];
-            int srcAlpha = srcIterator.rawData()[1];
+    ScreenThreshold threshold(config->hardness(prefix) / 100.0, !invert, !invert);
 
-            // Combine pixels
-            int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
+    const KoColorSpace *colorSpace = device->colorSpace();
+    const int pixelSize = colorSpace->pixelSize();
+    QVarLengthArray<quint8, 64> values;
 
-            // Apply hardness
-            result = hardnessLut[result];
+    processSpans(device, generatorDevice, applyRect,
+        [&] (quint8 *pixels, const quint8 *screen, int numPixels) {
+            values.resize(numPixels);
 
-            device->colorSpace()->setOpacity(dstIterator.rawData(), static_cast<quint8>(255 - result), 1);
-        }
-    } else {
-        while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-            int dst = device->colorSpace()->opacityU8(dstIterator.rawData());
-            int src = srcIterator.rawData()[0];
-            int srcAlpha = srcIterator.rawData()[1];
-
-            // Combine pixels
-            int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] * srcAlpha / 0xFE01, 255);
+            quint8 *pixel = pixels;
+            for (int i = 0; i < numPixels; ++i, pixel += pixelSize) {
+                values[i] = colorSpace->opacityU8(pixel);
+            }
 
-            // Apply hardness
-            result = hardnessLut[result];
+            threshold.apply(screen, values.constData(), numPixels, values.data());
 
-            device->colorSpace()->setOpacity(dstIterator.rawData(), static_cast<quint8>(result), 1);
-        }
-    }
-    m_grayDevicesCache.putDevice(generatorDevice);
+            pixel = pixels;
+            for (int i = 0; i < numPixels; ++i, pixel += pixelSize) {
+                colorSpace->setOpacity(pixel, values[i], 1);
+            }
+        });
 
     if (checkUpdaterInterruptedAndSetPercent(progressUpdater, 100)) {
         return;
@@ -581,44 +599,34 @@ void KisHalftoneFilter::processMask(KisPaintDeviceSP device,
         return;
     }
 
-    // Make the hardness and the noise weight LUT
-    const qreal hardness = config->hardness(prefix) / 100.0;
-    const QVector<quint8> hardnessLut = makeHardnessLut(hardness);
-    const QVector<quint8> noiseWeightLut = makeNoiseWeightLut(hardness);
-
     // Fill the device
     const bool invert = config->invert(prefix);
-    KisSequentialIterator dstIterator(device, applyRect);
-    KisSequentialIterator srcIterator(generatorDevice, applyRect);
+    ScreenThreshold threshold(config->hardness(prefix) / 100.0, !invert, !invert);
 
-    if (!invert) {
-        while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-            int dst = 255 - *dstIterator.rawData();
-            int src = *srcIterator.rawData();
+    // The alpha of the screen is not taken into account for the masks
+    QVector<quint8> grayLut(256);
+    for (int i = 0; i < 256; ++i) {
+        grayLut[i] = i;
+    }
+    threshold.setScreenLuts(grayLut, QVector<quint8>(256, 255));
 
-            // Combine pixels
-            int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] / 0xFF, 255);
+    const int pixelSize = device->colorSpace()->pixelSize();
+    QVarLengthArray<quint8, 64> values;
 
-            // Apply hardness
-            result = hardnessLut[result];
+    processSpans(device, generatorDevice, applyRect,
+        [&] (quint8 *pixels, const quint8 *screen, int numPixels) {
+            values.resize(numPixels);
 
-            *dstIterator.rawData() = static_cast<quint8>(255 - result);
-        }
-    } else {
-        while (dstIterator.nextPixel() && srcIterator.nextPixel()) {
-            int dst = *dstIterator.rawData();
-            int src = *srcIterator.rawData();
-
-            // Combine pixels
-            int result = qBound(0, dst + (src - 128) * noiseWeightLut[dst] / 0xFF, 255);
+            for (int i = 0; i < numPixels; ++i) {
+                values[i] = pixels[i * pixelSize];
+            }
 
-            // Apply hardness
-            result = hardnessLut[result];
+            threshold.apply(screen, values.constData(), numPixels, values.data());
 
-            *dstIterator.rawData() =  static_cast<quint8>(result);
-        }
-    }
-    m_grayDevicesCache.putDevice(generatorDevice);
+            for (int i = 0; i < numPixels; ++i) {
+                pixels[i * pixelSize] = values[i];
+            }
+        });
 
     if (checkUpdaterInterruptedAndSetPercent(progressUpdater, 100)) {
         return;
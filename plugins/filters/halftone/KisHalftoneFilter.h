@@ -17,6 +17,7 @@
 #include <kis_cached_paint_device.h>
 
 #include "KisHalftoneFilterConfiguration.h"
+#include "KisHalftoneScreenCache.h"
 
 class KisConfigWidget;
 
@@ -46,14 +47,14 @@ public:
     KisFilterConfigurationSP factoryConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
     KisConfigWidget *createConfigurationWidget(QWidget *parent, const KisPaintDeviceSP dev, bool useForMasks) const override;
 
+    static QVector<quint8> makeHardnessLut(qreal hardness);
+    static QVector<quint8> makeNoiseWeightLut(qreal hardness);
+
 private:
     mutable KisCachedSelection m_selectionsCache;
-    mutable KisCachedPaintDevice m_grayDevicesCache;
     mutable KisCachedPaintDevice m_genericDevicesCache;
+    mutable KisHalftoneScreenCache m_screensCache;
 
-    static QVector<quint8> makeHardnessLut(qreal hardness);
-    static QVector<quint8> makeNoiseWeightLut(qreal hardness);
-    
     static inline quint8 mapU8ToRange(quint8 value, quint8 new_min, quint8 new_max) {
         Q_UNUSED(new_min);
         Q_UNUSED(new_max);
@@ -0,0 +1,168 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisHalftoneScreenCache.h"
+
+#include <QMutexLocker>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <generator/kis_generator.h>
+#include <generator/kis_generator_registry.h>
+#include <kis_filter_configuration.h>
+#include <kis_paint_device.h>
+#include <kis_painter.h>
+#include <kis_processing_information.h>
+#include <kis_selection.h>
+
+namespace {
+
+inline bool regionCovers(const QRegion &region, const QRect &rect)
+{
+    return (QRegion(rect) - region).isEmpty();
+}
+
+inline qint64 regionArea(const QRegion &region)
+{
+    qint64 area = 0;
+    for (const QRect &rc : region) {
+        area += qint64(rc.width()) * rc.height();
+    }
+    return area;
+}
+
+}
+
+KisHalftoneScreenCache::KisHalftoneScreenCache(qint64 maxBytes)
+    : m_maxBytes(maxBytes)
+{
+}
+
+KisPaintDeviceSP KisHalftoneScreenCache::screen(const QString &generatorId,
+                                                const KisFilterConfigurationSP generatorConfiguration,
+                                                KisPaintDeviceSP prototype,
+                                                const QRect &rect)
+{
+    KisGeneratorSP generator = KisGeneratorRegistry::instance()->get(generatorId);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(generator, nullptr);
+
+    /**
+     * Some generators depend on the image bounds and all of them
+     * depend on the level of detail of the device
+     */
+    const QRect bounds = prototype->defaultBounds()->bounds();
+    const QString key =
+        QString("%1\n%2\n%3\n%4,%5,%6,%7")
+            .arg(generatorId)
+            .arg(generatorConfiguration->toXML())
+            .arg(prototype->defaultBounds()->currentLevelOfDetail())
+            .arg(bounds.x()).arg(bounds.y()).arg(bounds.width()).arg(bounds.height());
+
+    return screen(key, prototype, rect,
+        [generator, generatorConfiguration] (KisPaintDeviceSP device, const QRect &rc) {
+            generator->generate(
+                KisProcessingInformation(device, rc.topLeft(), KisSelectionSP()),
+                rc.size(),
+                generatorConfiguration,
+                nullptr
+            );
+        });
+}
+
+KisPaintDeviceSP KisHalftoneScreenCache::screen(const QString &key,
+                                                KisPaintDeviceSP prototype,
+                                                const QRect &rect,
+                                                RenderFunction render)
+{
+    {
+        QMutexLocker l(&m_mutex);
+
+        dropUnusedEntries();
+
+        for (int i = 0; i < m_entries.size(); i++) {
+            if (m_entries[i].key == key) {
+                m_entries.move(i, 0);
+
+                if (regionCovers(m_entries.first().renderedRegion, rect)) {
+                    return m_entries.first().device;
+                }
+                break;
+            }
+        }
+    }
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->graya8();
+
+    // the rendering may be long, so it is done without holding the lock
+    KisPaintDeviceSP device = new KisPaintDevice(cs);
+    device->setDefaultBounds(prototype->defaultBounds());
+    render(device, rect);
+
+    {
+        QMutexLocker l(&m_mutex);
+
+        int index = 0;
+        while (index < m_entries.size() && m_entries[index].key != key) {
+            index++;
+        }
+
+        if (index < m_entries.size()) {
+            m_entries.move(index, 0);
+        } else {
+            /**
+             * The cached device doesn't keep the default bounds of the
+             * prototype, otherwise the owner would never be destroyed
+             */
+            Entry entry;
+            entry.key = key;
+            entry.device = new KisPaintDevice(cs);
+            entry.owner = prototype->defaultBounds();
+            m_entries.prepend(entry);
+        }
+
+        Entry &entry = m_entries.first();
+
+        /**
+         * Only the areas that are still missing are copied, the
+         * rendered ones may be being read by the other threads
+         */
+        const QRegion missingRegion = QRegion(rect) - entry.renderedRegion;
+        for (const QRect &rc : missingRegion) {
+            KisPainter::copyAreaOptimized(rc.topLeft(), device, entry.device, rc);
+        }
+        entry.renderedRegion += rect;
+
+        const qint64 bytes = regionArea(entry.renderedRegion) * cs->pixelSize();
+        m_usedBytes += bytes - entry.bytes;
+        entry.bytes = bytes;
+
+        while (m_usedBytes > m_maxBytes && !m_entries.isEmpty()) {
+            m_usedBytes -= m_entries.last().bytes;
+            m_entries.removeLast();
+        }
+    }
+
+    return device;
+}
+
+qint64 KisHalftoneScreenCache::usedBytes()
+{
+    QMutexLocker l(&m_mutex);
+    dropUnusedEntries();
+    return m_usedBytes;
+}
+
+void KisHalftoneScreenCache::dropUnusedEntries()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (!it->owner.isValid()) {
+            m_usedBytes -= it->bytes;
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_HALFTONE_SCREEN_CACHE_H
+#define KIS_HALFTONE_SCREEN_CACHE_H
+
+#include <functional>
+
+#include <QList>
+#include <QMutex>
+#include <QRegion>
+#include <QString>
+
+#include <kis_types.h>
+#include <kis_default_bounds_base.h>
+
+/**
+ * @brief Keeps the screens rendered by the generators of the halftone filter
+ *
+ * The screen depends only on the generator configuration and the
+ * position, but not on the pixels being filtered. So when a halftone
+ * filter mask is updated after an edit underneath, the screen of the
+ * dirty rect has usually been rendered already. The cache keeps a
+ * GrayA8 device per generator configuration with all the areas that
+ * have been rendered so far.
+ *
+ * The total size of the rendered areas is limited by the memory budget
+ * passed to the constructor, the least recently used screens are dropped
+ * first. A screen is also dropped as soon as the default bounds of the
+ * device it was rendered for are destroyed, i.e. when the layer or the
+ * whole document is closed.
+ *
+ * The cache is thread-safe, the patches of one filter run can request
+ * their screens concurrently.
+ */
+class KisHalftoneScreenCache
+{
+public:
+    using RenderFunction = std::function<void(KisPaintDeviceSP device, const QRect &rect)>;
+
+    static const qint64 defaultMaxBytes = 128 * 1024 * 1024;
+
+    KisHalftoneScreenCache(qint64 maxBytes = defaultMaxBytes);
+
+    /**
+     * @return a GrayA8 device with the screen of \p generatorId with
+     *         \p generatorConfiguration rendered over \p rect. The
+     *         device may be shared with other threads, so it must be
+     *         treated as read-only. Returns null if the generator
+     *         doesn't exist.
+     */
+    KisPaintDeviceSP screen(const QString &generatorId,
+                            const KisFilterConfigurationSP generatorConfiguration,
+                            KisPaintDeviceSP prototype,
+                            const QRect &rect);
+
+    /**
+     * A generic version of the function above. \p render is called to
+     * render the screen identified by \p key over the requested rect
+     * into a GrayA8 device with the default bounds of \p prototype,
+     * if the rect has not been rendered yet.
+     */
+    KisPaintDeviceSP screen(const QString &key,
+                            KisPaintDeviceSP prototype,
+                            const QRect &rect,
+                            RenderFunction render);
+
+    /**
+     * @return the number of bytes taken by the screens in the cache
+     */
+    qint64 usedBytes();
+
+private:
+    struct Entry {
+        QString key;
+        KisPaintDeviceSP device;
+        QRegion renderedRegion;
+        qint64 bytes {0};
+        KisWeakSharedPtr<KisDefaultBoundsBase> owner;
+    };
+
+    void dropUnusedEntries();
+
+    const qint64 m_maxBytes;
+    qint64 m_usedBytes {0};
+
+    QMutex m_mutex;
+    QList<Entry> m_entries;
+};
+
+#endif
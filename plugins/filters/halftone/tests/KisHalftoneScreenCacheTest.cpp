@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisHalftoneScreenCacheTest.h"
+
+#include <simpletest.h>
+
+#include <KoColorSpaceRegistry.h>
+#include <kis_paint_device.h>
+#include <kis_sequential_iterator.h>
+
+#include "../KisHalftoneScreenCache.h"
+
+namespace {
+
+inline quint8 screenValue(int x, int y, int seed)
+{
+    return quint8((x * 7 + y * 13 + seed) & 0xff);
+}
+
+/**
+ * Renders a pattern that depends on the position only, and remembers
+ * all the rects it has been asked to render
+ */
+struct TestRenderer
+{
+    TestRenderer(int seed) : seed(seed) {}
+
+    KisHalftoneScreenCache::RenderFunction function() {
+        return [this] (KisPaintDeviceSP device, const QRect &rect) {
+            renderedRects << rect;
+
+            KisSequentialIterator it(device, rect);
+            while (it.nextPixel()) {
+                quint8 *pixel = it.rawData();
+                pixel[0] = screenValue(it.x(), it.y(), seed);
+                pixel[1] = 255;
+            }
+        };
+    }
+
+    int seed;
+    QVector<QRect> renderedRects;
+};
+
+bool checkScreen(KisPaintDeviceSP device, const QRect &rect, int seed)
+{
+    KisSequentialConstIterator it(device, rect);
+    while (it.nextPixel()) {
+        const quint8 *pixel = it.rawDataConst();
+        if (pixel[0] != screenValue(it.x(), it.y(), seed) || pixel[1] != 255) {
+            qWarning() << "Wrong screen pixel at" << it.x() << it.y()
+                       << "expected" << screenValue(it.x(), it.y(), seed)
+                       << "got" << pixel[0] << pixel[1];
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void KisHalftoneScreenCacheTest::testPartialRegionReuse()
+{
+    KisPaintDeviceSP prototype = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    KisHalftoneScreenCache cache;
+    TestRenderer renderer(1);
+
+    const QRect rect1(0, 0, 64, 64);
+    QVERIFY(checkScreen(cache.screen("a", prototype, rect1, renderer.function()), rect1, 1));
+    QCOMPARE(renderer.renderedRects, QVector<QRect>({rect1}));
+
+    // a part of the rendered area is reused
+    const QRect rect2(16, 16, 32, 32);
+    QVERIFY(checkScreen(cache.screen("a", prototype, rect2, renderer.function()), rect2, 1));
+    QCOMPARE(renderer.renderedRects.size(), 1);
+
+    // the area is only partially rendered, so it is rendered again
+    const QRect rect3(32, 0, 64, 64);
+    QVERIFY(checkScreen(cache.screen("a", prototype, rect3, renderer.function()), rect3, 1));
+    QCOMPARE(renderer.renderedRects.size(), 2);
+    QCOMPARE(renderer.renderedRects.last(), rect3);
+
+    // now the union of the two rendered rects is covered
+    const QRect rect4 = rect1 | rect3;
+    QVERIFY(checkScreen(cache.screen("a", prototype, rect4, renderer.function()), rect4, 1));
+    QCOMPARE(renderer.renderedRects.size(), 2);
+
+    // another configuration doesn't reuse the screen
+    TestRenderer otherRenderer(2);
+    QVERIFY(checkScreen(cache.screen("b", prototype, rect2, otherRenderer.function()), rect2, 2));
+    QCOMPARE(otherRenderer.renderedRects, QVector<QRect>({rect2}));
+
+    // ...and doesn't invalidate the first one
+    QVERIFY(checkScreen(cache.screen("a", prototype, rect4, renderer.function()), rect4, 1));
+    QCOMPARE(renderer.renderedRects.size(), 2);
+
+    QCOMPARE(cache.usedBytes(), qint64(rect4.width() * rect4.height() + rect2.width() * rect2.height()) * 2);
+}
+
+void KisHalftoneScreenCacheTest::testDropWithOwner()
+{
+    KisPaintDeviceSP prototype1 = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    KisPaintDeviceSP prototype2 = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    KisHalftoneScreenCache cache;
+
+    const QRect rect(0, 0, 64, 64);
+
+    TestRenderer renderer1(1);
+    cache.screen("a", prototype1, rect, renderer1.function());
+    TestRenderer renderer2(2);
+    cache.screen("b", prototype2, rect, renderer2.function());
+
+    QCOMPARE(cache.usedBytes(), qint64(rect.width() * rect.height()) * 2 * 2);
+
+    // the screen rendered for a device is dropped together with the device
+    prototype1 = 0;
+    QCOMPARE(cache.usedBytes(), qint64(rect.width() * rect.height()) * 2);
+
+    cache.screen("b", prototype2, rect, renderer2.function());
+    QCOMPARE(renderer2.renderedRects.size(), 1);
+
+    prototype1 = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    cache.screen("a", prototype1, rect, renderer1.function());
+    QCOMPARE(renderer1.renderedRects.size(), 2);
+
+    prototype1 = 0;
+    prototype2 = 0;
+    QCOMPARE(cache.usedBytes(), qint64(0));
+}
+
+void KisHalftoneScreenCacheTest::testMemoryBudget()
+{
+    KisPaintDeviceSP prototype = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+
+    const QRect rect(0, 0, 64, 64);
+    const qint64 screenBytes = rect.width() * rect.height() * 2;
+
+    // only two screens fit into the cache
+    KisHalftoneScreenCache cache(2 * screenBytes);
+
+    TestRenderer renderer1(1);
+    TestRenderer renderer2(2);
+    TestRenderer renderer3(3);
+
+    cache.screen("a", prototype, rect, renderer1.function());
+    cache.screen("b", prototype, rect, renderer2.function());
+    QCOMPARE(cache.usedBytes(), 2 * screenBytes);
+
+    // "a" becomes the most recently used one
+    cache.screen("a", prototype, rect, renderer1.function());
+    QCOMPARE(renderer1.renderedRects.size(), 1);
+
+    // "b" is dropped to free the memory for "c"
+    cache.screen("c", prototype, rect, renderer3.function());
+    QCOMPARE(cache.usedBytes(), 2 * screenBytes);
+
+    cache.screen("a", prototype, rect, renderer1.function());
+    QCOMPARE(renderer1.renderedRects.size(), 1);
+
+    cache.screen("b", prototype, rect, renderer2.function());
+    QCOMPARE(renderer2.renderedRects.size(), 2);
+
+    // a screen bigger than the whole budget is returned, but not kept
+    const QRect bigRect(0, 0, 128, 128);
+    TestRenderer bigRenderer(4);
+    QVERIFY(checkScreen(cache.screen("d", prototype, bigRect, bigRenderer.function()), bigRect, 4));
+    QVERIFY(cache.usedBytes() <= 2 * screenBytes);
+
+    cache.screen("d", prototype, bigRect, bigRenderer.function());
+    QCOMPARE(bigRenderer.renderedRects.size(), 2);
+}
+
+SIMPLE_TEST_MAIN(KisHalftoneScreenCacheTest)
@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_HALFTONE_SCREEN_CACHE_TEST_H
+#define KIS_HALFTONE_SCREEN_CACHE_TEST_H
+
+#include <simpletest.h>
+
+class KisHalftoneScreenCacheTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testPartialRegionReuse();
+    void testDropWithOwner();
+    void testMemoryBudget();
+};
+
+#endif
@@ -91,6 +91,17 @@ KisIndexColorTransformation::KisIndexColorTransformation(IndexColorPalette palet
 {
     m_palette = palette;
 
+    QVector<quint16> coordinates;
+    Q_FOREACH (const LabColor &color, m_palette.m_colors) {
+        coordinates << color.L << color.a << color.b;
+    }
+
+    // maximizing the similarity of the palette is the same as minimizing the weighted distance
+    m_index = KoColorQuantizationIndex::fromCache(coordinates, 1,
+                                                  QVector3D(m_palette.similarityFactors.L,
+                                                            m_palette.similarityFactors.a,
+                                                            m_palette.similarityFactors.b));
+
     static const qreal max = KoColorSpaceMathsTraits<quint16>::max;
     if(alphaSteps > 0)
     {
@@ -111,23 +122,33 @@ void KisIndexColorTransformation::transform(const quint8* src, quint8* dst, qint
         return;
     }
 
-    union
-    {
-        quint16 laba[4];
-        LabColor lab;
-    } clr;
-    while (nPixels--)
-    {
-        m_colorSpace->toLabA16(src, reinterpret_cast<quint8 *>(clr.laba), 1);
-        clr.lab = m_palette.getNearestIndex(clr.lab);
-        if(m_alphaStep)
-        {
-            quint16 amod = clr.laba[3] % m_alphaStep;
-            clr.laba[3] = clr.laba[3] + (amod > m_alphaHalfStep ? m_alphaStep - amod : -amod);
+    const int batchSize = 256;
+    quint16 laba[4 * batchSize];
+    int indices[batchSize];
+
+    while (nPixels > 0) {
+        const int numPixels = qMin(nPixels, batchSize);
+
+        m_colorSpace->toLabA16(src, reinterpret_cast<quint8 *>(laba), numPixels);
+        m_index->nearestBatch(laba, 4, numPixels, indices);
+
+        for (int i = 0; i < numPixels; ++i) {
+            quint16 *clr = laba + 4 * i;
+            const LabColor &nearest = m_palette.m_colors[indices[i]];
+            clr[0] = nearest.L;
+            clr[1] = nearest.a;
+            clr[2] = nearest.b;
+            if(m_alphaStep)
+            {
+                quint16 amod = clr[3] % m_alphaStep;
+                clr[3] = clr[3] + (amod > m_alphaHalfStep ? m_alphaStep - amod : -amod);
+            }
         }
-        m_colorSpace->fromLabA16(reinterpret_cast<quint8 *>(clr.laba), dst, 1);
-        src += m_psize;
-        dst += m_psize;
+
+        m_colorSpace->fromLabA16(reinterpret_cast<quint8 *>(laba), dst, numPixels);
+        src += numPixels * m_psize;
+        dst += numPixels * m_psize;
+        nPixels -= numPixels;
     }
 }
 
@@ -14,6 +14,7 @@
 #include "kis_oilpaint_filter.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <vector>
 
 #include <QPoint>
@@ -39,6 +40,8 @@
 #include <kis_paint_device.h>
 #include "widgets/kis_multi_integer_filter_widget.h"
 #include <KisGlobalResourcesInterface.h>
+#include <KisSlidingWindowHistogram.h>
+#include <krita_utils.h>
 
 
 KisOilPaintFilter::KisOilPaintFilter() : KisFilter(id(), FiltersCategoryArtisticId, i18n("&Oilpaint..."))
@@ -63,126 +66,161 @@ void KisOilPaintFilter::processImpl(KisPaintDeviceSP device,
     OilPaint(device, device, applyRect, brushSize, smooth, progressUpdater);
 }
 
-// This method have been ported from Pieter Z. Voloshyn algorithm code.
+namespace {
 
-/* Function to apply the OilPaint effect.
- *
- * data             => The image data in RGBA mode.
- * w                => Width of image.
- * h                => Height of image.
- * BrushSize        => Brush size.
- * Smoothness       => Smooth value.
- *
- * Theory           => Using MostFrequentColor function we take the main color in
- *                     a matrix and simply write at the original position.
+/**
+ * Keeps the sum of the normalized channels of the pixels in every
+ * intensity bin of the window
  */
-
-void KisOilPaintFilter::OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
-                                 int BrushSize, int Smoothness, KoUpdater* progressUpdater) const
+struct OilPaintPolicy
 {
-    KisSequentialConstIteratorProgress it(src, applyRect, progressUpdater);
-    KisSequentialIterator dstIt(dst, applyRect);
-
-    while (it.nextPixel() && dstIt.nextPixel()) {
-        MostFrequentColor(src, dstIt.rawData(), applyRect, it.x(), it.y(), BrushSize, Smoothness);
+    OilPaintPolicy(const KoColorSpace *cs, const QRect &rc, const QRect &dataRect,
+                   const QVector<float> &channels, const QVector<qreal> &opacities,
+                   int numBins, quint8 *dstData)
+        : cs(cs)
+        , channelCount(cs->channelCount())
+        , pixelSize(cs->pixelSize())
+        , rc(rc)
+        , dataRect(dataRect)
+        , channels(channels.constData())
+        , opacities(opacities.constData())
+        , sums(numBins * channelCount)
+        , pixel(channelCount)
+        , dstData(dstData)
+    {
     }
-}
-
-// This method has been ported from Pieter Z. Voloshyn's algorithm code in Digikam.
-
-/* Function to determine the most frequent color in a matrix
- *
- * Bits             => Bits array
- * Width            => Image width
- * Height           => Image height
- * X                => Position horizontal
- * Y                => Position vertical
- * Radius           => Is the radius of the matrix to be analyzed
- * Intensity        => Intensity to calculate
- *
- * Theory           => This function creates a matrix with the analyzed pixel in
- *                     the center of this matrix and find the most frequent color
- */
 
-void KisOilPaintFilter::MostFrequentColor(KisPaintDeviceSP src, quint8* dst, const QRect& /*bounds*/, int X, int Y, int Radius, int Intensity) const
-{
-    uint I;
-
-    double Scale = Intensity / 255.0;
-
-    // Alloc some arrays to be used
-    uchar *IntensityCount = new uchar[(Intensity + 1)];
+    void reset()
+    {
+        std::fill(sums.begin(), sums.end(), 0.0f);
+    }
 
-    const KoColorSpace* cs = src->colorSpace();
+    inline void add(int dataIndex, int bin)
+    {
+        float *sum = sums.data() + bin * channelCount;
+        const float *channel = channels + dataIndex * channelCount;
 
-    QVector<float> channel(cs->channelCount());
-    QVector<float>* AverageChannels = new QVector<float>[(Intensity + 1)];
+        for (int i = 0; i < channelCount; i++) {
+            sum[i] += channel[i];
+        }
+    }
 
-    // Erase the array
-    memset(IntensityCount, 0, (Intensity + 1) * sizeof(uchar));
+    inline void remove(int dataIndex, int bin)
+    {
+        float *sum = sums.data() + bin * channelCount;
+        const float *channel = channels + dataIndex * channelCount;
 
-    int startx = X - Radius;
-    int starty = Y - Radius;
-    int width = (2 * Radius) + 1;
-    int height = (2 * Radius) + 1;
+        for (int i = 0; i < channelCount; i++) {
+            sum[i] -= channel[i];
+        }
+    }
 
-    qreal middlePointAlpha = 1;
+    void writePixel(int x, int y, const KisSlidingWindowHistogram &histogram)
     {
+        quint8 *dst = dstData + ((y - rc.top()) * rc.width() + x - rc.left()) * pixelSize;
+
         // if the current pixel is transparent, the result must be transparent, too.
-        KisSequentialConstIterator middlePointIt(src, QRect(X, Y, 1, 1));
-        middlePointIt.nextPixel();
-        middlePointAlpha = cs->opacityF(middlePointIt.oldRawData());
-    }
+        const qreal middlePointAlpha =
+            opacities[(y - dataRect.top()) * dataRect.width() + x - dataRect.left()];
 
+        const int bin = middlePointAlpha > 0 ? histogram.mostFrequentBin() : -1;
 
-    KisSequentialConstIterator srcIt(src, QRect(startx, starty, width, height));
-    while (middlePointAlpha > 0 && srcIt.nextPixel()) {
+        if (bin >= 0) {
+            const int count = histogram.count(bin);
+            const float *sum = sums.constData() + bin * channelCount;
 
-        cs->normalisedChannelsValue(srcIt.oldRawData(), channel);
+            for (int i = 0; i < channelCount; i++) {
+                pixel[i] = sum[i] / count;
+            }
 
-        if (cs->opacityU8(srcIt.oldRawData()) == 0) {
-            // if the pixel is transparent, it's not going to provide any useful information
-            continue;
+            cs->fromNormalisedChannelsValue(dst, pixel);
+            cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
+        } else {
+            memset(dst, 0, pixelSize);
+            cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
         }
+    }
 
-        I = (uint)(cs->intensity8(srcIt.oldRawData()) * Scale);
+    const KoColorSpace *cs;
+    const int channelCount;
+    const int pixelSize;
+    const QRect rc;
+    const QRect dataRect;
+    const float *channels;
+    const qreal *opacities;
+    QVector<float> sums;
+    QVector<float> pixel;
+    quint8 *dstData;
+};
 
-        IntensityCount[I]++;
+}
 
-        if (IntensityCount[I] == 1) {
-            AverageChannels[I] = channel;
-        } else {
-            for (int i = 0; i < channel.size(); i++) {
-                AverageChannels[I][i] += channel[i];
-            }
-        }
-    }
+// This method have been ported from Pieter Z. Voloshyn algorithm code.
 
-    I = 0;
-    int MaxInstance = 0;
+/* Function to apply the OilPaint effect.
+ *
+ * BrushSize        => Brush size.
+ * Smoothness       => Smooth value.
+ *
+ * Theory           => Every pixel is replaced with the average color of the
+ *                     most frequent intensity in the matrix around it.
+ *
+ * The histogram of intensities of the matrix is updated incrementally
+ * while the matrix moves along the row (see KisSlidingWindowHistogram)
+ * and the rows are processed in parallel strips.
+ */
 
-    for (int i = 0 ; i <= Intensity ; ++i) {
-        if (IntensityCount[i] > MaxInstance) {
-            I = i;
-            MaxInstance = IntensityCount[i];
-        }
-    }
+void KisOilPaintFilter::OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
+                                 int BrushSize, int Smoothness, KoUpdater* progressUpdater) const
+{
+    const KoColorSpace* cs = src->colorSpace();
+    const int pixelSize = cs->pixelSize();
+    const int channelCount = cs->channelCount();
+    const double Scale = Smoothness / 255.0;
+
+    /**
+     * The filter is applied in-place, so the strips read the original
+     * pixels from a copy-on-write clone of the source device
+     */
+    KisPaintDeviceSP source = new KisPaintDevice(*src);
+
+    KritaUtils::runOnRowStrips(applyRect,
+        [&] (const QRect &rc) {
+            const QRect dataRect = kisGrowRect(rc, BrushSize);
+            const int numDataPixels = dataRect.width() * dataRect.height();
+
+            QVector<quint8> srcData(numDataPixels * pixelSize);
+            source->readBytes(srcData.data(), dataRect);
+
+            QVector<int> bins(numDataPixels);
+            QVector<float> channels(numDataPixels * channelCount);
+            QVector<qreal> opacities(numDataPixels);
+            QVector<float> channel(channelCount);
+
+            const quint8 *srcPixel = srcData.constData();
+            for (int i = 0; i < numDataPixels; i++, srcPixel += pixelSize) {
+                opacities[i] = cs->opacityF(srcPixel);
+
+                // if the pixel is transparent, it's not going to provide any useful information
+                if (cs->opacityU8(srcPixel) == 0) {
+                    bins[i] = -1;
+                    continue;
+                }
+
+                bins[i] = int(cs->intensity8(srcPixel) * Scale);
+
+                cs->normalisedChannelsValue(srcPixel, channel);
+                std::copy(channel.begin(), channel.end(), channels.begin() + i * channelCount);
+            }
 
-    if (MaxInstance != 0) {
-        channel = AverageChannels[I];
-        for (int i = 0; i < channel.size(); i++) {
-            channel[i] /= MaxInstance;
-        }
-        cs->fromNormalisedChannelsValue(dst, channel);
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
-    } else {
-        memset(dst, 0, cs->pixelSize());
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
-    }
+            QVector<quint8> dstData(rc.width() * rc.height() * pixelSize);
 
+            KisSlidingWindowHistogram histogram(Smoothness + 1);
+            OilPaintPolicy policy(cs, rc, dataRect, channels, opacities, Smoothness + 1, dstData.data());
+            histogram.slideAlongRows(rc, BrushSize, dataRect, bins.constData(), policy);
 
-    delete [] IntensityCount;        // free all the arrays
-    delete [] AverageChannels;
+            dst->writeBytes(dstData.constData(), rc);
+        }, progressUpdater);
 }
 
 QRect KisOilPaintFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int /*lod*/) const
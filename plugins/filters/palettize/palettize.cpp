@@ -15,7 +15,6 @@
 #include <kis_filter_configuration.h>
 #include <kis_filter_category_ids.h>
 #include <KoUpdater.h>
-#include <KisSequentialIteratorProgress.h>
 #include <KisResourceItemChooser.h>
 #include <KoColorSet.h>
 #include <KoPattern.h>
@@ -23,6 +22,9 @@
 #include <KisDitherUtil.h>
 #include <KisGlobalResourcesInterface.h>
 #include <KoResourceLoadResult.h>
+#include <KoColorQuantizationIndex.h>
+
+#include <QSet>
 
 K_PLUGIN_FACTORY_WITH_JSON(PalettizeFactory, "kritapalettize.json", registerPlugin<Palettize>();)
 
@@ -243,17 +245,14 @@ void KisFilterPalettize::processImpl(KisPaintDeviceSP device, const QRect& apply
 
     const quint8 colorCount = ditherEnabled && colorMode == ColorMode::NearestColors ? 2 : 1;
 
-    using SearchColor = boost::geometry::model::point<quint16, 3, boost::geometry::cs::cartesian>;
-    struct ColorCandidate {
-        KoColor color;
-        quint16 index;
-        double distance;
-    };
-    using SearchEntry = std::pair<SearchColor, ColorCandidate>;
-    boost::geometry::index::rtree<SearchEntry, boost::geometry::index::quadratic<16>> rtree;
+    QVector<quint16> searchCoordinates;
+    QVector<KoColor> entryColors;
+    QVector<quint16> entryIndices;
 
     if (palette) {
-        // Add palette colors to search tree
+        // Add palette colors to search index
+        QSet<quint64> addedColors;
+
         quint16 index = 0;
         for (int row = 0; row < palette->rowCount(); ++row) {
             for (int column = 0; column < palette->columnCount(); ++column) {
@@ -261,87 +260,142 @@ void KisFilterPalettize::processImpl(KisPaintDeviceSP device, const QRect& apply
                 if (swatch.isValid()) {
                     KoColor color = swatch.color().convertedTo(colorspace);
                     KoColor workColor = swatch.color().convertedTo(workColorspace);
-                    SearchColor searchColor;
-                    memcpy(&searchColor, workColor.data(), sizeof(SearchColor));
+                    const quint16 *searchColor = reinterpret_cast<const quint16*>(workColor.data());
+                    const quint64 key = quint64(searchColor[0]) << 32 | quint64(searchColor[1]) << 16 | searchColor[2];
                     // Don't add duplicates so won't dither between identical colors
-                    std::vector<SearchEntry> result;
-                    rtree.query(boost::geometry::index::contains(searchColor), std::back_inserter(result));
-                    if (result.empty()) rtree.insert(SearchEntry(searchColor, {color, index, 0.0}));
+                    if (!addedColors.contains(key)) {
+                        addedColors.insert(key);
+                        searchCoordinates << searchColor[0] << searchColor[1] << searchColor[2];
+                        entryColors << color;
+                        entryIndices << index;
+                    }
                 }
                 ++index;
             }
         }
+    }
+
+    if (entryColors.isEmpty()) return;
+
+    const QSharedPointer<const KoColorQuantizationIndex> searchIndex =
+        KoColorQuantizationIndex::fromCache(searchCoordinates, colorCount);
 
-        KisDitherUtil ditherUtil;
-        if (ditherEnabled) ditherUtil.setConfiguration(*config, "dither/");
+    KisDitherUtil ditherUtil;
+    if (ditherEnabled) ditherUtil.setConfiguration(*config, "dither/");
 
-        KisDitherUtil alphaDitherUtil;
-        if (alphaMode == AlphaMode::Dither) alphaDitherUtil.setConfiguration(*config, "alphaDither/");
+    KisDitherUtil alphaDitherUtil;
+    if (alphaMode == AlphaMode::Dither) alphaDitherUtil.setConfiguration(*config, "alphaDither/");
 
-        KisSequentialIteratorProgress pixel(device, applyRect, progressUpdater);
-        while (pixel.nextPixel()) {
-            KoColor workColor(pixel.oldRawData(), colorspace);
-            workColor.convertTo(workColorspace);
+    const int pixelSize = colorspace->pixelSize();
+    const int workChannelCount = workColorspace->channelCount();
 
-            // Find dither threshold
-            double threshold = 0.5;
-            if (ditherEnabled) {
-                threshold = ditherUtil.threshold(QPoint(pixel.x(), pixel.y()));
+    /**
+     * Every pixel depends only on itself, so the strips are processed
+     * in place independently. The colors are converted to the search
+     * color space and looked up in batches for the whole strip.
+     *
+     * The filter stroke already runs the patches of the filter on all the
+     * threads of the updater context, so the strips are processed on the
+     * calling thread.
+     */
+    const int stripHeight = 64;
+    const int numStrips = (applyRect.height() + stripHeight - 1) / stripHeight;
 
-                // Traditional per-channel ordered dithering
-                if (colorMode == ColorMode::PerChannelOffset) {
-                    QVector<float> normalized(int(workColorspace->channelCount()));
-                    workColorspace->normalisedChannelsValue(workColor.data(), normalized);
-                    for (int channel = 0; channel < int(workColorspace->channelCount()); ++channel) {
-                        normalized[channel] += (threshold - 0.5) * offsetScale;
+    for (int strip = 0; strip < numStrips; ++strip) {
+        if (progressUpdater && progressUpdater->interrupted()) {
+            return;
+        }
+
+        const QRect rc(applyRect.left(), applyRect.top() + strip * stripHeight,
+                       applyRect.width(), qMin(stripHeight, applyRect.height() - strip * stripHeight));
+
+        const int numPixels = rc.width() * rc.height();
+
+        QVector<quint8> pixels(numPixels * pixelSize);
+        device->readBytes(pixels.data(), rc);
+
+        QVector<quint16> workPixels(numPixels * workChannelCount);
+        colorspace->convertPixelsTo(pixels.constData(), reinterpret_cast<quint8*>(workPixels.data()),
+                                    workColorspace, numPixels,
+                                    KoColorConversionTransformation::internalRenderingIntent(),
+                                    KoColorConversionTransformation::internalConversionFlags());
+
+        // Find dither thresholds
+        QVector<qreal> thresholds(numPixels, 0.5);
+        if (ditherEnabled) {
+            QVector<float> normalized(workChannelCount);
+
+            int i = 0;
+            for (int y = rc.top(); y <= rc.bottom(); ++y) {
+                for (int x = rc.left(); x <= rc.right(); ++x, ++i) {
+                    thresholds[i] = ditherUtil.threshold(QPoint(x, y));
+
+                    // Traditional per-channel ordered dithering
+                    if (colorMode == ColorMode::PerChannelOffset) {
+                        quint8 *workPixel = reinterpret_cast<quint8*>(workPixels.data() + i * workChannelCount);
+                        workColorspace->normalisedChannelsValue(workPixel, normalized);
+                        for (int channel = 0; channel < workChannelCount; ++channel) {
+                            normalized[channel] += (thresholds[i] - 0.5) * offsetScale;
+                        }
+                        workColorspace->fromNormalisedChannelsValue(workPixel, normalized);
                     }
-                    workColorspace->fromNormalisedChannelsValue(workColor.data(), normalized);
                 }
             }
+        }
 
-            // Get candidate colors and their distances
-            SearchColor searchColor;
-            memcpy(reinterpret_cast<quint8 *>(&searchColor), workColor.data(), sizeof(SearchColor));
-            std::vector<ColorCandidate> candidateColors;
-            candidateColors.reserve(size_t(colorCount));
-            double distanceSum = 0.0;
-            for (auto it = rtree.qbegin(boost::geometry::index::nearest(searchColor, colorCount)); it != rtree.qend() && candidateColors.size() < colorCount; ++it) {
-                ColorCandidate candidate = it->second;
-                candidate.distance = boost::geometry::distance(searchColor, it->first);
-                candidateColors.push_back(candidate);
-                distanceSum += candidate.distance;
-            }
+        // Select color candidates
+        QVector<int> selected(numPixels);
+        if (colorCount == 1) {
+            searchIndex->nearestBatch(workPixels.constData(), workChannelCount, numPixels, selected.data());
+        } else {
+            for (int i = 0; i < numPixels; ++i) {
+                int candidates[2];
+                float distances[2];
+                const int numCandidates = searchIndex->nearest(workPixels.constData() + i * workChannelCount, 2, candidates, distances);
+
+                if (numCandidates < 2) {
+                    selected[i] = candidates[0];
+                    continue;
+                }
 
-            // Select color candidate
-            quint16 selected;
-            if (ditherEnabled && colorMode == ColorMode::NearestColors) {
                 // Sort candidates by palette order for stable dither color ordering
-                const bool swap = candidateColors[0].index > candidateColors[1].index;
-                selected = swap ^ (candidateColors[swap].distance / distanceSum > threshold);
+                const bool swap = entryIndices[candidates[0]] > entryIndices[candidates[1]];
+                const double distanceSum = double(distances[0]) + distances[1];
+                selected[i] = candidates[swap ^ (distances[swap] / distanceSum > thresholds[i])];
             }
-            else {
-                selected = 0;
-            }
-            ColorCandidate &candidate = candidateColors[selected];
-
-            // Set alpha
-            const double oldAlpha = colorspace->opacityF(pixel.oldRawData());
-            double newAlpha = oldAlpha;
-            if (alphaEnabled && !(!ditherEnabled && alphaMode == AlphaMode::Dither)) {
-                if (alphaMode == AlphaMode::Clip) {
-                    newAlpha = oldAlpha < alphaClip? 0.0 : 1.0;
-                }
-                else if (alphaMode == AlphaMode::Index) {
-                    newAlpha = (candidate.index == alphaIndex ? 0.0 : 1.0);
-                }
-                else if (alphaMode == AlphaMode::Dither) {
-                    newAlpha = oldAlpha < alphaDitherUtil.threshold(QPoint(pixel.x(), pixel.y())) ? 0.0 : 1.0;
+        }
+
+        quint8 *pixel = pixels.data();
+        int i = 0;
+        for (int y = rc.top(); y <= rc.bottom(); ++y) {
+            for (int x = rc.left(); x <= rc.right(); ++x, ++i, pixel += pixelSize) {
+                const int entry = selected[i];
+
+                // Set alpha
+                const double oldAlpha = colorspace->opacityF(pixel);
+                double newAlpha = oldAlpha;
+                if (alphaEnabled && !(!ditherEnabled && alphaMode == AlphaMode::Dither)) {
+                    if (alphaMode == AlphaMode::Clip) {
+                        newAlpha = oldAlpha < alphaClip? 0.0 : 1.0;
+                    }
+                    else if (alphaMode == AlphaMode::Index) {
+                        newAlpha = (entryIndices[entry] == alphaIndex ? 0.0 : 1.0);
+                    }
+                    else if (alphaMode == AlphaMode::Dither) {
+                        newAlpha = oldAlpha < alphaDitherUtil.threshold(QPoint(x, y)) ? 0.0 : 1.0;
+                    }
                 }
+
+                // Copy color to pixel
+                memcpy(pixel, entryColors[entry].data(), pixelSize);
+                colorspace->setOpacity(pixel, newAlpha, 1);
             }
-            colorspace->setOpacity(candidate.color.data(), newAlpha, 1);
+        }
+
+        device->writeBytes(pixels.constData(), rc);
 
-            // Copy color to pixel
-            memcpy(pixel.rawData(), candidate.color.data(), colorspace->pixelSize());
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * (strip + 1) / numStrips);
         }
     }
 }
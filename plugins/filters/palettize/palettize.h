@@ -14,10 +14,6 @@
 #include <kis_filter.h>
 #include <kis_config_widget.h>
 #include <kis_filter_configuration.h>
-#include <boost/geometry.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/geometries/register/point.hpp>
 
 class KisResourceItemChooser;
 
@@ -21,6 +21,7 @@
 #include <klocalizedstring.h>
 #include <kpluginfactory.h>
 
+#include <KoColor.h>
 #include <KoUpdater.h>
 
 #include <kis_debug.h>
@@ -36,8 +37,8 @@
 #include <kis_processing_information.h>
 
 #include "widgets/kis_multi_integer_filter_widget.h"
-#include <KoMixColorsOp.h>
-#include <KisSequentialIteratorProgress.h>
+#include <kis_painter.h>
+#include <KisSummedAreaTable.h>
 #include "kis_algebra_2d.h"
 #include "kis_lod_transform.h"
 
@@ -63,16 +64,8 @@ void KisPixelizeFilter::processImpl(KisPaintDeviceSP device,
     const int pixelWidth = qCeil(t.scale(config ? qMax(1, config->getInt("pixelWidth", 10)) : 10));
     const int pixelHeight = qCeil(t.scale(config ? qMax(1, config->getInt("pixelHeight", 10)) : 10));
 
-    const qint32 pixelSize = device->pixelSize();
-
     const QRect deviceBounds = device->defaultBounds()->bounds();
 
-    const int bufferSize = pixelSize * pixelWidth * pixelHeight;
-    QScopedArrayPointer<quint8> buffer(new quint8[bufferSize]);
-
-    KoColor pixelColor(Qt::black, device->colorSpace());
-    KoMixColorsOp *mixOp = device->colorSpace()->mixColorsOp();
-
     using namespace KisAlgebra2D;
     const qint32 firstCol = divideFloor(applyRect.x(), pixelWidth);
     const qint32 firstRow = divideFloor(applyRect.y(), pixelHeight);
@@ -82,35 +75,37 @@ void KisPixelizeFilter::processImpl(KisPaintDeviceSP device,
 
     progressUpdater->setRange(firstRow, lastRow);
 
+    const QRect blocksRect =
+        QRect(firstCol * pixelWidth, firstRow * pixelHeight,
+              (lastCol - firstCol + 1) * pixelWidth,
+              (lastRow - firstRow + 1) * pixelHeight) & deviceBounds;
+
+    if (blocksRect.isEmpty()) return;
+
+    /**
+     * The blocks may stick out of applyRect, so they are averaged from
+     * the pixels the device had before the filter started. The averages
+     * of all the blocks are taken from one summed-area table.
+     */
+    KisCachedPaintDevice::Guard d1(device, m_cachedPaintDevice);
+    KisPaintDeviceSP source = d1.device();
+    KisPainter::copyAreaOptimizedOldData(blocksRect.topLeft(), device, source, blocksRect);
+
+    KisSummedAreaTable table(source, blocksRect);
+    KoColor pixelColor(Qt::black, device->colorSpace());
+
     for(qint32 i = firstRow; i <= lastRow; i++) {
         for(qint32 j = firstCol; j <= lastCol; j++) {
             const QRect maxPatchRect(j * pixelWidth, i * pixelHeight,
                                      pixelWidth, pixelHeight);
             const QRect pixelRect = maxPatchRect & deviceBounds;
-            const int numColors = pixelRect.width() * pixelRect.height();
-
-
-            //read
-            KisSequentialConstIterator srcIt(device, pixelRect);
-
-            memset(buffer.data(), 0, bufferSize);
-            quint8 *bufferPtr = buffer.data();
-
-            while (srcIt.nextPixel()) {
-                memcpy(bufferPtr, srcIt.oldRawData(), pixelSize);
-                bufferPtr += pixelSize;
-            }
-
-            // mix all the colors
-            mixOp->mixColors(buffer.data(), numColors, pixelColor.data());
 
             // write only colors in applyRect
             const QRect writeRect = pixelRect & applyRect;
+            if (writeRect.isEmpty()) continue;
 
-            KisSequentialIterator dstIt(device, writeRect);
-            while (dstIt.nextPixel()) {
-                memcpy(dstIt.rawData(), pixelColor.data(), pixelSize);
-            }
+            table.meanPixel(pixelRect, pixelColor.data());
+            device->fill(writeRect, pixelColor);
         }
         progressUpdater->setValue(i);
     }
@@ -11,6 +11,7 @@
 
 #include "filter/kis_filter.h"
 #include "kis_config_widget.h"
+#include "kis_cached_paint_device.h"
 
 class KisPixelizeFilter : public KisFilter
 {
@@ -33,6 +34,9 @@ public:
 public:
     KisConfigWidget * createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP dev, bool useForMasks) const override;
     KisFilterConfigurationSP defaultConfiguration(KisResourcesInterfaceSP resourcesInterface) const override;
+
+private:
+    mutable KisCachedPaintDevice m_cachedPaintDevice;
 };
 
 #endif
@@ -20,12 +20,14 @@
 #include <KoUpdater.h>
 #include <KoConvolutionOp.h>
 #include <kis_paint_device.h>
+#include <kis_painter.h>
+#include <kis_global.h>
+#include <KisGaussianBlurCache.h>
 #include "kis_lod_transform.h"
 
 #include "kis_wdg_unsharp.h"
 #include "ui_wdgunsharp.h"
 #include "KoColorSpaceTraits.h"
-#include <KisSequentialIteratorProgress.h>
 
 
 KisUnsharpFilter::KisUnsharpFilter() : KisFilter(id(), FiltersCategoryEnhanceId, i18n("&Unsharp Mask..."))
@@ -66,19 +68,6 @@ void KisUnsharpFilter::processImpl(KisPaintDeviceSP device,
                                    KoUpdater* progressUpdater
                                    ) const
 {
-
-    QPointer<KoUpdater> filterUpdater = 0;
-    QPointer<KoUpdater> convolutionUpdater = 0;
-    QScopedPointer<KoProgressUpdater> updater;
-
-    if (progressUpdater) {
-        updater.reset(new KoProgressUpdater(progressUpdater));
-        updater->start(100, i18n("Unsharp Mask"));
-        // Two sub-sub tasks that each go from 0 to 100.
-        convolutionUpdater = updater->startSubtask();
-        filterUpdater = updater->startSubtask();
-    }
-
     KIS_SAFE_ASSERT_RECOVER_RETURN(config);
 
     QVariant value;
@@ -91,10 +80,6 @@ void KisUnsharpFilter::processImpl(KisPaintDeviceSP device,
     const uint lightnessOnly = (config->getProperty("lightnessOnly", value)) ? value.toBool() : true;
 
     QBitArray channelFlags = config->channelFlags();
-    KisGaussianKernel::applyGaussian(device, applyRect,
-                                     halfSize, halfSize,
-                                     channelFlags,
-                                     convolutionUpdater);
 
     qreal weights[2];
     qreal factor = 128;
@@ -102,95 +87,147 @@ void KisUnsharpFilter::processImpl(KisPaintDeviceSP device,
     weights[0] = factor * (1. + amount);
     weights[1] = -factor * amount;
 
-    if (lightnessOnly) {
-        processLightnessOnly(device, applyRect, threshold, weights, factor, channelFlags, filterUpdater);
-    } else {
-        processRaw(device, applyRect, threshold, weights, factor, channelFlags, filterUpdater);
+    /**
+     * The device is sharpened in place, so the original pixels are read
+     * from a snapshot. The blur of the snapshot comes from the shared
+     * cache, so when only the amount or the threshold changes (e.g. in
+     * the preview of the filter dialog) the blur is not recalculated.
+     */
+    const QRect sourceRect = kisGrowRect(applyRect, KisGaussianKernel::kernelSizeFromRadius(halfSize) / 2);
+
+    KisCachedPaintDevice::Guard d1(device, m_cachedPaintDevice);
+    KisPaintDeviceSP source = d1.device();
+    KisPainter::copyAreaOptimizedOldData(sourceRect.topLeft(), device, source, sourceRect);
+
+    const KoColorSpace *cs = device->colorSpace();
+    const int pixelSize = cs->pixelSize();
+
+    /**
+     * The filter stroke already runs the patches of the filter on all the
+     * threads of the updater context, so the cells are processed on the
+     * calling thread
+     */
+    const QVector<QRect> cells = KisGaussianBlurCache::splitIntoCells(applyRect);
+
+    for (int i = 0; i < cells.size(); i++) {
+        if (progressUpdater && progressUpdater->interrupted()) {
+            return;
+        }
+
+        const QRect &cell = cells[i];
+        const int numPixels = cell.width() * cell.height();
+
+        QVector<quint8> srcBytes(numPixels * pixelSize);
+        QVector<quint8> blurredBytes(numPixels * pixelSize);
+        QVector<quint8> dstBytes(numPixels * pixelSize);
+
+        source->readBytes(srcBytes.data(), cell);
+        KisGaussianBlurCache::instance()->readBlurredBytes(source, cell,
+                                                           halfSize,
+                                                           channelFlags,
+                                                           blurredBytes.data());
+
+        if (lightnessOnly) {
+            processLightnessOnly(cs, srcBytes.constData(), blurredBytes.constData(), dstBytes.data(),
+                                 numPixels, threshold, weights, factor);
+        } else {
+            processRaw(cs, srcBytes.constData(), blurredBytes.constData(), dstBytes.data(),
+                       numPixels, threshold, weights, factor, channelFlags);
+        }
+
+        device->writeBytes(dstBytes.constData(), cell);
+
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * (i + 1) / cells.size());
+        }
     }
 }
 
-void KisUnsharpFilter::processRaw(KisPaintDeviceSP device,
-                                  const QRect &rect,
+void KisUnsharpFilter::processRaw(const KoColorSpace *cs,
+                                  const quint8 *src,
+                                  const quint8 *blurred,
+                                  quint8 *dst,
+                                  int numPixels,
                                   quint8 threshold,
                                   qreal weights[2],
                                   qreal factor,
-                                  const QBitArray &channelFlags,
-                                  KoUpdater *progressUpdater) const
+                                  const QBitArray &channelFlags) const
 {
-    const KoColorSpace *cs = device->colorSpace();
     const int pixelSize = cs->pixelSize();
     KoConvolutionOp * convolutionOp = cs->convolutionOp();
 
-    quint8 *colors[2];
-    colors[0] = new quint8[pixelSize];
-    colors[1] = new quint8[pixelSize];
-
-    KisSequentialIteratorProgress dstIt(device, rect, progressUpdater);
+    const quint8 *colors[2];
 
-    while (dstIt.nextPixel()) {
+    for (int i = 0; i < numPixels; i++, src += pixelSize, blurred += pixelSize, dst += pixelSize) {
         quint8 diff = 0;
         if (threshold == 1) {
-            if (memcmp(dstIt.oldRawData(), dstIt.rawDataConst(), cs->pixelSize()) == 0) {
+            if (memcmp(src, blurred, pixelSize) == 0) {
                 diff = 1;
             }
         }
         else {
-            diff = cs->difference(dstIt.oldRawData(), dstIt.rawDataConst());
+            diff = cs->difference(src, blurred);
         }
 
         if (diff >= threshold) {
-            memcpy(colors[0], dstIt.oldRawData(), pixelSize);
-            memcpy(colors[1], dstIt.rawDataConst(), pixelSize);
-            convolutionOp->convolveColors(colors, weights, dstIt.rawData(), factor, 0, 2, channelFlags);
+            colors[0] = src;
+            colors[1] = blurred;
+            convolutionOp->convolveColors(colors, weights, dst, factor, 0, 2, channelFlags);
         } else {
-            memcpy(dstIt.rawData(), dstIt.oldRawData(), pixelSize);
+            memcpy(dst, src, pixelSize);
         }
     }
-
-    delete[] colors[0];
-    delete[] colors[1];
 }
 
-void KisUnsharpFilter::processLightnessOnly(KisPaintDeviceSP device,
-                                            const QRect &rect,
+void KisUnsharpFilter::processLightnessOnly(const KoColorSpace *cs,
+                                            const quint8 *src,
+                                            const quint8 *blurred,
+                                            quint8 *dst,
+                                            int numPixels,
                                             quint8 threshold,
                                             qreal weights[2],
-                                            qreal factor,
-                                            const QBitArray & /*channelFlags*/,
-                                            KoUpdater *progressUpdater) const
+                                            qreal factor) const
 {
-    const KoColorSpace *cs = device->colorSpace();
     const int pixelSize = cs->pixelSize();
 
-    quint16 labColorSrc[4];
-    quint16 labColorDst[4];
+    QVector<quint16> labColorsSrc(numPixels * 4);
+    QVector<quint16> labColorsDst(numPixels * 4);
+
+    // the whole cell is converted at once, it is much faster than per-pixel
+    cs->toLabA16(src, reinterpret_cast<quint8*>(labColorsSrc.data()), numPixels);
+    cs->toLabA16(blurred, reinterpret_cast<quint8*>(labColorsDst.data()), numPixels);
 
     const int posL = 0;
     const int posAlpha = 3;
 
     const qreal factorInv = 1.0 / factor;
 
-    KisSequentialIteratorProgress dstIt(device, rect, progressUpdater);
+    QVector<bool> sharpened(numPixels);
 
-    while (dstIt.nextPixel()) {
-        quint8 diff = cs->differenceA(dstIt.oldRawData(), dstIt.rawDataConst());
-        if (diff >= threshold) {
-            cs->toLabA16(dstIt.oldRawData(), (quint8*)labColorSrc, 1);
-            cs->toLabA16(dstIt.rawDataConst(), (quint8*)labColorDst, 1);
+    for (int i = 0; i < numPixels; i++) {
+        sharpened[i] = cs->differenceA(src + i * pixelSize, blurred + i * pixelSize) >= threshold;
+        if (!sharpened[i]) continue;
 
-            qint32 valueL = (labColorSrc[posL] * weights[0] + labColorDst[posL] * weights[1]) * factorInv;
-            labColorSrc[posL] = CLAMP(valueL,
+        quint16 *labColorSrc = labColorsSrc.data() + i * 4;
+        const quint16 *labColorDst = labColorsDst.constData() + i * 4;
+
+        qint32 valueL = (labColorSrc[posL] * weights[0] + labColorDst[posL] * weights[1]) * factorInv;
+        labColorSrc[posL] = CLAMP(valueL,
+                                  KoColorSpaceMathsTraits<quint16>::min,
+                                  KoColorSpaceMathsTraits<quint16>::max);
+
+        qint32 valueAlpha = (labColorSrc[posAlpha] * weights[0] + labColorDst[posAlpha] * weights[1]) * factorInv;
+        labColorSrc[posAlpha] = CLAMP(valueAlpha,
                                       KoColorSpaceMathsTraits<quint16>::min,
                                       KoColorSpaceMathsTraits<quint16>::max);
+    }
 
-            qint32 valueAlpha = (labColorSrc[posAlpha] * weights[0] + labColorDst[posAlpha] * weights[1]) * factorInv;
-            labColorSrc[posAlpha] = CLAMP(valueAlpha,
-                                          KoColorSpaceMathsTraits<quint16>::min,
-                                          KoColorSpaceMathsTraits<quint16>::max);
+    cs->fromLabA16(reinterpret_cast<const quint8*>(labColorsSrc.constData()), dst, numPixels);
 
-            cs->fromLabA16((quint8*)labColorSrc, dstIt.rawData(), 1);
-        } else {
-            memcpy(dstIt.rawData(), dstIt.oldRawData(), pixelSize);
+    // the pixels under the threshold are kept bit-exact
+    for (int i = 0; i < numPixels; i++) {
+        if (!sharpened[i]) {
+            memcpy(dst + i * pixelSize, src + i * pixelSize, pixelSize);
         }
     }
 }
@@ -10,6 +10,9 @@
 #define KIS_UNSHARP_FILTER_H
 
 #include "filter/kis_filter.h"
+#include "kis_cached_paint_device.h"
+
+class KoColorSpace;
 
 class KisUnsharpFilter : public KisFilter
 {
@@ -34,19 +37,27 @@ public:
     QRect neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const override;
 
 private:
-    void processLightnessOnly(KisPaintDeviceSP device,
-                              const QRect &rect,
+    void processLightnessOnly(const KoColorSpace *cs,
+                              const quint8 *src,
+                              const quint8 *blurred,
+                              quint8 *dst,
+                              int numPixels,
                               quint8 threshold,
                               qreal weights[2],
-                              qreal factor,
-                              const QBitArray &channelFlags, KoUpdater *progressUpdater) const;
+                              qreal factor) const;
 
-    void processRaw(KisPaintDeviceSP device,
-                    const QRect &rect,
+    void processRaw(const KoColorSpace *cs,
+                    const quint8 *src,
+                    const quint8 *blurred,
+                    quint8 *dst,
+                    int numPixels,
                     quint8 threshold,
                     qreal weights[2],
                     qreal factor,
-                    const QBitArray &channelFlags, KoUpdater *progressUpdater) const;
+                    const QBitArray &channelFlags) const;
+
+private:
+    mutable KisCachedPaintDevice m_cachedPaintDevice;
 };
 
 #endif
@@ -0,0 +1,97 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KRITA_KISCOLORSMUDGEPARALLELUTILS_H
+#define KRITA_KISCOLORSMUDGEPARALLELUTILS_H
+
+#include <QRect>
+#include <QVector>
+
+#include "kis_fixed_paint_device.h"
+#include "krita_utils.h"
+
+
+namespace KisColorSmudgeParallelUtils {
+
+/**
+ * Dabs smaller than this amount of pixels are always processed on
+ * the calling thread. Spawning the threads for them costs more than
+ * the blending itself.
+ */
+static constexpr int minParallelDabArea = 128 * 128;
+
+/**
+ * Minimal height of a single strip. Narrower strips make the threads
+ * fight for the same tiles of the source device.
+ */
+static constexpr int minStripHeight = 16;
+
+/**
+ * Split \p rc into horizontal strips spanning the full width of
+ * the rect. Full-width strips are essential: the pixels of every strip
+ * form a contiguous block in the buffer of a fixed paint device with
+ * bounds equal to \p rc.
+ */
+inline QVector<QRect> splitIntoStrips(const QRect &rc, int maxNumStrips)
+{
+    QVector<QRect> strips;
+
+    const int numStrips = qBound(1, rc.height() / minStripHeight, qMax(1, maxNumStrips));
+    const int stripHeight = rc.height() / numStrips;
+    const int extraRows = rc.height() % numStrips;
+
+    int y = rc.top();
+    for (int i = 0; i < numStrips; i++) {
+        const int height = stripHeight + (i < extraRows ? 1 : 0);
+        strips.append(QRect(rc.left(), y, rc.width(), height));
+        y += height;
+    }
+
+    return strips;
+}
+
+/**
+ * Run \p func for every strip of \p rc. The strips are guaranteed
+ * not to intersect, so the result does not depend on the number of
+ * threads or on the order of execution as long as \p func does only
+ * per-pixel operations. Small rects are processed on the calling
+ * thread as a single strip.
+ */
+template <typename Func>
+void runOnStrips(const QRect &rc, int maxNumThreads, Func func)
+{
+    if (maxNumThreads <= 1 || rc.width() * rc.height() < minParallelDabArea) {
+        func(rc);
+        return;
+    }
+
+    QVector<QRect> strips = splitIntoStrips(rc, maxNumThreads);
+
+    if (strips.size() <= 1) {
+        func(rc);
+        return;
+    }
+
+    KritaUtils::runOnPatches(strips,
+                             [func] (int, const QRect &strip) { func(strip); },
+                             nullptr, maxNumThreads);
+}
+
+/**
+ * Returns the pointer to the first pixel of \p rc inside the buffer
+ * of \p device. The rect should span the full width of the device.
+ */
+inline quint8* stripDataPtr(KisFixedPaintDeviceSP device, const QRect &rc)
+{
+    const QRect bounds = device->bounds();
+    KIS_SAFE_ASSERT_RECOVER_NOOP(rc.left() == bounds.left() && rc.width() == bounds.width());
+
+    return device->data() + (rc.top() - bounds.top()) * bounds.width() * device->pixelSize();
+}
+
+}
+
+#endif //KRITA_KISCOLORSMUDGEPARALLELUTILS_H
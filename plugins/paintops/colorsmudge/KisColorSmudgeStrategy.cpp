@@ -7,6 +7,6 @@
 #include "KisColorSmudgeStrategy.h"
 
 KisColorSmudgeStrategy::KisColorSmudgeStrategy()
-        : m_memoryAllocator(new KisOptimizedByteArray::PooledMemoryAllocator())
+        : m_memoryAllocator(new KisOptimizedByteArray::SizeClassMemoryAllocator())
 {
 }
@@ -11,6 +11,8 @@
 #include "kis_fixed_paint_device.h"
 #include "kis_paint_device.h"
 #include "KisColorSmudgeSampleUtils.h"
+#include "KisColorSmudgeParallelUtils.h"
+#include "kis_image_config.h"
 
 /**********************************************************************************/
 /*                 DabColoringStrategyMask                                        */
@@ -32,10 +34,12 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyMask::blendInFusedBackground
     colorRateOp->composite(dullingFillColor.data(), 1, paintColor.data(), 1, 0, 0, 1, 1, colorRateOpacity);
 
     if (smearOp->id() == COMPOSITE_COPY && qFuzzyCompare(smudgeRateOpacity, OPACITY_OPAQUE_F)) {
-        dst->fill(dst->bounds(), dullingFillColor);
+        dst->fill(dstRect, dullingFillColor);
     } else {
-        src->readBytes(dst->data(), dstRect);
-        smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
+        quint8 *dstPtr = KisColorSmudgeParallelUtils::stripDataPtr(dst, dstRect);
+
+        src->readBytes(dstPtr, dstRect);
+        smearOp->composite(dstPtr, dstRect.width() * dst->pixelSize(),
                            dullingFillColor.data(), 0,
                            0, 0,
                            1, dstRect.width() * dstRect.height(),
@@ -51,7 +55,8 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyMask::blendInColorRate(const
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(*paintColor.colorSpace() == *colorRateOp->colorSpace());
 
-    colorRateOp->composite(dstDevice->data(), dstRect.width() * dstDevice->pixelSize(),
+    colorRateOp->composite(KisColorSmudgeParallelUtils::stripDataPtr(dstDevice, dstRect),
+                           dstRect.width() * dstDevice->pixelSize(),
                            paintColor.data(), 0,
                            0, 0,
                            dstRect.height(), dstRect.width(),
@@ -78,8 +83,16 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyStamp::blendInColorRate(cons
     // TODO: check correctness for composition source device (transparency masks)
     KIS_ASSERT_RECOVER_RETURN(*dstDevice->colorSpace() == *m_origDab->colorSpace());
 
-    colorRateOp->composite(dstDevice->data(), dstRect.width() * dstDevice->pixelSize(),
-                           m_origDab->data(), dstRect.width() * m_origDab->pixelSize(),
+    /**
+     * The stamp has the same size as the blending device, so the
+     * strip is located at the same row offset in both buffers
+     */
+    const int rowOffset = dstRect.top() - dstDevice->bounds().top();
+    const quint8 *stampPtr = m_origDab->data() + rowOffset * dstRect.width() * m_origDab->pixelSize();
+
+    colorRateOp->composite(KisColorSmudgeParallelUtils::stripDataPtr(dstDevice, dstRect),
+                           dstRect.width() * dstDevice->pixelSize(),
+                           stampPtr, dstRect.width() * m_origDab->pixelSize(),
                            0, 0,
                            dstRect.height(), dstRect.width(),
                            colorRateOpacity);
@@ -112,6 +125,7 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyStamp::blendInFusedBackgroun
 
 KisColorSmudgeStrategyBase::KisColorSmudgeStrategyBase(bool useDullingMode)
         : m_useDullingMode(useDullingMode)
+        , m_maxNumStripThreads(KisImageConfig(true).maxNumberOfThreads())
 {
 }
 
@@ -124,6 +138,11 @@ void KisColorSmudgeStrategyBase::initializePaintingImpl(const KoColorSpace *dstC
     m_preparedDullingColor.convertTo(dstColorSpace);
 }
 
+int KisColorSmudgeStrategyBase::maxNumStripThreads() const
+{
+    return m_maxNumStripThreads;
+}
+
 const KoColorSpace *KisColorSmudgeStrategyBase::preciseColorSpace() const
 {
     // verify that initialize() has already been called!
@@ -206,45 +225,57 @@ KisColorSmudgeStrategyBase::blendBrush(const QVector<KisPainter *> dstPainters,
     DabColoringStrategy &coloringStrategy = this->coloringStrategy();
 
     const qreal dullingRateOpacity = this->dullingRateOpacity(opacity, smudgeRateValue);
+    const qreal smudgeRateOpacity = this->smearRateOpacity(opacity, smudgeRateValue);
 
-    if (colorRateOpacity > 0 &&
+    const bool useFusedBlending =
+        colorRateOpacity > 0 &&
         m_useDullingMode &&
         coloringStrategy.supportsFusedDullingBlending() &&
         ((m_smearOp->id() == COMPOSITE_OVER &&
           m_colorRateOp->id() == COMPOSITE_OVER) ||
          (m_smearOp->id() == COMPOSITE_COPY &&
-          qFuzzyCompare(dullingRateOpacity, OPACITY_OPAQUE_F)))) {
-
-        coloringStrategy.blendInFusedBackgroundAndColorRateWithDulling(m_blendDevice,
-                                                                       srcSampleDevice,
-                                                                       dstRect,
-                                                                       m_preparedDullingColor,
-                                                                       m_smearOp,
-                                                                       dullingRateOpacity,
-                                                                       currentPaintColor.convertedTo(
-                                                                               m_preparedDullingColor.colorSpace()),
-                                                                       m_colorRateOp,
-                                                                       colorRateOpacity);
-
-    } else {
-        if (!m_useDullingMode) {
-            const qreal smudgeRateOpacity = this->smearRateOpacity(opacity, smudgeRateValue);
-            blendInBackgroundWithSmearing(m_blendDevice, srcSampleDevice,
-                                          srcRect, dstRect, smudgeRateOpacity);
-        } else {
-            blendInBackgroundWithDulling(m_blendDevice, srcSampleDevice,
-                                         dstRect,
-                                         m_preparedDullingColor, dullingRateOpacity);
-        }
-
-        if (colorRateOpacity > 0) {
-            coloringStrategy.blendInColorRate(
-                    currentPaintColor.convertedTo(m_preparedDullingColor.colorSpace()),
-                    m_colorRateOp,
-                    colorRateOpacity,
-                    m_blendDevice, dstRect);
-        }
-    }
+          qFuzzyCompare(dullingRateOpacity, OPACITY_OPAQUE_F)));
+
+    const KoColor paintColor = currentPaintColor.convertedTo(m_preparedDullingColor.colorSpace());
+
+    /**
+     * All the blending operations below are done per-pixel, therefore
+     * we can safely split the dab into horizontal strips and blend
+     * them in parallel. The result doesn't depend on the way the dab
+     * is split.
+     */
+    KisColorSmudgeParallelUtils::runOnStrips(dstRect, m_maxNumStripThreads,
+        [&] (const QRect &dstStripRect) {
+            const QRect srcStripRect = dstStripRect.translated(srcRect.topLeft() - dstRect.topLeft());
+
+            if (useFusedBlending) {
+                coloringStrategy.blendInFusedBackgroundAndColorRateWithDulling(m_blendDevice,
+                                                                               srcSampleDevice,
+                                                                               dstStripRect,
+                                                                               m_preparedDullingColor,
+                                                                               m_smearOp,
+                                                                               dullingRateOpacity,
+                                                                               paintColor,
+                                                                               m_colorRateOp,
+                                                                               colorRateOpacity);
+            } else {
+                if (!m_useDullingMode) {
+                    blendInBackgroundWithSmearing(m_blendDevice, srcSampleDevice,
+                                                  srcStripRect, dstStripRect, smudgeRateOpacity);
+                } else {
+                    blendInBackgroundWithDulling(m_blendDevice, srcSampleDevice,
+                                                 dstStripRect,
+                                                 m_preparedDullingColor, dullingRateOpacity);
+                }
+
+                if (colorRateOpacity > 0) {
+                    coloringStrategy.blendInColorRate(paintColor,
+                                                      m_colorRateOp,
+                                                      colorRateOpacity,
+                                                      m_blendDevice, dstStripRect);
+                }
+            }
+        });
 
     const bool preserveDab = preserveMaskDab && dstPainters.size() > 1;
 
@@ -265,17 +296,19 @@ void KisColorSmudgeStrategyBase::blendInBackgroundWithSmearing(KisFixedPaintDevi
                                                                const QRect &srcRect, const QRect &dstRect,
                                                                const qreal smudgeRateOpacity)
 {
+    quint8 *dstPtr = KisColorSmudgeParallelUtils::stripDataPtr(dst, dstRect);
+
     if (m_smearOp->id() == COMPOSITE_COPY && qFuzzyCompare(smudgeRateOpacity, OPACITY_OPAQUE_F)) {
-        src->readBytes(dst->data(), srcRect);
+        src->readBytes(dstPtr, srcRect);
     } else {
-        src->readBytes(dst->data(), dstRect);
+        src->readBytes(dstPtr, dstRect);
 
         KisFixedPaintDevice tempDevice(src->colorSpace(), m_memoryAllocator);
         tempDevice.setRect(srcRect);
         tempDevice.lazyGrowBufferWithoutInitialization();
 
         src->readBytes(tempDevice.data(), srcRect);
-        m_smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
+        m_smearOp->composite(dstPtr, dstRect.width() * dst->pixelSize(),
                              tempDevice.data(), dstRect.width() * tempDevice.pixelSize(), // stride should be random non-zero
                              0, 0,
                              1, dstRect.width() * dstRect.height(),
@@ -290,10 +323,12 @@ void KisColorSmudgeStrategyBase::blendInBackgroundWithDulling(KisFixedPaintDevic
     Q_UNUSED(preparedDullingColor);
 
     if (m_smearOp->id() == COMPOSITE_COPY && qFuzzyCompare(smudgeRateOpacity, OPACITY_OPAQUE_F)) {
-        dst->fill(dst->bounds(), m_preparedDullingColor);
+        dst->fill(dstRect, m_preparedDullingColor);
     } else {
-        src->readBytes(dst->data(), dstRect);
-        m_smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
+        quint8 *dstPtr = KisColorSmudgeParallelUtils::stripDataPtr(dst, dstRect);
+
+        src->readBytes(dstPtr, dstRect);
+        m_smearOp->composite(dstPtr, dstRect.width() * dst->pixelSize(),
                              m_preparedDullingColor.data(), 0,
                              0, 0,
                              1, dstRect.width() * dstRect.height(),
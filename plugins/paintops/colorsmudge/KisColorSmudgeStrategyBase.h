@@ -114,6 +114,12 @@ public:
     void blendInBackgroundWithDulling(KisFixedPaintDeviceSP dst, KisColorSmudgeSourceSP src, const QRect &dstRect,
                                       const KoColor &preparedDullingColor, const qreal smudgeRateOpacity);
 
+protected:
+    /**
+     * The maximum number of threads the dab blending can be split into
+     */
+    int maxNumStripThreads() const;
+
 protected:
     const KoCompositeOp * m_colorRateOp {nullptr};
     KoColor m_preparedDullingColor;
@@ -121,6 +127,7 @@ protected:
 private:
     KisFixedPaintDeviceSP m_blendDevice;
     bool m_useDullingMode {true};
+    int m_maxNumStripThreads {1};
 };
 
 
@@ -14,6 +14,7 @@
 #include "kis_selection.h"
 
 #include "KisColorSmudgeInterstrokeData.h"
+#include "KisColorSmudgeParallelUtils.h"
 #include "kis_algebra_2d.h"
 #include <KoBgrColorSpaceTraits.h>
 
@@ -140,8 +141,6 @@ KisColorSmudgeStrategyLightness::paintDab(const QRect &srcRect, const QRect &dst
                                           qreal maxPossibleSmudgeRateValue, qreal paintThicknessValue,
                                           qreal smudgeRadiusValue)
 {
-    const int numPixels = dstRect.width() * dstRect.height();
-
     const QVector<QRect> mirroredRects = m_finalPainter.calculateAllMirroredRects(dstRect);
 
     QVector<QRect> readRects;
@@ -172,29 +171,29 @@ KisColorSmudgeStrategyLightness::paintDab(const QRect &srcRect, const QRect &dst
     m_heightmapPainter.renderMirrorMaskSafe(dstRect, m_origDab, m_shouldPreserveOriginalDab);
 
 
-    KisFixedPaintDeviceSP tempColorDevice =
-        new KisFixedPaintDevice(m_colorOnlyDevice->colorSpace(), m_memoryAllocator);
-
-    KisFixedPaintDeviceSP tempHeightmapDevice =
-        new KisFixedPaintDevice(m_heightmapDevice->colorSpace(), m_memoryAllocator);
-
     Q_FOREACH(const QRect& rc, mirroredRects) {
-        tempColorDevice->setRect(rc);
-        tempColorDevice->lazyGrowBufferWithoutInitialization();
-
-        tempHeightmapDevice->setRect(rc);
-        tempHeightmapDevice->lazyGrowBufferWithoutInitialization();
-
-        m_colorOnlyDevice->readBytes(tempColorDevice->data(), rc);
-        m_heightmapDevice->readBytes(tempHeightmapDevice->data(), rc);
-        tempColorDevice->colorSpace()->
-            modulateLightnessByGrayBrush(tempColorDevice->data(),
-                reinterpret_cast<const QRgb*>(tempHeightmapDevice->data()),
-                1.0,
-                numPixels);
-        m_projectionDevice->writeBytes(tempColorDevice->data(), tempColorDevice->bounds());
+        KisColorSmudgeParallelUtils::runOnStrips(rc, maxNumStripThreads(),
+            [this] (const QRect &stripRect) {
+                KisFixedPaintDevice tempColorDevice(m_colorOnlyDevice->colorSpace(), m_memoryAllocator);
+                KisFixedPaintDevice tempHeightmapDevice(m_heightmapDevice->colorSpace(), m_memoryAllocator);
+
+                tempColorDevice.setRect(stripRect);
+                tempColorDevice.lazyGrowBufferWithoutInitialization();
+
+                tempHeightmapDevice.setRect(stripRect);
+                tempHeightmapDevice.lazyGrowBufferWithoutInitialization();
+
+                m_colorOnlyDevice->readBytes(tempColorDevice.data(), stripRect);
+                m_heightmapDevice->readBytes(tempHeightmapDevice.data(), stripRect);
+                tempColorDevice.colorSpace()->
+                    modulateLightnessByGrayBrush(tempColorDevice.data(),
+                        reinterpret_cast<const QRgb*>(tempHeightmapDevice.data()),
+                        1.0,
+                        stripRect.width() * stripRect.height());
+                m_projectionDevice->writeBytes(tempColorDevice.data(), stripRect);
+            });
     }
- 
+
     m_layerOverlayDevice->writeRects(mirroredRects);
 
     return mirroredRects;
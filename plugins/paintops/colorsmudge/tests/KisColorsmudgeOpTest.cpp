@@ -16,6 +16,10 @@
 #include <brushengine/kis_paintop_preset.h>
 #include <brushengine/kis_paintop_settings.h>
 #include <KoCanvasResourcesIds.h>
+#include <kis_image_config.h>
+#include <testutil.h>
+
+#include "../KisColorSmudgeParallelUtils.h"
 
 class TestColorsmudgeOp : public TestUtil::QImageBasedTest
 {
@@ -109,6 +113,49 @@ public:
         }
     }
 
+    /**
+     * Paints a stroke of big dabs, so that the dabs are split into
+     * strips when \p numThreads is greater than one
+     */
+    KisPaintDeviceSP paintBigDabs(const QString &presetFileName, int numThreads) {
+        KisImageConfig(false).setMaxNumberOfThreads(numThreads);
+
+        KisSurrogateUndoStore *undoStore = new KisSurrogateUndoStore();
+        KisImageSP image = createTrivialImage(undoStore);
+        image->initialRefreshGraph();
+        image->resizeImage(QRect(0,0,400,400));
+        image->waitForDone();
+
+        KisNodeSP paint1 = findNode(image->root(), "paint1");
+        paint1->paintDevice()->fill(QRect(150, 5, 100, 390), KoColor(Qt::red, image->colorSpace()));
+
+        KisPainter gc(paint1->paintDevice());
+
+        QScopedPointer<KoCanvasResourceProvider> manager(
+            utils::createResourceManager(image, 0, presetFileName));
+
+        manager->setResource(KoCanvasResource::ForegroundColor, KoColor(Qt::green, image->colorSpace()));
+
+        KisPaintOpPresetSP preset =
+            manager->resource(KoCanvasResource::CurrentPaintOpPreset).value<KisPaintOpPresetSP>();
+        preset->settings()->setPaintOpSize(200);
+
+        KisResourcesSnapshotSP resources =
+            new KisResourcesSnapshot(image,
+                                     paint1,
+                                     manager.data());
+
+        resources->setupPainter(&gc);
+
+        KisDistanceInformation dist;
+        KisPaintInformation p1(QPointF(50, 200), 1.0);
+        KisPaintInformation p2(QPointF(350, 200), 0.8);
+
+        gc.paintLine(p1, p2, &dist);
+
+        return paint1->paintDevice();
+    }
+
     QString m_presetFileName;
     QString m_prefix;
 };
@@ -151,4 +198,62 @@ void KisColorsmudgeOpTest::test()
     t.test(testName, preset, overlay);
 }
 
+void KisColorsmudgeOpTest::testStripSplitting()
+{
+    const QVector<QRect> rects = {
+        QRect(10, 20, 300, 300),
+        QRect(-5, -7, 513, 257),
+        QRect(0, 0, 300, 17),
+        QRect(3, 4, 1, 1)
+    };
+
+    for (const QRect &rc : rects) {
+        for (int numThreads = 1; numThreads <= 16; numThreads++) {
+            const QVector<QRect> strips =
+                KisColorSmudgeParallelUtils::splitIntoStrips(rc, numThreads);
+
+            QVERIFY(!strips.isEmpty());
+            QVERIFY(strips.size() <= numThreads);
+
+            int expectedTop = rc.top();
+            for (const QRect &strip : strips) {
+                QCOMPARE(strip.left(), rc.left());
+                QCOMPARE(strip.width(), rc.width());
+                QCOMPARE(strip.top(), expectedTop);
+                QVERIFY(!strip.isEmpty());
+                expectedTop += strip.height();
+            }
+            QCOMPARE(expectedTop, rc.top() + rc.height());
+        }
+    }
+}
+
+void KisColorsmudgeOpTest::testParallelStripsMatchSingleThread_data()
+{
+    QTest::addColumn<QString>("preset");
+
+    QTest::newRow("dul_nsa") << "test_smudge_20px_dul_nsa_new.0001.kpp";
+    QTest::newRow("dul_sa") << "test_smudge_20px_dul_sa_new.0001.kpp";
+    QTest::newRow("sme_nsa") << "test_smudge_20px_sme_nsa_new.0001.kpp";
+    QTest::newRow("sme_sa") << "test_smudge_20px_sme_sa_new.0001.kpp";
+}
+
+void KisColorsmudgeOpTest::testParallelStripsMatchSingleThread()
+{
+    QFETCH(QString, preset);
+
+    const int originalNumThreads = KisImageConfig(true).maxNumberOfThreads();
+
+    TestColorsmudgeOp t;
+    KisPaintDeviceSP singleThread = t.paintBigDabs(preset, 1);
+    KisPaintDeviceSP parallel = t.paintBigDabs(preset, 8);
+
+    KisImageConfig(false).setMaxNumberOfThreads(originalNumThreads);
+
+    // the strips never intersect, so the dabs should be byte-identical
+    QPoint errorPoint;
+    QVERIFY2(TestUtil::comparePaintDevices(errorPoint, singleThread, parallel),
+             QString("The dabs differ at (%1, %2)").arg(errorPoint.x()).arg(errorPoint.y()).toLatin1());
+}
+
 KISTEST_MAIN(KisColorsmudgeOpTest)
@@ -16,6 +16,11 @@ private Q_SLOTS:
 
     void test();
     void test_data();
+
+    void testStripSplitting();
+
+    void testParallelStripsMatchSingleThread();
+    void testParallelStripsMatchSingleThread_data();
 };
 
 #endif // KISCOLORSMUDGEOPTEST_H
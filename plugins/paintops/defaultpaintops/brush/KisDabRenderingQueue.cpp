@@ -48,7 +48,7 @@ struct KisDabRenderingQueue::Private
         : cacheInterface(new DumbCacheInterface),
           colorSpace(_colorSpace),
           resourcesFactory(_resourcesFactory),
-          paintDeviceAllocator(new KisOptimizedByteArray::PooledMemoryAllocator()),
+          paintDeviceAllocator(new KisOptimizedByteArray::SizeClassMemoryAllocator()),
           avgExecutionTime(50),
           avgDabSize(50)
     {
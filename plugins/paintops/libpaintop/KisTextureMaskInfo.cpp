@@ -108,6 +108,50 @@ QRect KisTextureMaskInfo::maskBounds() const {
     return m_maskBounds;
 }
 
+const KoColorSpace *KisTextureMaskInfo::maskPixelsColorSpace() const
+{
+    return m_maskPixelsColorSpace;
+}
+
+void KisTextureMaskInfo::fillMaskPatch(quint8 *dst, const QRect &patchRect) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(isValid() && m_maskPixelsColorSpace);
+
+    const int pixelSize = m_maskPixelsColorSpace->pixelSize();
+    const int maskWidth = m_maskBounds.width();
+    const int maskHeight = m_maskBounds.height();
+    const int maskRowStride = maskWidth * pixelSize;
+
+    // the same wrapping as in KisFillPainter::fillRect() with a pattern
+    auto wrap = [] (int value, int size) {
+        const int result = value % size;
+        return result >= 0 ? result : result + size;
+    };
+
+    const int startX = wrap(patchRect.x(), maskWidth);
+    int srcY = wrap(patchRect.y(), maskHeight);
+
+    for (int row = 0; row < patchRect.height(); row++) {
+        const quint8 *srcRow = m_maskPixels.constData() + srcY * maskRowStride;
+
+        int srcX = startX;
+        int columnsRemaining = patchRect.width();
+
+        while (columnsRemaining > 0) {
+            const int columns = qMin(maskWidth - srcX, columnsRemaining);
+            memcpy(dst, srcRow + srcX * pixelSize, columns * pixelSize);
+
+            dst += columns * pixelSize;
+            columnsRemaining -= columns;
+            srcX = 0;
+        }
+
+        if (++srcY >= maskHeight) {
+            srcY = 0;
+        }
+    }
+}
+
 bool KisTextureMaskInfo::fillProperties(const KisPropertiesConfiguration *setting, KisResourcesInterfaceSP resourcesInterface, bool invertAdditionally)
 {
     KisTextureOptionData data;
@@ -241,6 +285,29 @@ void KisTextureMaskInfo::recalculateMask()
         m_mask->convertFromQImage(mask, 0);
     }
     m_maskBounds = QRect(0, 0, width, height);
+
+    /**
+     * Keep a flat copy of the mask in the color space the texture option
+     * consumes it in, so that applying the texture to a dab is a plain
+     * memcpy of the patch followed by a single composition pass
+     */
+    m_maskPixelsColorSpace = m_preserveAlpha ?
+        KoColorSpaceRegistry::instance()->rgb8() :
+        KoColorSpaceRegistry::instance()->alpha8();
+
+    const int numPixels = width * height;
+    m_maskPixels.resize(numPixels * m_maskPixelsColorSpace->pixelSize());
+
+    if (*m_mask->colorSpace() == *m_maskPixelsColorSpace) {
+        m_mask->readBytes(m_maskPixels.data(), m_maskBounds);
+    } else {
+        QVector<quint8> rawPixels(numPixels * m_mask->pixelSize());
+        m_mask->readBytes(rawPixels.data(), m_maskBounds);
+        m_mask->colorSpace()->convertPixelsTo(rawPixels.constData(), m_maskPixels.data(),
+                                              m_maskPixelsColorSpace, numPixels,
+                                              KoColorConversionTransformation::internalRenderingIntent(),
+                                              KoColorConversionTransformation::internalConversionFlags());
+    }
 }
 
 bool KisTextureMaskInfo::hasAlpha() {
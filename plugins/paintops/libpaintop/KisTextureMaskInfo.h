@@ -11,6 +11,7 @@
 #include <kis_paint_device.h>
 #include <QSharedPointer>
 #include <QMutex>
+#include <QVector>
 
 
 #include <boost/operators.hpp>
@@ -19,6 +20,7 @@
 
 class KisTextureMaskInfo;
 class KisResourcesInterface;
+class KoColorSpace;
 
 class KisTextureMaskInfo : public boost::equality_comparable<KisTextureMaskInfo>
 {
@@ -42,6 +44,24 @@ public:
 
     QRect maskBounds() const;
 
+    /**
+     * Color space of the pixels returned by fillMaskPatch(): alpha8
+     * for the masking modes and rgb8 when the alpha of the pattern
+     * should be preserved (lightness and gradient modes)
+     */
+    const KoColorSpace* maskPixelsColorSpace() const;
+
+    /**
+     * Copies the area \p patchRect of the mask, tiled infinitely in
+     * both directions, into a contiguous buffer \p dst. The buffer
+     * should be able to hold patchRect.width() * patchRect.height()
+     * pixels in maskPixelsColorSpace().
+     *
+     * The pixels are copied from a flat pre-converted copy of the
+     * mask, so no tile lookups or color conversions happen per dab.
+     */
+    void fillMaskPatch(quint8 *dst, const QRect &patchRect) const;
+
     bool fillProperties(const KisPropertiesConfiguration *setting, KisResourcesInterfaceSP resourcesInterface, bool invertAdditionally);
 
     void recalculateMask();
@@ -67,6 +87,9 @@ private:
     KisPaintDeviceSP m_mask;
     QRect m_maskBounds;
 
+    QVector<quint8> m_maskPixels;
+    const KoColorSpace *m_maskPixelsColorSpace = nullptr;
+
 };
 
 typedef QSharedPointer<KisTextureMaskInfo> KisTextureMaskInfoSP;
@@ -21,14 +21,11 @@
 #include <KoResource.h>
 #include <KoResourceServerProvider.h>
 #include <kis_paint_device.h>
-#include <kis_fill_painter.h>
 #include <kis_painter.h>
-#include <kis_iterator_ng.h>
 #include <kis_fixed_paint_device.h>
 #include "KoMixColorsOp.h"
 #include <strokes/KisMaskingBrushCompositeOpBase.h>
 #include <strokes/KisMaskingBrushCompositeOpFactory.h>
-#include <kis_random_accessor_ng.h>
 #include <KoCompositeOpRegistry.h>
 
 #include <KoCanvasResourcesIds.h>
@@ -169,36 +166,43 @@ bool KisTextureOption::requiresEffectiveCompositeOp(const KisPropertiesConfigura
 }
 
 
-void KisTextureOption::applyLightness(KisFixedPaintDeviceSP dab, const QPoint& offset, const KisPaintInformation& info) {
-    if (!m_enabled) return;
-    if (!m_maskInfo->isValid()) return;
+quint8* KisTextureOption::fetchMaskPatch(const QPoint &offset, const QRect &dabRect)
+{
+    const QRect maskBounds = m_maskInfo->maskBounds();
 
-    KisPaintDeviceSP mask = m_maskInfo->mask();
+    const int x = offset.x() % maskBounds.width() - m_offsetX;
+    const int y = offset.y() % maskBounds.height() - m_offsetY;
 
-    const QRect rect = dab->bounds();
-    const QRect maskBounds = m_maskInfo->maskBounds();
+    const int patchSize = dabRect.width() * dabRect.height() * m_maskInfo->maskPixelsColorSpace()->pixelSize();
+    if (m_maskPatch.size() < patchSize) {
+        m_maskPatch.resize(patchSize);
+    }
+
+    m_maskInfo->fillMaskPatch(m_maskPatch.data(), QRect(x, y, dabRect.width(), dabRect.height()));
 
-    KisCachedPaintDevice::Guard g(mask, KoColorSpaceRegistry::instance()->rgb8(), m_cachedPaintDevice);
-    KisPaintDeviceSP fillMaskDevice = g.device();
+    return m_maskPatch.data();
+}
 
-    int x = offset.x() % maskBounds.width() - m_offsetX;
-    int y = offset.y() % maskBounds.height() - m_offsetY;
+void KisTextureOption::applyLightness(KisFixedPaintDeviceSP dab, const QPoint& offset, const KisPaintInformation& info) {
+    if (!m_enabled) return;
+    if (!m_maskInfo->isValid()) return;
 
-    const QRect maskPatchRect = QRect(x, y, rect.width(), rect.height());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(*m_maskInfo->maskPixelsColorSpace() == *KoColorSpaceRegistry::instance()->rgb8());
 
-    KisFillPainter fillMaskPainter(fillMaskDevice);
-    fillMaskPainter.setCompositeOpId(COMPOSITE_COPY);
-    fillMaskPainter.fillRect(kisGrowRect(maskPatchRect, 1), mask, maskBounds);
-    fillMaskPainter.end();
+    const QRect rect = dab->bounds();
+    const QRgb *maskQRgb = reinterpret_cast<const QRgb*>(fetchMaskPatch(offset, rect));
 
     qreal pressure = m_strengthOption.apply(info);
     quint8* dabData = dab->data();
 
-    KisSequentialConstIterator it(fillMaskDevice, QRect(x, y, rect.width(), rect.height()));
-    while (it.nextPixel()) {
-        const QRgb *maskQRgb = reinterpret_cast<const QRgb*>(it.oldRawData());
-        dab->colorSpace()->fillGrayBrushWithColorAndLightnessWithStrength(dabData, maskQRgb, dabData, pressure, 1);
-        dabData += dab->pixelSize();
+    const KoColorSpace *cs = dab->colorSpace();
+    const int pixelSize = dab->pixelSize();
+    const int numPixels = rect.width() * rect.height();
+
+    for (int i = 0; i < numPixels; i++) {
+        cs->fillGrayBrushWithColorAndLightnessWithStrength(dabData, maskQRgb, dabData, pressure, 1);
+        dabData += pixelSize;
+        maskQRgb++;
     }
 }
 
@@ -207,54 +211,54 @@ void KisTextureOption::applyGradient(KisFixedPaintDeviceSP dab, const QPoint& of
     if (!m_maskInfo->isValid()) return;
 
     KIS_SAFE_ASSERT_RECOVER_RETURN(m_gradient && m_gradient->valid());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(*m_maskInfo->maskPixelsColorSpace() == *KoColorSpaceRegistry::instance()->rgb8());
 
-    KisPaintDeviceSP mask = m_maskInfo->mask();
-    const QRect maskBounds = m_maskInfo->maskBounds();
-    QRect rect = dab->bounds();
-
-    KisCachedPaintDevice::Guard g(mask, KoColorSpaceRegistry::instance()->rgb8(), m_cachedPaintDevice);
-    KisPaintDeviceSP fillDevice = g.device();
-
-    int x = offset.x() % maskBounds.width() - m_offsetX;
-    int y = offset.y() % maskBounds.height() - m_offsetY;
-
-    const QRect maskPatchRect = QRect(x, y, rect.width(), rect.height());
-
-    KisFillPainter fillPainter(fillDevice);
-    fillPainter.setCompositeOpId(COMPOSITE_COPY);
-    fillPainter.fillRect(kisGrowRect(maskPatchRect, 1), mask, maskBounds);
-    fillPainter.end();
+    const QRect rect = dab->bounds();
+    const QRgb *maskQRgb = reinterpret_cast<const QRgb*>(fetchMaskPatch(offset, rect));
 
     qreal pressure = m_strengthOption.apply(info);
     quint8* dabData = dab->data();
 
+    const KoColorSpace *cs = dab->colorSpace();
+    const int pixelSize = dab->pixelSize();
+
     //for gradient textures...
-    KoMixColorsOp* colorMix = dab->colorSpace()->mixColorsOp();
+    KoMixColorsOp* colorMix = cs->mixColorsOp();
     qint16 colorWeights[2];
     colorWeights[0] = qRound(pressure * 255);
     colorWeights[1] = 255 - colorWeights[0];
-    quint8* colors[2];
-    m_cachedGradient.setColorSpace(dab->colorSpace()); //Change colorspace here so we don't have to convert each pixel drawn
-
-    KisHLineIteratorSP iter = fillDevice->createHLineIteratorNG(x, y, rect.width());
-    for (int row = 0; row < rect.height(); ++row) {
-        for (int col = 0; col < rect.width(); ++col) {
-
-            const QRgb* maskQRgb = reinterpret_cast<const QRgb*>(iter->oldRawData());
-            qreal gradientvalue = qreal(qGray(*maskQRgb))/255.0;//qreal(*iter->oldRawData()) / 255.0;
-            KoColor paintcolor;
-            paintcolor.setColor(m_cachedGradient.cachedAt(gradientvalue), dab->colorSpace());
-            qreal paintOpacity = paintcolor.opacityF() * (qreal(qAlpha(*maskQRgb)) / 255.0);
-            paintcolor.setOpacity(qMin(paintOpacity, dab->colorSpace()->opacityF(dabData)));
-            colors[0] = paintcolor.data();
-            KoColor dabColor(dabData, dab->colorSpace());
-            colors[1] = dabColor.data();
-            colorMix->mixColors(colors, colorWeights, 2, dabData);
-
-            iter->nextPixel();
-            dabData += dab->pixelSize();
-        }
-        iter->nextRow();
+    m_cachedGradient.setColorSpace(cs); //Change colorspace here so we don't have to convert each pixel drawn
+
+    /**
+     * The gradient is sampled by the gray value of the mask only, so
+     * fetch the colors and their opacities once per dab instead of
+     * constructing KoColor objects for every pixel
+     */
+    const quint8 *gradientColors[256];
+    qreal gradientOpacities[256];
+    for (int i = 0; i < 256; i++) {
+        gradientColors[i] = m_cachedGradient.cachedAt(qreal(i) / 255.0);
+        gradientOpacities[i] = cs->opacityF(gradientColors[i]);
+    }
+
+    QVector<quint8> paintColor(pixelSize);
+    QVector<quint8> dabColor(pixelSize);
+    const quint8 *colors[2] = {paintColor.constData(), dabColor.constData()};
+
+    const int numPixels = rect.width() * rect.height();
+
+    for (int i = 0; i < numPixels; i++) {
+        const int gray = qGray(*maskQRgb);
+
+        memcpy(paintColor.data(), gradientColors[gray], pixelSize);
+        const qreal paintOpacity = gradientOpacities[gray] * (qreal(qAlpha(*maskQRgb)) / 255.0);
+        cs->setOpacity(paintColor.data(), qMin(paintOpacity, cs->opacityF(dabData)), 1);
+
+        memcpy(dabColor.data(), dabData, pixelSize);
+        colorMix->mixColors(colors, colorWeights, 2, dabData);
+
+        dabData += pixelSize;
+        maskQRgb++;
     }
 }
 
@@ -272,22 +276,21 @@ void KisTextureOption::apply(KisFixedPaintDeviceSP dab, const QPoint &offset, co
         return;
     }
 
-    QRect rect = dab->bounds();
-    KisPaintDeviceSP mask = m_maskInfo->mask();
-    const QRect maskBounds = m_maskInfo->maskBounds();
-
-    KisCachedPaintDevice::Guard g(mask, KoColorSpaceRegistry::instance()->alpha8(), m_cachedPaintDevice);
-    KisPaintDeviceSP maskPatch = g.device();
-
-    int x = offset.x() % maskBounds.width() - m_offsetX;
-    int y = offset.y() % maskBounds.height() - m_offsetY;
-
-    const QRect maskPatchRect = QRect(x, y, rect.width(), rect.height());
-
-    KisFillPainter fillPainter(maskPatch);
-    fillPainter.setCompositeOpId(COMPOSITE_COPY);
-    fillPainter.fillRect(kisGrowRect(maskPatchRect, 1), mask, maskBounds);
-    fillPainter.end();
+    const QRect rect = dab->bounds();
+    const quint8 *maskPatch = fetchMaskPatch(offset, rect);
+
+    const KoColorSpace *alpha8 = KoColorSpaceRegistry::instance()->alpha8();
+    QVector<quint8> convertedMaskPatch;
+
+    if (*m_maskInfo->maskPixelsColorSpace() != *alpha8) {
+        // the gradient mode falls back to masking when there is no gradient
+        const int numPixels = rect.width() * rect.height();
+        convertedMaskPatch.resize(numPixels * alpha8->pixelSize());
+        m_maskInfo->maskPixelsColorSpace()->convertPixelsTo(maskPatch, convertedMaskPatch.data(), alpha8, numPixels,
+                                                            KoColorConversionTransformation::internalRenderingIntent(),
+                                                            KoColorConversionTransformation::internalConversionFlags());
+        maskPatch = convertedMaskPatch.constData();
+    }
 
     // Compute final strength
     qreal strength = m_strengthOption.apply(info);
@@ -334,45 +337,9 @@ void KisTextureOption::apply(KisFixedPaintDeviceSP dab, const QPoint &offset, co
                         compositeOpId, alphaChannelType, dab->pixelSize(),
                         alphaChannelOffset, strength, m_useSoftTexturing));
 
-    // Apply the mask to the dab
-    {
-        quint8 *dabIt = nullptr;
-        KisRandomConstAccessorSP maskPatchIt = maskPatch->createRandomConstAccessorNG();
-
-        qint32 dabY = dab->bounds().y();
-        qint32 maskPatchY = maskPatchRect.y();
-        qint32 rowsRemaining = dab->bounds().height();
-        const qint32 dabRowStride = dab->bounds().width() * dab->pixelSize();
-
-        while (rowsRemaining > 0) {
-            qint32 dabX = dab->bounds().x();
-            qint32 maskPatchX = maskPatchRect.x();
-            const qint32 numContiguousMaskPatchRows = maskPatchIt->numContiguousRows(maskPatchY);
-            const qint32 rows = std::min(rowsRemaining, numContiguousMaskPatchRows);
-            qint32 columnsRemaining = dab->bounds().width();
-
-            while (columnsRemaining > 0) {
-                const qint32 numContiguousMaskPatchColumns = maskPatchIt->numContiguousColumns(maskPatchX);
-                const qint32 columns = std::min(columnsRemaining, numContiguousMaskPatchColumns);
-
-                const qint32 maskPatchRowStride = maskPatchIt->rowStride(maskPatchX, maskPatchY);
-
-                dabIt = dab->data() + (dabY * dab->bounds().width() + dabX) * dab->pixelSize();
-                maskPatchIt->moveTo(maskPatchX, maskPatchY);
-
-                compositeOp->composite(maskPatchIt->rawDataConst(), maskPatchRowStride,
-                                       dabIt, dabRowStride,
-                                       columns, rows);
-
-                dabX += columns;
-                maskPatchX += columns;
-                columnsRemaining -= columns;
-
-            }
-
-            dabY += rows;
-            maskPatchY += rows;
-            rowsRemaining -= rows;
-        }
-    }
+    // Apply the mask to the dab, both buffers are contiguous, so it
+    // can be done in a single pass
+    compositeOp->composite(maskPatch, rect.width(),
+                           dab->data(), rect.width() * dab->pixelSize(),
+                           rect.width(), rect.height());
 }
@@ -11,7 +11,6 @@
 #include <kritapaintop_export.h>
 
 #include <kis_paint_device.h>
-#include <kis_cached_paint_device.h>
 #include <kis_types.h>
 #include <resources/KoAbstractGradient.h>
 #include <resources/KoCachedGradient.h>
@@ -56,6 +55,14 @@ private:
     void applyLightness(KisFixedPaintDeviceSP dab, const QPoint& offset, const KisPaintInformation& info);
     void applyGradient(KisFixedPaintDeviceSP dab, const QPoint& offset, const KisPaintInformation& info);
     void fillProperties(const KisPropertiesConfiguration *setting, KisResourcesInterfaceSP resourcesInterface, KoCanvasResourcesInterfaceSP canvasResourcesInterface);
+
+    /**
+     * Fills m_maskPatch with the part of the texture covered by the dab
+     * and returns the pointer to it. The patch is a contiguous buffer of
+     * dabRect.width() * dabRect.height() pixels in the color space of
+     * KisTextureMaskInfo::maskPixelsColorSpace().
+     */
+    quint8* fetchMaskPatch(const QPoint &offset, const QRect &dabRect);
 private:
 
     int m_offsetX {0};
@@ -71,7 +78,7 @@ private:
     KisStrengthOption m_strengthOption;
     KisTextureMaskInfoSP m_maskInfo;
     KisBrushTextureFlags m_flags;
-    KisCachedPaintDevice m_cachedPaintDevice;
+    QVector<quint8> m_maskPatch;
 };
 
 #endif // KIS_TEXTURE_OPTION_H
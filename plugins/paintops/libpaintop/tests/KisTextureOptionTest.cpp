@@ -0,0 +1,156 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTextureOptionTest.h"
+
+#include <QRandomGenerator>
+
+#include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
+#include <resources/KoPattern.h>
+
+#include <kis_fill_painter.h>
+#include <kis_fixed_paint_device.h>
+#include <kis_global.h>
+#include <kis_paint_device.h>
+#include <kis_properties_configuration.h>
+#include <kis_random_accessor_ng.h>
+#include <brushengine/kis_paint_information.h>
+#include <strokes/KisMaskingBrushCompositeOpBase.h>
+#include <strokes/KisMaskingBrushCompositeOpFactory.h>
+#include <KisLocalStrokeResources.h>
+
+#include "KisEmbeddedTextureData.h"
+#include "KisStandardOptions.h"
+#include "KisTextureMaskInfo.h"
+#include "KisTextureOptionData.h"
+#include "kis_texture_option.h"
+
+namespace {
+
+KoPatternSP createNoisePattern()
+{
+    QImage image(37, 29, QImage::Format_ARGB32);
+    QRandomGenerator random(12345);
+
+    for (int y = 0; y < image.height(); y++) {
+        QRgb *line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); x++) {
+            const int value = random.bounded(256);
+            line[x] = qRgba(value, value, value, 255);
+        }
+    }
+
+    return KoPatternSP(new KoPattern(image, "test_texture", "test_texture.pat"));
+}
+
+KisFixedPaintDeviceSP createNoiseDab(const QRect &rect)
+{
+    KisFixedPaintDeviceSP dab = new KisFixedPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dab->setRect(rect);
+    dab->initialize();
+
+    QRandomGenerator random(54321);
+    quint8 *data = dab->data();
+    for (int i = 0; i < rect.width() * rect.height() * dab->pixelSize(); i++) {
+        data[i] = random.bounded(256);
+    }
+
+    return dab;
+}
+
+/**
+ * Applies the texture the way KisTextureOption used to: the mask
+ * patch is filled into a paint device and composited on the dab
+ * pixel by pixel
+ */
+void applyTexturePerPixel(KisFixedPaintDeviceSP dab, const QPoint &offset,
+                          KisTextureMaskInfoSP maskInfo, const QString &compositeOpId,
+                          qreal strength)
+{
+    const QRect rect = dab->bounds();
+    const QRect maskBounds = maskInfo->maskBounds();
+
+    KisPaintDeviceSP maskPatch = new KisPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
+
+    const int x = offset.x() % maskBounds.width();
+    const int y = offset.y() % maskBounds.height();
+    const QRect maskPatchRect(x, y, rect.width(), rect.height());
+
+    KisFillPainter fillPainter(maskPatch);
+    fillPainter.setCompositeOpId(COMPOSITE_COPY);
+    fillPainter.fillRect(kisGrowRect(maskPatchRect, 1), maskInfo->mask(), maskBounds);
+    fillPainter.end();
+
+    const int alphaChannelOffset = 3;
+    QScopedPointer<KisMaskingBrushCompositeOpBase> compositeOp(
+        KisMaskingBrushCompositeOpFactory::createForAlphaSrc(
+            compositeOpId, KoChannelInfo::UINT8, dab->pixelSize(),
+            alphaChannelOffset, strength, false));
+
+    KisRandomConstAccessorSP it = maskPatch->createRandomConstAccessorNG();
+    quint8 *dabPtr = dab->data();
+
+    for (int row = 0; row < rect.height(); row++) {
+        for (int col = 0; col < rect.width(); col++) {
+            it->moveTo(x + col, y + row);
+            compositeOp->composite(it->rawDataConst(), 1, dabPtr, dab->pixelSize(), 1, 1);
+            dabPtr += dab->pixelSize();
+        }
+    }
+}
+
+}
+
+void KisTextureOptionTest::testApplyMatchesPerPixelMasking_data()
+{
+    QTest::addColumn<int>("texturingMode");
+    QTest::addColumn<QString>("compositeOpId");
+    QTest::addColumn<QPoint>("offset");
+
+    QTest::newRow("multiply") << int(KisTextureOptionData::MULTIPLY) << QString(COMPOSITE_MULT) << QPoint(0, 0);
+    QTest::newRow("multiply-wrapped") << int(KisTextureOptionData::MULTIPLY) << QString(COMPOSITE_MULT) << QPoint(130, 77);
+    QTest::newRow("subtract") << int(KisTextureOptionData::SUBTRACT) << QString(COMPOSITE_SUBTRACT) << QPoint(0, 0);
+    QTest::newRow("subtract-wrapped") << int(KisTextureOptionData::SUBTRACT) << QString(COMPOSITE_SUBTRACT) << QPoint(45, 31);
+}
+
+void KisTextureOptionTest::testApplyMatchesPerPixelMasking()
+{
+    QFETCH(int, texturingMode);
+    QFETCH(QString, compositeOpId);
+    QFETCH(QPoint, offset);
+
+    KoPatternSP pattern = createNoisePattern();
+    KisResourcesInterfaceSP resourcesInterface(new KisLocalStrokeResources({pattern}));
+
+    KisPropertiesConfigurationSP setting = new KisPropertiesConfiguration();
+    KisEmbeddedTextureData::fromPattern(pattern).write(setting.data());
+    setting->setProperty("Texture/Pattern/Enabled", true);
+    setting->setProperty("Texture/Pattern/TexturingMode", texturingMode);
+
+    KisTextureOption option(setting.data(), resourcesInterface, nullptr, 0);
+    QVERIFY(option.m_enabled);
+
+    KisTextureMaskInfoSP maskInfo = toQShared(new KisTextureMaskInfo(0, false));
+    QVERIFY(maskInfo->fillProperties(setting.data(), resourcesInterface, false));
+    maskInfo = KisTextureMaskInfoCache::instance()->fetchCachedTextureInfo(maskInfo);
+
+    const KisPaintInformation info(QPointF(), 0.7);
+    const qreal strength = KisStrengthOption(setting.data()).apply(info);
+
+    const QRect dabRect(0, 0, 61, 53);
+    KisFixedPaintDeviceSP dab = createNoiseDab(dabRect);
+    KisFixedPaintDeviceSP reference = createNoiseDab(dabRect);
+
+    option.apply(dab, offset, info);
+    applyTexturePerPixel(reference, offset, maskInfo, compositeOpId, strength);
+
+    const int numBytes = dabRect.width() * dabRect.height() * dab->pixelSize();
+    QCOMPARE(QByteArray(reinterpret_cast<const char*>(dab->data()), numBytes),
+             QByteArray(reinterpret_cast<const char*>(reference->data()), numBytes));
+}
+
+SIMPLE_TEST_MAIN(KisTextureOptionTest)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTEXTUREOPTIONTEST_H
+#define KISTEXTUREOPTIONTEST_H
+
+#include <simpletest.h>
+
+class KisTextureOptionTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testApplyMatchesPerPixelMasking_data();
+    void testApplyMatchesPerPixelMasking();
+};
+
+#endif // KISTEXTUREOPTIONTEST_H